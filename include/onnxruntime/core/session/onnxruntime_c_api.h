@@ -4778,6 +4778,35 @@ struct OrtApi {
    */
   ORT_API2_STATUS(SetEpDynamicOptions, _Inout_ OrtSession* sess, _In_reads_(kv_len) const char* const* keys,
                   _In_reads_(kv_len) const char* const* values, _In_ size_t kv_len);
+
+  /// @}
+  /// \name OrtLoraAdapter
+  /// @{
+
+  /** \brief Create an OrtLoraAdapter that stacks the parameters of several adapters
+   *
+   * Every parameter of the new adapter has an extra leading dimension of size num_adapters and holds the
+   * corresponding parameter of adapters[i] at index i. This lets a single Run serve a batch in which every row
+   * uses a different adapter: activate the stacked adapter with OrtApi::RunOptionsAddActiveLoraAdapter and pass
+   * the per row adapter index as a model input, e.g. to com.microsoft.LoRAMatMul.
+   *
+   * All adapters must have the same parameter names, element types, ranks and model version. Parameters with
+   * smaller dimensions, such as a lower LoRA rank, are zero padded. The source adapters are not referenced after
+   * the call and may be released.
+   *
+   * \param[in] adapters array of adapters to stack.
+   * \param[in] num_adapters number of adapters in the array.
+   * \param[in] allocator optional pointer to a device allocator. If specified the stacked
+   *            data is copied to the device. If nullptr, data stays on CPU.
+   * \param[out] out A pointer to a newly created OrtLoraAdapter instance. Must be released with
+   *                  OrtApi::ReleaseLoraAdapter.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.21.
+   */
+  ORT_API2_STATUS(CreateLoraAdapterStack, _In_reads_(num_adapters) const OrtLoraAdapter* const* adapters,
+                  size_t num_adapters, _In_ OrtAllocator* allocator, _Outptr_ OrtLoraAdapter** out);
 };
 
 /*
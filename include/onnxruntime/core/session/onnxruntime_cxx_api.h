@@ -767,6 +767,15 @@ struct LoraAdapter : detail::Base<OrtLoraAdapter> {
   ///        be copied to device if required by the model at inference time.
   static LoraAdapter CreateLoraAdapterFromArray(const void* bytes, size_t num_bytes,
                                                 OrtAllocator* allocator);
+
+  /// \brief Wraps OrtApi::CreateLoraAdapterStack
+  ///
+  /// The function stacks the parameters of the adapters along a new leading dimension, so that
+  /// a single Run can select a different adapter for every batch row.
+  /// \param adapters The adapters to stack, in the order of their adapter index
+  /// \param allocator optional pointer to a device allocator. If nullptr, the data stays on CPU.
+  static LoraAdapter CreateLoraAdapterStack(const std::vector<const OrtLoraAdapter*>& adapters,
+                                            OrtAllocator* allocator);
 };
 
 /** \brief RunOptions
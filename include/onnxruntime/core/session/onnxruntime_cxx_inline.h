@@ -571,6 +571,13 @@ inline LoraAdapter LoraAdapter::CreateLoraAdapterFromArray(const void* bytes, si
   return LoraAdapter{p};
 }
 
+inline LoraAdapter LoraAdapter::CreateLoraAdapterStack(const std::vector<const OrtLoraAdapter*>& adapters,
+                                                       OrtAllocator* allocator) {
+  OrtLoraAdapter* p;
+  ThrowOnError(GetApi().CreateLoraAdapterStack(adapters.data(), adapters.size(), allocator, &p));
+  return LoraAdapter{p};
+}
+
 inline RunOptions::RunOptions() {
   ThrowOnError(GetApi().CreateRunOptions(&p_));
 }
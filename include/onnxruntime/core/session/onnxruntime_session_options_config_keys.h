@@ -32,6 +32,20 @@ static const char* const kOrtSessionOptionsConfigLoadModelFormat = "session.load
 // If unset, format will default to ONNX unless optimized_model_filepath ends in '.ort'.
 static const char* const kOrtSessionOptionsConfigSaveModelFormat = "session.save_model_format";
 
+// Save the execution plan of the main graph when saving an ORT format model, so that a session that loads the model
+// with the same execution providers and session options can skip creating the plan.
+// Only plans that run all nodes on a single stream are saved.
+// Option values:
+// - "0": The execution plan is not saved. [DEFAULT]
+// - "1": The execution plan is saved.
+static const char* const kOrtSessionOptionsSaveExecutionPlanInOrtFormat = "session.save_execution_plan_in_ort_format";
+
+// Use the execution plan saved in an ORT format model if it matches the session.
+// Option values:
+// - "0": The saved execution plan is ignored and a new plan is always created.
+// - "1": The saved execution plan is used if it matches the session. [DEFAULT]
+static const char* const kOrtSessionOptionsUseSavedExecutionPlan = "session.use_saved_execution_plan";
+
 // If a value is "1", flush-to-zero and denormal-as-zero are applied. The default is "0".
 // When multiple sessions are created, a main thread doesn't override changes from succeeding session options,
 // but threads in session thread pools follow option changes.
@@ -67,6 +81,28 @@ static const char* const kOrtSessionOptionsEnableQuantQDQCleanup = "session.enab
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Enable or disable the fusion of float elementwise operator subgraphs on the CPU EP into FusedElementwise nodes
+// that are evaluated in one pass over the data. "0": disable; "1": enable. The default is "0".
+// The fused kernel uses the MLAS implementations of the transcendental functions, which may differ slightly from the
+// results of the unfused operators.
+static const char* const kOrtSessionOptionsEnableElementwiseFusion = "optimization.enable_elementwise_fusion";
+
+// Quantize the data of Gather nodes on the CPU EP that read from large constant float tables, e.g. embedding tables,
+// and replace them with com.microsoft.GatherBlockQuantized nodes that dequantize only the gathered rows.
+// The value is the number of bits of the quantized data: "0": disable; "4" or "8": enable. The default is "0".
+// The data is quantized block-wise along its innermost axis, with a scale and zero point per block of up to 128
+// elements.
+static const char* const kOrtSessionOptionsGatherBlockQuantizeBits = "optimization.gather_block_quantize_bits";
+
+// The minimum number of elements of a Gather data initializer for it to be quantized. The default is "1048576".
+static const char* const kOrtSessionOptionsGatherBlockQuantizeMinElements =
+    "optimization.gather_block_quantize_min_elements";
+
+// The accuracy budget of the Gather data quantization. A table is only quantized if the root mean square of the
+// quantization error is at most this fraction of the root mean square of the table values. The default is "0.01",
+// which int8 tables typically meet. Int4 tables typically need a budget of "0.1".
+static const char* const kOrtSessionOptionsGatherBlockQuantizeMaxError = "optimization.gather_block_quantize_max_error";
+
 // This setting controls whether to enable AheadOfTime function inlining.
 // AOT function inlining examines the graph and attempts to inline as many locally defined functions in the model
 // as possible with the help of enabled execution providers.
@@ -111,6 +147,13 @@ static const char* const kOrtSessionOptionsDisableSpecifiedOptimizers = "optimiz
 // Using device allocators means the memory allocation is made using malloc/new.
 static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "session.use_device_allocator_for_initializers";
 
+// Enable or disable sharing CPU initializers and their pre-packed weights by content across all the sessions in the
+// process that enable it. "1": enable; "0": disable. The default is "0".
+// Identical initializers (same data type, shape and bytes), e.g. the embedding tables of several versions of a model,
+// are only stored once. They are released when the last session that uses them is released.
+// Initializers added with AddInitializer() are not shared by content, as their memory is owned by the user.
+static const char* const kOrtSessionOptionsShareInitializersByContent = "session.share_initializers_by_content";
+
 // Configure whether to allow the inter_op/intra_op threads spinning a number of times before blocking
 // "0": thread will block if found no job to run
 // "1": default, thread will spin a number of times before blocking
@@ -289,11 +332,37 @@ static const char* const kOrtSessionOptionShareEpContexts = "ep.share_ep_context
 // - "1": Gemm FastMath mode is enabled.
 static const char* const kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16 = "mlas.enable_gemm_fastmath_arm64_bfloat16";
 
+// Platform independent version of kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16. In addition to ARM64 processors
+// with the BF16 extensions, this also enables the bfloat16 based matmul on x64 processors with AVX512-BF16.
+// The weights of MatMul nodes are converted to bfloat16 once when they are pre-packed.
+// Option values:
+// - "0": Gemm FastMath mode is not enabled. [DEFAULT]
+// - "1": Gemm FastMath mode is enabled.
+static const char* const kOrtSessionOptionsMlasGemmFastMathBfloat16 = "mlas.enable_gemm_fastmath_bfloat16";
+
 // When converting DQ + MatMul -> MatMulNBits, the accuracy level of the MatMulNBits is controlled by this option.
 // Refer to MatMulNBits op schema for more details.
 // If not provided, default is 4.
 static const char* const kOrtSessionOptionsQDQMatMulNBitsAccuracyLevel = "session.qdq_matmulnbits_accuracy_level";
 
+// TunableOp settings of the CPU EP, which correspond to the "tunable_op_*" provider options of the CUDA and ROCm EPs.
+// With TunableOp enabled, kernels such as MatMul and Conv use the fastest of their implementations for each problem
+// size, as found by tuning or loaded from the tuning results of the session.
+// Option values:
+// - "0": TunableOp is not used. [DEFAULT]
+// - "1": TunableOp is used.
+static const char* const kOrtSessionOptionsCpuTunableOpEnable = "ep.cpu.tunable_op_enable";
+
+// Whether the CPU EP tunes the kernels for the problem sizes that have no tuning result yet, the first time they are
+// run. The results can be saved with the GetTuningResults API and loaded in later sessions.
+// Option values:
+// - "0": Tuning is not done. [DEFAULT]
+// - "1": Tuning is done.
+static const char* const kOrtSessionOptionsCpuTunableOpTuningEnable = "ep.cpu.tunable_op_tuning_enable";
+
+// Limits the time spent tuning each candidate implementation of a kernel, in milliseconds. 0 means no limit. [DEFAULT]
+static const char* const kOrtSessionOptionsCpuTunableOpMaxTuningDurationMs = "ep.cpu.tunable_op_max_tuning_duration_ms";
+
 // THIS OPTION IS NOT A REGULAR SESSION OPTION SINCE IT CAN BE MODIFIED AT ANY TIME
 // Meant to be used with SetEpDynamicOptions
 // Specify the type of workload for this session.
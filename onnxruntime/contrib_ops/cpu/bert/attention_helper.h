@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <limits>
+#include <type_traits>
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "core/common/safeint.h"
@@ -252,5 +254,95 @@ T* ConcatStateChunkGQA(const T* past,
   return start;
 }
 
+// Convert a chunk of K or V to the storage type of a quantized KV cache. An int8 cache is quantized
+// symmetrically with the given scale and no zero point.
+template <typename T, typename TCache>
+void ConvertToKVCacheType(const T* source, TCache* destination, size_t count, float scale) {
+  if constexpr (std::is_same<T, float>::value && std::is_same<TCache, MLFloat16>::value) {
+    ORT_UNUSED_PARAMETER(scale);
+    MlasConvertFloatToHalfBuffer(source, destination, count);
+  } else if constexpr (std::is_same<T, float>::value && std::is_same<TCache, int8_t>::value) {
+    MlasQuantizeLinear<int8_t>(source, destination, count, scale, 0);
+  } else {
+    static_assert(std::is_same<T, MLFloat16>::value && std::is_same<TCache, int8_t>::value,
+                  "unsupported KV cache conversion");
+    constexpr size_t kBlockSize = 256;
+    float buffer[kBlockSize];
+    for (size_t offset = 0; offset < count; offset += kBlockSize) {
+      const size_t block = std::min(kBlockSize, count - offset);
+      MlasConvertHalfToFloatBuffer(source + offset, buffer, block);
+      MlasQuantizeLinear<int8_t>(buffer, destination + offset, block, scale, 0);
+    }
+  }
+}
+
+// Convert a chunk of a quantized KV cache back to fp32 for the attention GEMMs.
+template <typename TCache>
+void ConvertFromKVCacheType(const TCache* source, float* destination, size_t count, float scale) {
+  if constexpr (std::is_same<TCache, MLFloat16>::value) {
+    ORT_UNUSED_PARAMETER(scale);
+    MlasConvertHalfToFloatBuffer(source, destination, count);
+  } else {
+    static_assert(std::is_same<TCache, int8_t>::value, "unsupported KV cache type");
+    for (size_t j = 0; j < count; j++) {
+      destination[j] = scale * static_cast<float>(source[j]);
+    }
+  }
+}
+
+// Same as ConcatStateChunkGQA, but the new chunk is converted to the storage type of the present state.
+template <typename T, typename TCache>
+TCache* ConcatStateChunkGQA(const TCache* past,
+                            const T* chunk,
+                            TCache* present,
+                            size_t present_buff_chunk_length,
+                            size_t past_buff_chunk_length,
+                            size_t past_chunk_length,
+                            size_t new_chunk_length,
+                            bool past_present_share_buffer,
+                            float scale,
+                            std::ptrdiff_t i) {
+  TCache* start = present + i * present_buff_chunk_length;
+
+  TCache* p = start;
+  if (!past_present_share_buffer && past_chunk_length > 0) {
+    const TCache* src_past = past + i * past_buff_chunk_length;
+    memcpy(p, src_past, past_chunk_length * sizeof(TCache));
+  }
+  p += past_chunk_length;
+
+  ConvertToKVCacheType(chunk, p, new_chunk_length, scale);
+  return start;
+}
+
+// Choose the query and key/value block sizes of MlasFlashAttention from the size of the L2 cache.
+inline void SetFlashAttentionBlockSizes(MlasFlashAttentionThreadedArgs& args, int l2_cache_size) {
+  /*
+    q_block_size, kv_block_size correspond to Br, Bc in the FlashAttention paper.
+    Let M = l2_cache_size / sizeof(float)
+    In the FlashAttention kernel, there are 5 big matrices that we need to keep in L2 cache:
+      slice of Q -- [Br, qk_head_size]
+      slice of K -- [Bc, qk_head_size]
+      slice of V -- [Bc, v_head_size]
+      result of QK -- [Br, Bc]
+      temporary output (same shape as QKV) -- [Br, v_head_size]
+    The total size of these matrices is (Br + Bc) * (qk_head_size + v_head_size) + Br * Bc
+    By taking Bc = M / (4 * (qk_head_size + v_head_size)), and Br = min(Bc, qk_head_size + v_head_size), we have
+      (Br + Bc) * (qk_head_size + v_head_size) + Br * Bc
+      <= 2 * Bc * (qk_head_size + v_head_size) + Br * Bc
+      <= 2 * Bc * (qk_head_size + v_head_size) + M/4
+      <= 2 * M/4 + M/4 = M * (3/4)
+
+    We leave 1/4 of the L2 cache for
+      1. storing small tensors l and m
+      2. instruction (code)
+  */
+  args.kv_block_size = l2_cache_size / (static_cast<int>(sizeof(float)) * 4 * (args.qk_head_size + args.v_head_size));
+  args.kv_block_size = std::max(args.kv_block_size, 1);  // avoid kv_block_size = 0
+  args.q_block_size = std::min(args.kv_block_size, args.qk_head_size + args.v_head_size);
+  args.kv_block_size = std::min(args.kv_block_size, args.kv_sequence_length);  // No point to have kv_block_size > kv_sequence_length
+  args.q_block_size = std::min(args.q_block_size, args.q_sequence_length);     // No point to have q_block_size > q_sequence_length
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <type_traits>
+#include <vector>
+
 #include "contrib_ops/cpu/bert/attention_base.h"
 #include "contrib_ops/cpu/bert/attention_helper.h"
 
@@ -10,6 +13,8 @@
 #include "contrib_ops/cpu/bert/attention_common.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/env.h"
+#include "core/platform/env_var_utils.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -34,6 +39,9 @@ class GQAAttentionBase {
     use_smooth_softmax_ = info.GetAttrOrDefault<int64_t>("smooth_softmax", 0) == 1;
 
     local_window_size_ = has_local ? static_cast<int>(info.GetAttrOrDefault<int64_t>("local_window_size", -1)) : -1;
+
+    l2_cache_size_ = Env::Default().GetL2CacheSize();
+    disable_flash_ = ParseEnvironmentVariableWithDefault<bool>(attention::kDisableFlashAttention, false);
   }
 
   int num_heads_;     // number of attention heads of Q
@@ -46,12 +54,17 @@ class GQAAttentionBase {
 
   bool use_smooth_softmax_;
 
+  bool disable_flash_;
+  int l2_cache_size_;
+
   template <typename T>
   Status ApplyAttention(const T* Q,                                 // Q data with shape BxNxSxH
                         const T* K,                                 // K data with shape BxN_kvxSxH
                         const T* V,                                 // V data with shape BxN_kvxSxH
                         const Tensor* past_key,                     // past K input tensor (if not using past state)
                         const Tensor* past_value,                   // past V input tensor (if not using past state)
+                        const Tensor* k_scale,                      // scale of int8 K cache (per tensor or per head)
+                        const Tensor* v_scale,                      // scale of int8 V cache (per tensor or per head)
                         Tensor* output,                             // output tensor
                         Tensor* present_key,                        // present K output tensor (if separating present KV)
                         Tensor* present_value,                      // present V output tensor (if separating present KV)
@@ -59,6 +72,71 @@ class GQAAttentionBase {
                         GroupQueryAttentionParameters& parameters,  // attention parameters
                         AllocatorPtr allocator,                     // allocator for temporary tensors
                         OpKernelContext* context) const {
+    // The KV cache may be stored in a narrower type than the activations. New K and V are converted when
+    // appended to the cache, and the cache is converted back to fp32 per head inside the attention loops.
+    if (present_key == nullptr || present_key->IsDataType<T>()) {
+      return ApplyAttentionWithKVCache<T, T>(Q, K, V, past_key, past_value, nullptr, nullptr, output, present_key,
+                                             present_value, seqlens_k, parameters, allocator, context);
+    }
+
+    if constexpr (std::is_same<T, float>::value) {
+      if (present_key->IsDataType<MLFloat16>()) {
+        return ApplyAttentionWithKVCache<T, MLFloat16>(Q, K, V, past_key, past_value, nullptr, nullptr, output,
+                                                       present_key, present_value, seqlens_k, parameters,
+                                                       allocator, context);
+      }
+    }
+
+    if (present_key->IsDataType<int8_t>()) {
+      std::vector<float> k_scales;
+      std::vector<float> v_scales;
+      ORT_RETURN_IF_ERROR(GetKVCacheScales(k_scale, "k_scale", k_scales));
+      ORT_RETURN_IF_ERROR(GetKVCacheScales(v_scale, "v_scale", v_scales));
+      return ApplyAttentionWithKVCache<T, int8_t>(Q, K, V, past_key, past_value, k_scales.data(), v_scales.data(),
+                                                  output, present_key, present_value, seqlens_k, parameters,
+                                                  allocator, context);
+    }
+
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported KV cache type ",
+                           DataTypeImpl::ToString(present_key->DataType()), " for GroupQueryAttention.");
+  }
+
+ private:
+  // Expand the scale of an int8 KV cache to one value per kv head.
+  Status GetKVCacheScales(const Tensor* scale, const char* name, std::vector<float>& scales) const {
+    if (scale == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input '", name, "' is required for an int8 KV cache.");
+    }
+
+    const int64_t size = scale->Shape().Size();
+    if (size != 1 && size != kv_num_heads_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input '", name,
+                             "' shall have 1 or kv_num_heads elements, got ", size);
+    }
+
+    const float* data = scale->Data<float>();
+    scales.resize(kv_num_heads_);
+    for (int h = 0; h < kv_num_heads_; h++) {
+      scales[h] = data[size == 1 ? 0 : h];
+    }
+    return Status::OK();
+  }
+
+  template <typename T, typename TCache>
+  Status ApplyAttentionWithKVCache(const T* Q,
+                                   const T* K,
+                                   const T* V,
+                                   const Tensor* past_key,
+                                   const Tensor* past_value,
+                                   const float* k_scales,
+                                   const float* v_scales,
+                                   Tensor* output,
+                                   Tensor* present_key,
+                                   Tensor* present_value,
+                                   const Tensor* seqlens_k,
+                                   GroupQueryAttentionParameters& parameters,
+                                   AllocatorPtr allocator,
+                                   OpKernelContext* context) const {
     const bool is_prompt = parameters.is_first_prompt;
     const int batch_size = parameters.batch_size;
     const int sequence_length = parameters.sequence_length;
@@ -74,39 +152,148 @@ class GQAAttentionBase {
     }
     int seqlen_present_kv_cache = static_cast<int>(present_key->Shape().GetDims()[2]);
 
+    const TCache* past_key_data = past_key != nullptr ? past_key->Data<TCache>() : nullptr;
+    TCache* present_key_data = present_key != nullptr ? present_key->MutableData<TCache>() : nullptr;
+    const TCache* past_value_data = past_value != nullptr ? past_value->Data<TCache>() : nullptr;
+    TCache* present_value_data = present_value != nullptr ? present_value->MutableData<TCache>() : nullptr;
+
+    bool past_present_share_buffer = past_key_data == present_key_data && past_value_data == present_value_data;
+
+    if constexpr (std::is_same<T, TCache>::value) {
+      if (!disable_flash_ && l2_cache_size_ > 0) {
+        ApplyFlashAttention<T>(Q, K, V, past_key_data, past_value_data, present_key_data, present_value_data,
+                               output->MutableData<T>(), seqlens_k->Data<int32_t>(), batch_size, sequence_length,
+                               seqlen_past_kv_cache, seqlen_present_kv_cache, head_size, past_present_share_buffer,
+                               packed_qkv, is_prompt, tp, allocator);
+        return Status::OK();
+      }
+    }
+
     // Compute the attention score.
     size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * seqlen_present_kv_cache * sizeof(float);
     auto attention_probs = allocator->Alloc(bytes);
     BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
 
-    const T* past_key_data = past_key != nullptr ? past_key->Data<T>() : nullptr;
-    T* present_key_data = present_key != nullptr ? present_key->MutableData<T>() : nullptr;
-    const T* past_value_data = past_value != nullptr ? past_value->Data<T>() : nullptr;
-    T* present_value_data = present_value != nullptr ? present_value->MutableData<T>() : nullptr;
-
-    bool past_present_share_buffer = past_key_data == present_key_data && past_value_data == present_value_data;
-
     const T* k = packed_qkv ? Q + num_heads_ * sequence_length * head_size : K;
-    ComputeAttentionProbs<T>(static_cast<float*>(attention_probs), Q, k, seqlens_k->Data<int32_t>(), batch_size,
-                             sequence_length, seqlen_past_kv_cache, seqlen_present_kv_cache, head_size, past_key_data,
-                             present_key_data, past_present_share_buffer, packed_qkv, is_prompt, tp, allocator);
+    ComputeAttentionProbs<T, TCache>(static_cast<float*>(attention_probs), Q, k, seqlens_k->Data<int32_t>(),
+                                     batch_size, sequence_length, seqlen_past_kv_cache, seqlen_present_kv_cache,
+                                     head_size, past_key_data, present_key_data, k_scales, past_present_share_buffer,
+                                     packed_qkv, is_prompt, tp, allocator);
 
     // Compute the attentionScore * Value: out(B, N, S, H_v) = attention_probs(B, N, S, T) x V(B, N, T, H_v)
     const T* v = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
-    ComputeVxAttentionScore(output->MutableData<T>(), static_cast<float*>(attention_probs), v,
-                            seqlens_k->Data<int32_t>(),
-                            batch_size, sequence_length, seqlen_past_kv_cache, seqlen_present_kv_cache, head_size,
-                            hidden_size, past_value_data, present_value_data, past_present_share_buffer, packed_qkv,
-                            is_prompt, tp, allocator);
+    ComputeVxAttentionScore<T, TCache>(output->MutableData<T>(), static_cast<float*>(attention_probs), v,
+                                       seqlens_k->Data<int32_t>(),
+                                       batch_size, sequence_length, seqlen_past_kv_cache, seqlen_present_kv_cache,
+                                       head_size, hidden_size, past_value_data, present_value_data, v_scales,
+                                       past_present_share_buffer, packed_qkv, is_prompt, tp, allocator);
 
     return Status::OK();
   }
 
- private:
+  // Append the new keys and values to the present state, then run the causal attention with MlasFlashAttention
+  // directly on the KV cache. The attention probabilities are never materialized, so the scratch memory only
+  // depends on the block sizes instead of S x T per head.
+  template <typename T>
+  void ApplyFlashAttention(const T* Q,                                   // Q data. Its size is BxNxSxH
+                           const T* K,                                   // K data. Its size is BxN_kvxSxH
+                           const T* V,                                   // V data. Its size is BxN_kvxSxH
+                           const T* past_key,                            // past key only
+                           const T* past_value,                          // past value only
+                           T* present_key,                               // present key only
+                           T* present_value,                             // present value only
+                           T* output,                                    // output tensor. Its size is BxSxNxH
+                           const int32_t* seqlens_k,                     // total - 1 sequence lengths tensor
+                           const size_t batch_size,                      // batch size of self-attention
+                           const size_t sequence_length,                 // sequence length of self-attention (S)
+                           const size_t past_buffer_sequence_length,     // sequence length of past state
+                           const size_t present_buffer_sequence_length,  // sequence length of present state
+                           const size_t head_size,                       // head size of self-attention
+                           const bool past_present_share_buffer,         // whether present key and value share the same buffer
+                           const bool packed_qkv,                        // whether Q, K, V are packed
+                           const bool is_prompt,                         // whether it is prompt
+                           ThreadPool* tp,                               // thread pool
+                           AllocatorPtr allocator) const {               // allocator for temporary buffer
+    const ptrdiff_t packed_batch_stride =
+        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
+                   : SafeInt<ptrdiff_t>(0);
+    const size_t kv_input_chunk_length = sequence_length * head_size;                     // L x H
+    const size_t past_buff_chunk_length = past_buffer_sequence_length * head_size;        // L x H
+    const size_t present_buff_chunk_length = present_buffer_sequence_length * head_size;  // T x H
+
+    if (!past_present_share_buffer) {
+      const size_t present_bytes = batch_size * kv_num_heads_ * present_buff_chunk_length * sizeof(T);
+      memset((void*)present_key, 0, present_bytes);
+      memset((void*)present_value, 0, present_bytes);
+    }
+
+    // Each kv head is appended once, instead of once per query head of its group.
+    std::vector<int32_t> total_seqlens(batch_size);
+    for (size_t b = 0; b < batch_size; b++) {
+      total_seqlens[b] = seqlens_k[b] + 1;
+      const size_t past_chunk_length = is_prompt ? 0 : (static_cast<size_t>(total_seqlens[b]) - sequence_length) * head_size;
+      for (size_t h = 0; h < static_cast<size_t>(kv_num_heads_); h++) {
+        const std::ptrdiff_t i = static_cast<std::ptrdiff_t>(b * kv_num_heads_ + h);
+        const T* k;
+        const T* v;
+        if (packed_qkv) {
+          k = Q + packed_batch_stride * b + kv_input_chunk_length * (num_heads_ + h);
+          v = Q + packed_batch_stride * b + kv_input_chunk_length * (num_heads_ + kv_num_heads_ + h);
+        } else {
+          k = K + kv_input_chunk_length * i;
+          v = V + kv_input_chunk_length * i;
+        }
+        ConcatStateChunkGQA(past_key, k, present_key, present_buff_chunk_length, past_buff_chunk_length,
+                            past_chunk_length, kv_input_chunk_length, past_present_share_buffer, i);
+        ConcatStateChunkGQA(past_value, v, present_value, present_buff_chunk_length, past_buff_chunk_length,
+                            past_chunk_length, kv_input_chunk_length, past_present_share_buffer, i);
+      }
+    }
+
+    MlasFlashAttentionThreadedArgs args;
+    args.batch_size = static_cast<int>(batch_size);
+    args.num_heads = num_heads_;
+    args.q_sequence_length = static_cast<int>(sequence_length);
+    args.kv_sequence_length = static_cast<int>(present_buffer_sequence_length);
+    args.qk_head_size = static_cast<int>(head_size);
+    args.v_head_size = static_cast<int>(head_size);
+    args.scale = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+    SetFlashAttentionBlockSizes(args, l2_cache_size_);
+
+    args.kv_num_heads = kv_num_heads_;
+    args.kv_buffer_sequence_length = static_cast<int>(present_buffer_sequence_length);
+    args.q_batch_stride = packed_batch_stride;
+    args.kv_valid_lengths = total_seqlens.data();
+    args.causal = true;
+    args.local_window_size = local_window_size_;
+    args.softcap = softcap_;
+    args.smooth_softmax = use_smooth_softmax_;
+
+    if constexpr (std::is_same<T, float>::value) {
+      args.query = Q;
+      args.key = present_key;
+      args.value = present_value;
+      args.output = output;
+    } else {
+      args.query_fp16 = Q;
+      args.key_fp16 = present_key;
+      args.value_fp16 = present_value;
+      args.output_fp16 = output;
+    }
+
+    args.thread_count = concurrency::ThreadPool::DegreeOfParallelism(tp);
+    args.buffer_size_per_thread = MlasFlashAttentionGetBufferSizePerThread(&args);
+    IAllocatorUniquePtr<void> buffer =
+        IAllocator::MakeUniquePtr<void>(allocator, args.buffer_size_per_thread * args.thread_count);
+    args.buffer = reinterpret_cast<float*>(buffer.get());
+
+    MlasFlashAttention(&args, tp);
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T)
   //  attention_probs(B, N, S, T) = Softmax(attention_probs)
-  template <typename T>
+  template <typename T, typename TCache>
   void ComputeAttentionProbs(float* attention_probs,                       // output buffer with size BxNxSxT
                              const T* Q,                                   // Q data. Its size is BxNxSxH
                              const T* K,                                   // k data. Its size is BxNxLxH
@@ -116,8 +303,9 @@ class GQAAttentionBase {
                              const size_t past_buffer_sequence_length,     // sequence length of past state
                              const size_t present_buffer_sequence_length,  // sequence length of present state
                              const size_t head_size,                       // head size of self-attention
-                             const T* past_key,                            // past key only
-                             T* present_key,                               // present key only
+                             const TCache* past_key,                       // past key only
+                             TCache* present_key,                          // present key only
+                             const float* k_scales,                        // per kv head scales of int8 key cache
                              const bool past_present_share_buffer,         // whether present key and value share the same buffer
                              const bool packed_qkv,                        // whether Q, K, V are packed
                              const bool is_prompt,                         // whether it is prompt
@@ -135,7 +323,7 @@ class GQAAttentionBase {
     if (!past_present_share_buffer) {
       memset((void*)present_key,
              0,
-             batch_size * kv_num_heads_ * present_buffer_sequence_length * head_size * sizeof(T));
+             batch_size * kv_num_heads_ * present_buffer_sequence_length * head_size * sizeof(TCache));
     }
 
     const size_t loop_len = batch_size * num_heads_;
@@ -147,14 +335,15 @@ class GQAAttentionBase {
     unit_cost.compute_cycles =
         static_cast<double>(SafeInt<ptrdiff_t>(2) * sequence_length * head_size * present_buffer_sequence_length);
     unit_cost.bytes_loaded =
-        static_cast<double>((sequence_length + present_buffer_sequence_length) * head_size * sizeof(T));
+        static_cast<double>(sequence_length * head_size * sizeof(T) +
+                            present_buffer_sequence_length * head_size * sizeof(TCache));
     unit_cost.bytes_stored = static_cast<double>(probs_matrix_bytes);
 
     unit_cost.bytes_loaded += static_cast<double>(probs_matrix_bytes);
     unit_cost.bytes_stored += static_cast<double>(probs_matrix_bytes);
 
     if (present_key) {
-      double bytes_to_copy_key = static_cast<double>(sizeof(T) * present_buff_chunk_length);
+      double bytes_to_copy_key = static_cast<double>(sizeof(TCache) * present_buff_chunk_length);
       unit_cost.bytes_loaded += bytes_to_copy_key;
       unit_cost.bytes_stored += bytes_to_copy_key;
     }
@@ -176,10 +365,17 @@ class GQAAttentionBase {
         } else {
           k = K + kv_input_chunk_length * (i / kv_num_heads_factor);
         }
+        const TCache* k_cache = nullptr;
         if (nullptr != present_key) {
-          k = ConcatStateChunkGQA(past_key, k, present_key, present_buff_chunk_length, past_buff_chunk_length,
-                                  past_chunk_length, kv_input_chunk_length, past_present_share_buffer,
-                                  i / kv_num_heads_factor);
+          if constexpr (std::is_same<T, TCache>::value) {
+            k = ConcatStateChunkGQA(past_key, k, present_key, present_buff_chunk_length, past_buff_chunk_length,
+                                    past_chunk_length, kv_input_chunk_length, past_present_share_buffer,
+                                    i / kv_num_heads_factor);
+          } else {
+            k_cache = ConcatStateChunkGQA(past_key, k, present_key, present_buff_chunk_length, past_buff_chunk_length,
+                                          past_chunk_length, kv_input_chunk_length, past_present_share_buffer,
+                                          k_scales[(i / kv_num_heads_factor) % kv_num_heads_], i / kv_num_heads_factor);
+          }
         }
 
         // Compute Q*K' + AttentionMask
@@ -194,20 +390,32 @@ class GQAAttentionBase {
           q = Q + q_input_chunk_length * i;
         }
 
-        if constexpr (std::is_same<T, float>::value) {
+        if constexpr (std::is_same<T, float>::value && std::is_same<TCache, float>::value) {
           math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, total_seqlen, head_size, alpha, q,
                                           static_cast<int>(head_size), k, static_cast<int>(head_size), 0.0f /*bata*/,
                                           output, static_cast<int>(present_buffer_sequence_length), nullptr);
         } else {
-          size_t bytes = head_size * (sequence_length + total_seqlen) * sizeof(float);
+          const size_t q_fp32_length = std::is_same<T, float>::value ? 0 : head_size * sequence_length;
+          size_t bytes = (q_fp32_length + head_size * total_seqlen) * sizeof(float);
           auto q_k_fp32 = allocator->Alloc(bytes);
           BufferUniquePtr scratch_buffer(q_k_fp32, BufferDeleter(allocator));
 
-          float* q_fp32 = static_cast<float*>(q_k_fp32);
-          MlasConvertHalfToFloatBuffer(q, q_fp32, head_size * sequence_length);
+          const float* q_fp32;
+          if constexpr (std::is_same<T, float>::value) {
+            q_fp32 = q;
+          } else {
+            MlasConvertHalfToFloatBuffer(q, static_cast<float*>(q_k_fp32), head_size * sequence_length);
+            q_fp32 = static_cast<float*>(q_k_fp32);
+          }
 
-          float* k_fp32 = q_fp32 + head_size * sequence_length;
-          MlasConvertHalfToFloatBuffer(k, k_fp32, head_size * total_seqlen);
+          // Dequantize the key cache of this head on the fly.
+          float* k_fp32 = static_cast<float*>(q_k_fp32) + q_fp32_length;
+          if constexpr (std::is_same<T, TCache>::value) {
+            MlasConvertHalfToFloatBuffer(k, k_fp32, head_size * total_seqlen);
+          } else {
+            ConvertFromKVCacheType(k_cache, k_fp32, head_size * total_seqlen,
+                                   k_scales[(i / kv_num_heads_factor) % kv_num_heads_]);
+          }
 
           math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, total_seqlen, head_size, alpha, q_fp32,
                                           static_cast<int>(head_size), k_fp32, static_cast<int>(head_size), 0.0f /*bata*/,
@@ -255,7 +463,7 @@ class GQAAttentionBase {
     });
   }
 
-  template <typename T>
+  template <typename T, typename TCache>
   void ComputeVxAttentionScore(T* output,                                    // buffer for the result with size BxSxNxH
                                const float* attention_probs,                 // Attention probs with size BxNxSxT
                                const T* V,                                   // V value with size BxN_kvxSxH
@@ -266,8 +474,9 @@ class GQAAttentionBase {
                                const size_t present_buffer_sequence_length,  // sequence length in past state
                                const size_t head_size,                       // head size of Q, K, V
                                const size_t hidden_size,                     // hidden size of Output
-                               const T* past_value,                          // past value only
-                               T* present_value,                             // present value only
+                               const TCache* past_value,                     // past value only
+                               TCache* present_value,                        // present value only
+                               const float* v_scales,                        // per kv head scales of int8 value cache
                                const bool past_present_share_buffer,         // whether present key and value share the same buffer
                                const bool packed_qkv,                        // whether Q, K, V are packed
                                const bool is_prompt,                         // whether it is prompt
@@ -284,7 +493,7 @@ class GQAAttentionBase {
     if (!past_present_share_buffer) {
       memset((void*)present_value,
              0,
-             batch_size * kv_num_heads_ * present_buffer_sequence_length * head_size * sizeof(T));
+             batch_size * kv_num_heads_ * present_buffer_sequence_length * head_size * sizeof(TCache));
     }
 
     const size_t loop_len = batch_size * num_heads_;
@@ -293,12 +502,14 @@ class GQAAttentionBase {
     TensorOpCost unit_cost;
     unit_cost.compute_cycles =
         static_cast<double>(SafeInt<ptrdiff_t>(2) * sequence_length * head_size * present_buffer_sequence_length);
-    unit_cost.bytes_loaded = static_cast<double>(SafeInt<ptrdiff_t>(sequence_length + head_size) *
-                                                 present_buffer_sequence_length * sizeof(T));
+    unit_cost.bytes_loaded = static_cast<double>(SafeInt<ptrdiff_t>(sequence_length) * present_buffer_sequence_length *
+                                                     sizeof(float) +
+                                                 SafeInt<ptrdiff_t>(head_size) * present_buffer_sequence_length *
+                                                     sizeof(TCache));
     unit_cost.bytes_stored = static_cast<double>(sequence_length * head_size * sizeof(T));
 
     if (present_value) {
-      double bytes_to_copy_value = static_cast<double>(present_buff_chunk_length * sizeof(T));
+      double bytes_to_copy_value = static_cast<double>(present_buff_chunk_length * sizeof(TCache));
       unit_cost.bytes_loaded += bytes_to_copy_value;
       unit_cost.bytes_stored += bytes_to_copy_value;
     }
@@ -329,15 +540,23 @@ class GQAAttentionBase {
         } else {
           v = V + kv_input_chunk_length * (i / kv_num_heads_factor);
         }
+        const TCache* v_cache = nullptr;
         if (nullptr != present_value) {
-          v = ConcatStateChunkGQA(past_value, v, present_value, present_buff_chunk_length, past_buff_chunk_length,
-                                  past_chunk_length, kv_input_chunk_length, past_present_share_buffer,
-                                  i / kv_num_heads_factor);
+          if constexpr (std::is_same<T, TCache>::value) {
+            v = ConcatStateChunkGQA(past_value, v, present_value, present_buff_chunk_length, past_buff_chunk_length,
+                                    past_chunk_length, kv_input_chunk_length, past_present_share_buffer,
+                                    i / kv_num_heads_factor);
+          } else {
+            v_cache = ConcatStateChunkGQA(past_value, v, present_value, present_buff_chunk_length,
+                                          past_buff_chunk_length, past_chunk_length, kv_input_chunk_length,
+                                          past_present_share_buffer, v_scales[(i / kv_num_heads_factor) % kv_num_heads_],
+                                          i / kv_num_heads_factor);
+          }
         }
 
         ptrdiff_t attention_probs_offset = SafeInt<ptrdiff_t>(sequence_length) * present_buffer_sequence_length * i;
 
-        if constexpr (std::is_same<T, float>::value) {
+        if constexpr (std::is_same<T, float>::value && std::is_same<TCache, float>::value) {
           T* output_current = output + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
           math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasNoTrans, sequence_length, head_size, total_seqlen,
                                           1.f, /*alpha*/ attention_probs + attention_probs_offset,
@@ -349,11 +568,22 @@ class GQAAttentionBase {
           auto v_fp32 = allocator->Alloc(bytes);
           BufferUniquePtr scratch_buffer(v_fp32, BufferDeleter(allocator));
 
+          // Dequantize the value cache of this head on the fly.
           float* v_fp32_ptr = static_cast<float*>(v_fp32);
-          MlasConvertHalfToFloatBuffer(v, v_fp32_ptr, head_size * total_seqlen);
+          if constexpr (std::is_same<T, TCache>::value) {
+            MlasConvertHalfToFloatBuffer(v, v_fp32_ptr, head_size * total_seqlen);
+          } else {
+            ConvertFromKVCacheType(v_cache, v_fp32_ptr, head_size * total_seqlen,
+                                   v_scales[(i / kv_num_heads_factor) % kv_num_heads_]);
+          }
 
-          float* output_fp32_current = static_cast<float*>(output_fp32) +
-                                       (batch_index * sequence_length * num_heads_ + head_index) * head_size;
+          float* output_fp32_current;
+          if constexpr (std::is_same<T, float>::value) {
+            output_fp32_current = output + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
+          } else {
+            output_fp32_current = static_cast<float*>(output_fp32) +
+                                  (batch_index * sequence_length * num_heads_ + head_index) * head_size;
+          }
           math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasNoTrans, sequence_length, head_size, total_seqlen,
                                           1.f, /*alpha*/ attention_probs + attention_probs_offset,
                                           static_cast<int>(present_buffer_sequence_length), v_fp32_ptr,
@@ -21,17 +21,34 @@ using onnxruntime::concurrency::ThreadPool;
 namespace onnxruntime {
 namespace contrib {
 
+namespace {
+// The KV cache may be kept in the activation type, or in a narrower type that is dequantized on the fly.
+template <typename T>
+std::vector<MLDataType> KVCacheTypes() {
+  if constexpr (std::is_same<T, float>::value) {
+    return {DataTypeImpl::GetTensorType<float>(),
+            DataTypeImpl::GetTensorType<MLFloat16>(),
+            DataTypeImpl::GetTensorType<int8_t>()};
+  } else {
+    return {DataTypeImpl::GetTensorType<T>(),
+            DataTypeImpl::GetTensorType<int8_t>()};
+  }
+}
+}  // namespace
+
 // These ops are internal-only, so register outside of onnx
-#define REGISTER_KERNEL_TYPED(T)                                        \
-  ONNX_OPERATOR_TYPED_KERNEL_EX(                                        \
-      GroupQueryAttention,                                              \
-      kMSDomain,                                                        \
-      1,                                                                \
-      T,                                                                \
-      kCpuExecutionProvider,                                            \
-      KernelDefBuilder()                                                \
-          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())        \
-          .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>()), \
+#define REGISTER_KERNEL_TYPED(T)                                                \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                \
+      GroupQueryAttention,                                                      \
+      kMSDomain,                                                                \
+      1,                                                                        \
+      T,                                                                        \
+      kCpuExecutionProvider,                                                    \
+      KernelDefBuilder()                                                        \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())                \
+          .TypeConstraint("T_CACHE", KVCacheTypes<T>())                         \
+          .TypeConstraint("T_KV_SCALE", DataTypeImpl::GetTensorType<float>())   \
+          .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>()),         \
       GroupQueryAttention<T>);
 
 REGISTER_KERNEL_TYPED(float)
@@ -52,6 +69,8 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   const Tensor* total_seqlen_tensor = context->Input<Tensor>(6);
   const Tensor* cos_cache = context->Input<Tensor>(7);
   const Tensor* sin_cache = context->Input<Tensor>(8);
+  const Tensor* k_scale = context->Input<Tensor>(9);
+  const Tensor* v_scale = context->Input<Tensor>(10);
 
   GroupQueryAttentionParameters parameters = {};
   ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckInputs(query,
@@ -194,7 +213,7 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
   // Compute the attention score and apply the score to V
   return ApplyAttention(q_rotary, packed_qkv ? nullptr : k_rotary, packed_qkv ? nullptr : V.Get<Tensor>().Data<T>(),
-                        past_key, past_value, output, present_k, present_v,
+                        past_key, past_value, k_scale, v_scale, output, present_k, present_v,
                         seqlens_k, parameters, allocator, context);
 }
 }  // namespace contrib
@@ -0,0 +1,180 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+// The number of bytes of a row that are prefetched while the previous row of the bag is accumulated.
+constexpr size_t kPrefetchBytes = 256;
+
+inline void PrefetchRow(const float* row, size_t row_size) {
+  const auto* bytes = reinterpret_cast<const char*>(row);
+  const size_t prefetch_bytes = std::min(row_size * sizeof(float), kPrefetchBytes);
+  for (size_t offset = 0; offset < prefetch_bytes; offset += 64) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(bytes + offset);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(bytes + offset, _MM_HINT_T0);
+#else
+    ORT_UNUSED_PARAMETER(bytes);
+#endif
+  }
+}
+
+}  // namespace
+
+class EmbeddingBag final : public OpKernel {
+ public:
+  explicit EmbeddingBag(const OpKernelInfo& info) : OpKernel(info) {
+    const std::string mode = info.GetAttrOrDefault<std::string>("mode", "sum");
+    ORT_ENFORCE(mode == "sum" || mode == "mean", "Unsupported mode: ", mode, ". It must be 'sum' or 'mean'.");
+    mean_ = mode == "mean";
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename Tind>
+  Status ComputeImpl(OpKernelContext* context) const;
+
+  bool mean_;
+};
+
+ONNX_OPERATOR_KERNEL_EX(
+    EmbeddingBag,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()}),
+    EmbeddingBag);
+
+Status EmbeddingBag::Compute(OpKernelContext* context) const {
+  if (context->Input<Tensor>(1)->IsDataType<int32_t>()) {
+    return ComputeImpl<int32_t>(context);
+  }
+  return ComputeImpl<int64_t>(context);
+}
+
+template <typename Tind>
+Status EmbeddingBag::ComputeImpl(OpKernelContext* context) const {
+  const Tensor* data = context->Input<Tensor>(0);
+  const Tensor* indices = context->Input<Tensor>(1);
+  const Tensor* offsets = context->Input<Tensor>(2);
+
+  const auto& data_shape = data->Shape();
+  const auto& indices_shape = indices->Shape();
+  ORT_RETURN_IF_NOT(data_shape.NumDimensions() >= 1, "data must have rank >= 1.");
+
+  const int64_t num_rows = data_shape[0];
+  const size_t row_size = narrow<size_t>(data_shape.SizeFromDimension(1));
+  const auto indices_data = indices->DataAsSpan<Tind>();
+
+  // Every bag is the range [bag_starts[i], bag_starts[i + 1]) of the indices.
+  TensorShapeVector output_dims;
+  InlinedVector<size_t> bag_starts;
+  if (offsets != nullptr) {
+    ORT_RETURN_IF_NOT(indices_shape.NumDimensions() == 1 && offsets->Shape().NumDimensions() == 1,
+                      "indices and offsets must be 1-D.");
+    const auto offsets_data = offsets->DataAsSpan<Tind>();
+    output_dims.push_back(narrow<int64_t>(offsets_data.size()));
+    bag_starts.reserve(offsets_data.size() + 1);
+    for (size_t i = 0; i < offsets_data.size(); ++i) {
+      const int64_t offset = static_cast<int64_t>(offsets_data[i]);
+      ORT_RETURN_IF_NOT(offset >= 0 && offset <= static_cast<int64_t>(indices_data.size()) &&
+                            (i == 0 || static_cast<size_t>(offset) >= bag_starts.back()),
+                        "offsets must be non-decreasing and within [0, ", indices_data.size(), "], got ", offset);
+      bag_starts.push_back(static_cast<size_t>(offset));
+    }
+    bag_starts.push_back(indices_data.size());
+  } else {
+    ORT_RETURN_IF_NOT(indices_shape.NumDimensions() >= 1, "indices must have rank >= 1.");
+    const size_t num_dims = indices_shape.NumDimensions();
+    const auto bag_size = narrow<size_t>(indices_shape[num_dims - 1]);
+    const auto num_bags = narrow<size_t>(indices_shape.SizeToDimension(num_dims - 1));
+    for (size_t i = 0; i + 1 < num_dims; ++i) {
+      output_dims.push_back(indices_shape[i]);
+    }
+    bag_starts.reserve(num_bags + 1);
+    for (size_t i = 0; i <= num_bags; ++i) {
+      bag_starts.push_back(i * bag_size);
+    }
+  }
+  for (size_t i = 1; i < data_shape.NumDimensions(); ++i) {
+    output_dims.push_back(data_shape[i]);
+  }
+
+  Tensor* output = context->Output(0, TensorShape(output_dims));
+  const size_t num_bags = bag_starts.size() - 1;
+  if (num_bags == 0 || row_size == 0) {
+    return Status::OK();
+  }
+
+  for (const Tind index : indices_data) {
+    ORT_RETURN_IF_NOT(index >= -num_rows && index < num_rows, "indices element out of data bounds, idx=", index,
+                      " must be within the inclusive range [", -num_rows, ",", num_rows - 1, "]");
+  }
+
+  const float* data_ptr = data->Data<float>();
+  float* output_ptr = output->MutableData<float>();
+  auto get_row = [&](size_t i) {
+    const int64_t index = static_cast<int64_t>(indices_data[i]);
+    return data_ptr + SafeInt<size_t>(index < 0 ? index + num_rows : index) * row_size;
+  };
+
+  const double average_bag_size = static_cast<double>(indices_data.size()) / static_cast<double>(num_bags);
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_bags),
+      TensorOpCost{average_bag_size * row_size * sizeof(float), static_cast<double>(row_size * sizeof(float)),
+                   average_bag_size * row_size},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (auto bag = static_cast<size_t>(first); bag < static_cast<size_t>(last); ++bag) {
+          const size_t begin = bag_starts[bag];
+          const size_t end = bag_starts[bag + 1];
+          float* bag_output = output_ptr + bag * row_size;
+          if (begin == end) {
+            std::memset(bag_output, 0, row_size * sizeof(float));
+            continue;
+          }
+
+          // The rows are accumulated in the output, and the next row is prefetched as the table is read in random
+          // order.
+          EigenVectorArrayMap<float> sum(bag_output, narrow<Eigen::Index>(row_size));
+          for (size_t i = begin; i < end; ++i) {
+            if (i + 1 < end) {
+              PrefetchRow(get_row(i + 1), row_size);
+            }
+            ConstEigenVectorArrayMap<float> row(get_row(i), narrow<Eigen::Index>(row_size));
+            if (i == begin) {
+              sum = row;
+            } else {
+              sum += row;
+            }
+          }
+          if (mean_) {
+            sum /= static_cast<float>(end - begin);
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
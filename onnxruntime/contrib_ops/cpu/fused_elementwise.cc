@@ -0,0 +1,502 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/common/narrow.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+enum class ElementwiseOp : uint8_t {
+  Add,
+  Sub,
+  Mul,
+  Div,
+  Pow,
+  Abs,
+  Ceil,
+  Erf,
+  Exp,
+  Floor,
+  LeakyRelu,
+  Log,
+  Neg,
+  Reciprocal,
+  Relu,
+  Sigmoid,
+  Sqrt,
+  Tanh,
+};
+
+struct ElementwiseOpInfo {
+  std::string_view name;
+  ElementwiseOp op;
+  int num_operands;
+  // Rough cost of one element in cycles, used to partition the work between threads.
+  double cost;
+};
+
+// Keep in sync with the ops fused by the ElementwiseFusion transformer in core/optimizer/elementwise_fusion.cc.
+constexpr ElementwiseOpInfo kElementwiseOps[] = {
+    {"Add", ElementwiseOp::Add, 2, 1.0},
+    {"Sub", ElementwiseOp::Sub, 2, 1.0},
+    {"Mul", ElementwiseOp::Mul, 2, 1.0},
+    {"Div", ElementwiseOp::Div, 2, 4.0},
+    {"Pow", ElementwiseOp::Pow, 2, 40.0},
+    {"Abs", ElementwiseOp::Abs, 1, 1.0},
+    {"Ceil", ElementwiseOp::Ceil, 1, 1.0},
+    {"Erf", ElementwiseOp::Erf, 1, 10.0},
+    {"Exp", ElementwiseOp::Exp, 1, 10.0},
+    {"Floor", ElementwiseOp::Floor, 1, 1.0},
+    {"LeakyRelu", ElementwiseOp::LeakyRelu, 1, 1.0},
+    {"Log", ElementwiseOp::Log, 1, 20.0},
+    {"Neg", ElementwiseOp::Neg, 1, 1.0},
+    {"Reciprocal", ElementwiseOp::Reciprocal, 1, 4.0},
+    {"Relu", ElementwiseOp::Relu, 1, 1.0},
+    {"Sigmoid", ElementwiseOp::Sigmoid, 1, 10.0},
+    {"Sqrt", ElementwiseOp::Sqrt, 1, 4.0},
+    {"Tanh", ElementwiseOp::Tanh, 1, 10.0},
+};
+
+// The scratch buffers of a thread are sized to stay in the L1 cache together with the tiles of the inputs
+// and outputs streamed through it.
+constexpr size_t kScratchBytes = 16 * 1024;
+constexpr size_t kMinTileSize = 256;
+constexpr size_t kMaxTileSize = 4096;
+
+// A value of a tile as seen by an op. A scalar input is also filled into `data` for the ops that do not
+// special case it.
+struct Operand {
+  const float* data;
+  float scalar;
+  bool is_scalar;
+};
+
+template <typename Op>
+void ComputeBinary(const Operand& a, const Operand& b, float* y, size_t n, Op op) {
+  if (b.is_scalar) {
+    const float b_value = b.scalar;
+    for (size_t i = 0; i < n; i++) {
+      y[i] = op(a.data[i], b_value);
+    }
+  } else if (a.is_scalar) {
+    const float a_value = a.scalar;
+    for (size_t i = 0; i < n; i++) {
+      y[i] = op(a_value, b.data[i]);
+    }
+  } else {
+    for (size_t i = 0; i < n; i++) {
+      y[i] = op(a.data[i], b.data[i]);
+    }
+  }
+}
+
+template <typename Op>
+void ComputeUnary(const float* x, float* y, size_t n, Op op) {
+  for (size_t i = 0; i < n; i++) {
+    y[i] = op(x[i]);
+  }
+}
+
+// The ops are elementwise, so `y` may alias the data of an operand.
+void ComputeOp(ElementwiseOp op, float alpha, const Operand& a, const Operand& b, float* y, size_t n) {
+  switch (op) {
+    case ElementwiseOp::Add:
+      ComputeBinary(a, b, y, n, [](float x0, float x1) { return x0 + x1; });
+      break;
+    case ElementwiseOp::Sub:
+      ComputeBinary(a, b, y, n, [](float x0, float x1) { return x0 - x1; });
+      break;
+    case ElementwiseOp::Mul:
+      ComputeBinary(a, b, y, n, [](float x0, float x1) { return x0 * x1; });
+      break;
+    case ElementwiseOp::Div:
+      ComputeBinary(a, b, y, n, [](float x0, float x1) { return x0 / x1; });
+      break;
+    case ElementwiseOp::Pow:
+      if (b.is_scalar && b.scalar == 2.0f) {
+        ComputeUnary(a.data, y, n, [](float x) { return x * x; });
+      } else {
+        ComputeBinary(a, b, y, n, [](float x0, float x1) { return std::pow(x0, x1); });
+      }
+      break;
+    case ElementwiseOp::Abs:
+      ComputeUnary(a.data, y, n, [](float x) { return std::abs(x); });
+      break;
+    case ElementwiseOp::Ceil:
+      ComputeUnary(a.data, y, n, [](float x) { return std::ceil(x); });
+      break;
+    case ElementwiseOp::Erf:
+      MlasComputeErf(a.data, y, n);
+      break;
+    case ElementwiseOp::Exp:
+      MlasComputeExp(a.data, y, n);
+      break;
+    case ElementwiseOp::Floor:
+      ComputeUnary(a.data, y, n, [](float x) { return std::floor(x); });
+      break;
+    case ElementwiseOp::LeakyRelu:
+      ComputeUnary(a.data, y, n, [alpha](float x) { return x >= 0.0f ? x : alpha * x; });
+      break;
+    case ElementwiseOp::Log:
+      ComputeUnary(a.data, y, n, [](float x) { return std::log(x); });
+      break;
+    case ElementwiseOp::Neg:
+      ComputeUnary(a.data, y, n, [](float x) { return -x; });
+      break;
+    case ElementwiseOp::Reciprocal:
+      ComputeUnary(a.data, y, n, [](float x) { return 1.0f / x; });
+      break;
+    case ElementwiseOp::Relu:
+      ComputeUnary(a.data, y, n, [](float x) { return x > 0.0f ? x : 0.0f; });
+      break;
+    case ElementwiseOp::Sigmoid:
+      MlasComputeLogistic(a.data, y, n);
+      break;
+    case ElementwiseOp::Sqrt:
+      ComputeUnary(a.data, y, n, [](float x) { return std::sqrt(x); });
+      break;
+    case ElementwiseOp::Tanh:
+      MlasComputeTanh(a.data, y, n);
+      break;
+  }
+}
+
+// How the elements of an input are read for a tile of the output.
+enum class InputMode : uint8_t {
+  kFull,       // the input has the output shape and is read in place
+  kScalar,     // the input has a single element
+  kRepeat,     // the input has the trailing dimensions of the output and repeats along the leading ones
+  kBroadcast,  // any other broadcast, gathered with the strides of the input
+};
+
+struct InputView {
+  const float* data;
+  size_t size;
+  InputMode mode;
+  // Strides of the input over the dimensions of the output, 0 for broadcast dimensions. kBroadcast only.
+  TensorShapeVector strides;
+};
+
+// Copies the elements [start, start + count) of the input broadcast to `dims` to `y`. The innermost dimension is
+// handled in runs, which are either a copy or a fill.
+void GatherBroadcast(const float* x, gsl::span<const int64_t> dims, gsl::span<const int64_t> strides,
+                     size_t start, size_t count, float* y) {
+  const size_t rank = dims.size();
+  TensorShapeVector index(rank);
+  int64_t offset = 0;
+  size_t remainder = start;
+  for (size_t d = rank; d-- > 0;) {
+    const auto dim = narrow<size_t>(dims[d]);
+    index[d] = static_cast<int64_t>(remainder % dim);
+    remainder /= dim;
+    offset += index[d] * strides[d];
+  }
+
+  const int64_t inner_dim = dims[rank - 1];
+  const int64_t inner_stride = strides[rank - 1];
+  while (count > 0) {
+    const size_t run = std::min(count, narrow<size_t>(inner_dim - index[rank - 1]));
+    if (inner_stride == 0) {
+      std::fill_n(y, run, x[offset]);
+    } else {
+      std::copy_n(x + offset, run, y);
+    }
+    y += run;
+    count -= run;
+
+    // Move to the start of the next row.
+    offset -= index[rank - 1] * inner_stride;
+    index[rank - 1] = 0;
+    for (size_t d = rank - 1; d-- > 0;) {
+      offset += strides[d];
+      if (++index[d] < dims[d]) {
+        break;
+      }
+      offset -= dims[d] * strides[d];
+      index[d] = 0;
+    }
+  }
+}
+
+// Copies the elements [start, start + count) of an input of `size` elements repeated along the output to `y`.
+void GatherRepeat(const float* x, size_t size, size_t start, size_t count, float* y) {
+  size_t offset = start % size;
+  while (count > 0) {
+    const size_t run = std::min(count, size - offset);
+    std::copy_n(x + offset, run, y);
+    y += run;
+    count -= run;
+    offset = 0;
+  }
+}
+
+}  // namespace
+
+// Evaluates a subgraph of elementwise ops fused by the ElementwiseFusion transformer.
+//
+// The output is processed in tiles that are distributed over the threads of the intra-op thread pool. All ops are
+// applied to a tile before moving to the next one. Intermediate results are kept in per-thread scratch registers of
+// one tile each, which are reused once a value is no longer needed, and results that are outputs of the node are
+// written in place. Inputs of the output shape are read in place and broadcast inputs are gathered into a register.
+class FusedElementwise final : public OpKernel {
+ public:
+  explicit FusedElementwise(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  struct Instruction {
+    ElementwiseOp op;
+    float alpha;
+    int64_t operands[2];
+    // The result is written to output `output` if it is not negative, else to register `register_index`.
+    int output;
+    int register_index;
+  };
+
+  size_t num_inputs_;
+  size_t num_registers_ = 0;
+  double cost_per_element_ = 0.0;
+  std::vector<Instruction> instructions_;
+};
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+  const auto ops = info.GetAttrsOrDefault<std::string>("ops");
+  const auto operands = info.GetAttrsOrDefault<int64_t>("operands");
+  const auto alphas = info.GetAttrsOrDefault<float>("alphas");
+  const auto output_values = info.GetAttrsOrDefault<int64_t>("output_values");
+
+  num_inputs_ = info.GetInputCount();
+  const size_t num_outputs = info.GetOutputCount();
+  ORT_ENFORCE(!ops.empty(), "FusedElementwise requires at least one op.");
+  ORT_ENFORCE(operands.size() == 2 * ops.size(), "FusedElementwise requires two operands per op.");
+  ORT_ENFORCE(alphas.empty() || alphas.size() == ops.size(), "FusedElementwise requires one alpha per op.");
+  ORT_ENFORCE(output_values.size() == num_outputs, "FusedElementwise requires one value per output.");
+
+  const int64_t num_values = static_cast<int64_t>(num_inputs_ + ops.size());
+  std::vector<int> value_outputs(narrow<size_t>(num_values), -1);
+  for (size_t i = 0; i < num_outputs; i++) {
+    const int64_t value = output_values[i];
+    ORT_ENFORCE(value >= static_cast<int64_t>(num_inputs_) && value < num_values &&
+                    value_outputs[static_cast<size_t>(value)] < 0,
+                "Output ", i, " of FusedElementwise refers to an invalid value ", value);
+    value_outputs[static_cast<size_t>(value)] = static_cast<int>(i);
+  }
+
+  // The last op that uses each value, -1 if it is not used.
+  std::vector<int64_t> last_uses(narrow<size_t>(num_values), -1);
+  instructions_.reserve(ops.size());
+  for (size_t i = 0; i < ops.size(); i++) {
+    const auto* op_info = std::find_if(std::begin(kElementwiseOps), std::end(kElementwiseOps),
+                                       [&](const ElementwiseOpInfo& op) { return op.name == ops[i]; });
+    ORT_ENFORCE(op_info != std::end(kElementwiseOps), "FusedElementwise does not support op ", ops[i]);
+
+    Instruction instruction{op_info->op, alphas.empty() ? 0.0f : alphas[i], {-1, -1}, -1, -1};
+    for (int j = 0; j < 2; j++) {
+      const int64_t operand = operands[2 * i + j];
+      if (j < op_info->num_operands) {
+        ORT_ENFORCE(operand >= 0 && operand < static_cast<int64_t>(num_inputs_ + i),
+                    "Operand ", j, " of op ", i, " of FusedElementwise refers to an invalid value ", operand);
+        instruction.operands[j] = operand;
+        last_uses[static_cast<size_t>(operand)] = static_cast<int64_t>(i);
+      } else {
+        ORT_ENFORCE(operand == -1, "Op ", i, " of FusedElementwise has too many operands.");
+      }
+    }
+    instructions_.push_back(instruction);
+    cost_per_element_ += op_info->cost;
+  }
+
+  // Assign the registers. The registers of the operands that are last used by an op are released before its
+  // result is assigned, so that the op may run in place.
+  std::vector<int> value_registers(narrow<size_t>(num_values), -1);
+  std::vector<int> free_registers;
+  for (size_t i = 0; i < instructions_.size(); i++) {
+    Instruction& instruction = instructions_[i];
+    for (const int64_t operand : instruction.operands) {
+      if (operand < 0) {
+        continue;
+      }
+      const auto value = static_cast<size_t>(operand);
+      if (last_uses[value] == static_cast<int64_t>(i) && value_registers[value] >= 0) {
+        free_registers.push_back(value_registers[value]);
+        value_registers[value] = -1;
+      }
+    }
+
+    const size_t result = num_inputs_ + i;
+    if (value_outputs[result] >= 0) {
+      instruction.output = value_outputs[result];
+      continue;
+    }
+
+    if (free_registers.empty()) {
+      free_registers.push_back(static_cast<int>(num_registers_++));
+    }
+    instruction.register_index = free_registers.back();
+    free_registers.pop_back();
+    if (last_uses[result] >= 0) {
+      value_registers[result] = instruction.register_index;
+    } else {
+      free_registers.push_back(instruction.register_index);
+    }
+  }
+}
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  // Every output has the shape of all inputs broadcast together.
+  TensorShape output_shape = context->Input<Tensor>(0)->Shape();
+  for (size_t i = 1; i < num_inputs_; i++) {
+    ORT_RETURN_IF_ERROR(ComputeBroadcastOutputShape(Node().Name(), output_shape,
+                                                    context->Input<Tensor>(static_cast<int>(i))->Shape(),
+                                                    output_shape));
+  }
+
+  const size_t num_outputs = static_cast<size_t>(context->OutputCount());
+  InlinedVector<float*> outputs(num_outputs);
+  for (size_t i = 0; i < num_outputs; i++) {
+    outputs[i] = context->Output(static_cast<int>(i), output_shape)->MutableData<float>();
+  }
+
+  const size_t size = narrow<size_t>(output_shape.Size());
+  if (size == 0) {
+    return Status::OK();
+  }
+
+  const auto output_dims = output_shape.GetDims();
+  const size_t rank = output_dims.size();
+
+  // Every input that is not read in place is gathered into a register of its own.
+  InlinedVector<InputView> inputs(num_inputs_);
+  size_t num_full_inputs = 0;
+  for (size_t i = 0; i < num_inputs_; i++) {
+    const Tensor& input = *context->Input<Tensor>(static_cast<int>(i));
+    InputView& view = inputs[i];
+    view.data = input.Data<float>();
+    view.size = narrow<size_t>(input.Shape().Size());
+    if (view.size == size) {
+      view.mode = InputMode::kFull;
+      num_full_inputs++;
+      continue;
+    }
+    if (view.size == 1) {
+      view.mode = InputMode::kScalar;
+      continue;
+    }
+
+    // Align the dimensions of the input with the trailing dimensions of the output.
+    const auto input_dims = input.Shape().GetDims();
+    const size_t leading = rank - input_dims.size();
+    TensorShapeVector dims(leading, 1);
+    dims.insert(dims.end(), input_dims.begin(), input_dims.end());
+
+    size_t first = 0;
+    while (dims[first] == 1) {
+      first++;
+    }
+    if (std::equal(dims.begin() + first, dims.end(), output_dims.begin() + first)) {
+      view.mode = InputMode::kRepeat;
+      continue;
+    }
+
+    view.mode = InputMode::kBroadcast;
+    view.strides.resize(rank);
+    int64_t stride = 1;
+    for (size_t d = rank; d-- > 0;) {
+      view.strides[d] = dims[d] == 1 ? 0 : stride;
+      stride *= dims[d];
+    }
+  }
+
+  const size_t num_buffers = num_registers_ + num_inputs_ - num_full_inputs;
+  size_t tile_size = kMaxTileSize;
+  if (num_buffers > 0) {
+    tile_size = std::clamp(kScratchBytes / sizeof(float) / num_buffers / 16 * 16, kMinTileSize, kMaxTileSize);
+  }
+  const size_t num_tiles = (size + tile_size - 1) / tile_size;
+
+  const double tile_bytes = static_cast<double>(tile_size * sizeof(float));
+  const TensorOpCost cost{static_cast<double>(num_inputs_) * tile_bytes, static_cast<double>(num_outputs) * tile_bytes,
+                          cost_per_element_ * static_cast<double>(tile_size)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_tiles), cost,
+      [&](std::ptrdiff_t first_tile, std::ptrdiff_t last_tile) {
+        std::vector<float> scratch(num_buffers * tile_size);
+        float* const registers = scratch.data();
+        InlinedVector<Operand> values(num_inputs_ + instructions_.size());
+
+        // The inputs that are not read in place use the registers after the ones of the ops.
+        InlinedVector<float*> input_buffers(num_inputs_, nullptr);
+        float* buffer = registers + num_registers_ * tile_size;
+        for (size_t i = 0; i < num_inputs_; i++) {
+          if (inputs[i].mode == InputMode::kFull) {
+            continue;
+          }
+          input_buffers[i] = buffer;
+          buffer += tile_size;
+          if (inputs[i].mode == InputMode::kScalar) {
+            std::fill_n(input_buffers[i], tile_size, inputs[i].data[0]);
+            values[i] = Operand{input_buffers[i], inputs[i].data[0], true};
+          } else {
+            values[i] = Operand{input_buffers[i], 0.0f, false};
+          }
+        }
+
+        for (auto tile = first_tile; tile < last_tile; tile++) {
+          const size_t start = static_cast<size_t>(tile) * tile_size;
+          const size_t count = std::min(tile_size, size - start);
+
+          for (size_t i = 0; i < num_inputs_; i++) {
+            const InputView& view = inputs[i];
+            switch (view.mode) {
+              case InputMode::kFull:
+                values[i] = Operand{view.data + start, 0.0f, false};
+                break;
+              case InputMode::kScalar:
+                break;
+              case InputMode::kRepeat:
+                GatherRepeat(view.data, view.size, start, count, input_buffers[i]);
+                break;
+              case InputMode::kBroadcast:
+                GatherBroadcast(view.data, output_dims, view.strides, start, count, input_buffers[i]);
+                break;
+            }
+          }
+
+          for (size_t i = 0; i < instructions_.size(); i++) {
+            const Instruction& instruction = instructions_[i];
+            const Operand& a = values[static_cast<size_t>(instruction.operands[0])];
+            const Operand& b =
+                instruction.operands[1] >= 0 ? values[static_cast<size_t>(instruction.operands[1])] : a;
+            float* y = instruction.output >= 0 ? outputs[static_cast<size_t>(instruction.output)] + start
+                                               : registers + static_cast<size_t>(instruction.register_index) * tile_size;
+            ComputeOp(instruction.op, instruction.alpha, a, b, y, count);
+            values[num_inputs_ + i] = Operand{y, 0.0f, false};
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,159 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Y[b] = A[b] * B + scale * (A[b] * lora_A[i]) * lora_B[i] with i = adapter_indices[b].
+//
+// The base product is a single GEMM over all rows of the batch. The low-rank update of the
+// rows that select an adapter is computed with two batched GEMMs whose B operands are
+// gathered from the stacked adapter weights, accumulating into Y.
+class LoRAMatMul final : public OpKernel {
+ public:
+  explicit LoRAMatMul(const OpKernelInfo& info) : OpKernel(info) {
+    scale_ = info.GetAttrOrDefault<float>("scale", 1.0f);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  float scale_;
+};
+
+ONNX_OPERATOR_KERNEL_EX(
+    LoRAMatMul,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<int32_t>()),
+    LoRAMatMul);
+
+Status LoRAMatMul::Compute(OpKernelContext* context) const {
+  const Tensor* a = context->Input<Tensor>(0);
+  const Tensor* b = context->Input<Tensor>(1);
+  const Tensor* lora_a = context->Input<Tensor>(2);
+  const Tensor* lora_b = context->Input<Tensor>(3);
+  const Tensor* adapter_indices = context->Input<Tensor>(4);
+
+  const auto& a_shape = a->Shape();
+  const auto& b_shape = b->Shape();
+  const auto& lora_a_shape = lora_a->Shape();
+  const auto& lora_b_shape = lora_b->Shape();
+
+  ORT_RETURN_IF_NOT(a_shape.NumDimensions() >= 2, "Input A must have at least 2 dimensions.");
+  ORT_RETURN_IF_NOT(b_shape.NumDimensions() == 2, "Input B must have 2 dimensions.");
+  ORT_RETURN_IF_NOT(lora_a_shape.NumDimensions() == 3, "Input lora_A must have 3 dimensions.");
+  ORT_RETURN_IF_NOT(lora_b_shape.NumDimensions() == 3, "Input lora_B must have 3 dimensions.");
+
+  const size_t a_rank = a_shape.NumDimensions();
+  const int64_t batch_size = a_shape[0];
+  const int64_t K = a_shape[a_rank - 1];
+  const int64_t N = b_shape[1];
+  const int64_t num_adapters = lora_a_shape[0];
+  const int64_t lora_rank = lora_a_shape[2];
+
+  ORT_RETURN_IF_NOT(b_shape[0] == K, "Input B must have shape (K, N), got ", b_shape, " for K = ", K);
+  ORT_RETURN_IF_NOT(lora_a_shape[1] == K, "Input lora_A must have shape (num_adapters, K, rank), got ", lora_a_shape);
+  ORT_RETURN_IF_NOT(lora_b_shape[0] == num_adapters && lora_b_shape[1] == lora_rank && lora_b_shape[2] == N,
+                    "Input lora_B must have shape (num_adapters, rank, N), got ", lora_b_shape);
+  ORT_RETURN_IF_NOT(adapter_indices->Shape().NumDimensions() == 1 && adapter_indices->Shape()[0] == batch_size,
+                    "Input adapter_indices must have shape (batch_size), got ", adapter_indices->Shape());
+
+  TensorShapeVector y_dims = a_shape.AsShapeVector();
+  y_dims[a_rank - 1] = N;
+  Tensor* y = context->Output(0, TensorShape(y_dims));
+  if (y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const size_t batch = narrow<size_t>(batch_size);
+  const size_t M = narrow<size_t>(a_shape.SizeToDimension(a_rank - 1) / batch_size);
+  const size_t k = narrow<size_t>(K);
+  const size_t n = narrow<size_t>(N);
+  const size_t r = narrow<size_t>(lora_rank);
+
+  const float* a_data = a->Data<float>();
+  float* y_data = y->MutableData<float>();
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  if (k == 0) {
+    memset(y_data, 0, y->SizeInBytes());
+    return Status::OK();
+  }
+
+  MlasGemm(CblasNoTrans, CblasNoTrans, batch * M, n, k, 1.0f, a_data, k, b->Data<float>(), n, 0.0f, y_data, n,
+           thread_pool);
+
+  if (r == 0) {
+    return Status::OK();
+  }
+
+  const auto indices = adapter_indices->DataAsSpan<int32_t>();
+  InlinedVector<size_t> active_rows;
+  active_rows.reserve(batch);
+  for (size_t i = 0; i < batch; i++) {
+    const int32_t index = indices[i];
+    ORT_RETURN_IF_NOT(index < num_adapters, "Adapter index ", index, " of batch row ", i,
+                      " is out of range, the number of adapters is ", num_adapters);
+    if (index >= 0) {
+      active_rows.push_back(i);
+    }
+  }
+
+  if (active_rows.empty()) {
+    return Status::OK();
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+  const size_t num_active = active_rows.size();
+  auto down = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(num_active) * M * r);
+
+  const float* lora_a_data = lora_a->Data<float>();
+  const float* lora_b_data = lora_b->Data<float>();
+
+  // down[j] = A[row] * lora_A[index]
+  InlinedVector<MLAS_SGEMM_DATA_PARAMS> data(num_active);
+  for (size_t j = 0; j < num_active; j++) {
+    const size_t row = active_rows[j];
+    const size_t index = static_cast<size_t>(indices[row]);
+    data[j].A = a_data + row * M * k;
+    data[j].lda = k;
+    data[j].B = lora_a_data + index * k * r;
+    data[j].ldb = r;
+    data[j].C = down.get() + j * M * r;
+    data[j].ldc = r;
+    data[j].alpha = 1.0f;
+    data[j].beta = 0.0f;
+  }
+  MlasGemmBatch(CblasNoTrans, CblasNoTrans, M, r, k, data.data(), num_active, thread_pool);
+
+  // Y[row] += scale * down[j] * lora_B[index]
+  for (size_t j = 0; j < num_active; j++) {
+    const size_t row = active_rows[j];
+    const size_t index = static_cast<size_t>(indices[row]);
+    data[j].A = down.get() + j * M * r;
+    data[j].lda = r;
+    data[j].B = lora_b_data + index * r * n;
+    data[j].ldb = n;
+    data[j].C = y_data + row * M * n;
+    data[j].ldc = n;
+    data[j].alpha = scale_;
+    data[j].beta = 1.0f;
+  }
+  MlasGemmBatch(CblasNoTrans, CblasNoTrans, M, n, r, data.data(), num_active, thread_pool);
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -1,8 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#include <vector>
+#include <algorithm>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include "core/common/common.h"
 #include "core/common/narrow.h"
@@ -16,6 +18,50 @@
 namespace onnxruntime {
 namespace contrib {
 
+namespace {
+
+template <typename T1>
+constexpr bool IsInt4Type() {
+  return std::is_same_v<T1, Int4x2> || std::is_same_v<T1, UInt4x2>;
+}
+
+template <typename T1>
+inline int32_t GetQuantizedValue(const T1* data_ptr, int64_t idx) {
+  if constexpr (IsInt4Type<T1>()) {
+    return static_cast<int32_t>(data_ptr[idx >> 1].GetElem(narrow<size_t>(idx & 1)));
+  } else {
+    return static_cast<int32_t>(data_ptr[idx]);
+  }
+}
+
+// Dequantizes `count` contiguous elements that share a scale and zero point. The loops are kept simple so the
+// compiler can vectorize them.
+template <typename T1, typename T2>
+void DequantizeBlock(const T1* data_ptr, int64_t data_idx, int64_t count, float scale, int32_t zp, T2* output_ptr) {
+  if constexpr (IsInt4Type<T1>()) {
+    if ((data_idx & 1) == 0) {
+      const T1* pairs = data_ptr + (data_idx >> 1);
+      int64_t i = 0;
+      for (; i + 1 < count; i += 2) {
+        const T1 pair = pairs[i >> 1];
+        output_ptr[i] = static_cast<T2>(static_cast<float>(static_cast<int32_t>(pair.GetElem(0)) - zp) * scale);
+        output_ptr[i + 1] = static_cast<T2>(static_cast<float>(static_cast<int32_t>(pair.GetElem(1)) - zp) * scale);
+      }
+      if (i < count) {
+        const int32_t data_val = static_cast<int32_t>(pairs[i >> 1].GetElem(0));
+        output_ptr[i] = static_cast<T2>(static_cast<float>(data_val - zp) * scale);
+      }
+      return;
+    }
+  }
+
+  for (int64_t i = 0; i < count; ++i) {
+    output_ptr[i] = static_cast<T2>(static_cast<float>(GetQuantizedValue(data_ptr, data_idx + i) - zp) * scale);
+  }
+}
+
+}  // namespace
+
 template <typename T1, typename Tind>
 class GatherBlockQuantized : public OpKernel {
  public:
@@ -161,20 +207,35 @@ Status GatherBlockQuantized<T1, Tind>::CopyDataAndDequantize(const T1* data_ptr,
       return;
     }
 
-    // TODO(fajin): use SIMD
+    if (quantize_N == 1 && quantize_axis_dim > 0 && gather_block % quantize_axis_dim == 0) {
+      // The data is quantized along the innermost axis and the gathered block is made of whole rows, which are
+      // dequantized block by block from contiguous memory.
+      for (int64_t row_offset = 0; row_offset < gather_block; row_offset += quantize_axis_dim) {
+        const int64_t row_idx = (data_idx_base + row_offset) / quantize_axis_dim;
+        int64_t scale_idx = row_idx * scale_full_block;
+        for (int64_t y = 0; y < quantize_axis_dim; y += block_size_, ++scale_idx) {
+          auto scale_val = static_cast<float>(scales_ptr[scale_idx]);
+          auto zp_val = zero_points_ptr ? GetQuantizedValue(zero_points_ptr, scale_idx) : 0;
+          DequantizeBlock(data_ptr, data_idx_base + row_offset + y, std::min(block_size_, quantize_axis_dim - y),
+                          scale_val, zp_val, output_ptr + output_idx_base + row_offset + y);
+        }
+      }
+
+      cache[data_idx_base] = output_idx_base;
+      return;
+    }
+
     int64_t output_idx = output_idx_base;
     int64_t data_idx = data_idx_base;
     for (int64_t i = 0; i < gather_block; ++i, ++output_idx, ++data_idx) {
-      auto data_val = static_cast<int32_t>(data_ptr[data_idx >> 1].GetElem(narrow<size_t>(data_idx & 1)));
+      auto data_val = GetQuantizedValue(data_ptr, data_idx);
 
       int64_t x = data_idx / quantize_full_block;
       int64_t y = data_idx % quantize_full_block / quantize_N;
       int64_t z = data_idx % quantize_N;
       int64_t scale_idx = x * scale_full_block + y / block_size_ * quantize_N + z;
       auto scale_val = static_cast<float>(scales_ptr[scale_idx]);
-      auto zp_val = static_cast<int32_t>(zero_points_ptr
-                                             ? zero_points_ptr[scale_idx >> 1].GetElem(narrow<size_t>(scale_idx & 1))
-                                             : 0);
+      auto zp_val = zero_points_ptr ? GetQuantizedValue(zero_points_ptr, scale_idx) : 0;
 
       output_ptr[output_idx] = static_cast<T2>(static_cast<float>(data_val - zp_val) * scale_val);
     }
@@ -277,6 +338,10 @@ REGISTER_GATHERBLOCKQUANTIZED(UInt4x2, int32_t);
 REGISTER_GATHERBLOCKQUANTIZED(UInt4x2, int64_t);
 REGISTER_GATHERBLOCKQUANTIZED(Int4x2, int32_t);
 REGISTER_GATHERBLOCKQUANTIZED(Int4x2, int64_t);
+REGISTER_GATHERBLOCKQUANTIZED(uint8_t, int32_t);
+REGISTER_GATHERBLOCKQUANTIZED(uint8_t, int64_t);
+REGISTER_GATHERBLOCKQUANTIZED(int8_t, int32_t);
+REGISTER_GATHERBLOCKQUANTIZED(int8_t, int64_t);
 
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -59,6 +59,13 @@ void ComputeJob(
   T* p_output = output_data + offset;
   T* p_skip_input_bias_add_output = skip_input_bias_add_output_data == nullptr ? nullptr : skip_input_bias_add_output_data + offset;
 
+  if constexpr (std::is_same_v<T, float>) {
+    MlasLayerNormalization<float>(p_input, p_skip, bias_data, gamma_data, beta_data, p_output,
+                                  p_skip_input_bias_add_output, static_cast<size_t>(hidden_size), epsilon, simplified,
+                                  nullptr, nullptr);
+    return;
+  }
+
   T mean(0.0f);
   T mean_square(0.0f);
 
@@ -96,6 +103,31 @@ void ComputeJob(
   }
 }
 
+void ComputeJob(
+    const MLFloat16* input_data,
+    const MLFloat16* skip_data,
+    const float* gamma_float_ptr,
+    const float* beta_float_ptr,
+    const float* bias_float_ptr,
+    ptrdiff_t task_idx,
+    int hidden_size,
+    int64_t skip_size,
+    float epsilon,
+    bool simplified,
+    MLFloat16* output_data,
+    MLFloat16* skip_input_bias_add_output_data) {
+  auto offset = task_idx * hidden_size;
+  const MLFloat16* p_input = input_data + offset;
+  const MLFloat16* p_skip = skip_data + (offset % skip_size);
+  MLFloat16* p_output = output_data + offset;
+  MLFloat16* p_skip_input_bias_add_output =
+      skip_input_bias_add_output_data == nullptr ? nullptr : skip_input_bias_add_output_data + offset;
+
+  MlasLayerNormalization<MLFloat16>(p_input, p_skip, bias_float_ptr, gamma_float_ptr, beta_float_ptr, p_output,
+                                    p_skip_input_bias_add_output, static_cast<size_t>(hidden_size), epsilon,
+                                    simplified, nullptr, nullptr);
+}
+
 void ConvertMLFloat16ToFloatIfNeeded(const Tensor& tensor, AllocatorPtr alloc, IAllocatorUniquePtr<float>& dest, bool& is_packed) {
   if (tensor.GetElementType() == utils::ToTensorProtoElementType<MLFloat16>()) {
     auto tensor_data_ptr = tensor.Data<MLFloat16>();
@@ -167,42 +199,16 @@ Status SkipLayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
     AllocatorPtr alloc;
     ORT_RETURN_IF_ERROR(p_ctx->GetTempSpaceAllocator(&alloc));
 
-    IAllocatorUniquePtr<float> input_fp32;
-    IAllocatorUniquePtr<float> output_fp32;
-    IAllocatorUniquePtr<float> skip_input_bias_add_output_fp32;
-    IAllocatorUniquePtr<float> skip_fp32;
     IAllocatorUniquePtr<float> gamma_fp32;
     IAllocatorUniquePtr<float> beta_fp32;
     IAllocatorUniquePtr<float> bias_fp32;
 
-    const float* input_data_f = nullptr;
-    const float* skip_data_f = nullptr;
     const float* gamma_data_f = nullptr;
     const float* beta_data_f = nullptr;
     const float* bias_data_f = nullptr;
-    float* output_data_f = nullptr;
-    float* skip_input_bias_add_output_data_f = nullptr;
 
     const size_t num_elems = static_cast<size_t>(hidden_size);
 
-    input_fp32 = IAllocator::MakeUniquePtr<float>(alloc, total_data_size);
-    MlasConvertHalfToFloatBuffer(input_data, input_fp32.get(), total_data_size);
-    input_data_f = input_fp32.get();
-
-    output_fp32 = IAllocator::MakeUniquePtr<float>(alloc, total_data_size);
-    output_data_f = output_fp32.get();
-
-    skip_input_bias_add_output_fp32 = IAllocator::MakeUniquePtr<float>(alloc, total_data_size);
-    skip_input_bias_add_output_data_f = skip_input_bias_add_output_fp32.get();
-
-    if (skip_data) {
-      skip_fp32 = IAllocator::MakeUniquePtr<float>(alloc, static_cast<size_t>(skip_size));
-      MlasConvertHalfToFloatBuffer(skip_data, skip_fp32.get(), static_cast<size_t>(skip_size));
-      skip_data_f = skip_fp32.get();
-    } else if (prepacked_skip_fp32_data_) {
-      skip_data_f = prepacked_skip_fp32_data_.get();
-    }
-
     if (gamma_data) {
       gamma_fp32 = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
       MlasConvertHalfToFloatBuffer(gamma_data, gamma_fp32.get(), num_elems);
@@ -227,6 +233,35 @@ Status SkipLayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
       bias_data_f = prepacked_bias_fp32_data_.get();
     }
 
+    // The skip input is usually an activation, so each row is widened, normalized and narrowed in one job.
+    if (skip_data) {
+      concurrency::ThreadPool::TryBatchParallelFor(
+          p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
+          [&](ptrdiff_t task_idx) {
+            ComputeJob(input_data, skip_data, gamma_data_f, beta_data_f, bias_data_f, task_idx, hidden_size, skip_size,
+                       epsilon_, simplified, output_data, skip_input_bias_add_output_data);
+          },
+          0);
+      return Status::OK();
+    }
+
+    // A constant skip input was prepacked to fp32, so the whole tensor is normalized in fp32.
+    IAllocatorUniquePtr<float> input_fp32 = IAllocator::MakeUniquePtr<float>(alloc, total_data_size);
+    MlasConvertHalfToFloatBuffer(input_data, input_fp32.get(), total_data_size);
+    const float* input_data_f = input_fp32.get();
+
+    IAllocatorUniquePtr<float> output_fp32 = IAllocator::MakeUniquePtr<float>(alloc, total_data_size);
+    float* output_data_f = output_fp32.get();
+
+    IAllocatorUniquePtr<float> skip_input_bias_add_output_fp32;
+    float* skip_input_bias_add_output_data_f = nullptr;
+    if (skip_input_bias_add_output_data != nullptr) {
+      skip_input_bias_add_output_fp32 = IAllocator::MakeUniquePtr<float>(alloc, total_data_size);
+      skip_input_bias_add_output_data_f = skip_input_bias_add_output_fp32.get();
+    }
+
+    const float* skip_data_f = prepacked_skip_fp32_data_.get();
+
     concurrency::ThreadPool::TryBatchParallelFor(
         p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
         [&](ptrdiff_t task_idx) {
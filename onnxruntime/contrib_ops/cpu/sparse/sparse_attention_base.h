@@ -3,12 +3,17 @@
 
 #pragma once
 
+#include <type_traits>
+#include <vector>
+
 #include "contrib_ops/cpu/bert/attention_helper.h"
 
 #include "core/common/common.h"
 #include "contrib_ops/cpu/bert/attention_common.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/env.h"
+#include "core/platform/env_var_utils.h"
 #include "contrib_ops/cpu/utils/dump_tensor.h"
 
 namespace onnxruntime {
@@ -33,6 +38,9 @@ class SparseAttentionBase {
     int64_t sparse_block_size = 0;
     ORT_ENFORCE(info.GetAttr("sparse_block_size", &sparse_block_size).IsOK());
     sparse_block_size_ = static_cast<int>(sparse_block_size);
+
+    l2_cache_size_ = Env::Default().GetL2CacheSize();
+    disable_flash_ = ParseEnvironmentVariableWithDefault<bool>(attention::kDisableFlashAttention, false);
   }
 
   int num_heads_;     // number of attention heads of Q
@@ -41,6 +49,8 @@ class SparseAttentionBase {
   bool do_rotary_;    // whether or not to use rotary embeddings
   bool rotary_interleaved_;
   int sparse_block_size_;
+  bool disable_flash_;
+  int l2_cache_size_;
 
   template <typename T>
   Status ApplyAttention(const T* Q,                             // Q data with shape BxNxSxH
@@ -65,6 +75,16 @@ class SparseAttentionBase {
     int past_buffer_sequence_length = static_cast<int>(past_key->Shape().GetDims()[2]);
     int present_buffer_sequence_length = static_cast<int>(present_key->Shape().GetDims()[2]);
 
+    auto* tp = context->GetOperatorThreadPool();
+
+    if constexpr (std::is_same<T, float>::value) {
+      if (!disable_flash_ && l2_cache_size_ > 0) {
+        ApplyFlashAttention(Q, K, V, past_key, past_value, output, present_key, present_value, total_key_lengths,
+                            block_row_indices, block_col_indices, parameters, allocator, tp);
+        return Status::OK();
+      }
+    }
+
     // Allocate a buffer to store Softmax(QK)
     size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * parameters.total_sequence_length * sizeof(T);
     auto attention_probs = allocator->Alloc(bytes);
@@ -73,8 +93,6 @@ class SparseAttentionBase {
     bool past_present_share_buffer = parameters.past_present_share_buffer;
     assert(past_present_share_buffer);
 
-    auto* tp = context->GetOperatorThreadPool();
-
     const T* k = packed_qkv ? Q + num_heads_ * sequence_length * head_size : K;
     ComputeAttentionProbs<T>(
         static_cast<T*>(attention_probs), Q, k, total_key_lengths->Data<int32_t>(),
@@ -96,6 +114,107 @@ class SparseAttentionBase {
   }
 
  private:
+  // Append the new keys and values to the KV cache, then compute the block sparse causal attention with
+  // MlasFlashAttention. Key blocks that are not in the sparse layout are skipped, and the attention
+  // probabilities are never materialized.
+  void ApplyFlashAttention(const float* Q,
+                           const float* K,
+                           const float* V,
+                           const Tensor* past_key,
+                           const Tensor* past_value,
+                           Tensor* output,
+                           Tensor* present_key,
+                           Tensor* present_value,
+                           const Tensor* total_key_lengths,
+                           const Tensor* block_row_indices,
+                           const Tensor* block_col_indices,
+                           const SparseAttentionParameters& parameters,
+                           AllocatorPtr allocator,
+                           ThreadPool* tp) const {
+    const int batch_size = parameters.batch_size;
+    const int sequence_length = parameters.sequence_length;
+    const int head_size = parameters.head_size;
+    const bool packed_qkv = parameters.is_packed_qkv;
+    const bool is_prompt = (parameters.total_sequence_length == sequence_length);
+    const bool past_present_share_buffer = parameters.past_present_share_buffer;
+
+    const int past_buffer_sequence_length = static_cast<int>(past_key->Shape().GetDims()[2]);
+    const int present_buffer_sequence_length = static_cast<int>(present_key->Shape().GetDims()[2]);
+
+    const ptrdiff_t packed_batch_stride =
+        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
+                   : SafeInt<ptrdiff_t>(0);
+    const size_t kv_input_chunk_length = static_cast<size_t>(sequence_length) * head_size;
+    const size_t past_buff_chunk_length = static_cast<size_t>(past_buffer_sequence_length) * head_size;
+    const size_t present_buff_chunk_length = static_cast<size_t>(present_buffer_sequence_length) * head_size;
+
+    const int32_t* total_key_lengths_data = total_key_lengths->Data<int32_t>();
+    const float* past_key_data = past_key->Data<float>();
+    const float* past_value_data = past_value->Data<float>();
+    float* present_key_data = present_key->MutableData<float>();
+    float* present_value_data = present_value->MutableData<float>();
+
+    // Concatenate past + new -> present once per kv head.
+    for (int b = 0; b < batch_size; b++) {
+      const int past_seq_len = is_prompt ? 0 : (total_key_lengths_data[b] - sequence_length);
+      const size_t past_chunk_length = static_cast<size_t>(past_seq_len) * head_size;
+      for (int h = 0; h < kv_num_heads_; h++) {
+        const std::ptrdiff_t i = static_cast<std::ptrdiff_t>(b) * kv_num_heads_ + h;
+        const float* k;
+        const float* v;
+        if (packed_qkv) {
+          k = Q + packed_batch_stride * b + kv_input_chunk_length * (num_heads_ + h);
+          v = Q + packed_batch_stride * b + kv_input_chunk_length * (num_heads_ + kv_num_heads_ + h);
+        } else {
+          k = K + kv_input_chunk_length * i;
+          v = V + kv_input_chunk_length * i;
+        }
+        ConcatStateChunkGQA(past_key_data, k, present_key_data, present_buff_chunk_length, past_buff_chunk_length,
+                            past_chunk_length, kv_input_chunk_length, past_present_share_buffer, i);
+        ConcatStateChunkGQA(past_value_data, v, present_value_data, present_buff_chunk_length, past_buff_chunk_length,
+                            past_chunk_length, kv_input_chunk_length, past_present_share_buffer, i);
+      }
+    }
+
+    MlasFlashAttentionThreadedArgs args;
+    args.batch_size = batch_size;
+    args.num_heads = num_heads_;
+    args.q_sequence_length = sequence_length;
+    args.kv_sequence_length = present_buffer_sequence_length;
+    args.qk_head_size = head_size;
+    args.v_head_size = head_size;
+    args.scale = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+    SetFlashAttentionBlockSizes(args, l2_cache_size_);
+
+    // The kernel looks up the sparse layout once per key block.
+    args.kv_block_size = parameters.sparse_block_size;
+
+    args.kv_num_heads = kv_num_heads_;
+    args.kv_buffer_sequence_length = present_buffer_sequence_length;
+    args.q_batch_stride = packed_batch_stride;
+    args.kv_valid_lengths = total_key_lengths_data;
+    args.causal = true;
+    args.sparse_block_size = parameters.sparse_block_size;
+    args.num_sparse_layout = parameters.num_sparse_layout;
+    args.sparse_stride_row_indices = parameters.stride_row_indices;
+    args.sparse_stride_col_indices = parameters.stride_col_indices;
+    args.sparse_block_row_indices = block_row_indices->Data<int32_t>();
+    args.sparse_block_col_indices = block_col_indices->Data<int32_t>();
+
+    args.query = Q;
+    args.key = present_key_data;
+    args.value = present_value_data;
+    args.output = output->MutableData<float>();
+
+    args.thread_count = concurrency::ThreadPool::DegreeOfParallelism(tp);
+    args.buffer_size_per_thread = MlasFlashAttentionGetBufferSizePerThread(&args);
+    IAllocatorUniquePtr<void> buffer =
+        IAllocator::MakeUniquePtr<void>(allocator, args.buffer_size_per_thread * args.thread_count);
+    args.buffer = reinterpret_cast<float*>(buffer.get());
+
+    MlasFlashAttention(&args, tp);
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T)
   //  attention_probs(B, N, S, T) = Softmax(attention_probs)
@@ -24,6 +24,7 @@ ONNX_OPERATOR_KERNEL_EX(
     kWebGpuExecutionProvider,
     (*KernelDefBuilder::Create())
         .TypeConstraint("T", WebGpuSupportedFloatTypes())
+        .TypeConstraint("T_CACHE", WebGpuSupportedFloatTypes())
         .MayInplace(3, 1)
         .MayInplace(4, 2)
         .InputMemoryType(OrtMemTypeCPUInput, 6),
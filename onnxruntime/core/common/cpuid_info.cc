@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #include "core/common/cpuid_info.h"
+
+#include <cstring>
+
 #include "core/common/logging/logging.h"
 #include "core/common/logging/severity.h"
 
@@ -139,6 +142,20 @@ void CPUIDInfo::X86Init() {
       }
     }
   }
+
+  // The brand string is returned by the extended functions 0x80000002 to 0x80000004, 16 bytes at a time.
+  GetCPUID(static_cast<int>(0x80000000u), data);
+  if (static_cast<uint32_t>(data[0]) >= 0x80000004u) {
+    char brand[3 * sizeof(data) + 1] = {};
+    for (int i = 0; i < 3; ++i) {
+      GetCPUID(static_cast<int>(0x80000002u) + i, data);
+      memcpy(brand + i * sizeof(data), data, sizeof(data));
+    }
+    model_name_ = brand;
+    const auto first = model_name_.find_first_not_of(' ');
+    const auto last = model_name_.find_last_not_of(' ');
+    model_name_ = first == std::string::npos ? std::string() : model_name_.substr(first, last - first + 1);
+  }
 }
 
 #endif  // defined(CPUIDINFO_ARCH_X86)
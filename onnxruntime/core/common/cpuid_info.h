@@ -34,6 +34,12 @@ class CPUIDInfo {
 
   uint32_t GetCurrentCoreIdx() const;
 
+  /**
+   * @return The processor brand string, e.g. "Intel(R) Xeon(R) Platinum 8272CL CPU @ 2.60GHz", or an empty string
+   * if it is not available.
+   */
+  const std::string& GetModelName() const { return model_name_; }
+
   /**
    * @return CPU core micro-architecture running the current thread
    */
@@ -104,6 +110,7 @@ class CPUIDInfo {
   bool has_sse3_{false};
   bool has_sse4_1_{false};
   bool is_hybrid_{false};
+  std::string model_name_;
 
   std::vector<uint32_t> core_uarchs_;  // micro-arch of each core
 
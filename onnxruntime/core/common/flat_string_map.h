@@ -0,0 +1,256 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "core/common/common.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace onnxruntime {
+
+/**
+ * A string keyed hash map for lookup tables that are built once, typically from node attributes,
+ * and then queried many times.
+ *
+ * The keys are copied into one contiguous pool and indexed by an open addressing table with linear
+ * probing. Each slot holds the value together with the first 8 bytes, the size, the pool offset and
+ * 16 bits of the hash of its key, so a probe is resolved within the slot, a hit on a key of up to 8
+ * bytes reads nothing else and a longer hit compares only the tail of the key against the pool.
+ *
+ * Lookups take a std::string_view and may run concurrently. FindEach looks up a batch of keys and
+ * overlaps their cache misses, which is the preferred way to map a tensor. Keys are never erased.
+ * Pointers to values are invalidated by the next insertion.
+ */
+template <typename T>
+class FlatStringMap {
+ public:
+  FlatStringMap() = default;
+
+  size_t Size() const noexcept { return size_; }
+  bool Empty() const noexcept { return size_ == 0; }
+
+  // Reserves space for `count` keys with a total length of `total_key_size` bytes.
+  void Reserve(size_t count, size_t total_key_size = 0) {
+    pool_.reserve(total_key_size);
+    if (count > MaxSize(slots_.size())) {
+      Rehash(count);
+    }
+  }
+
+  // Inserts `key` with a value constructed from `args` if the key is not present.
+  // Returns the value of the key and whether it was inserted.
+  template <typename... Args>
+  std::pair<T*, bool> TryEmplace(std::string_view key, Args&&... args) {
+    const uint64_t hash = Hash(key);
+    if (const size_t existing = FindSlot(key, hash); existing != kNotFound) {
+      return {&slots_[existing].value, false};
+    }
+
+    if (size_ + 1 > MaxSize(slots_.size())) {
+      Rehash(size_ + 1);
+    }
+
+    // Keys whose size does not fit the slot store it in front of their bytes.
+    if (key.size() >= kLongKeySize) {
+      const size_t key_size = key.size();
+      pool_.append(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+    }
+    ORT_ENFORCE(pool_.size() + key.size() <= std::numeric_limits<uint32_t>::max(),
+                "The keys of a FlatStringMap are limited to 4 GB.");
+    const auto offset = static_cast<uint32_t>(pool_.size());
+    pool_.append(key.data(), key.size());
+
+    Slot& slot = EmptySlot(hash);
+    slot = Slot{Prefix(key), offset, Tag(hash), SlotSize(key.size()), T(std::forward<Args>(args)...)};
+    ++size_;
+    return {&slot.value, true};
+  }
+
+  // Inserts `key` or replaces its value.
+  T* InsertOrAssign(std::string_view key, T value) {
+    auto [found, inserted] = TryEmplace(key, std::move(value));
+    if (!inserted) {
+      *found = std::move(value);
+    }
+    return found;
+  }
+
+  // Returns the value of `key`, or nullptr if the key is not present.
+  const T* Find(std::string_view key) const noexcept {
+    const size_t position = FindSlot(key, Hash(key));
+    return position == kNotFound ? nullptr : &slots_[position].value;
+  }
+
+  T* Find(std::string_view key) noexcept {
+    const size_t position = FindSlot(key, Hash(key));
+    return position == kNotFound ? nullptr : &slots_[position].value;
+  }
+
+  // Calls fn(i, Find(keys[i])) for every key in order. Tables that do not fit in cache are probed a
+  // block at a time: the keys of the block are hashed and their slots prefetched before the probes.
+  template <typename Key, typename Fn>
+  void FindEach(gsl::span<const Key> keys, Fn&& fn) const {
+    if (slots_.size() * sizeof(Slot) <= kPrefetchThreshold) {
+      for (size_t i = 0; i < keys.size(); ++i) {
+        fn(i, Find(keys[i]));
+      }
+      return;
+    }
+
+    const size_t mask = slots_.size() - 1;
+    uint64_t hashes[kPrefetchBlock];
+    for (size_t first = 0; first < keys.size(); first += kPrefetchBlock) {
+      const size_t count = std::min(kPrefetchBlock, keys.size() - first);
+      for (size_t i = 0; i < count; ++i) {
+        hashes[i] = Hash(keys[first + i]);
+        Prefetch(&slots_[hashes[i] & mask]);
+      }
+      for (size_t i = 0; i < count; ++i) {
+        const size_t position = FindSlot(keys[first + i], hashes[i]);
+        fn(first + i, position == kNotFound ? nullptr : &slots_[position].value);
+      }
+    }
+  }
+
+ private:
+  struct Slot {
+    uint64_t prefix;
+    uint32_t offset;
+    uint16_t tag;   // 0 marks an empty slot
+    uint16_t size;  // saturated at kLongKeySize
+    T value;
+  };
+
+  static constexpr size_t kNotFound = std::numeric_limits<size_t>::max();
+  static constexpr uint16_t kLongKeySize = 0xFFFF;
+  static constexpr uint64_t kMultiplier = 0x9E3779B97F4A7C15ull;
+  static constexpr size_t kPrefetchBlock = 16;
+  static constexpr size_t kPrefetchThreshold = 256 * 1024;
+
+  static void Prefetch(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+  }
+
+  // Keep the load factor at or below 3/4.
+  static size_t MaxSize(size_t capacity) noexcept { return capacity - capacity / 4; }
+
+  static uint64_t Mix(uint64_t value) noexcept {
+    value *= kMultiplier;
+    return value ^ (value >> 29);
+  }
+
+  static uint64_t Hash(std::string_view key) noexcept {
+    const char* data = key.data();
+    size_t remaining = key.size();
+    uint64_t hash = Mix(remaining + kMultiplier);
+    for (; remaining >= 8; data += 8, remaining -= 8) {
+      uint64_t word;
+      std::memcpy(&word, data, 8);
+      hash = Mix(hash ^ word);
+    }
+    if (remaining > 0) {
+      uint64_t word = 0;
+      std::memcpy(&word, data, remaining);
+      hash = Mix(hash ^ word);
+    }
+    // Final avalanche so that both the low bits (position) and the high bits (tag) depend on every byte.
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    return hash;
+  }
+
+  static uint64_t Prefix(std::string_view key) noexcept {
+    uint64_t prefix = 0;
+    std::memcpy(&prefix, key.data(), key.size() < 8 ? key.size() : 8);
+    return prefix;
+  }
+
+  static uint16_t Tag(uint64_t hash) noexcept { return static_cast<uint16_t>(hash >> 48) | 1; }
+
+  static uint16_t SlotSize(size_t size) noexcept {
+    return size < kLongKeySize ? static_cast<uint16_t>(size) : kLongKeySize;
+  }
+
+  std::string_view SlotKey(const Slot& slot) const noexcept {
+    size_t size = slot.size;
+    if (size == kLongKeySize) {
+      std::memcpy(&size, pool_.data() + slot.offset - sizeof(size), sizeof(size));
+    }
+    return std::string_view(pool_.data() + slot.offset, size);
+  }
+
+  size_t FindSlot(std::string_view key, uint64_t hash) const noexcept {
+    if (slots_.empty()) {
+      return kNotFound;
+    }
+    const uint16_t tag = Tag(hash);
+    const uint16_t size = SlotSize(key.size());
+    const uint64_t prefix = Prefix(key);
+    const size_t mask = slots_.size() - 1;
+    for (size_t position = hash & mask;; position = (position + 1) & mask) {
+      const Slot& slot = slots_[position];
+      if (slot.tag == 0) {
+        return kNotFound;
+      }
+      if (slot.tag == tag && slot.size == size && slot.prefix == prefix) {
+        // The prefix covers the first 8 bytes, so only the tail of a longer key is left to compare.
+        if (key.size() <= 8 ||
+            (size < kLongKeySize
+                 ? std::memcmp(pool_.data() + slot.offset + 8, key.data() + 8, key.size() - 8) == 0
+                 : SlotKey(slot) == key)) {
+          return position;
+        }
+      }
+    }
+  }
+
+  Slot& EmptySlot(uint64_t hash) noexcept {
+    const size_t mask = slots_.size() - 1;
+    size_t position = hash & mask;
+    while (slots_[position].tag != 0) {
+      position = (position + 1) & mask;
+    }
+    return slots_[position];
+  }
+
+  void Rehash(size_t count) {
+    size_t capacity = 16;
+    while (MaxSize(capacity) < count) {
+      capacity *= 2;
+    }
+    std::vector<Slot> slots(capacity);
+    slots.swap(slots_);
+    for (Slot& slot : slots) {
+      if (slot.tag != 0) {
+        EmptySlot(Hash(SlotKey(slot))) = std::move(slot);
+      }
+    }
+  }
+
+  std::vector<Slot> slots_;
+  std::string pool_;
+  size_t size_ = 0;
+};
+
+}  // namespace onnxruntime
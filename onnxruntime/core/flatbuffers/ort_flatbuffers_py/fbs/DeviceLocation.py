@@ -0,0 +1,81 @@
+# automatically generated by the FlatBuffers compiler, do not modify
+
+# namespace: fbs
+
+import flatbuffers
+from flatbuffers.compat import import_numpy
+np = import_numpy()
+
+# location of an allocation, see OrtDevice in <repo root>/include/onnxruntime/core/framework/ortdevice.h
+class DeviceLocation(object):
+    __slots__ = ['_tab']
+
+    @classmethod
+    def GetRootAs(cls, buf, offset=0):
+        n = flatbuffers.encode.Get(flatbuffers.packer.uoffset, buf, offset)
+        x = DeviceLocation()
+        x.Init(buf, n + offset)
+        return x
+
+    @classmethod
+    def GetRootAsDeviceLocation(cls, buf, offset=0):
+        """This method is deprecated. Please switch to GetRootAs."""
+        return cls.GetRootAs(buf, offset)
+    @classmethod
+    def DeviceLocationBufferHasIdentifier(cls, buf, offset, size_prefixed=False):
+        return flatbuffers.util.BufferHasIdentifier(buf, offset, b"\x4F\x52\x54\x4D", size_prefixed=size_prefixed)
+
+    # DeviceLocation
+    def Init(self, buf, pos):
+        self._tab = flatbuffers.table.Table(buf, pos)
+
+    # DeviceLocation
+    def DeviceType(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(4))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Int8Flags, o + self._tab.Pos)
+        return 0
+
+    # DeviceLocation
+    def MemoryType(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Int8Flags, o + self._tab.Pos)
+        return 0
+
+    # DeviceLocation
+    def DeviceId(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(8))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Int16Flags, o + self._tab.Pos)
+        return 0
+
+def DeviceLocationStart(builder):
+    builder.StartObject(3)
+
+def Start(builder):
+    DeviceLocationStart(builder)
+
+def DeviceLocationAddDeviceType(builder, deviceType):
+    builder.PrependInt8Slot(0, deviceType, 0)
+
+def AddDeviceType(builder, deviceType):
+    DeviceLocationAddDeviceType(builder, deviceType)
+
+def DeviceLocationAddMemoryType(builder, memoryType):
+    builder.PrependInt8Slot(1, memoryType, 0)
+
+def AddMemoryType(builder, memoryType):
+    DeviceLocationAddMemoryType(builder, memoryType)
+
+def DeviceLocationAddDeviceId(builder, deviceId):
+    builder.PrependInt16Slot(2, deviceId, 0)
+
+def AddDeviceId(builder, deviceId):
+    DeviceLocationAddDeviceId(builder, deviceId)
+
+def DeviceLocationEnd(builder):
+    return builder.EndObject()
+
+def End(builder):
+    return DeviceLocationEnd(builder)
@@ -0,0 +1,432 @@
+# automatically generated by the FlatBuffers compiler, do not modify
+
+# namespace: fbs
+
+import flatbuffers
+from flatbuffers.compat import import_numpy
+np = import_numpy()
+
+# execution plan of the main graph of a session that runs all nodes on one stream
+# see SequentialExecutionPlan in <repo root>/onnxruntime/core/framework/sequential_execution_plan.h
+class ExecutionPlan(object):
+    __slots__ = ['_tab']
+
+    @classmethod
+    def GetRootAs(cls, buf, offset=0):
+        n = flatbuffers.encode.Get(flatbuffers.packer.uoffset, buf, offset)
+        x = ExecutionPlan()
+        x.Init(buf, n + offset)
+        return x
+
+    @classmethod
+    def GetRootAsExecutionPlan(cls, buf, offset=0):
+        """This method is deprecated. Please switch to GetRootAs."""
+        return cls.GetRootAs(buf, offset)
+    @classmethod
+    def ExecutionPlanBufferHasIdentifier(cls, buf, offset, size_prefixed=False):
+        return flatbuffers.util.BufferHasIdentifier(buf, offset, b"\x4F\x52\x54\x4D", size_prefixed=size_prefixed)
+
+    # ExecutionPlan
+    def Init(self, buf, pos):
+        self._tab = flatbuffers.table.Table(buf, pos)
+
+    # ExecutionPlan
+    def ExecutionProviders(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(4))
+        if o != 0:
+            x = self._tab.Vector(o)
+            x += flatbuffers.number_types.UOffsetTFlags.py_type(j) * 4
+            x = self._tab.Indirect(x)
+            from ort_flatbuffers_py.fbs.ExecutionProviderDevice import ExecutionProviderDevice
+            obj = ExecutionProviderDevice()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
+    # ExecutionPlan
+    def ExecutionProvidersLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(4))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # ExecutionPlan
+    def ExecutionProvidersIsNone(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(4))
+        return o == 0
+
+    # ExecutionPlan
+    def NodeExecutionProviders(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        if o != 0:
+            a = self._tab.Vector(o)
+            return self._tab.String(a + flatbuffers.number_types.UOffsetTFlags.py_type(j * 4))
+        return ""
+
+    # ExecutionPlan
+    def NodeExecutionProvidersLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # ExecutionPlan
+    def NodeExecutionProvidersIsNone(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        return o == 0
+
+    # ExecutionPlan
+    def ExecutionMode(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(8))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Int32Flags, o + self._tab.Pos)
+        return 0
+
+    # ExecutionPlan
+    def ExecutionOrder(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(10))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Int32Flags, o + self._tab.Pos)
+        return 0
+
+    # ExecutionPlan
+    def EnableMemReuse(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(12))
+        if o != 0:
+            return bool(self._tab.Get(flatbuffers.number_types.BoolFlags, o + self._tab.Pos))
+        return False
+
+    # ExecutionPlan
+    def ValueNames(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(14))
+        if o != 0:
+            a = self._tab.Vector(o)
+            return self._tab.String(a + flatbuffers.number_types.UOffsetTFlags.py_type(j * 4))
+        return ""
+
+    # ExecutionPlan
+    def ValueNamesLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(14))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # ExecutionPlan
+    def ValueNamesIsNone(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(14))
+        return o == 0
+
+    # ExecutionPlan
+    def AllocationPlan(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(16))
+        if o != 0:
+            x = self._tab.Vector(o)
+            x += flatbuffers.number_types.UOffsetTFlags.py_type(j) * 4
+            x = self._tab.Indirect(x)
+            from ort_flatbuffers_py.fbs.ValueAllocationPlan import ValueAllocationPlan
+            obj = ValueAllocationPlan()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
+    # ExecutionPlan
+    def AllocationPlanLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(16))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # ExecutionPlan
+    def AllocationPlanIsNone(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(16))
+        return o == 0
+
+    # ExecutionPlan
+    def InitializerAllocationOrder(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(18))
+        if o != 0:
+            a = self._tab.Vector(o)
+            return self._tab.Get(flatbuffers.number_types.Int32Flags, a + flatbuffers.number_types.UOffsetTFlags.py_type(j * 4))
+        return 0
+
+    # ExecutionPlan
+    def InitializerAllocationOrderAsNumpy(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(18))
+        if o != 0:
+            return self._tab.GetVectorAsNumpy(flatbuffers.number_types.Int32Flags, o)
+        return 0
+
+    # ExecutionPlan
+    def InitializerAllocationOrderLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(18))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # ExecutionPlan
+    def InitializerAllocationOrderIsNone(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(18))
+        return o == 0
+
+    # ExecutionPlan
+    def ActivationAllocationOrder(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(20))
+        if o != 0:
+            a = self._tab.Vector(o)
+            return self._tab.Get(flatbuffers.number_types.Int32Flags, a + flatbuffers.number_types.UOffsetTFlags.py_type(j * 4))
+        return 0
+
+    # ExecutionPlan
+    def ActivationAllocationOrderAsNumpy(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(20))
+        if o != 0:
+            return self._tab.GetVectorAsNumpy(flatbuffers.number_types.Int32Flags, o)
+        return 0
+
+    # ExecutionPlan
+    def ActivationAllocationOrderLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(20))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # ExecutionPlan
+    def ActivationAllocationOrderIsNone(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(20))
+        return o == 0
+
+    # ExecutionPlan
+    def StreamDevice(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(22))
+        if o != 0:
+            x = self._tab.Indirect(o + self._tab.Pos)
+            from ort_flatbuffers_py.fbs.DeviceLocation import DeviceLocation
+            obj = DeviceLocation()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
+    # ExecutionPlan
+    def NodeOrder(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(24))
+        if o != 0:
+            a = self._tab.Vector(o)
+            return self._tab.Get(flatbuffers.number_types.Uint32Flags, a + flatbuffers.number_types.UOffsetTFlags.py_type(j * 4))
+        return 0
+
+    # ExecutionPlan
+    def NodeOrderAsNumpy(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(24))
+        if o != 0:
+            return self._tab.GetVectorAsNumpy(flatbuffers.number_types.Uint32Flags, o)
+        return 0
+
+    # ExecutionPlan
+    def NodeOrderLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(24))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # ExecutionPlan
+    def NodeOrderIsNone(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(24))
+        return o == 0
+
+    # ExecutionPlan
+    def ReleaseValueIndices(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(26))
+        if o != 0:
+            a = self._tab.Vector(o)
+            return self._tab.Get(flatbuffers.number_types.Uint32Flags, a + flatbuffers.number_types.UOffsetTFlags.py_type(j * 4))
+        return 0
+
+    # ExecutionPlan
+    def ReleaseValueIndicesAsNumpy(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(26))
+        if o != 0:
+            return self._tab.GetVectorAsNumpy(flatbuffers.number_types.Uint32Flags, o)
+        return 0
+
+    # ExecutionPlan
+    def ReleaseValueIndicesLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(26))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # ExecutionPlan
+    def ReleaseValueIndicesIsNone(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(26))
+        return o == 0
+
+    # ExecutionPlan
+    def ReleaseNodeIndices(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(28))
+        if o != 0:
+            a = self._tab.Vector(o)
+            return self._tab.Get(flatbuffers.number_types.Uint32Flags, a + flatbuffers.number_types.UOffsetTFlags.py_type(j * 4))
+        return 0
+
+    # ExecutionPlan
+    def ReleaseNodeIndicesAsNumpy(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(28))
+        if o != 0:
+            return self._tab.GetVectorAsNumpy(flatbuffers.number_types.Uint32Flags, o)
+        return 0
+
+    # ExecutionPlan
+    def ReleaseNodeIndicesLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(28))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # ExecutionPlan
+    def ReleaseNodeIndicesIsNone(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(28))
+        return o == 0
+
+def ExecutionPlanStart(builder):
+    builder.StartObject(13)
+
+def Start(builder):
+    ExecutionPlanStart(builder)
+
+def ExecutionPlanAddExecutionProviders(builder, executionProviders):
+    builder.PrependUOffsetTRelativeSlot(0, flatbuffers.number_types.UOffsetTFlags.py_type(executionProviders), 0)
+
+def AddExecutionProviders(builder, executionProviders):
+    ExecutionPlanAddExecutionProviders(builder, executionProviders)
+
+def ExecutionPlanStartExecutionProvidersVector(builder, numElems):
+    return builder.StartVector(4, numElems, 4)
+
+def StartExecutionProvidersVector(builder, numElems: int) -> int:
+    return ExecutionPlanStartExecutionProvidersVector(builder, numElems)
+
+def ExecutionPlanAddNodeExecutionProviders(builder, nodeExecutionProviders):
+    builder.PrependUOffsetTRelativeSlot(1, flatbuffers.number_types.UOffsetTFlags.py_type(nodeExecutionProviders), 0)
+
+def AddNodeExecutionProviders(builder, nodeExecutionProviders):
+    ExecutionPlanAddNodeExecutionProviders(builder, nodeExecutionProviders)
+
+def ExecutionPlanStartNodeExecutionProvidersVector(builder, numElems):
+    return builder.StartVector(4, numElems, 4)
+
+def StartNodeExecutionProvidersVector(builder, numElems: int) -> int:
+    return ExecutionPlanStartNodeExecutionProvidersVector(builder, numElems)
+
+def ExecutionPlanAddExecutionMode(builder, executionMode):
+    builder.PrependInt32Slot(2, executionMode, 0)
+
+def AddExecutionMode(builder, executionMode):
+    ExecutionPlanAddExecutionMode(builder, executionMode)
+
+def ExecutionPlanAddExecutionOrder(builder, executionOrder):
+    builder.PrependInt32Slot(3, executionOrder, 0)
+
+def AddExecutionOrder(builder, executionOrder):
+    ExecutionPlanAddExecutionOrder(builder, executionOrder)
+
+def ExecutionPlanAddEnableMemReuse(builder, enableMemReuse):
+    builder.PrependBoolSlot(4, enableMemReuse, 0)
+
+def AddEnableMemReuse(builder, enableMemReuse):
+    ExecutionPlanAddEnableMemReuse(builder, enableMemReuse)
+
+def ExecutionPlanAddValueNames(builder, valueNames):
+    builder.PrependUOffsetTRelativeSlot(5, flatbuffers.number_types.UOffsetTFlags.py_type(valueNames), 0)
+
+def AddValueNames(builder, valueNames):
+    ExecutionPlanAddValueNames(builder, valueNames)
+
+def ExecutionPlanStartValueNamesVector(builder, numElems):
+    return builder.StartVector(4, numElems, 4)
+
+def StartValueNamesVector(builder, numElems: int) -> int:
+    return ExecutionPlanStartValueNamesVector(builder, numElems)
+
+def ExecutionPlanAddAllocationPlan(builder, allocationPlan):
+    builder.PrependUOffsetTRelativeSlot(6, flatbuffers.number_types.UOffsetTFlags.py_type(allocationPlan), 0)
+
+def AddAllocationPlan(builder, allocationPlan):
+    ExecutionPlanAddAllocationPlan(builder, allocationPlan)
+
+def ExecutionPlanStartAllocationPlanVector(builder, numElems):
+    return builder.StartVector(4, numElems, 4)
+
+def StartAllocationPlanVector(builder, numElems: int) -> int:
+    return ExecutionPlanStartAllocationPlanVector(builder, numElems)
+
+def ExecutionPlanAddInitializerAllocationOrder(builder, initializerAllocationOrder):
+    builder.PrependUOffsetTRelativeSlot(7, flatbuffers.number_types.UOffsetTFlags.py_type(initializerAllocationOrder), 0)
+
+def AddInitializerAllocationOrder(builder, initializerAllocationOrder):
+    ExecutionPlanAddInitializerAllocationOrder(builder, initializerAllocationOrder)
+
+def ExecutionPlanStartInitializerAllocationOrderVector(builder, numElems):
+    return builder.StartVector(4, numElems, 4)
+
+def StartInitializerAllocationOrderVector(builder, numElems: int) -> int:
+    return ExecutionPlanStartInitializerAllocationOrderVector(builder, numElems)
+
+def ExecutionPlanAddActivationAllocationOrder(builder, activationAllocationOrder):
+    builder.PrependUOffsetTRelativeSlot(8, flatbuffers.number_types.UOffsetTFlags.py_type(activationAllocationOrder), 0)
+
+def AddActivationAllocationOrder(builder, activationAllocationOrder):
+    ExecutionPlanAddActivationAllocationOrder(builder, activationAllocationOrder)
+
+def ExecutionPlanStartActivationAllocationOrderVector(builder, numElems):
+    return builder.StartVector(4, numElems, 4)
+
+def StartActivationAllocationOrderVector(builder, numElems: int) -> int:
+    return ExecutionPlanStartActivationAllocationOrderVector(builder, numElems)
+
+def ExecutionPlanAddStreamDevice(builder, streamDevice):
+    builder.PrependUOffsetTRelativeSlot(9, flatbuffers.number_types.UOffsetTFlags.py_type(streamDevice), 0)
+
+def AddStreamDevice(builder, streamDevice):
+    ExecutionPlanAddStreamDevice(builder, streamDevice)
+
+def ExecutionPlanAddNodeOrder(builder, nodeOrder):
+    builder.PrependUOffsetTRelativeSlot(10, flatbuffers.number_types.UOffsetTFlags.py_type(nodeOrder), 0)
+
+def AddNodeOrder(builder, nodeOrder):
+    ExecutionPlanAddNodeOrder(builder, nodeOrder)
+
+def ExecutionPlanStartNodeOrderVector(builder, numElems):
+    return builder.StartVector(4, numElems, 4)
+
+def StartNodeOrderVector(builder, numElems: int) -> int:
+    return ExecutionPlanStartNodeOrderVector(builder, numElems)
+
+def ExecutionPlanAddReleaseValueIndices(builder, releaseValueIndices):
+    builder.PrependUOffsetTRelativeSlot(11, flatbuffers.number_types.UOffsetTFlags.py_type(releaseValueIndices), 0)
+
+def AddReleaseValueIndices(builder, releaseValueIndices):
+    ExecutionPlanAddReleaseValueIndices(builder, releaseValueIndices)
+
+def ExecutionPlanStartReleaseValueIndicesVector(builder, numElems):
+    return builder.StartVector(4, numElems, 4)
+
+def StartReleaseValueIndicesVector(builder, numElems: int) -> int:
+    return ExecutionPlanStartReleaseValueIndicesVector(builder, numElems)
+
+def ExecutionPlanAddReleaseNodeIndices(builder, releaseNodeIndices):
+    builder.PrependUOffsetTRelativeSlot(12, flatbuffers.number_types.UOffsetTFlags.py_type(releaseNodeIndices), 0)
+
+def AddReleaseNodeIndices(builder, releaseNodeIndices):
+    ExecutionPlanAddReleaseNodeIndices(builder, releaseNodeIndices)
+
+def ExecutionPlanStartReleaseNodeIndicesVector(builder, numElems):
+    return builder.StartVector(4, numElems, 4)
+
+def StartReleaseNodeIndicesVector(builder, numElems: int) -> int:
+    return ExecutionPlanStartReleaseNodeIndicesVector(builder, numElems)
+
+def ExecutionPlanEnd(builder):
+    return builder.EndObject()
+
+def End(builder):
+    return ExecutionPlanEnd(builder)
@@ -0,0 +1,72 @@
+# automatically generated by the FlatBuffers compiler, do not modify
+
+# namespace: fbs
+
+import flatbuffers
+from flatbuffers.compat import import_numpy
+np = import_numpy()
+
+# default device of an execution provider
+class ExecutionProviderDevice(object):
+    __slots__ = ['_tab']
+
+    @classmethod
+    def GetRootAs(cls, buf, offset=0):
+        n = flatbuffers.encode.Get(flatbuffers.packer.uoffset, buf, offset)
+        x = ExecutionProviderDevice()
+        x.Init(buf, n + offset)
+        return x
+
+    @classmethod
+    def GetRootAsExecutionProviderDevice(cls, buf, offset=0):
+        """This method is deprecated. Please switch to GetRootAs."""
+        return cls.GetRootAs(buf, offset)
+    @classmethod
+    def ExecutionProviderDeviceBufferHasIdentifier(cls, buf, offset, size_prefixed=False):
+        return flatbuffers.util.BufferHasIdentifier(buf, offset, b"\x4F\x52\x54\x4D", size_prefixed=size_prefixed)
+
+    # ExecutionProviderDevice
+    def Init(self, buf, pos):
+        self._tab = flatbuffers.table.Table(buf, pos)
+
+    # ExecutionProviderDevice
+    def ExecutionProvider(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(4))
+        if o != 0:
+            return self._tab.String(o + self._tab.Pos)
+        return None
+
+    # ExecutionProviderDevice
+    def Device(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        if o != 0:
+            x = self._tab.Indirect(o + self._tab.Pos)
+            from ort_flatbuffers_py.fbs.DeviceLocation import DeviceLocation
+            obj = DeviceLocation()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
+def ExecutionProviderDeviceStart(builder):
+    builder.StartObject(2)
+
+def Start(builder):
+    ExecutionProviderDeviceStart(builder)
+
+def ExecutionProviderDeviceAddExecutionProvider(builder, executionProvider):
+    builder.PrependUOffsetTRelativeSlot(0, flatbuffers.number_types.UOffsetTFlags.py_type(executionProvider), 0)
+
+def AddExecutionProvider(builder, executionProvider):
+    ExecutionProviderDeviceAddExecutionProvider(builder, executionProvider)
+
+def ExecutionProviderDeviceAddDevice(builder, device):
+    builder.PrependUOffsetTRelativeSlot(1, flatbuffers.number_types.UOffsetTFlags.py_type(device), 0)
+
+def AddDevice(builder, device):
+    ExecutionProviderDeviceAddDevice(builder, device)
+
+def ExecutionProviderDeviceEnd(builder):
+    return builder.EndObject()
+
+def End(builder):
+    return ExecutionProviderDeviceEnd(builder)
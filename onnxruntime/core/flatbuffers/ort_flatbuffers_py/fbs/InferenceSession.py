@@ -57,8 +57,19 @@ class InferenceSession(object):
             return obj
         return None
 
+    # InferenceSession
+    def ExecutionPlan(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(12))
+        if o != 0:
+            x = self._tab.Indirect(o + self._tab.Pos)
+            from ort_flatbuffers_py.fbs.ExecutionPlan import ExecutionPlan
+            obj = ExecutionPlan()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
 def InferenceSessionStart(builder):
-    builder.StartObject(4)
+    builder.StartObject(5)
 
 def Start(builder):
     InferenceSessionStart(builder)
@@ -81,6 +92,12 @@ def InferenceSessionAddKernelTypeStrResolver(builder, kernelTypeStrResolver):
 def AddKernelTypeStrResolver(builder, kernelTypeStrResolver):
     InferenceSessionAddKernelTypeStrResolver(builder, kernelTypeStrResolver)
 
+def InferenceSessionAddExecutionPlan(builder, executionPlan):
+    builder.PrependUOffsetTRelativeSlot(4, flatbuffers.number_types.UOffsetTFlags.py_type(executionPlan), 0)
+
+def AddExecutionPlan(builder, executionPlan):
+    InferenceSessionAddExecutionPlan(builder, executionPlan)
+
 def InferenceSessionEnd(builder):
     return builder.EndObject()
 
@@ -0,0 +1,177 @@
+# automatically generated by the FlatBuffers compiler, do not modify
+
+# namespace: fbs
+
+import flatbuffers
+from flatbuffers.compat import import_numpy
+np = import_numpy()
+
+# allocation plan of an OrtValue
+# see AllocPlanPerValue in <repo root>/onnxruntime/core/framework/sequential_execution_plan.h
+class ValueAllocationPlan(object):
+    __slots__ = ['_tab']
+
+    @classmethod
+    def GetRootAs(cls, buf, offset=0):
+        n = flatbuffers.encode.Get(flatbuffers.packer.uoffset, buf, offset)
+        x = ValueAllocationPlan()
+        x.Init(buf, n + offset)
+        return x
+
+    @classmethod
+    def GetRootAsValueAllocationPlan(cls, buf, offset=0):
+        """This method is deprecated. Please switch to GetRootAs."""
+        return cls.GetRootAs(buf, offset)
+    @classmethod
+    def ValueAllocationPlanBufferHasIdentifier(cls, buf, offset, size_prefixed=False):
+        return flatbuffers.util.BufferHasIdentifier(buf, offset, b"\x4F\x52\x54\x4D", size_prefixed=size_prefixed)
+
+    # ValueAllocationPlan
+    def Init(self, buf, pos):
+        self._tab = flatbuffers.table.Table(buf, pos)
+
+    # ValueAllocationPlan
+    def AllocKind(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(4))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Int8Flags, o + self._tab.Pos)
+        return 0
+
+    # ValueAllocationPlan
+    def Location(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        if o != 0:
+            x = self._tab.Indirect(o + self._tab.Pos)
+            from ort_flatbuffers_py.fbs.DeviceLocation import DeviceLocation
+            obj = DeviceLocation()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
+    # ValueAllocationPlan
+    def ReusedBuffer(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(8))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Int32Flags, o + self._tab.Pos)
+        return 0
+
+    # ValueAllocationPlan
+    def HasValueType(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(10))
+        if o != 0:
+            return bool(self._tab.Get(flatbuffers.number_types.BoolFlags, o + self._tab.Pos))
+        return False
+
+    # ValueAllocationPlan
+    def ProgramCounterStarts(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(12))
+        if o != 0:
+            a = self._tab.Vector(o)
+            return self._tab.Get(flatbuffers.number_types.Uint64Flags, a + flatbuffers.number_types.UOffsetTFlags.py_type(j * 8))
+        return 0
+
+    # ValueAllocationPlan
+    def ProgramCounterStartsAsNumpy(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(12))
+        if o != 0:
+            return self._tab.GetVectorAsNumpy(flatbuffers.number_types.Uint64Flags, o)
+        return 0
+
+    # ValueAllocationPlan
+    def ProgramCounterStartsLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(12))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # ValueAllocationPlan
+    def ProgramCounterStartsIsNone(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(12))
+        return o == 0
+
+    # ValueAllocationPlan
+    def ProgramCounterEnds(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(14))
+        if o != 0:
+            a = self._tab.Vector(o)
+            return self._tab.Get(flatbuffers.number_types.Uint64Flags, a + flatbuffers.number_types.UOffsetTFlags.py_type(j * 8))
+        return 0
+
+    # ValueAllocationPlan
+    def ProgramCounterEndsAsNumpy(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(14))
+        if o != 0:
+            return self._tab.GetVectorAsNumpy(flatbuffers.number_types.Uint64Flags, o)
+        return 0
+
+    # ValueAllocationPlan
+    def ProgramCounterEndsLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(14))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # ValueAllocationPlan
+    def ProgramCounterEndsIsNone(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(14))
+        return o == 0
+
+def ValueAllocationPlanStart(builder):
+    builder.StartObject(6)
+
+def Start(builder):
+    ValueAllocationPlanStart(builder)
+
+def ValueAllocationPlanAddAllocKind(builder, allocKind):
+    builder.PrependInt8Slot(0, allocKind, 0)
+
+def AddAllocKind(builder, allocKind):
+    ValueAllocationPlanAddAllocKind(builder, allocKind)
+
+def ValueAllocationPlanAddLocation(builder, location):
+    builder.PrependUOffsetTRelativeSlot(1, flatbuffers.number_types.UOffsetTFlags.py_type(location), 0)
+
+def AddLocation(builder, location):
+    ValueAllocationPlanAddLocation(builder, location)
+
+def ValueAllocationPlanAddReusedBuffer(builder, reusedBuffer):
+    builder.PrependInt32Slot(2, reusedBuffer, 0)
+
+def AddReusedBuffer(builder, reusedBuffer):
+    ValueAllocationPlanAddReusedBuffer(builder, reusedBuffer)
+
+def ValueAllocationPlanAddHasValueType(builder, hasValueType):
+    builder.PrependBoolSlot(3, hasValueType, 0)
+
+def AddHasValueType(builder, hasValueType):
+    ValueAllocationPlanAddHasValueType(builder, hasValueType)
+
+def ValueAllocationPlanAddProgramCounterStarts(builder, programCounterStarts):
+    builder.PrependUOffsetTRelativeSlot(4, flatbuffers.number_types.UOffsetTFlags.py_type(programCounterStarts), 0)
+
+def AddProgramCounterStarts(builder, programCounterStarts):
+    ValueAllocationPlanAddProgramCounterStarts(builder, programCounterStarts)
+
+def ValueAllocationPlanStartProgramCounterStartsVector(builder, numElems):
+    return builder.StartVector(8, numElems, 8)
+
+def StartProgramCounterStartsVector(builder, numElems: int) -> int:
+    return ValueAllocationPlanStartProgramCounterStartsVector(builder, numElems)
+
+def ValueAllocationPlanAddProgramCounterEnds(builder, programCounterEnds):
+    builder.PrependUOffsetTRelativeSlot(5, flatbuffers.number_types.UOffsetTFlags.py_type(programCounterEnds), 0)
+
+def AddProgramCounterEnds(builder, programCounterEnds):
+    ValueAllocationPlanAddProgramCounterEnds(builder, programCounterEnds)
+
+def ValueAllocationPlanStartProgramCounterEndsVector(builder, numElems):
+    return builder.StartVector(8, numElems, 8)
+
+def StartProgramCounterEndsVector(builder, numElems: int) -> int:
+    return ValueAllocationPlanStartProgramCounterEndsVector(builder, numElems)
+
+def ValueAllocationPlanEnd(builder):
+    return builder.EndObject()
+
+def End(builder):
+    return ValueAllocationPlanEnd(builder)
@@ -105,6 +105,18 @@ struct OpIdKernelTypeStrArgsEntryBuilder;
 struct KernelTypeStrResolver;
 struct KernelTypeStrResolverBuilder;
 
+struct DeviceLocation;
+struct DeviceLocationBuilder;
+
+struct ValueAllocationPlan;
+struct ValueAllocationPlanBuilder;
+
+struct ExecutionProviderDevice;
+struct ExecutionProviderDeviceBuilder;
+
+struct ExecutionPlan;
+struct ExecutionPlanBuilder;
+
 struct InferenceSession;
 struct InferenceSessionBuilder;
 
@@ -2971,12 +2983,486 @@ inline ::flatbuffers::Offset<KernelTypeStrResolver> CreateKernelTypeStrResolverD
       op_kernel_type_str_args__);
 }
 
+/// location of an allocation, see OrtDevice in <repo root>/include/onnxruntime/core/framework/ortdevice.h
+struct DeviceLocation FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef DeviceLocationBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_DEVICE_TYPE = 4,
+    VT_MEMORY_TYPE = 6,
+    VT_DEVICE_ID = 8
+  };
+  int8_t device_type() const {
+    return GetField<int8_t>(VT_DEVICE_TYPE, 0);
+  }
+  int8_t memory_type() const {
+    return GetField<int8_t>(VT_MEMORY_TYPE, 0);
+  }
+  int16_t device_id() const {
+    return GetField<int16_t>(VT_DEVICE_ID, 0);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<int8_t>(verifier, VT_DEVICE_TYPE, 1) &&
+           VerifyField<int8_t>(verifier, VT_MEMORY_TYPE, 1) &&
+           VerifyField<int16_t>(verifier, VT_DEVICE_ID, 2) &&
+           verifier.EndTable();
+  }
+};
+
+struct DeviceLocationBuilder {
+  typedef DeviceLocation Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_device_type(int8_t device_type) {
+    fbb_.AddElement<int8_t>(DeviceLocation::VT_DEVICE_TYPE, device_type, 0);
+  }
+  void add_memory_type(int8_t memory_type) {
+    fbb_.AddElement<int8_t>(DeviceLocation::VT_MEMORY_TYPE, memory_type, 0);
+  }
+  void add_device_id(int16_t device_id) {
+    fbb_.AddElement<int16_t>(DeviceLocation::VT_DEVICE_ID, device_id, 0);
+  }
+  explicit DeviceLocationBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<DeviceLocation> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<DeviceLocation>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<DeviceLocation> CreateDeviceLocation(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    int8_t device_type = 0,
+    int8_t memory_type = 0,
+    int16_t device_id = 0) {
+  DeviceLocationBuilder builder_(_fbb);
+  builder_.add_device_id(device_id);
+  builder_.add_memory_type(memory_type);
+  builder_.add_device_type(device_type);
+  return builder_.Finish();
+}
+
+/// allocation plan of an OrtValue
+/// see AllocPlanPerValue in <repo root>/onnxruntime/core/framework/sequential_execution_plan.h
+struct ValueAllocationPlan FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef ValueAllocationPlanBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_ALLOC_KIND = 4,
+    VT_LOCATION = 6,
+    VT_REUSED_BUFFER = 8,
+    VT_HAS_VALUE_TYPE = 10,
+    VT_PROGRAM_COUNTER_STARTS = 12,
+    VT_PROGRAM_COUNTER_ENDS = 14,
+    VT_IS_INPLACE_REUSE = 16
+  };
+  int8_t alloc_kind() const {
+    return GetField<int8_t>(VT_ALLOC_KIND, 0);
+  }
+  const onnxruntime::fbs::DeviceLocation *location() const {
+    return GetPointer<const onnxruntime::fbs::DeviceLocation *>(VT_LOCATION);
+  }
+  int32_t reused_buffer() const {
+    return GetField<int32_t>(VT_REUSED_BUFFER, 0);
+  }
+  bool has_value_type() const {
+    return GetField<uint8_t>(VT_HAS_VALUE_TYPE, 0) != 0;
+  }
+  const ::flatbuffers::Vector<uint64_t> *program_counter_starts() const {
+    return GetPointer<const ::flatbuffers::Vector<uint64_t> *>(VT_PROGRAM_COUNTER_STARTS);
+  }
+  const ::flatbuffers::Vector<uint64_t> *program_counter_ends() const {
+    return GetPointer<const ::flatbuffers::Vector<uint64_t> *>(VT_PROGRAM_COUNTER_ENDS);
+  }
+  bool is_inplace_reuse() const {
+    return GetField<uint8_t>(VT_IS_INPLACE_REUSE, 0) != 0;
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<int8_t>(verifier, VT_ALLOC_KIND, 1) &&
+           VerifyOffset(verifier, VT_LOCATION) &&
+           verifier.VerifyTable(location()) &&
+           VerifyField<int32_t>(verifier, VT_REUSED_BUFFER, 4) &&
+           VerifyField<uint8_t>(verifier, VT_HAS_VALUE_TYPE, 1) &&
+           VerifyOffset(verifier, VT_PROGRAM_COUNTER_STARTS) &&
+           verifier.VerifyVector(program_counter_starts()) &&
+           VerifyOffset(verifier, VT_PROGRAM_COUNTER_ENDS) &&
+           verifier.VerifyVector(program_counter_ends()) &&
+           VerifyField<uint8_t>(verifier, VT_IS_INPLACE_REUSE, 1) &&
+           verifier.EndTable();
+  }
+};
+
+struct ValueAllocationPlanBuilder {
+  typedef ValueAllocationPlan Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_alloc_kind(int8_t alloc_kind) {
+    fbb_.AddElement<int8_t>(ValueAllocationPlan::VT_ALLOC_KIND, alloc_kind, 0);
+  }
+  void add_location(::flatbuffers::Offset<onnxruntime::fbs::DeviceLocation> location) {
+    fbb_.AddOffset(ValueAllocationPlan::VT_LOCATION, location);
+  }
+  void add_reused_buffer(int32_t reused_buffer) {
+    fbb_.AddElement<int32_t>(ValueAllocationPlan::VT_REUSED_BUFFER, reused_buffer, 0);
+  }
+  void add_has_value_type(bool has_value_type) {
+    fbb_.AddElement<uint8_t>(ValueAllocationPlan::VT_HAS_VALUE_TYPE, static_cast<uint8_t>(has_value_type), 0);
+  }
+  void add_program_counter_starts(::flatbuffers::Offset<::flatbuffers::Vector<uint64_t>> program_counter_starts) {
+    fbb_.AddOffset(ValueAllocationPlan::VT_PROGRAM_COUNTER_STARTS, program_counter_starts);
+  }
+  void add_program_counter_ends(::flatbuffers::Offset<::flatbuffers::Vector<uint64_t>> program_counter_ends) {
+    fbb_.AddOffset(ValueAllocationPlan::VT_PROGRAM_COUNTER_ENDS, program_counter_ends);
+  }
+  void add_is_inplace_reuse(bool is_inplace_reuse) {
+    fbb_.AddElement<uint8_t>(ValueAllocationPlan::VT_IS_INPLACE_REUSE, static_cast<uint8_t>(is_inplace_reuse), 0);
+  }
+  explicit ValueAllocationPlanBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<ValueAllocationPlan> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<ValueAllocationPlan>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<ValueAllocationPlan> CreateValueAllocationPlan(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    int8_t alloc_kind = 0,
+    ::flatbuffers::Offset<onnxruntime::fbs::DeviceLocation> location = 0,
+    int32_t reused_buffer = 0,
+    bool has_value_type = false,
+    ::flatbuffers::Offset<::flatbuffers::Vector<uint64_t>> program_counter_starts = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<uint64_t>> program_counter_ends = 0,
+    bool is_inplace_reuse = false) {
+  ValueAllocationPlanBuilder builder_(_fbb);
+  builder_.add_program_counter_ends(program_counter_ends);
+  builder_.add_program_counter_starts(program_counter_starts);
+  builder_.add_reused_buffer(reused_buffer);
+  builder_.add_location(location);
+  builder_.add_is_inplace_reuse(is_inplace_reuse);
+  builder_.add_has_value_type(has_value_type);
+  builder_.add_alloc_kind(alloc_kind);
+  return builder_.Finish();
+}
+
+inline ::flatbuffers::Offset<ValueAllocationPlan> CreateValueAllocationPlanDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    int8_t alloc_kind = 0,
+    ::flatbuffers::Offset<onnxruntime::fbs::DeviceLocation> location = 0,
+    int32_t reused_buffer = 0,
+    bool has_value_type = false,
+    const std::vector<uint64_t> *program_counter_starts = nullptr,
+    const std::vector<uint64_t> *program_counter_ends = nullptr,
+    bool is_inplace_reuse = false) {
+  auto program_counter_starts__ = program_counter_starts ? _fbb.CreateVector<uint64_t>(*program_counter_starts) : 0;
+  auto program_counter_ends__ = program_counter_ends ? _fbb.CreateVector<uint64_t>(*program_counter_ends) : 0;
+  return onnxruntime::fbs::CreateValueAllocationPlan(
+      _fbb,
+      alloc_kind,
+      location,
+      reused_buffer,
+      has_value_type,
+      program_counter_starts__,
+      program_counter_ends__,
+      is_inplace_reuse);
+}
+
+/// default device of an execution provider
+struct ExecutionProviderDevice FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef ExecutionProviderDeviceBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_EXECUTION_PROVIDER = 4,
+    VT_DEVICE = 6
+  };
+  const ::flatbuffers::String *execution_provider() const {
+    return GetPointer<const ::flatbuffers::String *>(VT_EXECUTION_PROVIDER);
+  }
+  const onnxruntime::fbs::DeviceLocation *device() const {
+    return GetPointer<const onnxruntime::fbs::DeviceLocation *>(VT_DEVICE);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_EXECUTION_PROVIDER) &&
+           verifier.VerifyString(execution_provider()) &&
+           VerifyOffset(verifier, VT_DEVICE) &&
+           verifier.VerifyTable(device()) &&
+           verifier.EndTable();
+  }
+};
+
+struct ExecutionProviderDeviceBuilder {
+  typedef ExecutionProviderDevice Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_execution_provider(::flatbuffers::Offset<::flatbuffers::String> execution_provider) {
+    fbb_.AddOffset(ExecutionProviderDevice::VT_EXECUTION_PROVIDER, execution_provider);
+  }
+  void add_device(::flatbuffers::Offset<onnxruntime::fbs::DeviceLocation> device) {
+    fbb_.AddOffset(ExecutionProviderDevice::VT_DEVICE, device);
+  }
+  explicit ExecutionProviderDeviceBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<ExecutionProviderDevice> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<ExecutionProviderDevice>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<ExecutionProviderDevice> CreateExecutionProviderDevice(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    ::flatbuffers::Offset<::flatbuffers::String> execution_provider = 0,
+    ::flatbuffers::Offset<onnxruntime::fbs::DeviceLocation> device = 0) {
+  ExecutionProviderDeviceBuilder builder_(_fbb);
+  builder_.add_device(device);
+  builder_.add_execution_provider(execution_provider);
+  return builder_.Finish();
+}
+
+inline ::flatbuffers::Offset<ExecutionProviderDevice> CreateExecutionProviderDeviceDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    const char *execution_provider = nullptr,
+    ::flatbuffers::Offset<onnxruntime::fbs::DeviceLocation> device = 0) {
+  auto execution_provider__ = execution_provider ? _fbb.CreateString(execution_provider) : 0;
+  return onnxruntime::fbs::CreateExecutionProviderDevice(
+      _fbb,
+      execution_provider__,
+      device);
+}
+
+/// execution plan of the main graph of a session that runs all nodes on one stream
+/// see SequentialExecutionPlan in <repo root>/onnxruntime/core/framework/sequential_execution_plan.h
+struct ExecutionPlan FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef ExecutionPlanBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_EXECUTION_PROVIDERS = 4,
+    VT_NODE_EXECUTION_PROVIDERS = 6,
+    VT_EXECUTION_MODE = 8,
+    VT_EXECUTION_ORDER = 10,
+    VT_ENABLE_MEM_REUSE = 12,
+    VT_VALUE_NAMES = 14,
+    VT_ALLOCATION_PLAN = 16,
+    VT_INITIALIZER_ALLOCATION_ORDER = 18,
+    VT_ACTIVATION_ALLOCATION_ORDER = 20,
+    VT_STREAM_DEVICE = 22,
+    VT_NODE_ORDER = 24,
+    VT_RELEASE_VALUE_INDICES = 26,
+    VT_RELEASE_NODE_INDICES = 28
+  };
+  const ::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::ExecutionProviderDevice>> *execution_providers() const {
+    return GetPointer<const ::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::ExecutionProviderDevice>> *>(VT_EXECUTION_PROVIDERS);
+  }
+  const ::flatbuffers::Vector<::flatbuffers::Offset<::flatbuffers::String>> *node_execution_providers() const {
+    return GetPointer<const ::flatbuffers::Vector<::flatbuffers::Offset<::flatbuffers::String>> *>(VT_NODE_EXECUTION_PROVIDERS);
+  }
+  int32_t execution_mode() const {
+    return GetField<int32_t>(VT_EXECUTION_MODE, 0);
+  }
+  int32_t execution_order() const {
+    return GetField<int32_t>(VT_EXECUTION_ORDER, 0);
+  }
+  bool enable_mem_reuse() const {
+    return GetField<uint8_t>(VT_ENABLE_MEM_REUSE, 0) != 0;
+  }
+  const ::flatbuffers::Vector<::flatbuffers::Offset<::flatbuffers::String>> *value_names() const {
+    return GetPointer<const ::flatbuffers::Vector<::flatbuffers::Offset<::flatbuffers::String>> *>(VT_VALUE_NAMES);
+  }
+  const ::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::ValueAllocationPlan>> *allocation_plan() const {
+    return GetPointer<const ::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::ValueAllocationPlan>> *>(VT_ALLOCATION_PLAN);
+  }
+  const ::flatbuffers::Vector<int32_t> *initializer_allocation_order() const {
+    return GetPointer<const ::flatbuffers::Vector<int32_t> *>(VT_INITIALIZER_ALLOCATION_ORDER);
+  }
+  const ::flatbuffers::Vector<int32_t> *activation_allocation_order() const {
+    return GetPointer<const ::flatbuffers::Vector<int32_t> *>(VT_ACTIVATION_ALLOCATION_ORDER);
+  }
+  const onnxruntime::fbs::DeviceLocation *stream_device() const {
+    return GetPointer<const onnxruntime::fbs::DeviceLocation *>(VT_STREAM_DEVICE);
+  }
+  const ::flatbuffers::Vector<uint32_t> *node_order() const {
+    return GetPointer<const ::flatbuffers::Vector<uint32_t> *>(VT_NODE_ORDER);
+  }
+  const ::flatbuffers::Vector<uint32_t> *release_value_indices() const {
+    return GetPointer<const ::flatbuffers::Vector<uint32_t> *>(VT_RELEASE_VALUE_INDICES);
+  }
+  const ::flatbuffers::Vector<uint32_t> *release_node_indices() const {
+    return GetPointer<const ::flatbuffers::Vector<uint32_t> *>(VT_RELEASE_NODE_INDICES);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_EXECUTION_PROVIDERS) &&
+           verifier.VerifyVector(execution_providers()) &&
+           verifier.VerifyVectorOfTables(execution_providers()) &&
+           VerifyOffset(verifier, VT_NODE_EXECUTION_PROVIDERS) &&
+           verifier.VerifyVector(node_execution_providers()) &&
+           verifier.VerifyVectorOfStrings(node_execution_providers()) &&
+           VerifyField<int32_t>(verifier, VT_EXECUTION_MODE, 4) &&
+           VerifyField<int32_t>(verifier, VT_EXECUTION_ORDER, 4) &&
+           VerifyField<uint8_t>(verifier, VT_ENABLE_MEM_REUSE, 1) &&
+           VerifyOffset(verifier, VT_VALUE_NAMES) &&
+           verifier.VerifyVector(value_names()) &&
+           verifier.VerifyVectorOfStrings(value_names()) &&
+           VerifyOffset(verifier, VT_ALLOCATION_PLAN) &&
+           verifier.VerifyVector(allocation_plan()) &&
+           verifier.VerifyVectorOfTables(allocation_plan()) &&
+           VerifyOffset(verifier, VT_INITIALIZER_ALLOCATION_ORDER) &&
+           verifier.VerifyVector(initializer_allocation_order()) &&
+           VerifyOffset(verifier, VT_ACTIVATION_ALLOCATION_ORDER) &&
+           verifier.VerifyVector(activation_allocation_order()) &&
+           VerifyOffset(verifier, VT_STREAM_DEVICE) &&
+           verifier.VerifyTable(stream_device()) &&
+           VerifyOffset(verifier, VT_NODE_ORDER) &&
+           verifier.VerifyVector(node_order()) &&
+           VerifyOffset(verifier, VT_RELEASE_VALUE_INDICES) &&
+           verifier.VerifyVector(release_value_indices()) &&
+           VerifyOffset(verifier, VT_RELEASE_NODE_INDICES) &&
+           verifier.VerifyVector(release_node_indices()) &&
+           verifier.EndTable();
+  }
+};
+
+struct ExecutionPlanBuilder {
+  typedef ExecutionPlan Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_execution_providers(::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::ExecutionProviderDevice>>> execution_providers) {
+    fbb_.AddOffset(ExecutionPlan::VT_EXECUTION_PROVIDERS, execution_providers);
+  }
+  void add_node_execution_providers(::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<::flatbuffers::String>>> node_execution_providers) {
+    fbb_.AddOffset(ExecutionPlan::VT_NODE_EXECUTION_PROVIDERS, node_execution_providers);
+  }
+  void add_execution_mode(int32_t execution_mode) {
+    fbb_.AddElement<int32_t>(ExecutionPlan::VT_EXECUTION_MODE, execution_mode, 0);
+  }
+  void add_execution_order(int32_t execution_order) {
+    fbb_.AddElement<int32_t>(ExecutionPlan::VT_EXECUTION_ORDER, execution_order, 0);
+  }
+  void add_enable_mem_reuse(bool enable_mem_reuse) {
+    fbb_.AddElement<uint8_t>(ExecutionPlan::VT_ENABLE_MEM_REUSE, static_cast<uint8_t>(enable_mem_reuse), 0);
+  }
+  void add_value_names(::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<::flatbuffers::String>>> value_names) {
+    fbb_.AddOffset(ExecutionPlan::VT_VALUE_NAMES, value_names);
+  }
+  void add_allocation_plan(::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::ValueAllocationPlan>>> allocation_plan) {
+    fbb_.AddOffset(ExecutionPlan::VT_ALLOCATION_PLAN, allocation_plan);
+  }
+  void add_initializer_allocation_order(::flatbuffers::Offset<::flatbuffers::Vector<int32_t>> initializer_allocation_order) {
+    fbb_.AddOffset(ExecutionPlan::VT_INITIALIZER_ALLOCATION_ORDER, initializer_allocation_order);
+  }
+  void add_activation_allocation_order(::flatbuffers::Offset<::flatbuffers::Vector<int32_t>> activation_allocation_order) {
+    fbb_.AddOffset(ExecutionPlan::VT_ACTIVATION_ALLOCATION_ORDER, activation_allocation_order);
+  }
+  void add_stream_device(::flatbuffers::Offset<onnxruntime::fbs::DeviceLocation> stream_device) {
+    fbb_.AddOffset(ExecutionPlan::VT_STREAM_DEVICE, stream_device);
+  }
+  void add_node_order(::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> node_order) {
+    fbb_.AddOffset(ExecutionPlan::VT_NODE_ORDER, node_order);
+  }
+  void add_release_value_indices(::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> release_value_indices) {
+    fbb_.AddOffset(ExecutionPlan::VT_RELEASE_VALUE_INDICES, release_value_indices);
+  }
+  void add_release_node_indices(::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> release_node_indices) {
+    fbb_.AddOffset(ExecutionPlan::VT_RELEASE_NODE_INDICES, release_node_indices);
+  }
+  explicit ExecutionPlanBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<ExecutionPlan> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<ExecutionPlan>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<ExecutionPlan> CreateExecutionPlan(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    ::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::ExecutionProviderDevice>>> execution_providers = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<::flatbuffers::String>>> node_execution_providers = 0,
+    int32_t execution_mode = 0,
+    int32_t execution_order = 0,
+    bool enable_mem_reuse = false,
+    ::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<::flatbuffers::String>>> value_names = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::ValueAllocationPlan>>> allocation_plan = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<int32_t>> initializer_allocation_order = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<int32_t>> activation_allocation_order = 0,
+    ::flatbuffers::Offset<onnxruntime::fbs::DeviceLocation> stream_device = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> node_order = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> release_value_indices = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> release_node_indices = 0) {
+  ExecutionPlanBuilder builder_(_fbb);
+  builder_.add_release_node_indices(release_node_indices);
+  builder_.add_release_value_indices(release_value_indices);
+  builder_.add_node_order(node_order);
+  builder_.add_stream_device(stream_device);
+  builder_.add_activation_allocation_order(activation_allocation_order);
+  builder_.add_initializer_allocation_order(initializer_allocation_order);
+  builder_.add_allocation_plan(allocation_plan);
+  builder_.add_value_names(value_names);
+  builder_.add_execution_order(execution_order);
+  builder_.add_execution_mode(execution_mode);
+  builder_.add_node_execution_providers(node_execution_providers);
+  builder_.add_execution_providers(execution_providers);
+  builder_.add_enable_mem_reuse(enable_mem_reuse);
+  return builder_.Finish();
+}
+
+inline ::flatbuffers::Offset<ExecutionPlan> CreateExecutionPlanDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<::flatbuffers::Offset<onnxruntime::fbs::ExecutionProviderDevice>> *execution_providers = nullptr,
+    const std::vector<::flatbuffers::Offset<::flatbuffers::String>> *node_execution_providers = nullptr,
+    int32_t execution_mode = 0,
+    int32_t execution_order = 0,
+    bool enable_mem_reuse = false,
+    const std::vector<::flatbuffers::Offset<::flatbuffers::String>> *value_names = nullptr,
+    const std::vector<::flatbuffers::Offset<onnxruntime::fbs::ValueAllocationPlan>> *allocation_plan = nullptr,
+    const std::vector<int32_t> *initializer_allocation_order = nullptr,
+    const std::vector<int32_t> *activation_allocation_order = nullptr,
+    ::flatbuffers::Offset<onnxruntime::fbs::DeviceLocation> stream_device = 0,
+    const std::vector<uint32_t> *node_order = nullptr,
+    const std::vector<uint32_t> *release_value_indices = nullptr,
+    const std::vector<uint32_t> *release_node_indices = nullptr) {
+  auto execution_providers__ = execution_providers ? _fbb.CreateVector<::flatbuffers::Offset<onnxruntime::fbs::ExecutionProviderDevice>>(*execution_providers) : 0;
+  auto node_execution_providers__ = node_execution_providers ? _fbb.CreateVector<::flatbuffers::Offset<::flatbuffers::String>>(*node_execution_providers) : 0;
+  auto value_names__ = value_names ? _fbb.CreateVector<::flatbuffers::Offset<::flatbuffers::String>>(*value_names) : 0;
+  auto allocation_plan__ = allocation_plan ? _fbb.CreateVector<::flatbuffers::Offset<onnxruntime::fbs::ValueAllocationPlan>>(*allocation_plan) : 0;
+  auto initializer_allocation_order__ = initializer_allocation_order ? _fbb.CreateVector<int32_t>(*initializer_allocation_order) : 0;
+  auto activation_allocation_order__ = activation_allocation_order ? _fbb.CreateVector<int32_t>(*activation_allocation_order) : 0;
+  auto node_order__ = node_order ? _fbb.CreateVector<uint32_t>(*node_order) : 0;
+  auto release_value_indices__ = release_value_indices ? _fbb.CreateVector<uint32_t>(*release_value_indices) : 0;
+  auto release_node_indices__ = release_node_indices ? _fbb.CreateVector<uint32_t>(*release_node_indices) : 0;
+  return onnxruntime::fbs::CreateExecutionPlan(
+      _fbb,
+      execution_providers__,
+      node_execution_providers__,
+      execution_mode,
+      execution_order,
+      enable_mem_reuse,
+      value_names__,
+      allocation_plan__,
+      initializer_allocation_order__,
+      activation_allocation_order__,
+      stream_device,
+      node_order__,
+      release_value_indices__,
+      release_node_indices__);
+}
+
 struct InferenceSession FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef InferenceSessionBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_ORT_VERSION = 4,
     VT_MODEL = 6,
-    VT_KERNEL_TYPE_STR_RESOLVER = 10
+    VT_KERNEL_TYPE_STR_RESOLVER = 10,
+    VT_EXECUTION_PLAN = 12
   };
   const ::flatbuffers::String *ort_version() const {
     return GetPointer<const ::flatbuffers::String *>(VT_ORT_VERSION);
@@ -2987,6 +3473,9 @@ struct InferenceSession FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   const onnxruntime::fbs::KernelTypeStrResolver *kernel_type_str_resolver() const {
     return GetPointer<const onnxruntime::fbs::KernelTypeStrResolver *>(VT_KERNEL_TYPE_STR_RESOLVER);
   }
+  const onnxruntime::fbs::ExecutionPlan *execution_plan() const {
+    return GetPointer<const onnxruntime::fbs::ExecutionPlan *>(VT_EXECUTION_PLAN);
+  }
   bool Verify(::flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_ORT_VERSION) &&
@@ -2995,6 +3484,8 @@ struct InferenceSession FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
            verifier.VerifyTable(model()) &&
            VerifyOffset(verifier, VT_KERNEL_TYPE_STR_RESOLVER) &&
            verifier.VerifyTable(kernel_type_str_resolver()) &&
+           VerifyOffset(verifier, VT_EXECUTION_PLAN) &&
+           verifier.VerifyTable(execution_plan()) &&
            verifier.EndTable();
   }
 };
@@ -3012,6 +3503,9 @@ struct InferenceSessionBuilder {
   void add_kernel_type_str_resolver(::flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver) {
     fbb_.AddOffset(InferenceSession::VT_KERNEL_TYPE_STR_RESOLVER, kernel_type_str_resolver);
   }
+  void add_execution_plan(::flatbuffers::Offset<onnxruntime::fbs::ExecutionPlan> execution_plan) {
+    fbb_.AddOffset(InferenceSession::VT_EXECUTION_PLAN, execution_plan);
+  }
   explicit InferenceSessionBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -3027,8 +3521,10 @@ inline ::flatbuffers::Offset<InferenceSession> CreateInferenceSession(
     ::flatbuffers::FlatBufferBuilder &_fbb,
     ::flatbuffers::Offset<::flatbuffers::String> ort_version = 0,
     ::flatbuffers::Offset<onnxruntime::fbs::Model> model = 0,
-    ::flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0) {
+    ::flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0,
+    ::flatbuffers::Offset<onnxruntime::fbs::ExecutionPlan> execution_plan = 0) {
   InferenceSessionBuilder builder_(_fbb);
+  builder_.add_execution_plan(execution_plan);
   builder_.add_kernel_type_str_resolver(kernel_type_str_resolver);
   builder_.add_model(model);
   builder_.add_ort_version(ort_version);
@@ -3039,13 +3535,15 @@ inline ::flatbuffers::Offset<InferenceSession> CreateInferenceSessionDirect(
     ::flatbuffers::FlatBufferBuilder &_fbb,
     const char *ort_version = nullptr,
     ::flatbuffers::Offset<onnxruntime::fbs::Model> model = 0,
-    ::flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0) {
+    ::flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0,
+    ::flatbuffers::Offset<onnxruntime::fbs::ExecutionPlan> execution_plan = 0) {
   auto ort_version__ = ort_version ? _fbb.CreateString(ort_version) : 0;
   return onnxruntime::fbs::CreateInferenceSession(
       _fbb,
       ort_version__,
       model,
-      kernel_type_str_resolver);
+      kernel_type_str_resolver,
+      execution_plan);
 }
 
 inline bool VerifyTypeInfoValue(::flatbuffers::Verifier &verifier, const void *obj, TypeInfoValue type) {
@@ -98,6 +98,7 @@ std::ostream& operator<<(std::ostream& out, std::pair<const SequentialExecutionP
       auto& elt_plan = plan.allocation_plan[index];
       out << elt_plan.alloc_kind;
       if (elt_plan.alloc_kind == AllocKind::kReuse) out << " " << elt_plan.reused_buffer;
+      if (elt_plan.is_inplace_reuse) out << " (in-place)";
       auto& loc = elt_plan.location;
       out << ", " << loc.ToString();
     } else {
@@ -304,13 +305,16 @@ class PlannerImpl {
 #endif
 
   // Find if there exists some input tensor that we can use in-place for output_arg_num-th output in the node.
+  // is_inplace_reuse is set if the input is reused because the kernel allows it with MayInplace, rather than
+  // because the output must alias it.
   bool FindReusableInput(const GraphViewer& graph, const onnxruntime::Node& node, int output_arg_num,
-                         OrtValueIndex* reusable_input, bool* is_strided_tensor) {
+                         OrtValueIndex* reusable_input, bool* is_strided_tensor, bool* is_inplace_reuse) {
 #if defined(ORT_MINIMAL_BUILD) && !defined(ORT_EXTENDED_MINIMAL_BUILD)
     ORT_UNUSED_PARAMETER(graph);
 #endif
 
     *is_strided_tensor = false;
+    *is_inplace_reuse = false;
 #ifdef ENABLE_TRAINING
     // Inputs of Yields are essentially the outputs for FW partial subgraph
     // These tensors will be passed back to pytorch, thus cannot share the buffer with other tensors
@@ -403,6 +407,7 @@ class PlannerImpl {
                 if (SameSize(*p_input_arg, *p_output_arg)) {
                   // we can reuse this input since it is its last use and permitted for in-place update
                   *reusable_input = input_arg_index;  // or original; both should be okay
+                  *is_inplace_reuse = true;
                   return true;
                 }
               } else {
@@ -1293,6 +1298,7 @@ class PlannerImpl {
                     if (value_consumer_map[input_arg_index].size() == 1 && SameSize(*p_input_arg, *p_output_arg)) {
                       allocation_plan[output_idx_global].alloc_kind = AllocKind::kReuse;
                       allocation_plan[output_idx_global].reused_buffer = input_arg_index;
+                      allocation_plan[output_idx_global].is_inplace_reuse = true;
                       value_consumer_map[input_arg_index].insert(value_consumer_map[output_idx_global].begin(),
                                                                  value_consumer_map[output_idx_global].end());
                       reused.insert(input_arg_index);
@@ -1508,6 +1514,7 @@ class PlannerImpl {
         // The the OrtValue indexed by current may reuse the memory in the OrtValue indexed by reused.
         OrtValueIndex reused;
         bool is_strided_tensor = false;
+        bool is_inplace_reuse = false;
         if (has_external_outputs) {
           ORT_ENFORCE(!IsNonTensor(*node_output), "Only tensors are supported for external outputs for now.");
           AllocPlan(current).alloc_kind = AllocKind::kAllocatedExternally;
@@ -1549,12 +1556,13 @@ class PlannerImpl {
           }
         } else if (!context_->IsParallelExecutionEnabled() &&
                    FindReusableInput(graph_viewer_, *pnode, static_cast<int>(output_arg_def_index),
-                                     &reused, &is_strided_tensor)) {
+                                     &reused, &is_strided_tensor, &is_inplace_reuse)) {
           // Re-using inputs is applicable for tensors, sequence tensors,
           // and optional types if the kernel has marked certain inputs as
           // possible candidates for re-use
           Reuse(reused, current, AllocKind::kReuse);
           ort_value_info_[current].is_inplace_reuse = true;
+          AllocPlan(current).is_inplace_reuse = is_inplace_reuse;
 #ifdef ENABLE_STRIDED_TENSORS
           if (is_strided_tensor) AllocPlan(current).is_strided_tensor = true;
 #else
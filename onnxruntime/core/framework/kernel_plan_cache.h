@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/tensor_shape.h"
+
+namespace onnxruntime {
+
+/**
+ * Caches the shape dependent state of a kernel, e.g. the output shape, the broadcast offsets and the MLAS routine
+ * and its parameters, keyed by the shapes of its inputs. A kernel computes the plan once for each input shape
+ * signature and reuses it for later calls with the same shapes, which saves most of the per call overhead of
+ * kernels that are run on small tensors.
+ *
+ * The plan must only depend on the shapes of the inputs and on state of the kernel that is constant after it is
+ * constructed. The cache is thread-safe and holds a few of the most recently used plans, as the number of distinct
+ * shape signatures a node sees is usually small, e.g. one per batch size or sequence length.
+ */
+template <typename Plan>
+class KernelPlanCache {
+ public:
+  static constexpr size_t kDefaultCapacity = 8;
+
+  explicit KernelPlanCache(size_t capacity = kDefaultCapacity) : capacity_(std::max<size_t>(capacity, 1)) {}
+
+  /**
+   * Gets the plan for the given input shapes. If there is none, it is created with create_fn, which has the
+   * signature Status(Plan&). Plans are only cached if create_fn succeeds.
+   */
+  template <typename CreateFn>
+  Status GetOrCreate(std::initializer_list<const TensorShape*> shapes, CreateFn&& create_fn,
+                     std::shared_ptr<const Plan>& plan) const {
+    Key key;
+    for (const TensorShape* shape : shapes) {
+      const auto dims = shape->GetDims();
+      key.push_back(static_cast<int64_t>(dims.size()));
+      key.insert(key.end(), dims.begin(), dims.end());
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (size_t i = 0; i < entries_.size(); ++i) {
+        if (entries_[i].first == key) {
+          // Keep the most recently used plans at the front.
+          const auto entry = entries_.begin() + static_cast<std::ptrdiff_t>(i);
+          std::rotate(entries_.begin(), entry, entry + 1);
+          plan = entries_.front().second;
+          return Status::OK();
+        }
+      }
+    }
+
+    // The plan is created without holding the lock, so concurrent calls with other shapes are not blocked.
+    auto new_plan = std::make_shared<Plan>();
+    ORT_RETURN_IF_ERROR(create_fn(*new_plan));
+    plan = new_plan;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& entry : entries_) {
+      if (entry.first == key) {
+        // Another call created the plan in the meantime.
+        return Status::OK();
+      }
+    }
+    if (entries_.size() >= capacity_) {
+      entries_.pop_back();
+    }
+    entries_.emplace(entries_.begin(), std::move(key), std::move(new_plan));
+    return Status::OK();
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(KernelPlanCache);
+
+  size_t Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+
+ private:
+  // The rank of each shape followed by its dimensions.
+  using Key = InlinedVector<int64_t, 16>;
+
+  const size_t capacity_;
+  mutable std::mutex mutex_;
+  mutable std::vector<std::pair<Key, std::shared_ptr<const Plan>>> entries_;
+};
+
+}  // namespace onnxruntime
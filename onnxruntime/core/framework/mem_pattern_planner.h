@@ -16,7 +16,11 @@ limitations under the License.
 // Licensed under the MIT License.
 
 #pragma once
+#include <algorithm>
+#include <limits>
 #include <list>
+#include <numeric>
+#include <tuple>
 #include "core/common/safeint.h"
 #include "core/framework/mem_pattern.h"
 #include "core/framework/allocation_planner.h"
@@ -136,7 +140,7 @@ class MemPatternPlanner {
     std::lock_guard<std::mutex> lock(lock_);
 
     if (size == 0) {
-      allocs_.emplace_back(ml_value_idx, MemoryBlock(0, 0));
+      allocs_.emplace_back(ml_value_idx, MemoryBlock(0, 0), time_++);
       return;
     }
 
@@ -174,7 +178,7 @@ class MemPatternPlanner {
     // we only need to bounds check the addition of size to best_offset as that is the only time we extend
     // the maximum size of the buffer.
     buffer_size_ = std::max(buffer_size_, SafeInt<size_t>(best_offset) + size);
-    allocs_.emplace_back(ml_value_idx, MemoryBlock(best_offset, size));
+    allocs_.emplace_back(ml_value_idx, MemoryBlock(best_offset, size), time_++);
     std::list<int>::iterator best_fit_it = blocks_.end();
     for (auto it = blocks_.begin(); it != blocks_.end(); it++) {
       if (allocs_[*it].block_.offset_ < best_offset)
@@ -194,6 +198,7 @@ class MemPatternPlanner {
 
     for (auto it = blocks_.begin(); it != blocks_.end(); it++) {
       if (allocs_[*it].index_ == ml_value_index) {
+        allocs_[*it].free_time_ = time_++;
         blocks_.erase(it);
         break;
       }
@@ -240,6 +245,22 @@ class MemPatternPlanner {
       pattern.patterns_.insert_or_assign(alloc.index_, alloc.block_);
     }
 
+    if (!using_counters_) {
+      pattern.lower_bound_size_ = GetLowerBoundSize();
+
+      // The blocks are placed as they are traced, without knowing the ones that come later, which leaves gaps that
+      // are too small for them. Now that all the lifetimes are known, pack the blocks again and use that if it is
+      // tighter.
+      InlinedVector<MemoryBlock> packed_blocks;
+      size_t packed_peak_size = 0;
+      if (PackBlocksByLifetime(packed_blocks, packed_peak_size) && packed_peak_size < pattern.peak_size_) {
+        pattern.peak_size_ = packed_peak_size;
+        for (size_t i = 0; i < allocs_.size(); ++i) {
+          pattern.patterns_.insert_or_assign(allocs_[i].index_, packed_blocks[i]);
+        }
+      }
+    }
+
     return pattern;
   }
 
@@ -249,17 +270,119 @@ class MemPatternPlanner {
     MemoryBlock block_;
     const AllocPlanPerValue::ProgramCounter* counter_{nullptr};
     bool reuse_{false};
+    // The lifetime of the block when tracing without counters. A block that is not freed lives until the end.
+    size_t alloc_time_{0};
+    size_t free_time_{std::numeric_limits<size_t>::max()};
     OrtValueAllocationBlock() = default;
     OrtValueAllocationBlock(int index, const MemoryBlock& block) : index_(index), block_(block), reuse_{false} {}
+    OrtValueAllocationBlock(int index, const MemoryBlock& block, size_t alloc_time)
+        : index_(index), block_(block), reuse_{false}, alloc_time_(alloc_time) {}
     OrtValueAllocationBlock(int index, const AllocPlanPerValue::ProgramCounter& counter, const MemoryBlock& block)
         : index_(index), block_(block), counter_(&counter), reuse_{true} {
     }
+
+    bool OverlapsLifetime(const OrtValueAllocationBlock& other) const {
+      return alloc_time_ < other.free_time_ && other.alloc_time_ < free_time_;
+    }
   };
 
+  // Returns the largest total size of the blocks that are allocated at the same time.
+  size_t GetLowerBoundSize() const {
+    // (time, index of the allocation, whether it is the free) of the allocations and frees.
+    std::vector<std::tuple<size_t, size_t, bool>> events;
+    events.reserve(allocs_.size() * 2);
+    for (size_t i = 0; i < allocs_.size(); ++i) {
+      events.emplace_back(allocs_[i].alloc_time_, i, false);
+      if (allocs_[i].free_time_ != std::numeric_limits<size_t>::max()) {
+        events.emplace_back(allocs_[i].free_time_, i, true);
+      }
+    }
+    std::sort(events.begin(), events.end());
+
+    size_t live_size = 0;
+    size_t lower_bound_size = 0;
+    for (const auto& [time, i, is_free] : events) {
+      if (is_free) {
+        live_size -= allocs_[i].block_.size_;
+      } else {
+        live_size += allocs_[i].block_.size_;
+        lower_bound_size = std::max(lower_bound_size, live_size);
+      }
+    }
+    return lower_bound_size;
+  }
+
+  // Places the blocks offline, knowing all the lifetimes: the largest blocks are placed first, each at the offset
+  // with the smallest gap that fits it among the blocks whose lifetime overlaps with its own. Returns false if the
+  // blocks cannot be packed, i.e. if an OrtValue was traced more than once.
+  bool PackBlocksByLifetime(InlinedVector<MemoryBlock>& packed_blocks, size_t& packed_peak_size) const {
+    InlinedHashSet<int> indices;
+    for (const auto& alloc : allocs_) {
+      if (!indices.insert(alloc.index_).second) {
+        return false;
+      }
+    }
+
+    std::vector<size_t> order(allocs_.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+      return allocs_[lhs].block_.size_ > allocs_[rhs].block_.size_;
+    });
+
+    packed_blocks.assign(allocs_.size(), MemoryBlock(0, 0));
+    packed_peak_size = 0;
+    // The allocations that are placed, sorted in order of their offset.
+    std::vector<size_t> placed;
+    placed.reserve(allocs_.size());
+    for (size_t i : order) {
+      const auto& alloc = allocs_[i];
+      const size_t size = alloc.block_.size_;
+      if (size == 0) {
+        continue;
+      }
+
+      size_t current = 0;
+      size_t waste_bytes = std::numeric_limits<size_t>::max();
+      size_t best_offset = 0;
+      bool best_offset_found = false;
+      for (size_t j : placed) {
+        if (!alloc.OverlapsLifetime(allocs_[j])) {
+          continue;
+        }
+        const auto& block = packed_blocks[j];
+        if (block.offset_ >= current) {
+          auto gap = block.offset_ - current;
+          if (gap >= size && (gap - size) < waste_bytes) {
+            waste_bytes = gap - size;
+            best_offset = current;
+            best_offset_found = true;
+          }
+        }
+        current = std::max(current, block.offset_ + block.size_);
+      }
+
+      if (!best_offset_found) {
+        best_offset = current;
+      }
+
+      packed_blocks[i] = MemoryBlock(best_offset, size);
+      packed_peak_size = std::max<size_t>(packed_peak_size, SafeInt<size_t>(best_offset) + size);
+      auto insert_it = std::upper_bound(placed.begin(), placed.end(), best_offset,
+                                        [&packed_blocks](size_t offset, size_t j) {
+                                          return offset < packed_blocks[j].offset_;
+                                        });
+      placed.insert(insert_it, i);
+    }
+
+    return true;
+  }
+
   std::vector<OrtValueAllocationBlock> allocs_;
   // blocks_ the list of currently allocated memory blocks, sorted in order of their offset
   std::list<int> blocks_;
   SafeInt<size_t> buffer_size_{0};
+  // The time of the next allocation or free when tracing without counters.
+  size_t time_{0};
   bool using_counters_;
   mutable std::mutex lock_;
 };
@@ -35,6 +35,9 @@ struct AllocPlanPerValue {
   // reused_buffer is valid only if alloc_kind == kReuse. It indicates
   // which OrtValue's buffer must be reused for this OrtValue.
   OrtValueIndex reused_buffer{0};
+  // is_inplace_reuse is set if alloc_kind == kReuse and the reused buffer is that of an input of the node producing
+  // this OrtValue, which the kernel allows with MayInplace.
+  bool is_inplace_reuse{false};
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   IntervalT life_interval{0, 0};
   IntervalT allocate_interval{0, 0};
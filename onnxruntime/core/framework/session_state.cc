@@ -7,14 +7,19 @@
 
 #include <mutex>
 #include "core/common/logging/logging.h"
+#include "core/common/narrow.h"
 #include "core/common/safeint.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/allocator.h"
+#include "core/framework/execution_steps.h"
+#include "core/framework/mldata_type_utils.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/prepacked_weights_container.h"
 #include "core/framework/session_state_utils.h"
+#include "core/framework/shared_initializer_store.h"
+#include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
 #include "core/providers/cpu/controlflow/utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
@@ -529,6 +534,26 @@ Status SessionState::PrepackConstantInitializedTensors(
                     }
                   }
 
+                } else if (st->shared_initializer_names_.count(input_name) &&
+                           node.GetExecutionProviderType() == kCpuExecutionProvider &&
+                           !prepacked_for_graph->IsSaveModeOn()) {
+                  // the initializer is shared by content, so its pre-packed weights are shared in the same way
+                  SharedInitializerStore& store = SharedInitializerStore::Instance();
+                  PrePackedWeights weights_to_be_filled_in;
+                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, store.GetAllocator(),
+                                                      is_packed,
+                                                      &weights_to_be_filled_in));
+
+                  // As above, kernels that do not fill in the pre-packed weights keep their own copy.
+                  if (is_packed && !weights_to_be_filled_in.buffers_.empty()) {
+                    const std::string prepacked_weights_key = GenerateKeyForPrepackedWeightsMap(
+                        node.OpType(), weights_to_be_filled_in);
+                    auto shared_prepacked = store.GetOrAddPrePackedWeights(prepacked_weights_key,
+                                                                           std::move(weights_to_be_filled_in));
+                    ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx, *shared_prepacked,
+                                                                        node.Name()));
+                    shared_prepacked_weights_.push_back(std::move(shared_prepacked));
+                  }
                 } else {
                   // cross session caching of pre-packed weights' turned OFF
                   // we use serialization container to share weights loaded from disk
@@ -945,7 +970,16 @@ Status SessionState::UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> ten
 
   std::lock_guard<std::mutex> lock(mem_patterns_lock_);
   // Do not update if present, as the pointer to the existing one is cached
-  mem_patterns_.emplace(key, std::move(mem_patterns));
+  auto [it, inserted] = mem_patterns_.emplace(key, std::move(mem_patterns));
+  if (inserted) {
+    // Report how close the planned peak of each arena is to the lower bound of the traced lifetimes.
+    const MemoryPatternGroup& group = it->second;
+    for (size_t i = 0; i < group.locations.size(); ++i) {
+      LOGS(logger_, INFO) << "[Memory] Memory pattern for " << group.locations[i].ToString() << " plans "
+                          << group.patterns[i].PeakSize() << " bytes, the lower bound is "
+                          << group.patterns[i].LowerBoundSize() << " bytes";
+    }
+  }
   return Status::OK();
 }
 
@@ -1316,6 +1350,44 @@ static Status Index(const OrtValueNameIdxMap& ort_value_name_idx_map,
   return ort_value_name_idx_map.GetIdx(name, value);
 }
 
+static SessionState::InplaceReuseStats ComputeInplaceReuseStats(const SequentialExecutionPlan& plan,
+                                                                const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                                                const GraphViewer& graph_viewer) {
+  SessionState::InplaceReuseStats stats;
+  for (const auto& [name, index] : ort_value_name_idx_map) {
+    const auto& alloc_plan = plan.allocation_plan[static_cast<size_t>(index)];
+    if (alloc_plan.alloc_kind != AllocKind::kReuse || !alloc_plan.is_inplace_reuse) {
+      continue;
+    }
+
+    ++stats.num_values;
+
+    // a value with a symbolic shape also saves an allocation, but its size is only known at runtime
+    const NodeArg* node_arg = graph_viewer.GetNodeArg(name);
+    const auto* shape = node_arg != nullptr ? node_arg->Shape() : nullptr;
+    const auto* tensor_type = alloc_plan.value_type != nullptr ? alloc_plan.value_type->AsTensorType() : nullptr;
+    if (shape == nullptr || tensor_type == nullptr) {
+      continue;
+    }
+
+    SafeInt<size_t> num_bytes = tensor_type->GetElementType()->Size();
+    bool is_static_shape = true;
+    for (const auto& dim : shape->dim()) {
+      if (!utils::HasDimValue(dim) || dim.dim_value() < 0) {
+        is_static_shape = false;
+        break;
+      }
+      num_bytes *= dim.dim_value();
+    }
+
+    if (is_static_shape) {
+      stats.num_bytes += static_cast<size_t>(num_bytes);
+    }
+  }
+
+  return stats;
+}
+
 static bool IsNodeWhereNodeInputsAreSameAsExplicitSubgraphInputs(const Node& node) {
   const auto& op_type = node.OpType();
   int since_version = node.SinceVersion();
@@ -1435,6 +1507,290 @@ static void AccumulateAllNestedSubgraphsInfo(
   }
 }
 
+// Training builds keep additional state in the execution plan and memory profiling needs the life intervals computed
+// by the planner, so those builds always create the plan.
+#if defined(ENABLE_TRAINING) || (!defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE))
+static constexpr bool kCanUseOrtFormatExecutionPlan = false;
+#else
+static constexpr bool kCanUseOrtFormatExecutionPlan = true;
+#endif
+
+static OrtDevice LoadDeviceFromOrtFormat(const fbs::DeviceLocation& fbs_device) {
+  return OrtDevice(fbs_device.device_type(), fbs_device.memory_type(), fbs_device.device_id());
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+static flatbuffers::Offset<fbs::DeviceLocation> SaveDeviceToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
+                                                                      const OrtDevice& device) {
+  return fbs::CreateDeviceLocation(builder, device.Type(), device.MemType(), device.Id());
+}
+
+Status SessionState::SaveExecutionPlanToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
+                                                  flatbuffers::Offset<fbs::ExecutionPlan>& fbs_execution_plan) const {
+  fbs_execution_plan = 0;
+  ORT_RETURN_IF_NOT(p_seq_exec_plan_.has_value(), "The execution plan has not been created.");
+  const auto& plan = *p_seq_exec_plan_;
+
+  // A plan with a single stream and no synchronization only contains kernel launches, so the node order and the
+  // release actions describe it completely.
+  const size_t num_nodes = narrow<size_t>(graph_viewer_->NumberOfNodes());
+  const bool is_single_stream =
+      plan.execution_plan.size() <= 1 && plan.notification_owners.empty() && plan.downstream_map.empty() &&
+      plan.num_barriers == 0 &&
+      (plan.execution_plan.empty() ? num_nodes == 0 : plan.execution_plan[0]->steps_.size() == num_nodes) &&
+      std::all_of(plan.release_actions.cbegin(), plan.release_actions.cend(),
+                  [](const SequentialExecutionPlan::ReleaseAction& action) { return action.ref_count == 1; });
+  if (!kCanUseOrtFormatExecutionPlan || !is_single_stream) {
+    LOGS(logger_, INFO) << "The execution plan is not saved in the ORT format model. "
+                        << "Only plans that run all nodes on a single stream can be saved.";
+    return Status::OK();
+  }
+
+  std::vector<flatbuffers::Offset<fbs::ExecutionProviderDevice>> fbs_execution_providers;
+  fbs_execution_providers.reserve(execution_providers_.NumProviders());
+  for (const auto& ep : execution_providers_) {
+    const auto fbs_ep_type = builder.CreateString(ep->Type());
+    const auto fbs_ep_device = SaveDeviceToOrtFormat(builder, ep->GetOrtDeviceByMemType(OrtMemTypeDefault));
+    fbs_execution_providers.push_back(fbs::CreateExecutionProviderDevice(builder, fbs_ep_type, fbs_ep_device));
+  }
+
+  const NodeIndex max_node_index = narrow<NodeIndex>(graph_viewer_->MaxNodeIndex());
+  std::vector<flatbuffers::Offset<flatbuffers::String>> fbs_node_execution_providers;
+  fbs_node_execution_providers.reserve(max_node_index);
+  for (NodeIndex node_index = 0; node_index < max_node_index; ++node_index) {
+    const Node* node = graph_viewer_->GetNode(node_index);
+    fbs_node_execution_providers.push_back(
+        builder.CreateSharedString(node != nullptr ? node->GetExecutionProviderType() : std::string{}));
+  }
+
+  const size_t num_values = narrow<size_t>(ort_value_name_idx_map_.MaxIdx() + 1);
+  ORT_RETURN_IF_NOT(plan.allocation_plan.size() == num_values, "The allocation plan has ",
+                    plan.allocation_plan.size(), " entries but there are ", num_values, " OrtValues.");
+
+  std::vector<flatbuffers::Offset<flatbuffers::String>> fbs_value_names;
+  std::vector<flatbuffers::Offset<fbs::ValueAllocationPlan>> fbs_allocation_plan;
+  fbs_value_names.reserve(num_values);
+  fbs_allocation_plan.reserve(num_values);
+  std::string value_name;
+  for (size_t i = 0; i < num_values; ++i) {
+    ORT_RETURN_IF_ERROR(ort_value_name_idx_map_.GetName(static_cast<int>(i), value_name));
+    fbs_value_names.push_back(builder.CreateString(value_name));
+
+    const auto& value_plan = plan.allocation_plan[i];
+    const auto& starts = value_plan.program_counter.Starts();
+    const auto& ends = value_plan.program_counter.Ends();
+    const auto fbs_location = SaveDeviceToOrtFormat(builder, value_plan.location);
+    const auto fbs_starts = builder.CreateVector(std::vector<uint64_t>(starts.begin(), starts.end()));
+    const auto fbs_ends = builder.CreateVector(std::vector<uint64_t>(ends.begin(), ends.end()));
+    fbs_allocation_plan.push_back(fbs::CreateValueAllocationPlan(builder,
+                                                                 static_cast<int8_t>(value_plan.alloc_kind),
+                                                                 fbs_location,
+                                                                 value_plan.reused_buffer,
+                                                                 value_plan.value_type != nullptr,
+                                                                 fbs_starts, fbs_ends,
+                                                                 value_plan.is_inplace_reuse));
+  }
+
+  flatbuffers::Offset<fbs::DeviceLocation> fbs_stream_device = 0;
+  std::vector<uint32_t> node_order;
+  if (!plan.execution_plan.empty()) {
+    const auto& stream = *plan.execution_plan[0];
+    fbs_stream_device = SaveDeviceToOrtFormat(builder, stream.device_);
+    node_order.reserve(stream.steps_.size());
+    for (const auto& step : stream.steps_) {
+      node_order.push_back(narrow<uint32_t>(step->GetNodeIndex()));
+    }
+  }
+
+  std::vector<uint32_t> release_value_indices;
+  std::vector<uint32_t> release_node_indices(plan.release_actions.size());
+  release_value_indices.reserve(plan.release_actions.size());
+  for (const auto& action : plan.release_actions) {
+    release_value_indices.push_back(narrow<uint32_t>(action.value_index));
+  }
+  for (size_t node_index = 0; node_index < plan.node_release_list.size(); ++node_index) {
+    for (const size_t action_index : plan.node_release_list[node_index]) {
+      release_node_indices[action_index] = narrow<uint32_t>(node_index);
+    }
+  }
+
+  fbs_execution_plan = fbs::CreateExecutionPlanDirect(builder,
+                                                      &fbs_execution_providers,
+                                                      &fbs_node_execution_providers,
+                                                      static_cast<int32_t>(sess_options_.execution_mode),
+                                                      static_cast<int32_t>(sess_options_.execution_order),
+                                                      sess_options_.enable_mem_reuse,
+                                                      &fbs_value_names,
+                                                      &fbs_allocation_plan,
+                                                      &plan.initializer_allocation_order,
+                                                      &plan.activation_allocation_order,
+                                                      fbs_stream_device,
+                                                      &node_order,
+                                                      &release_value_indices,
+                                                      &release_node_indices);
+  return Status::OK();
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+Status SessionState::LoadExecutionPlanFromOrtFormat(const fbs::ExecutionPlan& fbs_execution_plan,
+                                                    const SessionOptions& session_options) {
+  ORT_RETURN_IF_NOT(fbs_execution_plan.execution_mode() == static_cast<int32_t>(session_options.execution_mode) &&
+                        fbs_execution_plan.execution_order() ==
+                            static_cast<int32_t>(session_options.execution_order) &&
+                        fbs_execution_plan.enable_mem_reuse() == session_options.enable_mem_reuse,
+                    "The execution plan was created with different session options.");
+  ORT_RETURN_IF_NOT(session_options.config_options.GetConfigOrDefault(kNodePartitionConfigFile, "").empty(),
+                    "A node partition config file is set.");
+
+  const auto* fbs_execution_providers = fbs_execution_plan.execution_providers();
+  ORT_RETURN_IF_NOT(fbs_execution_providers != nullptr &&
+                        fbs_execution_providers->size() == execution_providers_.NumProviders(),
+                    "The execution plan was created with different execution providers.");
+  flatbuffers::uoffset_t ep_idx = 0;
+  for (const auto& ep : execution_providers_) {
+    const auto* fbs_ep = fbs_execution_providers->Get(ep_idx++);
+    ORT_RETURN_IF_NOT(fbs_ep->execution_provider() != nullptr && fbs_ep->device() != nullptr &&
+                          fbs_ep->execution_provider()->string_view() == ep->Type() &&
+                          LoadDeviceFromOrtFormat(*fbs_ep->device()) ==
+                              ep->GetOrtDeviceByMemType(OrtMemTypeDefault),
+                      "The execution plan was created with different execution providers.");
+  }
+
+  const NodeIndex max_node_index = narrow<NodeIndex>(graph_viewer_->MaxNodeIndex());
+  const auto* fbs_node_execution_providers = fbs_execution_plan.node_execution_providers();
+  ORT_RETURN_IF_NOT(fbs_node_execution_providers != nullptr && fbs_node_execution_providers->size() == max_node_index,
+                    "The nodes of the graph do not match the execution plan.");
+  for (NodeIndex node_index = 0; node_index < max_node_index; ++node_index) {
+    const Node* node = graph_viewer_->GetNode(node_index);
+    const std::string_view ep_type = node != nullptr ? std::string_view{node->GetExecutionProviderType()}
+                                                     : std::string_view{};
+    ORT_RETURN_IF_NOT(fbs_node_execution_providers->Get(narrow<flatbuffers::uoffset_t>(node_index))->string_view() ==
+                          ep_type,
+                      "Node ", node_index, " is not assigned to the execution provider of the execution plan.");
+  }
+
+  const size_t num_values = narrow<size_t>(ort_value_name_idx_map_.MaxIdx() + 1);
+  const auto* fbs_value_names = fbs_execution_plan.value_names();
+  const auto* fbs_allocation_plan = fbs_execution_plan.allocation_plan();
+  ORT_RETURN_IF_NOT(fbs_value_names != nullptr && fbs_allocation_plan != nullptr &&
+                        fbs_value_names->size() == num_values && fbs_allocation_plan->size() == num_values,
+                    "The OrtValues of the graph do not match the execution plan.");
+
+  auto& plan = p_seq_exec_plan_.emplace();
+  plan.allocation_plan.resize(num_values);
+  std::string value_name;
+  for (size_t i = 0; i < num_values; ++i) {
+    const auto idx = narrow<flatbuffers::uoffset_t>(i);
+    ORT_RETURN_IF_ERROR(ort_value_name_idx_map_.GetName(static_cast<int>(i), value_name));
+    ORT_RETURN_IF_NOT(fbs_value_names->Get(idx)->string_view() == value_name,
+                      "The OrtValues of the graph do not match the execution plan.");
+
+    const auto& fbs_value_plan = *fbs_allocation_plan->Get(idx);
+    const int8_t alloc_kind = fbs_value_plan.alloc_kind();
+    const int32_t reused_buffer = fbs_value_plan.reused_buffer();
+    ORT_RETURN_IF_NOT(alloc_kind >= static_cast<int8_t>(AllocKind::kNotSet) &&
+                          alloc_kind <= static_cast<int8_t>(AllocKind::kAllocatedExternally) &&
+                          fbs_value_plan.location() != nullptr &&
+                          reused_buffer >= 0 && static_cast<size_t>(reused_buffer) < num_values,
+                      "Invalid allocation plan for OrtValue '", value_name, "'.");
+
+    auto& value_plan = plan.allocation_plan[i];
+    value_plan.alloc_kind = static_cast<AllocKind>(alloc_kind);
+    value_plan.location = LoadDeviceFromOrtFormat(*fbs_value_plan.location());
+    value_plan.reused_buffer = reused_buffer;
+    value_plan.is_inplace_reuse = fbs_value_plan.is_inplace_reuse();
+    if (fbs_value_plan.has_value_type()) {
+      const NodeArg* node_arg = graph_viewer_->GetNodeArg(value_name);
+      ORT_RETURN_IF(node_arg == nullptr, "OrtValue '", value_name, "' of the execution plan has no NodeArg.");
+      value_plan.value_type = utils::GetMLDataType(*node_arg);
+    }
+
+    const auto* starts = fbs_value_plan.program_counter_starts();
+    const auto* ends = fbs_value_plan.program_counter_ends();
+    const flatbuffers::uoffset_t num_intervals = starts != nullptr ? starts->size() : 0;
+    ORT_RETURN_IF_NOT(num_intervals == (ends != nullptr ? ends->size() : 0),
+                      "Invalid program counter for OrtValue '", value_name, "'.");
+    for (flatbuffers::uoffset_t j = 0; j < num_intervals; ++j) {
+      ORT_RETURN_IF_NOT(starts->Get(j) <= ends->Get(j) && (j == 0 || starts->Get(j) > ends->Get(j - 1)),
+                        "Invalid program counter for OrtValue '", value_name, "'.");
+      value_plan.program_counter.AddStart(narrow<size_t>(starts->Get(j)));
+      value_plan.program_counter.AddEnd(narrow<size_t>(ends->Get(j)));
+    }
+  }
+
+  const auto load_allocation_order = [num_values](const flatbuffers::Vector<int32_t>* fbs_order,
+                                                  std::vector<OrtValueIndex>& order) -> Status {
+    if (fbs_order != nullptr) {
+      order.reserve(fbs_order->size());
+      for (const int32_t value_index : *fbs_order) {
+        ORT_RETURN_IF_NOT(value_index >= 0 && static_cast<size_t>(value_index) < num_values,
+                          "Invalid OrtValue index ", value_index, " in the allocation order.");
+        order.push_back(value_index);
+      }
+    }
+    return Status::OK();
+  };
+  ORT_RETURN_IF_ERROR(load_allocation_order(fbs_execution_plan.initializer_allocation_order(),
+                                            plan.initializer_allocation_order));
+  ORT_RETURN_IF_ERROR(load_allocation_order(fbs_execution_plan.activation_allocation_order(),
+                                            plan.activation_allocation_order));
+
+  const size_t num_nodes = narrow<size_t>(graph_viewer_->NumberOfNodes());
+  if (num_nodes > 0) {
+    const auto* fbs_stream_device = fbs_execution_plan.stream_device();
+    const auto* fbs_node_order = fbs_execution_plan.node_order();
+    ORT_RETURN_IF_NOT(fbs_stream_device != nullptr && fbs_node_order != nullptr && fbs_node_order->size() == num_nodes,
+                      "The nodes of the graph do not match the execution plan.");
+
+    auto& stream = *plan.execution_plan.emplace_back(
+        std::make_unique<SequentialExecutionPlan::LogicStream>(LoadDeviceFromOrtFormat(*fbs_stream_device)));
+    stream.steps_.reserve(num_nodes);
+    plan.node_stream_map_.resize(SafeInt<size_t>(max_node_index) + 1);
+    InlinedVector<bool> is_scheduled(max_node_index, false);
+    for (const uint32_t node_index : *fbs_node_order) {
+      const Node* node = node_index < max_node_index ? graph_viewer_->GetNode(node_index) : nullptr;
+      ORT_RETURN_IF_NOT(node != nullptr && !is_scheduled[node_index],
+                        "Invalid node index ", node_index, " in the execution plan.");
+      is_scheduled[node_index] = true;
+#if defined(ORT_MINIMAL_BUILD)
+      stream.steps_.emplace_back(std::make_unique<LaunchKernelStep>(node_index));
+#else
+      stream.steps_.emplace_back(std::make_unique<LaunchKernelStep>(node_index, node->Name()));
+#endif
+      plan.node_stream_map_[node_index] = 0;
+
+      // The outputs of the node are produced on its stream, as in the plan created by the allocation planner.
+      for (const NodeArg* output_def : node->OutputDefs()) {
+        if (!output_def->Exists()) continue;
+        OrtValueIndex output_idx;
+        ORT_RETURN_IF_ERROR(ort_value_name_idx_map_.GetIdx(output_def->Name(), output_idx));
+        plan.value_to_stream_map[output_idx] = plan.node_stream_map_[node_index];
+      }
+    }
+  }
+
+  const auto* fbs_release_value_indices = fbs_execution_plan.release_value_indices();
+  const auto* fbs_release_node_indices = fbs_execution_plan.release_node_indices();
+  const flatbuffers::uoffset_t num_release_actions =
+      fbs_release_value_indices != nullptr ? fbs_release_value_indices->size() : 0;
+  ORT_RETURN_IF_NOT(num_release_actions ==
+                        (fbs_release_node_indices != nullptr ? fbs_release_node_indices->size() : 0),
+                    "Invalid release actions in the execution plan.");
+  plan.node_release_list.resize(SafeInt<size_t>(max_node_index) + 1);
+  plan.release_actions.reserve(num_release_actions);
+  for (flatbuffers::uoffset_t i = 0; i < num_release_actions; ++i) {
+    const uint32_t value_index = fbs_release_value_indices->Get(i);
+    const uint32_t node_index = fbs_release_node_indices->Get(i);
+    ORT_RETURN_IF_NOT(value_index < num_values && node_index < max_node_index &&
+                          graph_viewer_->GetNode(node_index) != nullptr,
+                      "Invalid release actions in the execution plan.");
+    plan.release_actions.push_back(SequentialExecutionPlan::ReleaseAction{value_index, 1});
+    plan.node_release_list[node_index].push_back(i);
+  }
+
+  return Status::OK();
+}
+
 Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_TYPE>& graph_location,
                                               const KernelRegistryManager& kernel_registry_manager,
                                               _In_opt_ const Node* parent_node,
@@ -1497,42 +1853,64 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   SubgraphsKernelCreateInfoMaps subgraphs_kernel_create_info_maps;
   AccumulateAllNestedSubgraphsInfo(*this, "", 0, subgraphs_kernel_create_info_maps);
 
-  SequentialPlannerContext context(session_options.execution_mode,
-                                   session_options.execution_order,
-                                   session_options.enable_mem_reuse);
+  // use the execution plan saved in an ORT format model if it matches this session
+  execution_plan_from_ort_format_ = false;
+  if (kCanUseOrtFormatExecutionPlan && parent_node == nullptr && fbs_execution_plan_ != nullptr) {
+    const auto status = LoadExecutionPlanFromOrtFormat(*fbs_execution_plan_, session_options);
+    if (status.IsOK()) {
+      execution_plan_from_ort_format_ = true;
+    } else {
+      LOGS(logger_, INFO) << "Creating the execution plan as the one in the ORT format model cannot be used. "
+                          << status.ErrorMessage();
+    }
+  }
+  fbs_execution_plan_ = nullptr;
+
+  if (!execution_plan_from_ort_format_) {
+    SequentialPlannerContext context(session_options.execution_mode,
+                                     session_options.execution_order,
+                                     session_options.enable_mem_reuse);
 
 #ifdef _WIN32
 
-  PathString partition_config_file =
-      ToWideString(session_options.config_options.GetConfigOrDefault(
-          kNodePartitionConfigFile, ""));
+    PathString partition_config_file =
+        ToWideString(session_options.config_options.GetConfigOrDefault(
+            kNodePartitionConfigFile, ""));
 
 #else
 
-  PathString partition_config_file =
-      session_options.config_options.GetConfigOrDefault(
-          kNodePartitionConfigFile, "");
+    PathString partition_config_file =
+        session_options.config_options.GetConfigOrDefault(
+            kNodePartitionConfigFile, "");
 
 #endif
 
-  auto status = SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
-                                              execution_providers_, kernel_create_info_map_,
-                                              subgraphs_kernel_create_info_maps,
-                                              outer_scope_node_arg_to_location_map,
-                                              ort_value_name_idx_map_, context,
+    auto status = SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
+                                                execution_providers_, kernel_create_info_map_,
+                                                subgraphs_kernel_create_info_maps,
+                                                outer_scope_node_arg_to_location_map,
+                                                ort_value_name_idx_map_, context,
 #ifdef ORT_ENABLE_STREAM
-                                              GetStreamHandleRegistryInstance(),
+                                                GetStreamHandleRegistryInstance(),
 #endif
-                                              partition_config_file,
-                                              Logger(),
-                                              p_seq_exec_plan_);
-  ORT_RETURN_IF_ERROR(status);
+                                                partition_config_file,
+                                                Logger(),
+                                                p_seq_exec_plan_);
+    ORT_RETURN_IF_ERROR(status);
+  }
 
   // Record the allocation plan
 
   // Uncomment the below to dump the allocation plan to std::cout
   // std::cout << std::make_pair(&*p_seq_exec_plan_, this);
 
+  inplace_reuse_stats_ = ComputeInplaceReuseStats(*p_seq_exec_plan_, ort_value_name_idx_map_, *graph_viewer_);
+  if (inplace_reuse_stats_.num_values > 0) {
+    LOGS(logger_, INFO) << "[Memory] " << inplace_reuse_stats_.num_values
+                        << " values reuse the buffer of a node input in-place, saving "
+                        << inplace_reuse_stats_.num_bytes << " bytes of statically shaped values";
+  }
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   GetMemoryProfiler()->Init(GetExecutionPlan(), GetOrtValueNameIdxMap());
 #endif
@@ -1594,6 +1972,11 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   }
 #endif
 
+  SharedInitializerStore* shared_initializer_store = nullptr;
+  if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsShareInitializersByContent, "0") == "1") {
+    shared_initializer_store = &SharedInitializerStore::Instance();
+  }
+
   ORT_RETURN_IF_ERROR(session_state_utils::SaveInitializedTensors(
       Env::Default(), graph_location, *graph_viewer_,
       GetAllocator(OrtDevice()),
@@ -1607,7 +1990,8 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
         return Status::OK();
       },
       logger_, data_transfer_mgr_, external_data_loader_mgr_, *p_seq_exec_plan_, session_options,
-      memory_profile_func, name_to_buffered_tensor_, graph_.GetPrepacked()));
+      memory_profile_func, name_to_buffered_tensor_, graph_.GetPrepacked(),
+      shared_initializer_store, shared_initializer_names_));
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
@@ -1628,6 +2012,10 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
                                                           session_options.initializers_to_share_map));
   }
 
+  if (shared_initializer_store != nullptr) {
+    LOGS(logger_, INFO) << shared_initializer_store->GetMemoryReport();
+  }
+
   ORT_RETURN_IF_ERROR(
       session_state_utils::SaveInputOutputNamesToNodeMapping(*graph_viewer_, *this, valid_outer_scope_node_args));
 
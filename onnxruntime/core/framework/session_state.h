@@ -50,6 +50,7 @@
 namespace onnxruntime {
 
 namespace fbs {
+struct ExecutionPlan;
 struct SessionState;
 }  // namespace fbs
 
@@ -196,6 +197,26 @@ class SessionState {
 
   const std::vector<AllocPlanPerValue>& GetPerValueAllocPlan() const;
 
+#if !defined(ORT_MINIMAL_BUILD)
+  /**
+  Save the execution plan in ORT format.
+  Only plans that run all nodes on a single stream are saved. fbs_execution_plan is left null for other plans.
+  */
+  Status SaveExecutionPlanToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
+                                      flatbuffers::Offset<fbs::ExecutionPlan>& fbs_execution_plan) const;
+#endif
+
+  /**
+  Set the execution plan of an ORT format model. FinalizeSessionState uses it instead of creating a plan for the
+  main graph if it matches the session. The flatbuffer must remain valid until FinalizeSessionState returns.
+  */
+  void SetOrtFormatExecutionPlan(const fbs::ExecutionPlan* fbs_execution_plan) noexcept {
+    fbs_execution_plan_ = fbs_execution_plan;
+  }
+
+  // true if the execution plan was loaded from an ORT format model instead of being created
+  bool IsExecutionPlanFromOrtFormat() const noexcept { return execution_plan_from_ort_format_; }
+
   /**
   Get the logger for this session.
   Falls back to returning Logging::LoggingManager::DefaultLogger if SetLogger has not been called.
@@ -251,6 +272,18 @@ class SessionState {
 
   bool GetEnableMemoryReuse() const;
 
+  struct InplaceReuseStats {
+    // the number of values that reuse the buffer of an input of the node that produces them
+    size_t num_values = 0;
+    // the bytes these values do not allocate. only values with a static shape are counted.
+    size_t num_bytes = 0;
+  };
+
+  /**
+  Get the number of values that the allocation plan computes in-place, and the bytes that saves.
+  */
+  const InplaceReuseStats& GetInplaceReuseStats() const { return inplace_reuse_stats_; }
+
   /**
   Update enable_mem_pattern_ flag according to the presence of graph inputs' shape
   If any one of the graph input is shapeless, enable_mem_pattern_ will be set to false
@@ -415,6 +448,10 @@ class SessionState {
                                   const InlinedHashMap<OrtValueName, OrtDevice>& outer_scope_node_arg_to_location_map = {},
                                   bool graph_info_already_created = false);
 
+  // Load the execution plan of the main graph. Fails if the plan does not match the session.
+  Status LoadExecutionPlanFromOrtFormat(const fbs::ExecutionPlan& fbs_execution_plan,
+                                        const SessionOptions& session_options);
+
 #ifdef ENABLE_TRAINING
   Status GeneratePatternGroupCache(
       gsl::span<const OrtValue> inputs,
@@ -429,6 +466,10 @@ class SessionState {
   // fused_funcs_mgr_ must live longer than the session_kernels_, becaues a kernel could be created from this manager
   FuncManager fused_funcs_mgr_;
 
+  // Pre-packed weights shared by content with other sessions through the SharedInitializerStore.
+  // They must live longer than the session_kernels_ that use them.
+  std::vector<std::shared_ptr<const PrePackedWeights>> shared_prepacked_weights_;
+
   // cache of the constructed kernels to avoid spending construction time per executor
   std::vector<std::unique_ptr<OpKernel>> session_kernels_;
   Graph& graph_;
@@ -489,11 +530,17 @@ class SessionState {
   InlinedHashSet<int> sparse_initialized_tensors_;
 #endif
 
+  // names of the initializers that are shared by content with other sessions through the SharedInitializerStore
+  InlinedHashSet<std::string> shared_initializer_names_;
+
   // This data structure is for uninitializing string tensors and
   // munmap memory region and close file descriptor
   InlinedHashMap<int, OrtCallback> deleter_for_initialized_tensors_;
   InlinedVector<BufferUniquePtr> weights_buffers_;
   std::optional<SequentialExecutionPlan> p_seq_exec_plan_;
+  InplaceReuseStats inplace_reuse_stats_;
+  const fbs::ExecutionPlan* fbs_execution_plan_ = nullptr;
+  bool execution_plan_from_ort_format_ = false;
 
   const logging::Logger& logger_;
   profiling::Profiler& profiler_;
@@ -276,7 +276,9 @@ common::Status SaveInitializedTensors(
     const SessionOptions& session_options,
     const MemoryProfileFunction& memory_profile_func,
     std::unordered_map<std::string, std::unique_ptr<Tensor>>& buffered_tensors,
-    PrepackedWeightsForGraph& prepacked_for_graph) {
+    PrepackedWeightsForGraph& prepacked_for_graph,
+    SharedInitializerStore* shared_initializer_store,
+    InlinedHashSet<std::string>& shared_initializer_names) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -309,10 +311,19 @@ common::Status SaveInitializedTensors(
     return retval;
   };
 
+  // Initializers shared by content are allocated by the store, as they may outlive this session.
+  auto use_shared_initializer_store = [&shared_initializer_store, &exec_plan](
+                                          int ort_value_index, const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+    return shared_initializer_store != nullptr &&
+           tensor_proto.data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING &&
+           exec_plan.GetLocation(ort_value_index) == shared_initializer_store->GetAllocator()->Info().device;
+  };
+
   // 1. first plan the memory
   const InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
   InlinedHashMap<int, const ONNX_NAMESPACE::TensorProto*> id_to_initialized_tensor;
   InlinedHashSet<int> user_supplied_initializer_ids;  // set containing the ort value ids of all user supplied initializers
+  InlinedHashSet<int> shared_initializer_ids;         // set containing the ort value ids of initializers shared by content
 
   id_to_initialized_tensor.reserve(initialized_tensor_set.size());
   user_supplied_initializer_ids.reserve(initialized_tensor_set.size());
@@ -322,6 +333,8 @@ common::Status SaveInitializedTensors(
     ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(entry.first, ort_value_index));
     if (use_user_supplied_initializer(entry.first)) {
       user_supplied_initializer_ids.insert(ort_value_index);
+    } else if (use_shared_initializer_store(ort_value_index, *entry.second)) {
+      shared_initializer_ids.insert(ort_value_index);
     }
     id_to_initialized_tensor[ort_value_index] = entry.second;
   }
@@ -335,7 +348,8 @@ common::Status SaveInitializedTensors(
     const auto entry = initialized_tensors_to_allocate.find(ort_value_index);
     ORT_ENFORCE(entry != initialized_tensors_to_allocate.end(),
                 "OrtValue index: ", ort_value_index, " from initializer_allocation_order not found among initialized tensors");
-    if (!(utils::HasExternalData(*entry->second) && exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU)) {
+    if (!(utils::HasExternalData(*entry->second) && exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU) &&
+        shared_initializer_ids.find(ort_value_index) == shared_initializer_ids.end()) {
       // can not trace string tensor
       ORT_ENFORCE(entry->second->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING, "Can not trace string tensor");
       ORT_RETURN_IF_ERROR(planner.Trace(entry->first, entry->second));
@@ -344,8 +358,9 @@ common::Status SaveInitializedTensors(
   }
 
   for (const auto& entry : initialized_tensors_to_allocate) {
-    // We don't want to trace shared initializers since their memory is provided by the user
-    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
+    // We don't want to trace shared initializers since their memory is provided by the user or the store
+    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end() ||
+        shared_initializer_ids.find(entry.first) != shared_initializer_ids.end()) {
       continue;
     }
     if (entry.second->data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
@@ -389,12 +404,19 @@ common::Status SaveInitializedTensors(
     } else {
       const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
 
+      const bool is_shared_by_content = shared_initializer_ids.find(ort_value_index) != shared_initializer_ids.end();
+
       std::optional<MemBuffer> m;
       AllocatorPtr alloc;
-      // TODO: if the tensor need be copied, does it have enough room?
-      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, m, alloc));
-      bool use_device_allocator_for_initializers =
-          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+      bool use_device_allocator_for_initializers = false;
+      if (is_shared_by_content) {
+        alloc = shared_initializer_store->GetAllocator();
+      } else {
+        // TODO: if the tensor need be copied, does it have enough room?
+        ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, m, alloc));
+        use_device_allocator_for_initializers =
+            session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+      }
 
       Tensor* p_tensor = nullptr;
       if (auto iter = buffered_tensors.find(name);
@@ -412,6 +434,12 @@ common::Status SaveInitializedTensors(
         oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
         return Status(st.Category(), st.Code(), oss.str());
       }
+
+      if (is_shared_by_content) {
+        // If the store has an identical tensor, it is used instead and the copy that was just loaded is released.
+        ort_value = shared_initializer_store->GetOrAddInitializer(ort_value);
+        shared_initializer_names.insert(name);
+      }
     }
 
     // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
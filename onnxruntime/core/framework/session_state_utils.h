@@ -10,6 +10,7 @@
 #include "core/common/const_pointer_container.h"
 #include "core/framework/allocator.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/shared_initializer_store.h"
 #include "core/framework/tensor.h"
 #include "core/framework/tensor_allocator.h"
 #include "core/framework/session_options.h"
@@ -39,6 +40,8 @@ using SaveTensorFunction = std::function<Status(const std::string& name, int idx
                                                 const OrtCallback& d, bool constant, bool sparse)>;
 using MemoryProfileFunction = std::function<void(ITensorAllocator& planner)>;
 
+// If shared_initializer_store is not null, the initializers that are planned on CPU are shared by content through
+// it instead of being allocated by the planner, and their names are added to shared_initializer_names.
 common::Status SaveInitializedTensors(
     const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
     const GraphViewer& graph, const AllocatorPtr& default_cpu_memory_info,
@@ -52,7 +55,9 @@ common::Status SaveInitializedTensors(
     const SessionOptions& session_options,
     const MemoryProfileFunction& memory_profile_func,
     std::unordered_map<std::string, std::unique_ptr<Tensor>>& buffered_tensors,
-    PrepackedWeightsForGraph& prepacked_for_graph);
+    PrepackedWeightsForGraph& prepacked_for_graph,
+    SharedInitializerStore* shared_initializer_store,
+    InlinedHashSet<std::string>& shared_initializer_names);
 
 common::Status AllocateTensor(
     const onnxruntime::MemBuffer* m,
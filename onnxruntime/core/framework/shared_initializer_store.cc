@@ -0,0 +1,189 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_initializer_store.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+struct SharedInitializerStore::InitializerEntry {
+  OrtValue value;
+};
+
+namespace {
+
+class Hasher {
+ public:
+  void Update(const void* data, size_t len) {
+    // MurmurHash3 takes an int length, so large buffers are hashed in chunks.
+    constexpr size_t kMaxChunkSize = size_t{1} << 30;
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    while (len > 0) {
+      const size_t chunk_size = std::min(len, kMaxChunkSize);
+      MurmurHash3::x86_128(bytes, static_cast<int>(chunk_size), hash_[0], &hash_);
+      bytes += chunk_size;
+      len -= chunk_size;
+    }
+  }
+
+  uint64_t Value() const { return uint64_t{hash_[0]} | (uint64_t{hash_[1]} << 32); }
+
+ private:
+  uint32_t hash_[4] = {0, 0, 0, 0};
+};
+
+uint64_t HashTensor(const Tensor& tensor) {
+  Hasher hasher;
+  const int32_t element_type = tensor.GetElementType();
+  hasher.Update(&element_type, sizeof(element_type));
+  const auto dims = tensor.Shape().GetDims();
+  hasher.Update(dims.data(), dims.size() * sizeof(int64_t));
+  hasher.Update(tensor.DataRaw(), tensor.SizeInBytes());
+  return hasher.Value();
+}
+
+bool IsSameTensor(const Tensor& tensor, const Tensor& other) {
+  return tensor.GetElementType() == other.GetElementType() &&
+         tensor.Shape() == other.Shape() &&
+         std::memcmp(tensor.DataRaw(), other.DataRaw(), tensor.SizeInBytes()) == 0;
+}
+
+size_t GetSizeInBytes(const PrePackedWeights& weights) {
+  size_t size = 0;
+  for (size_t buffer_size : weights.buffer_sizes_) {
+    size += buffer_size;
+  }
+  return size;
+}
+
+bool IsSamePrePackedWeights(const PrePackedWeights& weights, const PrePackedWeights& other) {
+  if (weights.buffers_.size() != other.buffers_.size() || weights.buffer_sizes_ != other.buffer_sizes_) {
+    return false;
+  }
+  for (size_t i = 0; i < weights.buffers_.size(); ++i) {
+    const void* buffer = weights.buffers_[i].get();
+    const void* other_buffer = other.buffers_[i].get();
+    if ((buffer == nullptr) != (other_buffer == nullptr) ||
+        (buffer != nullptr && std::memcmp(buffer, other_buffer, weights.buffer_sizes_[i]) != 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+SharedInitializerStore& SharedInitializerStore::Instance() {
+  static SharedInitializerStore store;
+  return store;
+}
+
+SharedInitializerStore::SharedInitializerStore() : allocator_(std::make_shared<CPUAllocator>()) {}
+
+OrtValue SharedInitializerStore::GetOrAddInitializer(const OrtValue& value) {
+  const Tensor& tensor = value.Get<Tensor>();
+  ORT_ENFORCE(tensor.Location().device.Type() == OrtDevice::CPU && !tensor.IsDataTypeString(),
+              "Only CPU tensors with a fixed size element type can be shared by content.");
+
+  const uint64_t hash = HashTensor(tensor);
+
+  std::shared_ptr<InitializerEntry> entry;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto range = initializers_.equal_range(hash);
+    for (auto it = range.first; it != range.second && entry == nullptr; ++it) {
+      auto existing = it->second.lock();
+      if (existing != nullptr && IsSameTensor(existing->value.Get<Tensor>(), tensor)) {
+        entry = std::move(existing);
+        ++num_shared_lookups_;
+        shared_bytes_ += tensor.SizeInBytes();
+      }
+    }
+
+    if (entry == nullptr) {
+      PurgeExpiredEntries();
+      entry = std::make_shared<InitializerEntry>();
+      entry->value = value;
+      initializers_.emplace(hash, entry);
+    }
+  }
+
+  // The returned value refers to the buffer of the entry and keeps the entry alive until it is released.
+  const Tensor& shared_tensor = entry->value.Get<Tensor>();
+  auto p_tensor = std::make_unique<Tensor>(shared_tensor.DataType(), shared_tensor.Shape(),
+                                           const_cast<void*>(shared_tensor.DataRaw()), shared_tensor.Location());
+  OrtValue result;
+  result.Init(p_tensor.release(), DataTypeImpl::GetType<Tensor>(),
+              [entry = std::move(entry)](void* p) { delete static_cast<Tensor*>(p); });
+  return result;
+}
+
+std::shared_ptr<const PrePackedWeights> SharedInitializerStore::GetOrAddPrePackedWeights(
+    const std::string& key, PrePackedWeights&& weights) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = prepacked_weights_.find(key);
+  if (it != prepacked_weights_.end()) {
+    if (auto existing = it->second.lock(); existing != nullptr) {
+      if (!IsSamePrePackedWeights(*existing, weights)) {
+        // The key is based on a hash of the buffers, so this is a collision. The weights are not shared.
+        return std::make_shared<const PrePackedWeights>(std::move(weights));
+      }
+      ++num_shared_lookups_;
+      shared_bytes_ += GetSizeInBytes(weights);
+      return existing;
+    }
+  }
+
+  PurgeExpiredEntries();
+  auto shared_weights = std::make_shared<const PrePackedWeights>(std::move(weights));
+  prepacked_weights_[key] = shared_weights;
+  return shared_weights;
+}
+
+void SharedInitializerStore::PurgeExpiredEntries() {
+  for (auto it = initializers_.begin(); it != initializers_.end();) {
+    it = it->second.expired() ? initializers_.erase(it) : std::next(it);
+  }
+  for (auto it = prepacked_weights_.begin(); it != prepacked_weights_.end();) {
+    it = it->second.expired() ? prepacked_weights_.erase(it) : std::next(it);
+  }
+}
+
+SharedInitializerStore::Stats SharedInitializerStore::GetStats() const {
+  Stats stats;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& [hash, weak_entry] : initializers_) {
+    if (auto entry = weak_entry.lock(); entry != nullptr) {
+      ++stats.num_initializers;
+      stats.initializer_bytes += entry->value.Get<Tensor>().SizeInBytes();
+    }
+  }
+  for (const auto& [key, weak_weights] : prepacked_weights_) {
+    if (auto weights = weak_weights.lock(); weights != nullptr) {
+      ++stats.num_prepacked_weights;
+      stats.prepacked_weights_bytes += GetSizeInBytes(*weights);
+    }
+  }
+  stats.num_shared_lookups = num_shared_lookups_;
+  stats.shared_bytes = shared_bytes_;
+  return stats;
+}
+
+std::string SharedInitializerStore::GetMemoryReport() const {
+  const Stats stats = GetStats();
+  std::ostringstream oss;
+  oss << "Shared initializer store: " << stats.num_initializers << " initializers using "
+      << stats.initializer_bytes << " bytes, " << stats.num_prepacked_weights << " pre-packed weights using "
+      << stats.prepacked_weights_bytes << " bytes, " << stats.num_shared_lookups << " shared lookups saved "
+      << stats.shared_bytes << " bytes";
+  return oss.str();
+}
+
+}  // namespace onnxruntime
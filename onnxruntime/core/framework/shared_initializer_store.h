@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/prepacked_weights.h"
+
+namespace onnxruntime {
+
+/**
+ * A process-wide, content-addressed store of CPU initializers and of their pre-packed forms.
+ *
+ * Sessions that load models with identical initializers, e.g. several versions of the same model or models that
+ * share an embedding table, look up each initializer by a hash of its data type, shape and bytes. If an identical
+ * tensor is already in the store, the session uses it and drops its own copy, so the data is only kept once in the
+ * process. Pre-packed weights are shared in the same way, keyed by the op type and the hash of the pre-packed
+ * buffers, and compared byte by byte before they are shared.
+ *
+ * The entries are reference counted: the store only holds weak references, and an entry is released when the last
+ * session that uses it releases it.
+ */
+class SharedInitializerStore {
+ public:
+  static SharedInitializerStore& Instance();
+
+  struct Stats {
+    // The number of distinct initializers and pre-packed weights in the store, and the bytes they use.
+    size_t num_initializers = 0;
+    size_t initializer_bytes = 0;
+    size_t num_prepacked_weights = 0;
+    size_t prepacked_weights_bytes = 0;
+    // The number of lookups that found an identical entry, and the bytes they did not have to keep a copy of.
+    size_t num_shared_lookups = 0;
+    size_t shared_bytes = 0;
+  };
+
+  SharedInitializerStore();
+
+  /**
+   * Returns the allocator that initializers added to the store should be allocated with. Tensors in the store may
+   * outlive the session that created them, so they must not be allocated from the allocators of a session.
+   */
+  AllocatorPtr GetAllocator() const { return allocator_; }
+
+  /**
+   * Returns a value that holds an identical tensor to `value` if the store contains one. Otherwise `value` is
+   * added to the store and a value sharing its buffer is returned. `value` must be a CPU tensor that is not a string
+   * tensor, and its buffer must not be owned by a session allocator.
+   */
+  OrtValue GetOrAddInitializer(const OrtValue& value);
+
+  /**
+   * Returns identical pre-packed weights from the store for `key`, or adds `weights` and returns them. The returned
+   * pointer must be held for as long as a kernel uses the pre-packed buffers. The buffers of `weights` must be
+   * allocated with GetAllocator().
+   */
+  std::shared_ptr<const PrePackedWeights> GetOrAddPrePackedWeights(const std::string& key,
+                                                                  PrePackedWeights&& weights);
+
+  Stats GetStats() const;
+
+  // Returns a one line summary of GetStats().
+  std::string GetMemoryReport() const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SharedInitializerStore);
+
+ private:
+  struct InitializerEntry;
+
+  void PurgeExpiredEntries();
+
+  AllocatorPtr allocator_;
+
+  mutable std::mutex mutex_;
+  std::unordered_multimap<uint64_t, std::weak_ptr<InitializerEntry>> initializers_;
+  std::unordered_map<std::string, std::weak_ptr<const PrePackedWeights>> prepacked_weights_;
+  size_t num_shared_lookups_ = 0;
+  size_t shared_bytes_ = 0;
+};
+
+}  // namespace onnxruntime
@@ -2226,6 +2226,152 @@ ONNX_MS_OPERATOR_SET_SCHEMA(FusedMatMulActivation, 1,
                                 .SetDoc(FusedMatMulActivation_doc)
                                 .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) { FusedMatMulShapeInference(ctx); }));
 
+constexpr const char* LoRAMatMul_doc = R"DOC(
+MatMul of A with the base weight B plus a low-rank (LoRA) update, where every batch row selects its own adapter:
+
+  Y[b] = A[b] * B + scale * (A[b] * lora_A[i]) * lora_B[i],  i = adapter_indices[b]
+
+lora_A and lora_B hold the weights of all adapters stacked along the leading dimension, for example the parameters
+of an adapter created with OrtApi::CreateLoraAdapterStack. Adapters with a lower rank are zero padded to the
+common rank. A negative adapter index selects the base weight only.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(LoRAMatMul, 1,
+                            OpSchema()
+                                .Input(0, "A", "Input tensor with shape (batch_size, ..., K)", "T")
+                                .Input(1, "B", "Base weight with shape (K, N)", "T")
+                                .Input(2, "lora_A", "Stacked down projections with shape (num_adapters, K, rank)", "T")
+                                .Input(3, "lora_B", "Stacked up projections with shape (num_adapters, rank, N)", "T")
+                                .Input(4, "adapter_indices", "Adapter index of every batch row with shape (batch_size)", "T1")
+                                .Attr("scale", "Scalar multiplier for the low-rank update.", AttributeProto::FLOAT, 1.0f)
+                                .Output(0, "Y", "Output tensor with shape (batch_size, ..., N)", "T")
+                                .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+                                .TypeConstraint("T1", {"tensor(int32)"}, "Constrain adapter indices to int32 tensors.")
+                                .SetDoc(LoRAMatMul_doc)
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  propagateElemTypeFromInputToOutput(ctx, 0, 0);
+                                  if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 1)) {
+                                    return;
+                                  }
+                                  const auto& a_shape = getInputShape(ctx, 0);
+                                  const auto& b_shape = getInputShape(ctx, 1);
+                                  if (a_shape.dim_size() < 2) {
+                                    fail_shape_inference("Input A must have at least 2 dimensions.");
+                                  }
+                                  if (b_shape.dim_size() != 2) {
+                                    fail_shape_inference("Input B must have 2 dimensions.");
+                                  }
+                                  ONNX_NAMESPACE::TensorShapeProto output_shape = a_shape;
+                                  *output_shape.mutable_dim(a_shape.dim_size() - 1) = b_shape.dim(1);
+                                  updateOutputShape(ctx, 0, output_shape);
+                                }));
+
+constexpr const char* FusedElementwise_doc = R"DOC(
+A subgraph of float elementwise operators, created by the ElementwiseFusion graph transformer, that is evaluated in
+a single pass over the data.
+
+The subgraph is a list of ops in topological order. With N inputs, value i < N is input i and value N + j is the
+result of op j. Op j is the operator ops[j] applied to the values operands[2 * j] and operands[2 * j + 1], where the
+second operand is -1 for unary operators. LeakyRelu uses alphas[j] as its alpha. Output k is the value
+output_values[k].
+
+The supported operators are Abs, Add, Ceil, Div, Erf, Exp, Floor, LeakyRelu, Log, Mul, Neg, Pow, Reciprocal, Relu,
+Sigmoid, Sqrt, Sub and Tanh. The inputs are broadcast to a common shape, which is the shape of every value of the
+subgraph and of every output.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(FusedElementwise, 1,
+                            OpSchema()
+                                .Input(0, "inputs", "Inputs of the subgraph", "T", OpSchema::Variadic)
+                                .Output(0, "outputs", "Outputs of the subgraph", "T", OpSchema::Variadic)
+                                .Attr("ops", "Operator type of every op.", AttributeProto::STRINGS)
+                                .Attr("operands", "Two value indices per op, -1 for the second operand of unary operators.",
+                                      AttributeProto::INTS)
+                                .Attr("alphas", "Alpha of every op.", AttributeProto::FLOATS, OPTIONAL_VALUE)
+                                .Attr("output_values", "Value index of every output.", AttributeProto::INTS)
+                                .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+                                .SetDoc(FusedElementwise_doc)
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  const size_t num_inputs = ctx.getNumInputs();
+                                  const size_t num_outputs = ctx.getNumOutputs();
+                                  for (size_t i = 0; i < num_outputs; i++) {
+                                    propagateElemTypeFromInputToOutput(ctx, 0, i);
+                                  }
+                                  if (!hasNInputShapes(ctx, static_cast<int>(num_inputs))) {
+                                    return;
+                                  }
+                                  std::vector<const ONNX_NAMESPACE::TensorShapeProto*> shapes;
+                                  for (size_t i = 0; i < num_inputs; i++) {
+                                    shapes.push_back(&getInputShape(ctx, i));
+                                  }
+                                  ONNX_NAMESPACE::TensorShapeProto output_shape;
+                                  multidirectionalBroadcastShapeInference(shapes, output_shape);
+                                  for (size_t i = 0; i < num_outputs; i++) {
+                                    updateOutputShape(ctx, i, output_shape);
+                                  }
+                                }));
+
+constexpr const char* EmbeddingBag_doc = R"DOC(
+Computes the sums or means of bags of rows of an embedding table, without materializing the gathered rows.
+
+Without `offsets`, the bags are along the last axis of `indices`. The output has the shape of `indices` without its
+last axis, followed by the shape of `data` without its first axis. This is the same as a Gather on axis 0 followed by
+a ReduceSum or ReduceMean over the last axis of the indices with keepdims set to 0.
+
+With `offsets`, `indices` is 1-D and bag i is made of the indices from offsets[i] up to offsets[i + 1], or up to the
+end of `indices` for the last bag. The output has the shape [number of bags] followed by the shape of `data` without
+its first axis. The rows of an empty bag are 0.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(EmbeddingBag, 1,
+                            OpSchema()
+                                .Input(0, "data", "The embedding table, of rank r >= 1.", "T")
+                                .Input(1, "indices", "The rows of the table in the bags.", "Tind")
+                                .Input(2, "offsets", "1-D tensor with the start of every bag in the 1-D indices.",
+                                       "Tind", OpSchema::Optional)
+                                .Output(0, "output", "The reduced bags.", "T")
+                                .Attr("mode", "Reduction of the rows of a bag: 'sum' or 'mean'.",
+                                      AttributeProto::STRING, std::string("sum"))
+                                .TypeConstraint("T", {"tensor(float)"},
+                                                "Constrain input and output types to float tensors.")
+                                .TypeConstraint("Tind", {"tensor(int32)", "tensor(int64)"},
+                                                "Constrain indices and offsets to integer types.")
+                                .SetDoc(EmbeddingBag_doc)
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  propagateElemTypeFromInputToOutput(ctx, 0, 0);
+                                  const bool has_offsets = ctx.getNumInputs() > 2 && ctx.hasInput(2);
+                                  if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 1) ||
+                                      (has_offsets && !hasInputShape(ctx, 2))) {
+                                    return;
+                                  }
+
+                                  const auto& data_shape = getInputShape(ctx, 0);
+                                  const auto& indices_shape = getInputShape(ctx, 1);
+                                  if (data_shape.dim_size() < 1) {
+                                    fail_shape_inference("data must have rank >= 1");
+                                  }
+
+                                  ONNX_NAMESPACE::TensorShapeProto output_shape;
+                                  if (has_offsets) {
+                                    const auto& offsets_shape = getInputShape(ctx, 2);
+                                    if (indices_shape.dim_size() != 1 || offsets_shape.dim_size() != 1) {
+                                      fail_shape_inference("indices and offsets must be 1-D");
+                                    }
+                                    *output_shape.add_dim() = offsets_shape.dim(0);
+                                  } else {
+                                    if (indices_shape.dim_size() < 1) {
+                                      fail_shape_inference("indices must have rank >= 1");
+                                    }
+                                    for (int i = 0; i < indices_shape.dim_size() - 1; ++i) {
+                                      *output_shape.add_dim() = indices_shape.dim(i);
+                                    }
+                                  }
+                                  for (int i = 1; i < data_shape.dim_size(); ++i) {
+                                    *output_shape.add_dim() = data_shape.dim(i);
+                                  }
+                                  updateOutputShape(ctx, 0, output_shape);
+                                }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(SparseToDenseMatMul, 1,
                             OpSchema()
                                 .Input(0, "A", "2-dimensional sparse matrix A. Either COO or CSR format", "T")
@@ -3601,7 +3747,8 @@ GatherBlockQuantized is a Gather with data quantized. It is similar to Gather (h
       .Input(2, "scales", "quantization scale", "T2")
       .Input(3, "zero_points", "quantization zero points", "T1", OpSchema::Optional)
       .Output(0, "output", "Dequantized output tensor of rank q + (r - 1).", "T2")
-      .TypeConstraint("T1", {"tensor(int4)", "tensor(uint4)"}, "Constrain quantized types.")
+      .TypeConstraint("T1", {"tensor(int4)", "tensor(uint4)", "tensor(int8)", "tensor(uint8)"},
+                      "Constrain quantized types.")
       .TypeConstraint("T2", {"tensor(float)", "tensor(float16)", "tensor(bfloat16)"}, "Constrain dequantized types.")
       .TypeConstraint("Tind", {"tensor(int32)", "tensor(int64)"}, "Constrain indices to integer types.")
       .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
@@ -95,6 +95,16 @@ Abstract:
 #endif // ARM64
 #endif // Visual Studio 16 or earlier does not support fp16 intrinsic
 
+//
+// bfloat16 precision GEMM (SBGEMM) is available on Linux for ARM64 (NEON BF16
+// extensions) and AMD64 (AVX512-BF16 extensions). Availability on the current
+// processor is reported by MlasBf16AccelerationSupported().
+//
+
+#if defined(__linux__) && (defined(MLAS_TARGET_ARM64) || defined(MLAS_TARGET_AMD64))
+#define MLAS_SBGEMM_SUPPORTED
+#endif
+
 //
 // Basic Linear Algebra Subprograms (BLAS) types.
 //
@@ -747,6 +757,50 @@ MlasSymmQgemmPackB(
     void* PackedB
     );
 
+//
+// Block sparse single precision matrix/matrix multiply routines.
+//
+// MlasSparseGemmPackBSize returns zero if too few rows of the panels of B are
+// all zero for the sparse kernel to be faster than MlasGemm, in which case the
+// dense routines should be used.
+//
+
+size_t
+MLASCALL
+MlasSparseGemmPackBSize(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb
+    );
+
+void
+MLASCALL
+MlasSparseGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+void
+MLASCALL
+MlasSparseGemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Convolution routines.
 //
@@ -755,6 +809,7 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmWinograd,
 #if defined(MLAS_TARGET_WASM_SCALAR)
     MlasConvAlgorithmDepthwise,
 #endif
@@ -787,6 +842,12 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            size_t TileCountHeight;
+            size_t TileCountWidth;
+            size_t ThreadBufferSize;
+            const float* PackedFilter;
+        } Winograd;
     } u;
 };
 
@@ -820,6 +881,48 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Winograd F(4x4,3x3) convolution routines.
+//
+// MlasConvPrepare selects MlasConvAlgorithmWinograd for 3x3 convolutions with
+// unit strides and dilations. The filter is transformed on every call to
+// MlasConv unless the transformed filter is packed once with
+// MlasConvWinogradPackFilter and supplied with MlasConvSetWinogradPackedFilter.
+//
+
+bool
+MLASCALL
+MlasConvWinogradSupportsChannels(
+    size_t FilterCount,
+    size_t InputChannels
+    );
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels
+    );
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    float* PackedFilter
+    );
+
+void
+MLASCALL
+MlasConvSetWinogradPackedFilter(
+    MLAS_CONV_PARAMETERS* Parameters,
+    const float* PackedFilter,
+    size_t* WorkingBufferSize
+    );
+
 void
 MLASCALL
 MlasConvDepthwise(
@@ -1075,6 +1178,55 @@ MlasTranspose(
     size_t N
     );
 
+//
+// Transposes a strided tile of a larger matrix, e.g. the innermost two axes
+// of a permutation of a tensor. The strides are in elements.
+//
+
+void
+MLASCALL
+MlasTranspose(
+    const uint8_t* Input,
+    uint8_t* Output,
+    size_t M,
+    size_t N,
+    size_t InputStride,
+    size_t OutputStride
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint16_t* Input,
+    uint16_t* Output,
+    size_t M,
+    size_t N,
+    size_t InputStride,
+    size_t OutputStride
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    uint32_t* Output,
+    size_t M,
+    size_t N,
+    size_t InputStride,
+    size_t OutputStride
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint64_t* Input,
+    uint64_t* Output,
+    size_t M,
+    size_t N,
+    size_t InputStride,
+    size_t OutputStride
+    );
+
 //
 // Buffer reordering routines.
 //
@@ -1435,6 +1587,91 @@ MLAS_FP16* Destination,
 size_t Count
 );
 
+//
+// BFloat16 conversion routines. The bfloat16 values are passed as their bits.
+// Single precision values are rounded to the nearest even bfloat16 value.
+//
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatBuffer(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16Buffer(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    );
+
+/**
+ * @brief Fused layer normalization of one row. The row x = Input + Skip + Bias is
+ *        normalized as (x - mean(x)) / sqrt(var(x) + Epsilon) * Scale + Shift, or as
+ *        x / sqrt(mean(x^2) + Epsilon) * Scale when Simplified (RMSNorm).
+ *
+ * @tparam T: data type of input, skip and outputs. Currently only float32/16 are supported.
+ * @param Input:       input row, of shape [N]
+ * @param Skip:        optional residual row, of shape [N]
+ * @param Bias:        optional bias, of shape [N]
+ * @param Scale:       scale (gamma), of shape [N]
+ * @param Shift:       optional shift (beta), of shape [N]. Ignored when Simplified.
+ * @param Output:      normalized row, of shape [N]. May alias Input.
+ * @param SkipOutput:  optional output of Input + Skip + Bias, of shape [N]
+ * @param N:           number of elements in the row
+ * @param Epsilon:     value added to the variance
+ * @param Simplified:  whether to skip the mean subtraction (RMSNorm)
+ * @param Mean:        optional output of the row mean. Not written when Simplified.
+ * @param InvStdDev:   optional output of the row 1 / sqrt(variance + Epsilon)
+ */
+template <typename T>
+void
+MLASCALL
+MlasLayerNormalization(
+    const T* Input,
+    const T* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    T* Output,
+    T* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    );
+
+/**
+ * @brief Fused layer normalization of one fp32 row followed by a linear
+ *        quantization of the normalized row, for feeding quantized MatMuls.
+ *        Parameters match MlasLayerNormalization.
+ *
+ * @tparam OutputType: int8_t or uint8_t
+ * @param OutputScale: quantization scale of Output
+ * @param ZeroPoint:   quantization zero point of Output
+ */
+template <typename OutputType>
+void
+MLASCALL
+MlasLayerNormalizationQuantizeLinear(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    OutputType* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float OutputScale,
+    OutputType ZeroPoint
+    );
+
 /**
  * @brief rotary embedding for one hidden state vector
  *
@@ -1666,7 +1903,7 @@ MlasHalfGemmConvertPackB(
     void* PackedB
     );
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
 /**
  * @brief Whether current CPU supports Bfloat16(bf16) acceleration.
  */
@@ -1878,10 +2115,73 @@ struct MlasFlashAttentionThreadedArgs {
     const float* key;
     const float* value;
     float* output;
+
+    //
+    // Optional layout. Query is BNSH with a batch stride of q_batch_stride
+    // elements, key and value are B x kv_num_heads x kv_buffer_sequence_length x H,
+    // and output is BSNH. Heads of query share a key/value head in groups of
+    // num_heads / kv_num_heads. Zero selects the dense MHA layout.
+    //
+    int kv_num_heads = 0;
+    int kv_buffer_sequence_length = 0;
+    ptrdiff_t q_batch_stride = 0;
+
+    //
+    // Optional number of valid keys for each batch (at most kv_sequence_length).
+    //
+    const int32_t* kv_valid_lengths = nullptr;
+
+    //
+    // Optional masking without a mask tensor. With causal masking, query row i
+    // is at position (kv_valid_length - q_sequence_length + i) and attends to
+    // the keys up to its position, or only the last local_window_size + 1 keys
+    // when local_window_size > 0.
+    //
+    bool causal = false;
+    int local_window_size = -1;
+
+    //
+    // Optional block sparse layout in CSR format, as used by SparseAttention.
+    // Head h uses layout (h % num_sparse_layout). Key blocks not listed for the
+    // block row of a query are masked, and key blocks masked for all rows of a
+    // query block are skipped. kv_block_size must equal sparse_block_size.
+    //
+    int sparse_block_size = 0;
+    int num_sparse_layout = 0;
+    int sparse_stride_row_indices = 0;
+    int sparse_stride_col_indices = 0;
+    const int32_t* sparse_block_row_indices = nullptr;
+    const int32_t* sparse_block_col_indices = nullptr;
+
+    //
+    // Optional score transforms used by GroupQueryAttention.
+    //
+    float softcap = 0.0f;
+    bool smooth_softmax = false;
+
+    //
+    // Optional fp16 inputs and output. When set, these are used instead of the
+    // fp32 pointers and blocks are converted to fp32 in the thread buffer.
+    //
+    const MLAS_FP16* query_fp16 = nullptr;
+    const MLAS_FP16* key_fp16 = nullptr;
+    const MLAS_FP16* value_fp16 = nullptr;
+    MLAS_FP16* output_fp16 = nullptr;
 };
 
 /**
- * @brief Per-thread worker function for fp32 Flash Attention
+ * @brief Returns the number of bytes of buffer needed by each thread of Flash Attention
+ * @param args         Arguments with the block sizes and fp16 pointers set
+ * @return
+*/
+size_t
+MLASCALL
+MlasFlashAttentionGetBufferSizePerThread(
+    const MlasFlashAttentionThreadedArgs* args
+);
+
+/**
+ * @brief Per-thread worker function for fp32 or fp16 Flash Attention
  * @param thread_id    Thread index
  * @param args         Arguments
  * @return
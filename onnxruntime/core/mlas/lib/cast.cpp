@@ -10,11 +10,14 @@ Module Name:
 
 Abstract:
 
-    This module implements Half (F16) to Single (F32) precision casting.
+    This module implements Half (F16) and BFloat16 (BF16) to Single (F32)
+    precision casting.
 
 --*/
 #include "mlasi.h"
 
+#include <cstring>
+
 void
 MLASCALL
 MlasConvertHalfToFloatBuffer(
@@ -50,3 +53,124 @@ MlasConvertFloatToHalfBuffer(
         GetMlasPlatform().CastF32ToF16Kernel(Source, reinterpret_cast<unsigned short*>(Destination), Count);
     }
 }
+
+MLAS_FORCEINLINE
+uint16_t
+MlasFloatToBFloat16(
+    float Value
+    )
+{
+    uint32_t Bits;
+    memcpy(&Bits, &Value, sizeof(Bits));
+
+    //
+    // NaN values are kept quiet NaNs. Other values are rounded to the nearest
+    // even value, which overflows to infinity if needed.
+    //
+
+    if ((Bits & 0x7FFFFFFF) > 0x7F800000) {
+        return static_cast<uint16_t>((Bits >> 16) | 0x0040);
+    }
+
+    return static_cast<uint16_t>((Bits + 0x7FFF + ((Bits >> 16) & 1)) >> 16);
+}
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatBuffer(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    size_t i = 0;
+
+#if defined(MLAS_SSE2_INTRINSICS)
+
+    const __m128i Zero = _mm_setzero_si128();
+
+    for (; i + 8 <= Count; i += 8) {
+        __m128i Values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&Source[i]));
+        _mm_storeu_ps(&Destination[i], _mm_castsi128_ps(_mm_unpacklo_epi16(Zero, Values)));
+        _mm_storeu_ps(&Destination[i + 4], _mm_castsi128_ps(_mm_unpackhi_epi16(Zero, Values)));
+    }
+
+#elif defined(MLAS_NEON_INTRINSICS)
+
+    for (; i + 8 <= Count; i += 8) {
+        uint16x8_t Values = vld1q_u16(&Source[i]);
+        vst1q_f32(&Destination[i], vreinterpretq_f32_u32(vshll_n_u16(vget_low_u16(Values), 16)));
+        vst1q_f32(&Destination[i + 4], vreinterpretq_f32_u32(vshll_n_u16(vget_high_u16(Values), 16)));
+    }
+
+#endif
+
+    for (; i < Count; i++) {
+        uint32_t Bits = static_cast<uint32_t>(Source[i]) << 16;
+        memcpy(&Destination[i], &Bits, sizeof(Bits));
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16Buffer(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+{
+    size_t i = 0;
+
+#if defined(MLAS_SSE2_INTRINSICS)
+
+    const __m128i One = _mm_set1_epi32(1);
+    const __m128i RoundingBias = _mm_set1_epi32(0x7FFF);
+    const __m128i AbsMask = _mm_set1_epi32(0x7FFFFFFF);
+    const __m128i Infinity = _mm_set1_epi32(0x7F800000);
+    const __m128i QuietBit = _mm_set1_epi32(0x00400000);
+
+    auto RoundToBFloat16 = [&](__m128i Bits) {
+        __m128i Lsb = _mm_and_si128(_mm_srli_epi32(Bits, 16), One);
+        __m128i Rounded = _mm_add_epi32(Bits, _mm_add_epi32(Lsb, RoundingBias));
+        __m128i IsNaN = _mm_cmpgt_epi32(_mm_and_si128(Bits, AbsMask), Infinity);
+        __m128i Result = _mm_or_si128(_mm_and_si128(IsNaN, _mm_or_si128(Bits, QuietBit)),
+                                      _mm_andnot_si128(IsNaN, Rounded));
+        //
+        // The arithmetic shift keeps the upper halves in the range of the
+        // signed saturating pack.
+        //
+        return _mm_srai_epi32(Result, 16);
+    };
+
+    for (; i + 8 <= Count; i += 8) {
+        __m128i Lo = RoundToBFloat16(_mm_castps_si128(_mm_loadu_ps(&Source[i])));
+        __m128i Hi = RoundToBFloat16(_mm_castps_si128(_mm_loadu_ps(&Source[i + 4])));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&Destination[i]), _mm_packs_epi32(Lo, Hi));
+    }
+
+#elif defined(MLAS_NEON_INTRINSICS)
+
+    const uint32x4_t One = vdupq_n_u32(1);
+    const uint32x4_t RoundingBias = vdupq_n_u32(0x7FFF);
+    const uint32x4_t QuietBit = vdupq_n_u32(0x00400000);
+
+    auto RoundToBFloat16 = [&](float32x4_t Values) {
+        uint32x4_t Bits = vreinterpretq_u32_f32(Values);
+        uint32x4_t Lsb = vandq_u32(vshrq_n_u32(Bits, 16), One);
+        uint32x4_t Rounded = vaddq_u32(Bits, vaddq_u32(Lsb, RoundingBias));
+        uint32x4_t IsNotNaN = vceqq_f32(Values, Values);
+        return vshrn_n_u32(vbslq_u32(IsNotNaN, Rounded, vorrq_u32(Bits, QuietBit)), 16);
+    };
+
+    for (; i + 8 <= Count; i += 8) {
+        uint16x4_t Lo = RoundToBFloat16(vld1q_f32(&Source[i]));
+        uint16x4_t Hi = RoundToBFloat16(vld1q_f32(&Source[i + 4]));
+        vst1q_u16(&Destination[i], vcombine_u16(Lo, Hi));
+    }
+
+#endif
+
+    for (; i < Count; i++) {
+        Destination[i] = MlasFloatToBFloat16(Source[i]);
+    }
+}
@@ -729,6 +729,581 @@ Return Value:
     }
 }
 
+//
+// Define the number of tiles and filters processed by each batch of Winograd
+// GEMMs.
+//
+
+#define MLAS_CONV_WINOGRAD_TILE_BLOCK 16
+#define MLAS_CONV_WINOGRAD_FILTER_BLOCK 64
+
+//
+// Define the minimum number of input channels and filters for which the
+// Winograd algorithm is selected. The transforms are amortized over the
+// channels, so smaller convolutions are faster with the expansion and GEMM.
+//
+
+#define MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS 16
+
+//
+// Define the Winograd F(4x4,3x3) tile geometry: each 6x6 input tile produces
+// a 4x4 output tile.
+//
+
+#define MLAS_CONV_WINOGRAD_OUTPUT_TILE 4
+#define MLAS_CONV_WINOGRAD_INPUT_TILE 6
+#define MLAS_CONV_WINOGRAD_TILE_ELEMENTS \
+    (MLAS_CONV_WINOGRAD_INPUT_TILE * MLAS_CONV_WINOGRAD_INPUT_TILE)
+
+void
+MlasConvWinogradTransformFilter(
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    float* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the 3x3 filters of a group to the Winograd domain
+    (U = G * g * G^T).
+
+    The transformed filter is stored as 36 matrices of FilterCount rows by
+    InputChannels columns, one for each element of the 6x6 tile, so that each
+    element can be multiplied with the transformed input by a GEMM.
+
+Arguments:
+
+    FilterCount - Supplies the number of filters of the group.
+
+    InputChannels - Supplies the number of input channels of the group.
+
+    Filter - Supplies the filter tensor of the group.
+
+    PackedFilter - Supplies the buffer to receive the transformed filter.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t FilterMatrixSize = FilterCount * InputChannels;
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        for (size_t c = 0; c < InputChannels; c++) {
+
+            const float* g = Filter + (f * InputChannels + c) * 9;
+
+            //
+            // Compute G * g as a 6x3 matrix.
+            //
+
+            float t[MLAS_CONV_WINOGRAD_INPUT_TILE][3];
+
+            for (size_t j = 0; j < 3; j++) {
+                const float g0 = g[0 * 3 + j];
+                const float g1 = g[1 * 3 + j];
+                const float g2 = g[2 * 3 + j];
+                t[0][j] = g0 * (1.0f / 4.0f);
+                t[1][j] = -(g0 + g1 + g2) * (1.0f / 6.0f);
+                t[2][j] = -(g0 - g1 + g2) * (1.0f / 6.0f);
+                t[3][j] = g0 * (1.0f / 24.0f) + g1 * (1.0f / 12.0f) + g2 * (1.0f / 6.0f);
+                t[4][j] = g0 * (1.0f / 24.0f) - g1 * (1.0f / 12.0f) + g2 * (1.0f / 6.0f);
+                t[5][j] = g2;
+            }
+
+            //
+            // Compute (G * g) * G^T and scatter the 6x6 tile to the filter
+            // matrices.
+            //
+
+            float* u = PackedFilter + f * InputChannels + c;
+
+            for (size_t i = 0; i < MLAS_CONV_WINOGRAD_INPUT_TILE; i++) {
+                const float g0 = t[i][0];
+                const float g1 = t[i][1];
+                const float g2 = t[i][2];
+                float* ui = u + i * MLAS_CONV_WINOGRAD_INPUT_TILE * FilterMatrixSize;
+                ui[0 * FilterMatrixSize] = g0 * (1.0f / 4.0f);
+                ui[1 * FilterMatrixSize] = -(g0 + g1 + g2) * (1.0f / 6.0f);
+                ui[2 * FilterMatrixSize] = -(g0 - g1 + g2) * (1.0f / 6.0f);
+                ui[3 * FilterMatrixSize] = g0 * (1.0f / 24.0f) + g1 * (1.0f / 12.0f) + g2 * (1.0f / 6.0f);
+                ui[4 * FilterMatrixSize] = g0 * (1.0f / 24.0f) - g1 * (1.0f / 12.0f) + g2 * (1.0f / 6.0f);
+                ui[5 * FilterMatrixSize] = g2;
+            }
+        }
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasConvWinogradTransformInputRow(
+    const float* d,
+    size_t Stride,
+    float* v
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a vector of six elements with the Winograd input
+    transform matrix B^T.
+
+Arguments:
+
+    d - Supplies the input vector.
+
+    Stride - Supplies the distance between the elements of the input vector.
+
+    v - Supplies the buffer to receive the six transformed elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float d0 = d[0 * Stride];
+    const float d1 = d[1 * Stride];
+    const float d2 = d[2 * Stride];
+    const float d3 = d[3 * Stride];
+    const float d4 = d[4 * Stride];
+    const float d5 = d[5 * Stride];
+
+    v[0] = 4.0f * d0 - 5.0f * d2 + d4;
+    v[1] = -4.0f * (d1 + d2) + d3 + d4;
+    v[2] = 4.0f * (d1 - d2) - d3 + d4;
+    v[3] = 2.0f * (d3 - d1) - d2 + d4;
+    v[4] = 2.0f * (d1 - d3) - d2 + d4;
+    v[5] = 4.0f * d1 - 5.0f * d3 + d5;
+}
+
+void
+MlasConvWinogradTransformInput(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    size_t TileY,
+    size_t TileX,
+    size_t TileCount,
+    float* TransformedInput
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a row segment of 6x6 input tiles to the Winograd
+    domain (V = B^T * d * B).
+
+    The transformed input is stored as 36 matrices of InputChannels rows by
+    TileCount columns, one for each element of the 6x6 tile.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor of the group.
+
+    TileY - Supplies the row of the tiles to transform.
+
+    TileX - Supplies the column of the first tile to transform.
+
+    TileCount - Supplies the number of tiles to transform.
+
+    TransformedInput - Supplies the buffer to receive the transformed input.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t MatrixSize = InputChannels * TileCount;
+
+    const size_t OriginY = TileY * MLAS_CONV_WINOGRAD_OUTPUT_TILE - Parameters->Padding[0];
+
+    for (size_t c = 0; c < InputChannels; c++) {
+
+        const float* input = Input + c * InputSize;
+
+        for (size_t t = 0; t < TileCount; t++) {
+
+            const size_t OriginX = (TileX + t) * MLAS_CONV_WINOGRAD_OUTPUT_TILE - Parameters->Padding[1];
+
+            //
+            // Gather the 6x6 input tile with implicit zero padding.
+            //
+
+            float d[MLAS_CONV_WINOGRAD_TILE_ELEMENTS];
+
+            for (size_t i = 0; i < MLAS_CONV_WINOGRAD_INPUT_TILE; i++) {
+
+                const size_t ih = OriginY + i;
+
+                for (size_t j = 0; j < MLAS_CONV_WINOGRAD_INPUT_TILE; j++) {
+
+                    const size_t iw = OriginX + j;
+
+                    d[i * MLAS_CONV_WINOGRAD_INPUT_TILE + j] =
+                        (ih < InputHeight && iw < InputWidth) ? input[ih * InputWidth + iw] : 0.0f;
+                }
+            }
+
+            //
+            // Compute B^T * d and then (B^T * d) * B.
+            //
+
+            float w[MLAS_CONV_WINOGRAD_TILE_ELEMENTS];
+
+            for (size_t j = 0; j < MLAS_CONV_WINOGRAD_INPUT_TILE; j++) {
+
+                float v[MLAS_CONV_WINOGRAD_INPUT_TILE];
+
+                MlasConvWinogradTransformInputRow(&d[j], MLAS_CONV_WINOGRAD_INPUT_TILE, v);
+
+                for (size_t i = 0; i < MLAS_CONV_WINOGRAD_INPUT_TILE; i++) {
+                    w[i * MLAS_CONV_WINOGRAD_INPUT_TILE + j] = v[i];
+                }
+            }
+
+            float* transformed = TransformedInput + c * TileCount + t;
+
+            for (size_t i = 0; i < MLAS_CONV_WINOGRAD_INPUT_TILE; i++) {
+
+                float v[MLAS_CONV_WINOGRAD_INPUT_TILE];
+
+                MlasConvWinogradTransformInputRow(&w[i * MLAS_CONV_WINOGRAD_INPUT_TILE], 1, v);
+
+                for (size_t j = 0; j < MLAS_CONV_WINOGRAD_INPUT_TILE; j++) {
+                    transformed[(i * MLAS_CONV_WINOGRAD_INPUT_TILE + j) * MatrixSize] = v[j];
+                }
+            }
+        }
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasConvWinogradTransformOutputRow(
+    const float* m,
+    size_t Stride,
+    float* o
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a vector of six elements with the Winograd output
+    transform matrix A^T.
+
+Arguments:
+
+    m - Supplies the input vector.
+
+    Stride - Supplies the distance between the elements of the input vector.
+
+    o - Supplies the buffer to receive the four transformed elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float m0 = m[0 * Stride];
+    const float m1 = m[1 * Stride];
+    const float m2 = m[2 * Stride];
+    const float m3 = m[3 * Stride];
+    const float m4 = m[4 * Stride];
+    const float m5 = m[5 * Stride];
+
+    const float s12 = m1 + m2;
+    const float d12 = m1 - m2;
+    const float s34 = m3 + m4;
+    const float d34 = m3 - m4;
+
+    o[0] = m0 + s12 + s34;
+    o[1] = d12 + 2.0f * d34;
+    o[2] = s12 + 4.0f * s34;
+    o[3] = d12 + 8.0f * d34 + m5;
+}
+
+void
+MlasConvWinogradTransformOutput(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* TransformedOutput,
+    size_t FilterCount,
+    size_t TileY,
+    size_t TileX,
+    size_t TileCount,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a block of Winograd domain products back to 4x4
+    output tiles (Y = A^T * m * A) and stores the part of the tiles that is
+    inside the output image.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    TransformedOutput - Supplies the 36 product matrices of FilterCount rows by
+        TileCount columns.
+
+    FilterCount - Supplies the number of filters in the block.
+
+    TileY - Supplies the row of the tiles.
+
+    TileX - Supplies the column of the first tile.
+
+    TileCount - Supplies the number of tiles.
+
+    Output - Supplies the output tensor of the first filter in the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t MatrixSize = FilterCount * TileCount;
+    const float Beta = Parameters->Beta;
+
+    const size_t OriginY = TileY * MLAS_CONV_WINOGRAD_OUTPUT_TILE;
+    const size_t CountY = std::min<size_t>(OutputHeight - OriginY, MLAS_CONV_WINOGRAD_OUTPUT_TILE);
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        for (size_t t = 0; t < TileCount; t++) {
+
+            const float* m = TransformedOutput + f * TileCount + t;
+
+            //
+            // Compute A^T * m and then (A^T * m) * A.
+            //
+
+            float w[MLAS_CONV_WINOGRAD_OUTPUT_TILE][MLAS_CONV_WINOGRAD_INPUT_TILE];
+
+            for (size_t j = 0; j < MLAS_CONV_WINOGRAD_INPUT_TILE; j++) {
+
+                float o[MLAS_CONV_WINOGRAD_OUTPUT_TILE];
+
+                MlasConvWinogradTransformOutputRow(m + j * MatrixSize,
+                    MLAS_CONV_WINOGRAD_INPUT_TILE * MatrixSize, o);
+
+                for (size_t i = 0; i < MLAS_CONV_WINOGRAD_OUTPUT_TILE; i++) {
+                    w[i][j] = o[i];
+                }
+            }
+
+            const size_t OriginX = (TileX + t) * MLAS_CONV_WINOGRAD_OUTPUT_TILE;
+            const size_t CountX = std::min<size_t>(OutputWidth - OriginX, MLAS_CONV_WINOGRAD_OUTPUT_TILE);
+
+            float* output = Output + f * OutputSize + OriginY * OutputWidth + OriginX;
+
+            for (size_t i = 0; i < CountY; i++) {
+
+                float o[MLAS_CONV_WINOGRAD_OUTPUT_TILE];
+
+                MlasConvWinogradTransformOutputRow(w[i], 1, o);
+
+                if (Beta == 0.0f) {
+                    for (size_t j = 0; j < CountX; j++) {
+                        output[j] = o[j];
+                    }
+                } else {
+                    for (size_t j = 0; j < CountX; j++) {
+                        output[j] = Beta * output[j] + o[j];
+                    }
+                }
+
+                output += OutputWidth;
+            }
+        }
+    }
+}
+
+void
+MlasConvWinogradOperation(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    size_t TileY
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the Winograd F(4x4,3x3) convolution operation for
+    one row of output tiles of a group.
+
+    The row is processed in blocks of tiles: the input tiles are transformed,
+    multiplied with the transformed filter by one GEMM per tile element, and
+    the products are transformed back to the output image.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor of the group.
+
+    PackedFilter - Supplies the transformed filter of the group.
+
+    Bias - Optionally supplies the bias vector of the group.
+
+    WorkingBuffer - Supplies the thread local slice of the working buffer.
+
+    Output - Supplies the output tensor of the group.
+
+    TileY - Supplies the row of output tiles to compute.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t TileCountWidth = Parameters->u.Winograd.TileCountWidth;
+    const size_t FilterMatrixSize = FilterCount * InputChannels;
+
+    float* TransformedInput = WorkingBuffer;
+    float* TransformedOutput = WorkingBuffer +
+        MLAS_CONV_WINOGRAD_TILE_ELEMENTS * InputChannels * MLAS_CONV_WINOGRAD_TILE_BLOCK;
+
+    size_t TileCount;
+
+    for (size_t TileX = 0; TileX < TileCountWidth; TileX += TileCount) {
+
+        TileCount = std::min<size_t>(TileCountWidth - TileX, MLAS_CONV_WINOGRAD_TILE_BLOCK);
+
+        MlasConvWinogradTransformInput(Parameters, Input, TileY, TileX, TileCount,
+            TransformedInput);
+
+        //
+        // Step through the filters in blocks to bound the size of the product
+        // matrices.
+        //
+
+        size_t CountF;
+
+        for (size_t f = 0; f < FilterCount; f += CountF) {
+
+            CountF = std::min<size_t>(FilterCount - f, MLAS_CONV_WINOGRAD_FILTER_BLOCK);
+
+            for (size_t e = 0; e < MLAS_CONV_WINOGRAD_TILE_ELEMENTS; e++) {
+
+                MlasSgemmOperation(CblasNoTrans, CblasNoTrans, CountF, TileCount,
+                    InputChannels, 1.0f, PackedFilter + e * FilterMatrixSize + f * InputChannels,
+                    InputChannels, TransformedInput + e * InputChannels * TileCount, TileCount,
+                    0.0f, TransformedOutput + e * CountF * TileCount, TileCount);
+            }
+
+            MlasConvWinogradTransformOutput(Parameters, TransformedOutput, CountF, TileY,
+                TileX, TileCount, Output + f * OutputSize);
+        }
+    }
+
+    //
+    // Apply the activation with optional bias to the rows of the output image
+    // covered by the row of tiles.
+    //
+
+    const size_t OriginY = TileY * MLAS_CONV_WINOGRAD_OUTPUT_TILE;
+    const size_t CountY = std::min<size_t>(Parameters->OutputShape[0] - OriginY,
+        MLAS_CONV_WINOGRAD_OUTPUT_TILE);
+
+    MlasActivation(Parameters->Activation, Output + OriginY * OutputWidth, Bias, FilterCount,
+        CountY * OutputWidth, OutputSize);
+}
+
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    Winograd convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WORK_BLOCK* WorkBlock = (MLAS_CONV_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    //
+    // Compute the range of tile rows over all batches and groups to use for
+    // this thread.
+    //
+
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t TileCountHeight = Parameters->u.Winograd.TileCountHeight;
+    const size_t TotalWork = Parameters->BatchCount * GroupCount * TileCountHeight;
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->TargetThreadCount, TotalWork, &WorkIndex, &WorkRemaining);
+
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputGroupSize = Parameters->InputChannels * Parameters->InputSize;
+    const size_t OutputGroupSize = FilterCount * Parameters->OutputSize;
+    const size_t FilterGroupSize = MLAS_CONV_WINOGRAD_TILE_ELEMENTS * FilterCount * Parameters->InputChannels;
+
+    float* WorkingBuffer = WorkBlock->WorkingBuffer + Index * Parameters->u.Winograd.ThreadBufferSize;
+
+    for (size_t w = WorkIndex; w < WorkIndex + WorkRemaining; w++) {
+
+        const size_t bg = w / TileCountHeight;
+        const size_t group = bg % GroupCount;
+
+        const float* bias = WorkBlock->Bias;
+
+        if (bias != nullptr) {
+            bias += group * FilterCount;
+        }
+
+        MlasConvWinogradOperation(Parameters, WorkBlock->Input + bg * InputGroupSize,
+            WorkBlock->Filter + group * FilterGroupSize, bias, WorkingBuffer,
+            WorkBlock->Output + bg * OutputGroupSize, w % TileCountHeight);
+    }
+}
+
 inline
 bool
 MlasConvTryMultithread(
@@ -903,6 +1478,52 @@ Return Value:
         return;
     }
 
+    //
+    // Schedule rows of Winograd tiles across multiple threads.
+    //
+
+    if (Algorithm == MlasConvAlgorithmWinograd) {
+
+        const float* PackedFilter = Parameters->u.Winograd.PackedFilter;
+
+        if (PackedFilter == nullptr) {
+
+            //
+            // Transform the filter to the tail of the working buffer.
+            //
+
+            float* TransformedFilter =
+                WorkingBuffer + Parameters->ThreadCount * Parameters->u.Winograd.ThreadBufferSize;
+
+            MlasConvWinogradPackFilter(GroupCount, FilterCount, Parameters->InputChannels, Filter,
+                TransformedFilter);
+
+            PackedFilter = TransformedFilter;
+        }
+
+        const size_t TotalWork = BatchCount * GroupCount * Parameters->u.Winograd.TileCountHeight;
+
+        ptrdiff_t TargetThreadCount = std::min(Parameters->ThreadCount, MlasGetMaximumThreadCount(ThreadPool));
+
+        if (size_t(TargetThreadCount) >= TotalWork) {
+            TargetThreadCount = ptrdiff_t(TotalWork);
+        }
+
+        MLAS_CONV_WORK_BLOCK WorkBlock;
+
+        WorkBlock.Parameters = Parameters;
+        WorkBlock.Input = Input;
+        WorkBlock.Filter = PackedFilter;
+        WorkBlock.Bias = Bias;
+        WorkBlock.WorkingBuffer = WorkingBuffer;
+        WorkBlock.Output = Output;
+        WorkBlock.TargetThreadCount = TargetThreadCount;
+
+        MlasExecuteThreaded(MlasConvWinogradThreaded, &WorkBlock, TargetThreadCount, ThreadPool);
+
+        return;
+    }
+
 #if defined(MLAS_TARGET_WASM_SCALAR)
 
     if (Algorithm == MlasConvAlgorithmDepthwise) {
@@ -1002,6 +1623,15 @@ Return Value:
 
                     break;
                 }
+
+                case MlasConvAlgorithmWinograd:
+                {
+                    //
+                    // Handled above for all batches and groups.
+                    //
+
+                    break;
+                }
             }
 
             //
@@ -1211,6 +1841,57 @@ Return Value:
         }
     }
 
+    //
+    // Detect a 3x3 convolution with unit strides and dilations that has enough
+    // channels for the Winograd F(4x4,3x3) algorithm to reduce the number of
+    // multiplications compared to the expansion and GEMM.
+    //
+
+    if (Dimensions == 2 && AllStridesAreOne && AllDilationsAreOne &&
+        Parameters->KernelShape[0] == 3 && Parameters->KernelShape[1] == 3 &&
+        MlasConvWinogradSupportsChannels(FilterCount, InputChannels) &&
+        Parameters->OutputShape[0] >= MLAS_CONV_WINOGRAD_OUTPUT_TILE &&
+        Parameters->OutputShape[1] >= MLAS_CONV_WINOGRAD_OUTPUT_TILE) {
+
+        const size_t TileCountHeight = (Parameters->OutputShape[0] + MLAS_CONV_WINOGRAD_OUTPUT_TILE - 1) /
+            MLAS_CONV_WINOGRAD_OUTPUT_TILE;
+        const size_t TileCountWidth = (Parameters->OutputShape[1] + MLAS_CONV_WINOGRAD_OUTPUT_TILE - 1) /
+            MLAS_CONV_WINOGRAD_OUTPUT_TILE;
+
+        //
+        // Each thread processes whole rows of tiles, so the number of threads
+        // is limited by the number of tile rows over all batches and groups.
+        //
+
+        ptrdiff_t TargetThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+        const size_t TotalWork = BatchCount * GroupCount * TileCountHeight;
+
+        if (size_t(TargetThreadCount) >= TotalWork) {
+            TargetThreadCount = ptrdiff_t(TotalWork);
+        }
+
+        const size_t ThreadBufferSize = MLAS_CONV_WINOGRAD_TILE_ELEMENTS * MLAS_CONV_WINOGRAD_TILE_BLOCK *
+            (InputChannels + std::min<size_t>(FilterCount, MLAS_CONV_WINOGRAD_FILTER_BLOCK));
+
+        Parameters->ThreadCount = TargetThreadCount;
+
+        Parameters->Algorithm = MlasConvAlgorithmWinograd;
+        Parameters->u.Winograd.TileCountHeight = TileCountHeight;
+        Parameters->u.Winograd.TileCountWidth = TileCountWidth;
+        Parameters->u.Winograd.ThreadBufferSize = ThreadBufferSize;
+        Parameters->u.Winograd.PackedFilter = nullptr;
+
+        //
+        // The working buffer also holds the transformed filter unless a packed
+        // filter is supplied with MlasConvSetWinogradPackedFilter.
+        //
+
+        *WorkingBufferSize = TargetThreadCount * ThreadBufferSize +
+            MlasConvWinogradPackFilterSize(GroupCount, FilterCount, InputChannels);
+
+        return;
+    }
+
     if (FilterCount > OutputSize) {
 
         //
@@ -1299,4 +1980,155 @@ Return Value:
 }
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(pop)
-#endif
\ No newline at end of file
+#endif
+
+bool
+MLASCALL
+MlasConvWinogradSupportsChannels(
+    size_t FilterCount,
+    size_t InputChannels
+    )
+/*++
+
+Routine Description:
+
+    This routine returns whether a 3x3 convolution with unit strides and
+    dilations has enough channels for MlasConvPrepare to select the Winograd
+    algorithm. The algorithm is additionally only selected for outputs of at
+    least 4x4.
+
+Arguments:
+
+    FilterCount - Supplies the number of filters per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+Return Value:
+
+    Returns true if the Winograd algorithm may be selected.
+
+--*/
+{
+    return InputChannels >= MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS &&
+        FilterCount >= MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS;
+}
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the number of elements required to store the Winograd
+    transformed filter.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    FilterCount - Supplies the number of filters per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+Return Value:
+
+    Returns the number of elements of the transformed filter.
+
+--*/
+{
+    return GroupCount * MLAS_CONV_WINOGRAD_TILE_ELEMENTS * FilterCount * InputChannels;
+}
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    float* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a 3x3 filter tensor to the Winograd domain, so
+    that it can be supplied to MlasConvSetWinogradPackedFilter once instead of
+    being transformed by every call to MlasConv.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    FilterCount - Supplies the number of filters per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    Filter - Supplies the filter tensor in the layout of MlasConv.
+
+    PackedFilter - Supplies the buffer to receive the transformed filter. The
+        buffer must hold the number of elements returned by
+        MlasConvWinogradPackFilterSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t FilterGroupSize = FilterCount * InputChannels;
+
+    for (size_t group = 0; group < GroupCount; group++) {
+
+        MlasConvWinogradTransformFilter(FilterCount, InputChannels,
+            Filter + group * FilterGroupSize * 9,
+            PackedFilter + group * MLAS_CONV_WINOGRAD_TILE_ELEMENTS * FilterGroupSize);
+    }
+}
+
+void
+MLASCALL
+MlasConvSetWinogradPackedFilter(
+    MLAS_CONV_PARAMETERS* Parameters,
+    const float* PackedFilter,
+    size_t* WorkingBufferSize
+    )
+/*++
+
+Routine Description:
+
+    This routine supplies the filter packed by MlasConvWinogradPackFilter to a
+    convolution prepared by MlasConvPrepare. This does nothing if the
+    convolution does not use the Winograd algorithm.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    PackedFilter - Supplies the transformed filter. The buffer must remain
+        valid for as long as the parameters are used.
+
+    WorkingBufferSize - Supplies the number of elements of the working buffer
+        returned by MlasConvPrepare and receives the number of elements that
+        are still required.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Parameters->Algorithm != MlasConvAlgorithmWinograd || Parameters->u.Winograd.PackedFilter != nullptr) {
+        return;
+    }
+
+    Parameters->u.Winograd.PackedFilter = PackedFilter;
+
+    *WorkingBufferSize = Parameters->ThreadCount * Parameters->u.Winograd.ThreadBufferSize;
+}
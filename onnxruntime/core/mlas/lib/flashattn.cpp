@@ -1,7 +1,75 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 #include <numeric>
 
 #include "mlasi.h"
 
+namespace {
+
+//
+// Returns the range [lo, hi) of valid columns of one query row within the key
+// block [ir, ir + row_size_kv), relative to the start of the block.
+//
+void
+MlasFlashAttentionValidColumns(
+    const MlasFlashAttentionThreadedArgs* args,
+    ptrdiff_t head_idx,
+    ptrdiff_t q_position,
+    ptrdiff_t ir,
+    ptrdiff_t row_size_kv,
+    ptrdiff_t& lo,
+    ptrdiff_t& hi
+)
+{
+    lo = 0;
+    hi = row_size_kv;
+
+    if (args->causal) {
+        hi = std::min(hi, q_position + 1 - ir);
+        if (args->local_window_size > 0) {
+            lo = std::max(lo, q_position - args->local_window_size - ir);
+        }
+    }
+
+    if (args->sparse_block_size > 0 && lo < hi) {
+        const ptrdiff_t layout = head_idx % args->num_sparse_layout;
+        const int32_t* row_indices = args->sparse_block_row_indices + layout * args->sparse_stride_row_indices;
+        const int32_t* col_indices = args->sparse_block_col_indices + layout * args->sparse_stride_col_indices;
+        const ptrdiff_t block_row = q_position / args->sparse_block_size;
+        const int32_t block_col = static_cast<int32_t>(ir / args->sparse_block_size);
+        const int32_t* row_begin = col_indices + row_indices[block_row];
+        const int32_t* row_end = col_indices + row_indices[block_row + 1];
+        if (std::find(row_begin, row_end, block_col) == row_end) {
+            hi = lo;
+        }
+    }
+}
+
+}  // namespace
+
+size_t
+MLASCALL
+MlasFlashAttentionGetBufferSizePerThread(
+    const MlasFlashAttentionThreadedArgs* args
+)
+{
+    const size_t q_block_size = static_cast<size_t>(args->q_block_size);
+    const size_t kv_block_size = static_cast<size_t>(args->kv_block_size);
+    const size_t qk_head_size = static_cast<size_t>(args->qk_head_size);
+    const size_t v_head_size = static_cast<size_t>(args->v_head_size);
+
+    // l, m, intermediate and temp_output.
+    size_t element_count = q_block_size * 2 + q_block_size * kv_block_size + q_block_size * v_head_size;
+
+    // fp32 copies of the query block and the key/value blocks.
+    if (args->query_fp16 != nullptr) {
+        element_count += q_block_size * qk_head_size + kv_block_size * (qk_head_size + v_head_size);
+    }
+
+    return element_count * sizeof(float);
+}
+
 void
 MlasFlashAttentionThreaded(
     void* argptr,
@@ -25,6 +93,17 @@ MlasFlashAttentionThreaded(
     const float* value = args->value;
     float* output = args->output;
 
+    const bool is_fp16 = args->query_fp16 != nullptr;
+    ptrdiff_t kv_num_heads = args->kv_num_heads > 0 ? static_cast<ptrdiff_t>(args->kv_num_heads) : num_heads;
+    ptrdiff_t kv_buffer_sequence_length = args->kv_buffer_sequence_length > 0
+                                              ? static_cast<ptrdiff_t>(args->kv_buffer_sequence_length)
+                                              : kv_sequence_length;
+    ptrdiff_t q_batch_stride = args->q_batch_stride > 0 ? args->q_batch_stride
+                                                        : num_heads * q_sequence_length * qk_head_size;
+    ptrdiff_t kv_num_heads_factor = num_heads / kv_num_heads;
+
+    assert(args->sparse_block_size == 0 || args->sparse_block_size == args->kv_block_size);
+
 #if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
     auto&& mlas_platform = GetMlasPlatform();
 #endif
@@ -50,18 +129,62 @@ MlasFlashAttentionThreaded(
         batch_idx /= q_chunk_count;
         ptrdiff_t head_idx = batch_idx % num_heads;
         batch_idx /= num_heads;
+        ptrdiff_t kv_head_idx = head_idx / kv_num_heads_factor;
 
         char* buffer_current_thread = reinterpret_cast<char*>(buffer) + thread_id * buffer_size_per_thread;
         float* l = reinterpret_cast<float*>(buffer_current_thread);
         float* m = l + q_block_size;
-        for (ptrdiff_t t = 0; t < q_block_size; ++t) {
-            m[t] = std::numeric_limits<float>::lowest();
-        }
         float* intermediate = m + q_block_size;
         float* temp_output = intermediate + q_block_size * kv_block_size;
+        float* q_fp32 = temp_output + q_block_size * v_head_size;
+        float* k_fp32 = q_fp32 + q_block_size * qk_head_size;
+        float* v_fp32 = k_fp32 + kv_block_size * qk_head_size;
+
+        //
+        // The smooth softmax adds an implicit score of zero to every row.
+        //
+        for (ptrdiff_t t = 0; t < q_block_size; ++t) {
+            m[t] = args->smooth_softmax ? 0.0f : std::numeric_limits<float>::lowest();
+            l[t] = args->smooth_softmax ? 1.0f : 0.0f;
+        }
         float negmax = 0;
 
-        for (ptrdiff_t ir = 0; ir < kv_sequence_length; ir += kv_block_size) {
+        ptrdiff_t kv_valid_length = kv_sequence_length;
+        if (args->kv_valid_lengths != nullptr) {
+            kv_valid_length = std::min(kv_valid_length, static_cast<ptrdiff_t>(args->kv_valid_lengths[batch_idx]));
+        }
+
+        size_t row_size_q_capped = static_cast<size_t>(std::min(q_block_size, q_sequence_length - q_idx));
+
+        //
+        // Restrict the key range to the blocks that may be visible to this
+        // query block.
+        //
+        ptrdiff_t past_length = std::max(kv_valid_length - q_sequence_length, ptrdiff_t(0));
+        ptrdiff_t q_position = past_length + q_idx;
+        ptrdiff_t kv_begin = 0;
+        ptrdiff_t kv_end = kv_valid_length;
+        if (args->causal) {
+            kv_end = std::min(kv_end, q_position + static_cast<ptrdiff_t>(row_size_q_capped));
+            if (args->local_window_size > 0) {
+                kv_begin = std::max(q_position - args->local_window_size, ptrdiff_t(0));
+                kv_begin = (kv_begin / kv_block_size) * kv_block_size;
+            }
+        }
+
+        const float* inputQ;
+        if (is_fp16) {
+            MlasConvertHalfToFloatBuffer(args->query_fp16 + batch_idx * q_batch_stride + (head_idx * q_sequence_length + q_idx) * qk_head_size,
+                                         q_fp32,
+                                         row_size_q_capped * static_cast<size_t>(qk_head_size));
+            inputQ = q_fp32;
+        } else {
+            inputQ = query + batch_idx * q_batch_stride + (head_idx * q_sequence_length + q_idx) * qk_head_size;
+        }
+
+        bool first_block = true;
+
+        for (ptrdiff_t ir = kv_begin; ir < kv_end; ir += kv_block_size) {
             /*
                 S = Q[batch_idx, head_idx, q_idx:q_idx+q_block_size, :] * (K[batch_idx, head_idx, ir:ir+kv_block_size, :]).T
                 old_m = m
@@ -71,13 +194,36 @@ MlasFlashAttentionThreaded(
                 l = exp(diff) * l + rowsum(S)
                 O = diag(exp(diff)) * O + S * V[batch_idx, head_idx, ir:ir+kv_block_size, :]
             */
-            ptrdiff_t h = batch_idx * num_heads + head_idx;
-            const float* inputQ = query + (h * q_sequence_length + q_idx) * qk_head_size;
-            const float* inputK = key + (h * kv_sequence_length + ir) * qk_head_size;
-            const float* inputV = value + (h * kv_sequence_length + ir) * v_head_size;
+            ptrdiff_t row_size_kv = std::min(kv_block_size, kv_end - ir);
+            size_t row_size_kv_capped = static_cast<size_t>(row_size_kv);
+
+            //
+            // Skip key blocks that are masked for every row of the query block.
+            //
+            bool any_visible = false;
+            for (ptrdiff_t irow = 0; irow < static_cast<ptrdiff_t>(row_size_q_capped) && !any_visible; ++irow) {
+                ptrdiff_t lo, hi;
+                MlasFlashAttentionValidColumns(args, head_idx, q_position + irow, ir, row_size_kv, lo, hi);
+                any_visible = lo < hi;
+            }
+            if (!any_visible) {
+                continue;
+            }
 
-            size_t row_size_q_capped = static_cast<size_t>(std::min(q_block_size, q_sequence_length - q_idx));
-            size_t row_size_kv_capped = static_cast<size_t>(std::min(kv_block_size, kv_sequence_length - ir));
+            ptrdiff_t kv_offset = (batch_idx * kv_num_heads + kv_head_idx) * kv_buffer_sequence_length + ir;
+            const float* inputK;
+            const float* inputV;
+            if (is_fp16) {
+                MlasConvertHalfToFloatBuffer(args->key_fp16 + kv_offset * qk_head_size, k_fp32,
+                                             row_size_kv_capped * static_cast<size_t>(qk_head_size));
+                MlasConvertHalfToFloatBuffer(args->value_fp16 + kv_offset * v_head_size, v_fp32,
+                                             row_size_kv_capped * static_cast<size_t>(v_head_size));
+                inputK = k_fp32;
+                inputV = v_fp32;
+            } else {
+                inputK = key + kv_offset * qk_head_size;
+                inputV = value + kv_offset * v_head_size;
+            }
 
             MlasSgemmOperation(CBLAS_TRANSPOSE::CblasNoTrans,
                      CBLAS_TRANSPOSE::CblasTrans,
@@ -96,10 +242,27 @@ MlasFlashAttentionThreaded(
             for (ptrdiff_t irow = 0; irow < static_cast<ptrdiff_t>(row_size_q_capped); ++irow) {
                 float* p = intermediate + irow * row_size_kv_capped;
 
+                ptrdiff_t lo, hi;
+                MlasFlashAttentionValidColumns(args, head_idx, q_position + irow, ir, row_size_kv, lo, hi);
+                if (lo >= hi) {
+                    // The row sees no key in this block, so it contributes nothing to O.
+                    std::fill_n(p, row_size_kv_capped, 0.0f);
+                    continue;
+                }
+
+                float* p_valid = p + lo;
+                size_t valid_count = static_cast<size_t>(hi - lo);
+
+                if (args->softcap > 0.0f) {
+                    for (size_t i = 0; i < valid_count; i++) {
+                        p_valid[i] = args->softcap * std::tanh(p_valid[i] / args->softcap);
+                    }
+                }
+
 #if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
-                float rowmax = mlas_platform.ReduceMaximumF32Kernel(p, row_size_kv_capped);
+                float rowmax = mlas_platform.ReduceMaximumF32Kernel(p_valid, valid_count);
 #else
-                float rowmax = MlasReduceMaximumF32Kernel(p, row_size_kv_capped);
+                float rowmax = MlasReduceMaximumF32Kernel(p_valid, valid_count);
 #endif
                 float m_diff = m[irow];
                 m[irow] = std::max(m[irow], rowmax);  // new m
@@ -107,22 +270,21 @@ MlasFlashAttentionThreaded(
                 m_diff -= m[irow];  // old - new (less than 0)
 
 #if defined(MLAS_TARGET_AMD64)
-                float rowsum = mlas_platform.ComputeSumExpF32Kernel(p, p, row_size_kv_capped, &negmax);
+                float rowsum = mlas_platform.ComputeSumExpF32Kernel(p_valid, p_valid, valid_count, &negmax);
 #else
-                float rowsum = MlasComputeSumExpF32Kernel(p, p, row_size_kv_capped, &negmax);
+                float rowsum = MlasComputeSumExpF32Kernel(p_valid, p_valid, valid_count, &negmax);
 #endif
+                std::fill(p, p_valid, 0.0f);
+                std::fill(p + hi, p + row_size_kv, 0.0f);
 
-                // Note: for ir == 0, there is actually no need to calculate exp_diff
-                if (ir != 0) {
-                    float exp_diff = std::exp(m_diff);
-                    l[irow] = exp_diff * l[irow] + rowsum;
+                float exp_diff = std::exp(m_diff);
+                l[irow] = exp_diff * l[irow] + rowsum;
 
+                // There is no need to scale the old result of the first block because it is overwritten.
+                if (!first_block) {
                     for (ptrdiff_t icol = 0; icol < v_head_size; ++icol) {
                         temp_output[irow * v_head_size + icol] = exp_diff * temp_output[irow * v_head_size + icol];
                     }
-                } else {
-                    l[irow] = rowsum;
-                    // When ir == 0, there is no need to scale the old result because it is zero.
                 }
             }
             MlasSgemmOperation(CBLAS_TRANSPOSE::CblasNoTrans,
@@ -135,19 +297,36 @@ MlasFlashAttentionThreaded(
                      row_size_kv_capped,
                      inputV,
                      static_cast<size_t>(v_head_size),
-                     ir == 0 ? 0.0f : 1.0f,
+                     first_block ? 0.0f : 1.0f,
                      temp_output,
                      static_cast<size_t>(v_head_size));
+
+            first_block = false;
+        }
+
+        if (first_block) {
+            std::fill_n(temp_output, row_size_q_capped * static_cast<size_t>(v_head_size), 0.0f);
         }
 
-        float* output_row = output + ((batch_idx * q_sequence_length + q_idx) * num_heads + head_idx) * v_head_size;
-        ptrdiff_t row_size_q_valid = std::min(q_block_size, q_sequence_length - q_idx);
+        ptrdiff_t output_offset = ((batch_idx * q_sequence_length + q_idx) * num_heads + head_idx) * v_head_size;
+        ptrdiff_t row_size_q_valid = static_cast<ptrdiff_t>(row_size_q_capped);
         // TODO: leverage advanced instruction sets
         for (ptrdiff_t irow = 0; irow < row_size_q_valid; ++irow) {
-            for (ptrdiff_t icol = 0; icol < v_head_size; ++icol) {
-                output_row[icol] = temp_output[irow * v_head_size + icol] / l[irow];
+            float* temp_output_row = temp_output + irow * v_head_size;
+            float inverse_l = l[irow] > 0.0f ? 1.0f / l[irow] : 0.0f;
+            if (is_fp16) {
+                for (ptrdiff_t icol = 0; icol < v_head_size; ++icol) {
+                    temp_output_row[icol] *= inverse_l;
+                }
+                MlasConvertFloatToHalfBuffer(temp_output_row, args->output_fp16 + output_offset,
+                                             static_cast<size_t>(v_head_size));
+            } else {
+                float* output_row = output + output_offset;
+                for (ptrdiff_t icol = 0; icol < v_head_size; ++icol) {
+                    output_row[icol] = temp_output_row[icol] * inverse_l;
+                }
             }
-            output_row += num_heads * v_head_size;
+            output_offset += num_heads * v_head_size;
         }
     }
 }
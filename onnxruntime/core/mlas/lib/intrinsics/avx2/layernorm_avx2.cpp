@@ -0,0 +1,62 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_avx2.cpp
+
+Abstract:
+
+    This module implements the fused layer normalization kernel with AVX2 and
+    FMA3 instructions.
+
+--*/
+
+#include "../../layernorm.h"
+
+struct MLAS_LAYER_NORM_KERNEL_AVX2 {
+    using VectorType = __m256;
+    static constexpr size_t VectorCount = 8;
+
+    static MLAS_FORCEINLINE VectorType Load(const float* Buffer) { return _mm256_loadu_ps(Buffer); }
+    static MLAS_FORCEINLINE void Store(float* Buffer, VectorType Vector) { _mm256_storeu_ps(Buffer, Vector); }
+    static MLAS_FORCEINLINE VectorType Broadcast(float Value) { return _mm256_set1_ps(Value); }
+    static MLAS_FORCEINLINE VectorType Zero() { return _mm256_setzero_ps(); }
+    static MLAS_FORCEINLINE VectorType Add(VectorType a, VectorType b) { return _mm256_add_ps(a, b); }
+    static MLAS_FORCEINLINE VectorType Subtract(VectorType a, VectorType b) { return _mm256_sub_ps(a, b); }
+    static MLAS_FORCEINLINE VectorType Multiply(VectorType a, VectorType b) { return _mm256_mul_ps(a, b); }
+    static MLAS_FORCEINLINE VectorType MultiplyAdd(VectorType a, VectorType b, VectorType c)
+    {
+        return _mm256_fmadd_ps(a, b, c);
+    }
+    static MLAS_FORCEINLINE float ReduceAdd(VectorType Vector)
+    {
+        __m128 Sum = _mm_add_ps(_mm256_castps256_ps128(Vector), _mm256_extractf128_ps(Vector, 1));
+        return MlasReduceAddFloat32x4(Sum);
+    }
+};
+
+void
+MLASCALL
+MlasLayerNormF32KernelAvx2(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+{
+    MlasLayerNormF32KernelImpl<MLAS_LAYER_NORM_KERNEL_AVX2>(
+        Input, Skip, Bias, Scale, Shift, Output, SkipOutput, N, Epsilon, Simplified, Mean, InvStdDev
+    );
+}
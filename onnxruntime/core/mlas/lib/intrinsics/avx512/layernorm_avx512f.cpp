@@ -0,0 +1,58 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_avx512f.cpp
+
+Abstract:
+
+    This module implements the fused layer normalization kernel with AVX512F
+    instructions.
+
+--*/
+
+#include "../../layernorm.h"
+
+struct MLAS_LAYER_NORM_KERNEL_AVX512F {
+    using VectorType = __m512;
+    static constexpr size_t VectorCount = 16;
+
+    static MLAS_FORCEINLINE VectorType Load(const float* Buffer) { return _mm512_loadu_ps(Buffer); }
+    static MLAS_FORCEINLINE void Store(float* Buffer, VectorType Vector) { _mm512_storeu_ps(Buffer, Vector); }
+    static MLAS_FORCEINLINE VectorType Broadcast(float Value) { return _mm512_set1_ps(Value); }
+    static MLAS_FORCEINLINE VectorType Zero() { return _mm512_setzero_ps(); }
+    static MLAS_FORCEINLINE VectorType Add(VectorType a, VectorType b) { return _mm512_add_ps(a, b); }
+    static MLAS_FORCEINLINE VectorType Subtract(VectorType a, VectorType b) { return _mm512_sub_ps(a, b); }
+    static MLAS_FORCEINLINE VectorType Multiply(VectorType a, VectorType b) { return _mm512_mul_ps(a, b); }
+    static MLAS_FORCEINLINE VectorType MultiplyAdd(VectorType a, VectorType b, VectorType c)
+    {
+        return _mm512_fmadd_ps(a, b, c);
+    }
+    static MLAS_FORCEINLINE float ReduceAdd(VectorType Vector) { return _mm512_reduce_add_ps(Vector); }
+};
+
+void
+MLASCALL
+MlasLayerNormF32KernelAvx512F(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+{
+    MlasLayerNormF32KernelImpl<MLAS_LAYER_NORM_KERNEL_AVX512F>(
+        Input, Skip, Bias, Scale, Shift, Output, SkipOutput, N, Epsilon, Simplified, Mean, InvStdDev
+    );
+}
@@ -0,0 +1,209 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements fused layer normalization routines: LayerNorm,
+    SimplifiedLayerNorm (RMSNorm) and SkipLayerNorm with an optional bias and
+    residual output, for fp32 and fp16 rows, with an optional quantized output.
+
+--*/
+
+#include "layernorm.h"
+
+struct MLAS_LAYER_NORM_KERNEL_FLOAT32X4 {
+    using VectorType = MLAS_FLOAT32X4;
+    static constexpr size_t VectorCount = 4;
+
+    static MLAS_FORCEINLINE VectorType Load(const float* Buffer) { return MlasLoadFloat32x4(Buffer); }
+    static MLAS_FORCEINLINE void Store(float* Buffer, VectorType Vector) { MlasStoreFloat32x4(Buffer, Vector); }
+    static MLAS_FORCEINLINE VectorType Broadcast(float Value) { return MlasBroadcastFloat32x4(Value); }
+    static MLAS_FORCEINLINE VectorType Zero() { return MlasZeroFloat32x4(); }
+    static MLAS_FORCEINLINE VectorType Add(VectorType a, VectorType b) { return MlasAddFloat32x4(a, b); }
+    static MLAS_FORCEINLINE VectorType Subtract(VectorType a, VectorType b) { return MlasSubtractFloat32x4(a, b); }
+    static MLAS_FORCEINLINE VectorType Multiply(VectorType a, VectorType b) { return MlasMultiplyFloat32x4(a, b); }
+    static MLAS_FORCEINLINE VectorType MultiplyAdd(VectorType a, VectorType b, VectorType c)
+    {
+        return MlasMultiplyAddFloat32x4(a, b, c);
+    }
+    static MLAS_FORCEINLINE float ReduceAdd(VectorType Vector) { return MlasReduceAddFloat32x4(Vector); }
+};
+
+void
+MLASCALL
+MlasLayerNormF32Kernel(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+{
+    MlasLayerNormF32KernelImpl<MLAS_LAYER_NORM_KERNEL_FLOAT32X4>(
+        Input, Skip, Bias, Scale, Shift, Output, SkipOutput, N, Epsilon, Simplified, Mean, InvStdDev
+    );
+}
+
+MLAS_FORCEINLINE
+void
+MlasLayerNormF32(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().LayerNormF32Kernel(
+        Input, Skip, Bias, Scale, Shift, Output, SkipOutput, N, Epsilon, Simplified, Mean, InvStdDev
+    );
+#else
+    MlasLayerNormF32Kernel(Input, Skip, Bias, Scale, Shift, Output, SkipOutput, N, Epsilon, Simplified, Mean, InvStdDev);
+#endif
+}
+
+template <>
+void
+MLASCALL
+MlasLayerNormalization<float>(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+{
+    MlasLayerNormF32(Input, Skip, Bias, Scale, Shift, Output, SkipOutput, N, Epsilon, Simplified, Mean, InvStdDev);
+}
+
+template <>
+void
+MLASCALL
+MlasLayerNormalization<MLAS_FP16>(
+    const MLAS_FP16* Input,
+    const MLAS_FP16* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    MLAS_FP16* Output,
+    MLAS_FP16* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+{
+    //
+    // The row is widened into a per thread buffer, normalized in place and
+    // narrowed once, so the fp32 copy stays in cache between the passes.
+    //
+
+    MlasThreadedBufAlloc(2 * N * sizeof(float));
+    float* InputBuffer = reinterpret_cast<float*>(ThreadedBufHolder.get());
+    float* SkipBuffer = InputBuffer + N;
+
+    MlasConvertHalfToFloatBuffer(Input, InputBuffer, N);
+    if (Skip != nullptr) {
+        MlasConvertHalfToFloatBuffer(Skip, SkipBuffer, N);
+    }
+
+    MlasLayerNormF32(InputBuffer, Skip != nullptr ? SkipBuffer : nullptr, Bias, Scale, Shift, InputBuffer,
+                     SkipOutput != nullptr ? SkipBuffer : nullptr, N, Epsilon, Simplified, Mean, InvStdDev);
+
+    MlasConvertFloatToHalfBuffer(InputBuffer, Output, N);
+    if (SkipOutput != nullptr) {
+        MlasConvertFloatToHalfBuffer(SkipBuffer, SkipOutput, N);
+    }
+}
+
+template <typename OutputType>
+void
+MLASCALL
+MlasLayerNormalizationQuantizeLinear(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    OutputType* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float OutputScale,
+    OutputType ZeroPoint
+    )
+{
+    MlasThreadedBufAlloc(N * sizeof(float));
+    float* OutputBuffer = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+    MlasLayerNormF32(Input, Skip, Bias, Scale, Shift, OutputBuffer, SkipOutput, N, Epsilon, Simplified, nullptr, nullptr);
+
+    MlasQuantizeLinear(OutputBuffer, Output, N, OutputScale, ZeroPoint);
+}
+
+template
+void
+MLASCALL
+MlasLayerNormalizationQuantizeLinear<int8_t>(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    int8_t* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float OutputScale,
+    int8_t ZeroPoint
+    );
+
+template
+void
+MLASCALL
+MlasLayerNormalizationQuantizeLinear<uint8_t>(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    uint8_t* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float OutputScale,
+    uint8_t ZeroPoint
+    );
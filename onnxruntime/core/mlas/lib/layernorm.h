@@ -0,0 +1,237 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.h
+
+Abstract:
+
+    This module implements the single row layer normalization kernel shared by
+    the portable and the instruction set specific implementations.
+
+    The kernel makes one pass over the row to form x = Input + Skip + Bias,
+    store it to the output and accumulate the statistics, and a second pass to
+    normalize the stored row in place. The mean and variance are accumulated
+    with Welford's algorithm in each vector lane and the lanes are combined at
+    the end, which avoids the cancellation of E[x^2] - E[x]^2 for rows with a
+    large mean.
+
+    KernelType supplies the vector type and the primitive operations:
+
+        VectorType, VectorCount, Load, Store, Broadcast, Zero, Add, Subtract,
+        Multiply, MultiplyAdd (a * b + c) and ReduceAdd.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+#include <cmath>
+
+//
+// Welford update of a running mean and sum of squared deviations.
+//
+
+MLAS_FORCEINLINE
+void
+MlasLayerNormWelfordUpdate(
+    float Value,
+    size_t& Count,
+    float& Mean,
+    float& M2
+    )
+{
+    Count++;
+    const float Delta = Value - Mean;
+    Mean += Delta / float(Count);
+    M2 += Delta * (Value - Mean);
+}
+
+template <typename KernelType>
+MLAS_FORCEINLINE
+typename KernelType::VectorType
+MlasLayerNormLoadSum(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    size_t i
+    )
+{
+    auto Value = KernelType::Load(Input + i);
+    if (Skip != nullptr) {
+        Value = KernelType::Add(Value, KernelType::Load(Skip + i));
+    }
+    if (Bias != nullptr) {
+        Value = KernelType::Add(Value, KernelType::Load(Bias + i));
+    }
+    return Value;
+}
+
+template <typename KernelType>
+void
+MlasLayerNormF32KernelImpl(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+{
+    using VectorType = typename KernelType::VectorType;
+    constexpr size_t VectorCount = KernelType::VectorCount;
+
+    size_t i = 0;
+    float RowMean = 0.0f;
+    float RowVariance;
+
+    if (Simplified) {
+
+        //
+        // Accumulate the sum of squares.
+        //
+
+        VectorType SumSquare0 = KernelType::Zero();
+        VectorType SumSquare1 = KernelType::Zero();
+
+        for (; i + 2 * VectorCount <= N; i += 2 * VectorCount) {
+            VectorType Value0 = MlasLayerNormLoadSum<KernelType>(Input, Skip, Bias, i);
+            VectorType Value1 = MlasLayerNormLoadSum<KernelType>(Input, Skip, Bias, i + VectorCount);
+            KernelType::Store(Output + i, Value0);
+            KernelType::Store(Output + i + VectorCount, Value1);
+            if (SkipOutput != nullptr) {
+                KernelType::Store(SkipOutput + i, Value0);
+                KernelType::Store(SkipOutput + i + VectorCount, Value1);
+            }
+            SumSquare0 = KernelType::MultiplyAdd(Value0, Value0, SumSquare0);
+            SumSquare1 = KernelType::MultiplyAdd(Value1, Value1, SumSquare1);
+        }
+
+        float SumSquare = KernelType::ReduceAdd(KernelType::Add(SumSquare0, SumSquare1));
+
+        for (; i < N; i++) {
+            float Value = Input[i] + (Skip != nullptr ? Skip[i] : 0.0f) + (Bias != nullptr ? Bias[i] : 0.0f);
+            Output[i] = Value;
+            if (SkipOutput != nullptr) {
+                SkipOutput[i] = Value;
+            }
+            SumSquare += Value * Value;
+        }
+
+        RowVariance = SumSquare / float(N);
+
+    } else {
+
+        //
+        // Each lane of the two accumulator sets has seen the same number of
+        // elements, so the update uses a single reciprocal per step.
+        //
+
+        VectorType Mean0 = KernelType::Zero();
+        VectorType Mean1 = KernelType::Zero();
+        VectorType M20 = KernelType::Zero();
+        VectorType M21 = KernelType::Zero();
+        size_t Steps = 0;
+
+        for (; i + 2 * VectorCount <= N; i += 2 * VectorCount) {
+            VectorType Value0 = MlasLayerNormLoadSum<KernelType>(Input, Skip, Bias, i);
+            VectorType Value1 = MlasLayerNormLoadSum<KernelType>(Input, Skip, Bias, i + VectorCount);
+            KernelType::Store(Output + i, Value0);
+            KernelType::Store(Output + i + VectorCount, Value1);
+            if (SkipOutput != nullptr) {
+                KernelType::Store(SkipOutput + i, Value0);
+                KernelType::Store(SkipOutput + i + VectorCount, Value1);
+            }
+
+            Steps++;
+            const VectorType Reciprocal = KernelType::Broadcast(1.0f / float(Steps));
+
+            VectorType Delta0 = KernelType::Subtract(Value0, Mean0);
+            VectorType Delta1 = KernelType::Subtract(Value1, Mean1);
+            Mean0 = KernelType::MultiplyAdd(Delta0, Reciprocal, Mean0);
+            Mean1 = KernelType::MultiplyAdd(Delta1, Reciprocal, Mean1);
+            M20 = KernelType::MultiplyAdd(Delta0, KernelType::Subtract(Value0, Mean0), M20);
+            M21 = KernelType::MultiplyAdd(Delta1, KernelType::Subtract(Value1, Mean1), M21);
+        }
+
+        //
+        // Combine the lanes. All lanes have the same count, so the combined
+        // mean is the average of the lane means and the spread of the lane
+        // means adds Steps * sum((mean_lane - mean)^2) to the sum of squares.
+        //
+
+        size_t Count = 0;
+        float M2 = 0.0f;
+
+        if (Steps > 0) {
+            MLAS_DECLSPEC_ALIGN(float LaneMeans[2 * VectorCount], 64);
+            KernelType::Store(LaneMeans, Mean0);
+            KernelType::Store(LaneMeans + VectorCount, Mean1);
+
+            Count = Steps * 2 * VectorCount;
+            RowMean = KernelType::ReduceAdd(KernelType::Add(Mean0, Mean1)) / float(2 * VectorCount);
+            M2 = KernelType::ReduceAdd(KernelType::Add(M20, M21));
+
+            float Spread = 0.0f;
+            for (size_t lane = 0; lane < 2 * VectorCount; lane++) {
+                const float Delta = LaneMeans[lane] - RowMean;
+                Spread += Delta * Delta;
+            }
+            M2 += Spread * float(Steps);
+        }
+
+        for (; i < N; i++) {
+            float Value = Input[i] + (Skip != nullptr ? Skip[i] : 0.0f) + (Bias != nullptr ? Bias[i] : 0.0f);
+            Output[i] = Value;
+            if (SkipOutput != nullptr) {
+                SkipOutput[i] = Value;
+            }
+            MlasLayerNormWelfordUpdate(Value, Count, RowMean, M2);
+        }
+
+        RowVariance = std::max(M2 / float(N), 0.0f);
+    }
+
+    const float RowInvStdDev = 1.0f / std::sqrt(RowVariance + Epsilon);
+
+    if (Mean != nullptr && !Simplified) {
+        *Mean = RowMean;
+    }
+    if (InvStdDev != nullptr) {
+        *InvStdDev = RowInvStdDev;
+    }
+
+    //
+    // Normalize in place: y = (x - Mean) * (Scale * InvStdDev) + Shift. The
+    // mean is subtracted first so that rows with a large mean keep their
+    // precision.
+    //
+
+    const VectorType InvStdDevVector = KernelType::Broadcast(RowInvStdDev);
+    const VectorType MeanVector = KernelType::Broadcast(RowMean);
+
+    i = 0;
+    for (; i + VectorCount <= N; i += VectorCount) {
+        VectorType Multiplier = KernelType::Multiply(KernelType::Load(Scale + i), InvStdDevVector);
+        VectorType Offset = (Shift != nullptr && !Simplified) ? KernelType::Load(Shift + i) : KernelType::Zero();
+        VectorType Centered = KernelType::Subtract(KernelType::Load(Output + i), MeanVector);
+        KernelType::Store(Output + i, KernelType::MultiplyAdd(Centered, Multiplier, Offset));
+    }
+
+    for (; i < N; i++) {
+        const float Multiplier = Scale[i] * RowInvStdDev;
+        const float Offset = (Shift != nullptr && !Simplified) ? Shift[i] : 0.0f;
+        Output[i] = (Output[i] - RowMean) * Multiplier + Offset;
+    }
+}
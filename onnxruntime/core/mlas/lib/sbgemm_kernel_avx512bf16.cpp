@@ -0,0 +1,289 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_avx512bf16.cpp
+
+Abstract:
+
+    This module implements bfloat16 precision GEMM kernel for x64 processors
+    with the AVX512-BF16 extensions.
+
+    Matrix B is converted to bf16 and packed in panels of 16 columns. Within
+    a panel, two consecutive rows of K are interleaved so that each 32-bit
+    lane holds the pair of bf16 values consumed by one vdpbf16ps lane. Matrix
+    A is converted to bf16 pairs on the fly, one block of rows at a time.
+
+--*/
+
+#include "sbgemm.h"
+
+#if defined(MLAS_SBGEMM_SUPPORTED) && defined(MLAS_TARGET_AMD64)
+
+#include <immintrin.h>
+
+struct MLAS_SBGEMM_KERNEL_AVX512BF16 {
+    static constexpr bool PackNeeded = true;
+    static constexpr size_t KernelMaxM = 4;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 2;
+    static constexpr size_t PackedN = MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+    static constexpr MLAS_SBGEMM_STRIDES Strides{128, 128, 256};  // M:N:K
+};
+
+//
+// Both the packed and non-packed drivers step through K in slices of at most
+// Strides.K, which bounds the depth seen by a single kernel call.
+//
+
+constexpr size_t MlasSBGemmAvx512Bf16MaximumCountK = MLAS_SBGEMM_KERNEL_AVX512BF16::Strides.K;
+
+static_assert(MLAS_SBGEMM_KERNEL_AVX512BF16::PackedN == 16, "kernel assumes 16 column panels");
+
+MLAS_FORCEINLINE
+__mmask16
+MlasSBGemmMask16(size_t Count)
+{
+    return (Count >= 16) ? __mmask16(0xFFFF) : __mmask16((1u << Count) - 1);
+}
+
+/*
+    This routine converts fp32 to bf16 and copies elements from the source
+    matrix to the destination packed buffer.
+
+    Columns are grouped in panels of 16. For each panel, rows k and k+1 are
+    converted with round-to-nearest-even and interleaved into one 64-byte
+    vector. The remaining columns and the odd row of K are padded with zeros.
+*/
+MLAS_FORCEINLINE
+void
+MlasSBGemmConvertCopyPackBAvx512Bf16(bfloat16_t* D, const float* B, size_t ldb, size_t CountN, size_t CountK)
+{
+    const __m512i InterleaveIndex = _mm512_set_epi16(
+        31, 15, 30, 14, 29, 13, 28, 12, 27, 11, 26, 10, 25, 9, 24, 8,
+        23, 7, 22, 6, 21, 5, 20, 4, 19, 3, 18, 2, 17, 1, 16, 0
+    );
+
+    while (CountN > 0) {
+        const __mmask16 Mask = MlasSBGemmMask16(CountN);
+        const float* b = B;
+
+        for (size_t k = 0; k < CountK; k += 2) {
+            __m512 Row0 = _mm512_maskz_loadu_ps(Mask, b);
+            __m512 Row1 = (k + 1 < CountK) ? _mm512_maskz_loadu_ps(Mask, b + ldb) : _mm512_setzero_ps();
+
+            __m512i Packed = (__m512i)_mm512_cvtne2ps_pbh(Row1, Row0);
+            Packed = _mm512_permutexvar_epi16(InterleaveIndex, Packed);
+            _mm512_storeu_si512(D, Packed);
+
+            D += 32;
+            b += ldb * 2;
+        }
+
+        B += 16;
+        CountN -= std::min(CountN, size_t(16));
+    }
+}
+
+template <typename KernelType>
+void
+MlasSBGemmConvertPackB(
+    bfloat16_t* PackedB, const float* B, size_t ldb, size_t CountN, size_t CountK
+)
+{
+    constexpr size_t PackedN = KernelType::PackedN;
+    constexpr size_t PackedK = KernelType::PackedK;
+
+    const size_t AlignedN = (CountN + PackedN - 1) & ~(PackedN - 1);
+
+    //
+    // Step through each slice of matrix B along the K dimension.
+    //
+    size_t K_block_size;
+    constexpr MLAS_SBGEMM_STRIDES Strides = KernelType::Strides;
+
+    for (size_t k = 0; k < CountK; k += K_block_size) {
+        K_block_size = std::min(CountK - k, Strides.K);
+
+        MlasSBGemmConvertCopyPackBAvx512Bf16(PackedB, B + k * ldb, ldb, CountN, K_block_size);
+
+        const size_t AlignedK = (K_block_size + PackedK - 1) & ~(PackedK - 1);
+        PackedB += AlignedN * AlignedK;
+    }
+}
+
+/*
+    This routine converts RowCount rows of matrix A to bf16 pairs, where each
+    32-bit element holds A[m][2p] in the low half and A[m][2p+1] in the high
+    half, matching the interleaving of the packed B panels.
+*/
+template <size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasSBGemmConvertA(const float* A, size_t lda, size_t CountK, uint32_t (*APairs)[MlasSBGemmAvx512Bf16MaximumCountK / 2])
+{
+    for (size_t r = 0; r < RowCount; r++) {
+        const float* a = A + r * lda;
+
+        for (size_t k = 0; k < CountK; k += 32) {
+            const size_t CountRemaining = CountK - k;
+            __m512 Lo = _mm512_maskz_loadu_ps(MlasSBGemmMask16(CountRemaining), a + k);
+            __m512 Hi = (CountRemaining > 16)
+                            ? _mm512_maskz_loadu_ps(MlasSBGemmMask16(CountRemaining - 16), a + k + 16)
+                            : _mm512_setzero_ps();
+
+            _mm512_store_si512(&APairs[r][k / 2], (__m512i)_mm512_cvtne2ps_pbh(Hi, Lo));
+        }
+    }
+}
+
+template <size_t RowCount, size_t PanelCount>
+MLAS_FORCEINLINE
+void
+MlasSBGemmComputeBlock(
+    const uint32_t (*APairs)[MlasSBGemmAvx512Bf16MaximumCountK / 2],
+    const bfloat16_t* B,
+    size_t PanelStride,
+    size_t PairCount,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    const float* Bias,
+    bool ZeroMode
+)
+{
+    __m512 Accumulators[RowCount][PanelCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t j = 0; j < PanelCount; j++) {
+            Accumulators[r][j] = _mm512_setzero_ps();
+        }
+    }
+
+    for (size_t p = 0; p < PairCount; p++) {
+        __m512i BElements[PanelCount];
+
+        for (size_t j = 0; j < PanelCount; j++) {
+            BElements[j] = _mm512_loadu_si512(B + j * PanelStride + p * 32);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const __m512i ABroadcast = _mm512_set1_epi32(int32_t(APairs[r][p]));
+
+            for (size_t j = 0; j < PanelCount; j++) {
+                Accumulators[r][j] = _mm512_dpbf16_ps(Accumulators[r][j], (__m512bh)ABroadcast, (__m512bh)BElements[j]);
+            }
+        }
+    }
+
+    for (size_t j = 0; j < PanelCount; j++) {
+        const __mmask16 Mask = MlasSBGemmMask16(CountN - j * 16);
+
+        __m512 BiasVector = _mm512_setzero_ps();
+        if (ZeroMode && Bias != nullptr) {
+            BiasVector = _mm512_maskz_loadu_ps(Mask, Bias + j * 16);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            float* c = C + r * ldc + j * 16;
+            __m512 Result = Accumulators[r][j];
+
+            if (ZeroMode) {
+                Result = _mm512_add_ps(Result, BiasVector);
+            } else {
+                Result = _mm512_add_ps(Result, _mm512_maskz_loadu_ps(Mask, c));
+            }
+
+            _mm512_mask_storeu_ps(c, Mask, Result);
+        }
+    }
+}
+
+template <size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasSBGemmKernelRows(
+    size_t CountN,
+    size_t CountK,
+    const float* A,
+    size_t lda,
+    const bfloat16_t* B,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    bool ZeroMode
+)
+{
+    MLAS_DECLSPEC_ALIGN(uint32_t APairs[RowCount][MlasSBGemmAvx512Bf16MaximumCountK / 2], 64);
+
+    MlasSBGemmConvertA<RowCount>(A, lda, CountK, APairs);
+
+    const size_t PairCount = (CountK + 1) / 2;
+    const size_t PanelStride = PairCount * 32;
+
+    //
+    // Process two panels of 16 columns at a time, then the final panel.
+    //
+    while (CountN > 16) {
+        MlasSBGemmComputeBlock<RowCount, 2>(APairs, B, PanelStride, PairCount, C, ldc, CountN, Bias, ZeroMode);
+
+        B += 2 * PanelStride;
+        C += 32;
+        if (Bias != nullptr) {
+            Bias += 32;
+        }
+        CountN -= std::min(CountN, size_t(32));
+    }
+
+    if (CountN > 0) {
+        MlasSBGemmComputeBlock<RowCount, 1>(APairs, B, PanelStride, PairCount, C, ldc, CountN, Bias, ZeroMode);
+    }
+}
+
+template <>
+MLAS_FORCEINLINE void
+MlasSBGemmKernel<MLAS_SBGEMM_KERNEL_AVX512BF16>(size_t CountM, size_t CountN, size_t CountK, const float* A, size_t lda, const bfloat16_t* B, float* C, size_t ldc, const float* Bias, const bool ZeroMode)
+{
+    assert(CountK <= MlasSBGemmAvx512Bf16MaximumCountK);
+
+    while (CountM > 0) {
+        size_t RowsHandled;
+
+        switch (std::min(CountM, MLAS_SBGEMM_KERNEL_AVX512BF16::KernelMaxM)) {
+            case 1:
+                MlasSBGemmKernelRows<1>(CountN, CountK, A, lda, B, C, ldc, Bias, ZeroMode);
+                RowsHandled = 1;
+                break;
+            case 2:
+                MlasSBGemmKernelRows<2>(CountN, CountK, A, lda, B, C, ldc, Bias, ZeroMode);
+                RowsHandled = 2;
+                break;
+            case 3:
+                MlasSBGemmKernelRows<3>(CountN, CountK, A, lda, B, C, ldc, Bias, ZeroMode);
+                RowsHandled = 3;
+                break;
+            default:
+                MlasSBGemmKernelRows<4>(CountN, CountK, A, lda, B, C, ldc, Bias, ZeroMode);
+                RowsHandled = 4;
+                break;
+        }
+
+        C += ldc * RowsHandled;
+        A += lda * RowsHandled;
+        CountM -= RowsHandled;
+    }
+}
+
+const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx512Bf16 = {
+    MlasSBGemmOperation<MLAS_SBGEMM_KERNEL_AVX512BF16>,
+    MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX512BF16>,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::PackedK,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::PackedN,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::KernelMaxM,
+    0  // kernel does not read beyond the packed buffer
+};
+
+#endif  // defined(MLAS_SBGEMM_SUPPORTED) && defined(MLAS_TARGET_AMD64)
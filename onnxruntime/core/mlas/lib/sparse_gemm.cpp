@@ -0,0 +1,530 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparse_gemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation (SGEMM) for a block sparse B matrix.
+
+    The columns of B are split into panels of MLAS_SPARSE_GEMM_PANEL_WIDTH
+    columns. Within a panel, each row of B forms a block, and only the blocks
+    that have a non-zero element are packed along with their row index. The
+    kernel then skips the rows of a panel that are all zero, which covers both
+    block sparse weights and N:M structured sparsity where the same rows are
+    pruned for the output channels of a panel.
+
+--*/
+
+#include <cassert>
+
+#include "mlasi.h"
+
+//
+// Define the number of columns of a panel of the packed B matrix.
+//
+
+#define MLAS_SPARSE_GEMM_PANEL_WIDTH 16
+
+//
+// Define the number of rows of A that are computed together by the kernel.
+//
+
+#define MLAS_SPARSE_GEMM_ROW_BLOCK 2
+
+//
+// Define the number of rows of A that are assigned to a thread with a panel.
+//
+
+#define MLAS_SPARSE_GEMM_ROW_TILE 64
+
+//
+// Define the minimum fraction of the blocks of B that must be zero for the
+// sparse kernel to be faster than the dense SGEMM kernels, expressed as
+// a percentage.
+//
+
+#define MLAS_SPARSE_GEMM_MINIMUM_SPARSITY_PERCENT 75
+
+//
+// Define the layout of the packed B matrix.
+//
+// The header is followed by the panel offsets (PanelCount + 1 entries of
+// size_t), the row index of each block (BlockCount entries of uint32_t), and
+// the values of the blocks (BlockCount * MLAS_SPARSE_GEMM_PANEL_WIDTH floats)
+// aligned to MLAS_SPARSE_GEMM_PACKED_ALIGNMENT bytes. The values of the
+// columns past N in the last panel are zero.
+//
+
+#define MLAS_SPARSE_GEMM_PACKED_ALIGNMENT 64
+
+struct MLAS_SPARSE_GEMM_PACKED_HEADER {
+    size_t N;
+    size_t K;
+    size_t BlockCount;
+};
+
+struct MLAS_SPARSE_GEMM_PACKED_LAYOUT {
+    size_t PanelCount;
+    size_t BlockCount;
+    size_t RowIndicesOffset;
+    size_t ValuesOffset;
+    size_t TotalSize;
+};
+
+static
+MLAS_SPARSE_GEMM_PACKED_LAYOUT
+MlasSparseGemmGetPackedLayout(
+    size_t N,
+    size_t BlockCount
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the offsets of the sections of the packed B matrix.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    BlockCount - Supplies the number of non-zero blocks of matrix B.
+
+Return Value:
+
+    Returns the layout of the packed B matrix.
+
+--*/
+{
+    MLAS_SPARSE_GEMM_PACKED_LAYOUT Layout;
+
+    Layout.PanelCount = MlasDivRoundup(N, MLAS_SPARSE_GEMM_PANEL_WIDTH);
+    Layout.BlockCount = BlockCount;
+    Layout.RowIndicesOffset = sizeof(MLAS_SPARSE_GEMM_PACKED_HEADER) +
+        (Layout.PanelCount + 1) * sizeof(size_t);
+
+    size_t ValuesOffset = Layout.RowIndicesOffset + BlockCount * sizeof(uint32_t);
+    ValuesOffset = (ValuesOffset + MLAS_SPARSE_GEMM_PACKED_ALIGNMENT - 1) &
+        ~size_t(MLAS_SPARSE_GEMM_PACKED_ALIGNMENT - 1);
+
+    Layout.ValuesOffset = ValuesOffset;
+    Layout.TotalSize = ValuesOffset + BlockCount * MLAS_SPARSE_GEMM_PANEL_WIDTH * sizeof(float);
+
+    return Layout;
+}
+
+template<typename Callback>
+static
+void
+MlasSparseGemmForEachBlock(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    Callback Block
+    )
+/*++
+
+Routine Description:
+
+    This routine invokes the callback for each non-zero block of matrix B in
+    packed order.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    Block - Supplies the callback, which is invoked with the panel index, the
+        row index and the column count of the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t n = 0, panel = 0; n < N; n += MLAS_SPARSE_GEMM_PANEL_WIDTH, panel++) {
+
+        const size_t CountN = std::min(N - n, size_t(MLAS_SPARSE_GEMM_PANEL_WIDTH));
+
+        for (size_t k = 0; k < K; k++) {
+
+            bool IsZero = true;
+
+            for (size_t nn = 0; nn < CountN && IsZero; nn++) {
+                const float Value = (TransB == CblasNoTrans) ? B[k * ldb + n + nn] : B[(n + nn) * ldb + k];
+                IsZero = (Value == 0.0f);
+            }
+
+            if (!IsZero) {
+                Block(panel, k, n, CountN);
+            }
+        }
+    }
+}
+
+size_t
+MLASCALL
+MlasSparseGemmPackBSize(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the packed block sparse
+    representation of the B matrix.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+Return Value:
+
+    Returns the size in bytes for the packed B matrix, or zero if the
+    matrix is not sparse enough for the sparse kernel to be profitable.
+
+--*/
+{
+    if (N == 0 || K == 0 || K > std::numeric_limits<uint32_t>::max()) {
+        return 0;
+    }
+
+    size_t BlockCount = 0;
+
+    MlasSparseGemmForEachBlock(TransB, N, K, B, ldb, [&](size_t, size_t, size_t, size_t) {
+        BlockCount++;
+    });
+
+    const size_t PanelCount = MlasDivRoundup(N, MLAS_SPARSE_GEMM_PANEL_WIDTH);
+    const size_t TotalBlockCount = PanelCount * K;
+
+    if (BlockCount * 100 > TotalBlockCount * (100 - MLAS_SPARSE_GEMM_MINIMUM_SPARSITY_PERCENT)) {
+        return 0;
+    }
+
+    return MlasSparseGemmGetPackedLayout(N, BlockCount).TotalSize;
+}
+
+void
+MLASCALL
+MlasSparseGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the non-zero blocks of the B matrix. The buffer must
+    be MlasSparseGemmPackBSize bytes long.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t BlockCount = 0;
+
+    MlasSparseGemmForEachBlock(TransB, N, K, B, ldb, [&](size_t, size_t, size_t, size_t) {
+        BlockCount++;
+    });
+
+    const MLAS_SPARSE_GEMM_PACKED_LAYOUT Layout = MlasSparseGemmGetPackedLayout(N, BlockCount);
+
+    uint8_t* Buffer = static_cast<uint8_t*>(PackedB);
+    auto* Header = reinterpret_cast<MLAS_SPARSE_GEMM_PACKED_HEADER*>(Buffer);
+    auto* PanelOffsets = reinterpret_cast<size_t*>(Buffer + sizeof(MLAS_SPARSE_GEMM_PACKED_HEADER));
+    auto* RowIndices = reinterpret_cast<uint32_t*>(Buffer + Layout.RowIndicesOffset);
+    auto* Values = reinterpret_cast<float*>(Buffer + Layout.ValuesOffset);
+
+    Header->N = N;
+    Header->K = K;
+    Header->BlockCount = BlockCount;
+
+    //
+    // Zero the buffer so that the padding is deterministic, which allows the
+    // packed buffer to be shared by content across sessions.
+    //
+
+    std::fill_n(Buffer + sizeof(MLAS_SPARSE_GEMM_PACKED_HEADER), Layout.TotalSize - sizeof(MLAS_SPARSE_GEMM_PACKED_HEADER), uint8_t(0));
+
+    size_t Block = 0;
+
+    MlasSparseGemmForEachBlock(TransB, N, K, B, ldb, [&](size_t panel, size_t k, size_t n, size_t CountN) {
+
+        PanelOffsets[panel + 1] = Block + 1;
+        RowIndices[Block] = uint32_t(k);
+
+        float* v = Values + Block * MLAS_SPARSE_GEMM_PANEL_WIDTH;
+
+        for (size_t nn = 0; nn < CountN; nn++) {
+            v[nn] = (TransB == CblasNoTrans) ? B[k * ldb + n + nn] : B[(n + nn) * ldb + k];
+        }
+
+        Block++;
+    });
+
+    //
+    // Panels without a non-zero block end where the previous panel ends.
+    //
+
+    for (size_t panel = 0; panel < Layout.PanelCount; panel++) {
+        PanelOffsets[panel + 1] = std::max(PanelOffsets[panel + 1], PanelOffsets[panel]);
+    }
+}
+
+static
+void
+MlasSparseGemmKernel(
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    const uint32_t* RowIndices,
+    const float* Values,
+    size_t BlockCount,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    float alpha
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the rows of C for one panel of the packed B matrix.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    CountM - Supplies the number of rows of A and C.
+
+    RowIndices - Supplies the row index of each block of the panel.
+
+    Values - Supplies the values of the blocks of the panel.
+
+    BlockCount - Supplies the number of blocks of the panel.
+
+    C - Supplies the address of the panel of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    CountN - Supplies the number of columns of the panel.
+
+    alpha - Supplies the scalar multiplier.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 Alpha = MlasBroadcastFloat32x4(alpha);
+
+    while (CountM > 0) {
+
+        const size_t RowCount = std::min(CountM, size_t(MLAS_SPARSE_GEMM_ROW_BLOCK));
+        const float* a1 = (RowCount > 1) ? A + lda : A;
+
+        //
+        // The accumulators are explicitly unrolled so that they stay in
+        // registers regardless of the loop unrolling done by the compiler.
+        //
+
+        MLAS_FLOAT32X4 Accumulators[MLAS_SPARSE_GEMM_ROW_BLOCK][4];
+
+        MLAS_FLOAT32X4 Accumulator00 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator01 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator02 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator03 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator10 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator11 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator12 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator13 = MlasZeroFloat32x4();
+
+        const float* v = Values;
+
+        for (size_t Block = 0; Block < BlockCount; Block++) {
+
+            const size_t k = RowIndices[Block];
+            const MLAS_FLOAT32X4 A0 = MlasBroadcastFloat32x4(A[k]);
+            const MLAS_FLOAT32X4 A1 = MlasBroadcastFloat32x4(a1[k]);
+
+            const MLAS_FLOAT32X4 BElements0 = MlasLoadFloat32x4(v);
+            const MLAS_FLOAT32X4 BElements1 = MlasLoadFloat32x4(v + 4);
+            const MLAS_FLOAT32X4 BElements2 = MlasLoadFloat32x4(v + 8);
+            const MLAS_FLOAT32X4 BElements3 = MlasLoadFloat32x4(v + 12);
+
+            Accumulator00 = MlasMultiplyAddFloat32x4(A0, BElements0, Accumulator00);
+            Accumulator01 = MlasMultiplyAddFloat32x4(A0, BElements1, Accumulator01);
+            Accumulator02 = MlasMultiplyAddFloat32x4(A0, BElements2, Accumulator02);
+            Accumulator03 = MlasMultiplyAddFloat32x4(A0, BElements3, Accumulator03);
+            Accumulator10 = MlasMultiplyAddFloat32x4(A1, BElements0, Accumulator10);
+            Accumulator11 = MlasMultiplyAddFloat32x4(A1, BElements1, Accumulator11);
+            Accumulator12 = MlasMultiplyAddFloat32x4(A1, BElements2, Accumulator12);
+            Accumulator13 = MlasMultiplyAddFloat32x4(A1, BElements3, Accumulator13);
+
+            v += MLAS_SPARSE_GEMM_PANEL_WIDTH;
+        }
+
+        Accumulators[0][0] = MlasMultiplyFloat32x4(Accumulator00, Alpha);
+        Accumulators[0][1] = MlasMultiplyFloat32x4(Accumulator01, Alpha);
+        Accumulators[0][2] = MlasMultiplyFloat32x4(Accumulator02, Alpha);
+        Accumulators[0][3] = MlasMultiplyFloat32x4(Accumulator03, Alpha);
+        Accumulators[1][0] = MlasMultiplyFloat32x4(Accumulator10, Alpha);
+        Accumulators[1][1] = MlasMultiplyFloat32x4(Accumulator11, Alpha);
+        Accumulators[1][2] = MlasMultiplyFloat32x4(Accumulator12, Alpha);
+        Accumulators[1][3] = MlasMultiplyFloat32x4(Accumulator13, Alpha);
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            float* c = C + r * ldc;
+
+            if (CountN == MLAS_SPARSE_GEMM_PANEL_WIDTH) {
+                for (size_t i = 0; i < 4; i++) {
+                    MlasStoreFloat32x4(c + i * 4, Accumulators[r][i]);
+                }
+            } else {
+                MLAS_DECLSPEC_ALIGN(float Row[MLAS_SPARSE_GEMM_PANEL_WIDTH], 16);
+                for (size_t i = 0; i < 4; i++) {
+                    MlasStoreAlignedFloat32x4(Row + i * 4, Accumulators[r][i]);
+                }
+                std::copy_n(Row, CountN, c);
+            }
+        }
+
+        A += lda * RowCount;
+        C += ldc * RowCount;
+        CountM -= RowCount;
+    }
+}
+
+void
+MLASCALL
+MlasSparseGemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes C = alpha * A * B, where B has been packed by
+    MlasSparseGemmPackB.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar multiplier.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PackedB - Supplies the address of packed matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const uint8_t* Buffer = static_cast<const uint8_t*>(PackedB);
+    const auto* Header = reinterpret_cast<const MLAS_SPARSE_GEMM_PACKED_HEADER*>(Buffer);
+
+    MLAS_UNREFERENCED_PARAMETER(K);
+    assert(Header->N == N && Header->K == K);
+
+    const MLAS_SPARSE_GEMM_PACKED_LAYOUT Layout = MlasSparseGemmGetPackedLayout(N, Header->BlockCount);
+    const auto* PanelOffsets = reinterpret_cast<const size_t*>(Buffer + sizeof(MLAS_SPARSE_GEMM_PACKED_HEADER));
+    const auto* RowIndices = reinterpret_cast<const uint32_t*>(Buffer + Layout.RowIndicesOffset);
+    const auto* Values = reinterpret_cast<const float*>(Buffer + Layout.ValuesOffset);
+
+    const size_t RowTileCount = MlasDivRoundup(M, MLAS_SPARSE_GEMM_ROW_TILE);
+    const ptrdiff_t WorkCount = ptrdiff_t(Layout.PanelCount * RowTileCount);
+
+    MlasTrySimpleParallel(ThreadPool, WorkCount, [&](ptrdiff_t tid) {
+
+        const size_t panel = size_t(tid) / RowTileCount;
+        const size_t m = (size_t(tid) % RowTileCount) * MLAS_SPARSE_GEMM_ROW_TILE;
+        const size_t n = panel * MLAS_SPARSE_GEMM_PANEL_WIDTH;
+
+        const size_t FirstBlock = PanelOffsets[panel];
+        const size_t BlockCount = PanelOffsets[panel + 1] - FirstBlock;
+
+        MlasSparseGemmKernel(A + m * lda, lda, std::min(M - m, size_t(MLAS_SPARSE_GEMM_ROW_TILE)),
+                             RowIndices + FirstBlock, Values + FirstBlock * MLAS_SPARSE_GEMM_PANEL_WIDTH,
+                             BlockCount, C + m * ldc + n, ldc,
+                             std::min(N - n, size_t(MLAS_SPARSE_GEMM_PANEL_WIDTH)), alpha);
+    });
+}
@@ -488,6 +488,44 @@ MlasTranspose8x8Block(
 
 #endif
 
+#if defined(MLAS_SSE2_INTRINSICS)
+
+MLAS_FORCEINLINE
+void
+MlasTranspose2x2Block(
+    const uint64_t* Input,
+    size_t InputStride,
+    uint64_t* Output,
+    size_t OutputStride
+    )
+{
+    __m128i a0 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 0]);
+    __m128i a1 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 1]);
+
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 0], _mm_unpacklo_epi64(a0, a1));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 1], _mm_unpackhi_epi64(a0, a1));
+}
+
+#elif defined(MLAS_NEON64_INTRINSICS)
+
+MLAS_FORCEINLINE
+void
+MlasTranspose2x2Block(
+    const uint64_t* Input,
+    size_t InputStride,
+    uint64_t* Output,
+    size_t OutputStride
+    )
+{
+    uint64x2_t a0 = vld1q_u64(&Input[InputStride * 0]);
+    uint64x2_t a1 = vld1q_u64(&Input[InputStride * 1]);
+
+    vst1q_u64(&Output[OutputStride * 0], vtrn1q_u64(a0, a1));
+    vst1q_u64(&Output[OutputStride * 1], vtrn2q_u64(a0, a1));
+}
+
+#endif
+
 template<typename ElementType>
 MLAS_FORCEINLINE
 void
@@ -547,14 +585,17 @@ MlasTranspose(
     const uint32_t* Input,
     uint32_t* Output,
     size_t M,
-    size_t N
+    size_t N,
+    size_t InputStride,
+    size_t OutputStride
     )
 /*++
 
 Routine Description:
 
     This routine transposes the input matrix (M rows by N columns) to the
-    output matrix (N rows by M columns).
+    output matrix (N rows by M columns). The rows of the matrices may be
+    strided, so that a tile of a larger matrix can be transposed.
 
 Arguments:
 
@@ -568,6 +609,12 @@ Arguments:
     N - Supplies the number of columns for the input matrix and the number of
         rows for the output matrix.
 
+    InputStride - Supplies the number of elements between rows of the input
+        matrix.
+
+    OutputStride - Supplies the number of elements between rows of the output
+        matrix.
+
 Return Value:
 
     None.
@@ -592,9 +639,9 @@ Return Value:
 
         while (m >= 4) {
 
-            MlasTranspose4x4Block(s, N, d, M);
+            MlasTranspose4x4Block(s, InputStride, d, OutputStride);
 
-            s += N * 4;
+            s += InputStride * 4;
             d += 4;
             m -= 4;
         }
@@ -603,15 +650,15 @@ Return Value:
 
         while (m > 0) {
 
-            MlasTranspose4xNVector(s, 1, d, M);
+            MlasTranspose4xNVector(s, 1, d, OutputStride);
 
-            s += N;
+            s += InputStride;
             d += 1;
             m -= 1;
         }
 
         Input += 4;
-        Output += M * 4;
+        Output += OutputStride * 4;
         n -= 4;
     }
 
@@ -628,9 +675,9 @@ Return Value:
 
         while (m >= 4) {
 
-            MlasTranspose4xNVector(s, N, d, 1);
+            MlasTranspose4xNVector(s, InputStride, d, 1);
 
-            s += N * 4;
+            s += InputStride * 4;
             d += 4;
             m -= 4;
         }
@@ -639,17 +686,29 @@ Return Value:
 
             d[0] = s[0];
 
-            s += N;
+            s += InputStride;
             d += 1;
             m -= 1;
         }
 
         Input += 1;
-        Output += M;
+        Output += OutputStride;
         n -= 1;
     }
 }
 
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    uint32_t* Output,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTranspose(Input, Output, M, N, N, M);
+}
+
 void
 MLASCALL
 MlasTranspose(
@@ -673,14 +732,17 @@ MlasTranspose(
     const uint16_t* Input,
     uint16_t* Output,
     size_t M,
-    size_t N
+    size_t N,
+    size_t InputStride,
+    size_t OutputStride
     )
 /*++
 
 Routine Description:
 
     This routine transposes the input matrix (M rows by N columns) to the
-    output matrix (N rows by M columns).
+    output matrix (N rows by M columns). The rows of the matrices may be
+    strided, so that a tile of a larger matrix can be transposed.
 
 Arguments:
 
@@ -694,6 +756,12 @@ Arguments:
     N - Supplies the number of columns for the input matrix and the number of
         rows for the output matrix.
 
+    InputStride - Supplies the number of elements between rows of the input
+        matrix.
+
+    OutputStride - Supplies the number of elements between rows of the output
+        matrix.
+
 Return Value:
 
     None.
@@ -717,9 +785,9 @@ Return Value:
 
         while (m >= 4) {
 
-            MlasTranspose4x4Block(s, N, d, M);
+            MlasTranspose4x4Block(s, InputStride, d, OutputStride);
 
-            s += N * 4;
+            s += InputStride * 4;
             d += 4;
             m -= 4;
         }
@@ -728,15 +796,15 @@ Return Value:
 
         while (m > 0) {
 
-            MlasTranspose4xNVector(s, 1, d, M);
+            MlasTranspose4xNVector(s, 1, d, OutputStride);
 
-            s += N;
+            s += InputStride;
             d += 1;
             m -= 1;
         }
 
         Input += 4;
-        Output += M * 4;
+        Output += OutputStride * 4;
         n -= 4;
     }
 
@@ -753,9 +821,9 @@ Return Value:
 
         while (m >= 4) {
 
-            MlasTranspose4xNVector(s, N, d, 1);
+            MlasTranspose4xNVector(s, InputStride, d, 1);
 
-            s += N * 4;
+            s += InputStride * 4;
             d += 4;
             m -= 4;
         }
@@ -764,17 +832,28 @@ Return Value:
 
             d[0] = s[0];
 
-            s += N;
+            s += InputStride;
             d += 1;
             m -= 1;
         }
 
         Input += 1;
-        Output += M;
+        Output += OutputStride;
         n -= 1;
     }
 }
 
+void
+MLASCALL
+MlasTranspose(
+    const uint16_t* Input,
+    uint16_t* Output,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTranspose(Input, Output, M, N, N, M);
+}
 
 void
 MLASCALL
@@ -782,14 +861,17 @@ MlasTranspose(
     const uint8_t* Input,
     uint8_t* Output,
     size_t M,
-    size_t N
+    size_t N,
+    size_t InputStride,
+    size_t OutputStride
     )
 /*++
 
 Routine Description:
 
     This routine transposes the input matrix (M rows by N columns) to the
-    output matrix (N rows by M columns).
+    output matrix (N rows by M columns). The rows of the matrices may be
+    strided, so that a tile of a larger matrix can be transposed.
 
 Arguments:
 
@@ -803,6 +885,12 @@ Arguments:
     N - Supplies the number of columns for the input matrix and the number of
         rows for the output matrix.
 
+    InputStride - Supplies the number of elements between rows of the input
+        matrix.
+
+    OutputStride - Supplies the number of elements between rows of the output
+        matrix.
+
 Return Value:
 
     None.
@@ -823,24 +911,24 @@ Return Value:
         size_t m = M;
         while (m >= 16) {
 
-            MlasTranspose16x16Block(s, N, d, M);
+            MlasTranspose16x16Block(s, InputStride, d, OutputStride);
 
-            s += N * 16;
+            s += InputStride * 16;
             d += 16;
             m -= 16;
         }
 
         while (m > 0) {
 
-            MlasTranspose16xNVector(s, 1, d, M);
+            MlasTranspose16xNVector(s, 1, d, OutputStride);
 
-            s += N;
+            s += InputStride;
             d += 1;
             m -= 1;
         }
 
         Input += 16;
-        Output += M * 16;
+        Output += OutputStride * 16;
         n -= 16;
     }
 #endif
@@ -854,9 +942,9 @@ Return Value:
 
         while (m >= 8) {
 
-            MlasTranspose8x8Block(s, N, d, M);
+            MlasTranspose8x8Block(s, InputStride, d, OutputStride);
 
-            s += N * 8;
+            s += InputStride * 8;
             d += 8;
             m -= 8;
         }
@@ -865,15 +953,15 @@ Return Value:
 
         while (m > 0) {
 
-            MlasTranspose8xNVector(s, 1, d, M);
+            MlasTranspose8xNVector(s, 1, d, OutputStride);
 
-            s += N;
+            s += InputStride;
             d += 1;
             m -= 1;
         }
 
         Input += 8;
-        Output += M * 8;
+        Output += OutputStride * 8;
         n -= 8;
     }
 
@@ -890,9 +978,9 @@ Return Value:
 
         while (m >= 8) {
 
-            MlasTranspose8xNVector(s, N, d, 1);
+            MlasTranspose8xNVector(s, InputStride, d, 1);
 
-            s += N * 8;
+            s += InputStride * 8;
             d += 8;
             m -= 8;
         }
@@ -901,17 +989,29 @@ Return Value:
 
             d[0] = s[0];
 
-            s += N;
+            s += InputStride;
             d += 1;
             m -= 1;
         }
 
         Input += 1;
-        Output += M;
+        Output += OutputStride;
         n -= 1;
     }
 }
 
+void
+MLASCALL
+MlasTranspose(
+    const uint8_t* Input,
+    uint8_t* Output,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTranspose(Input, Output, M, N, N, M);
+}
+
 void
 MLASCALL
 MlasTranspose(
@@ -926,3 +1026,117 @@ MlasTranspose(
         M,
         N);
 }
+
+void
+MLASCALL
+MlasTranspose(
+    const uint64_t* Input,
+    uint64_t* Output,
+    size_t M,
+    size_t N,
+    size_t InputStride,
+    size_t OutputStride
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the input matrix (M rows by N columns) to the
+    output matrix (N rows by M columns). The rows of the matrices may be
+    strided, so that a tile of a larger matrix can be transposed.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    M - Supplies the number of rows for the input matrix and the number of
+        columns for the output matrix.
+
+    N - Supplies the number of columns for the input matrix and the number of
+        rows for the output matrix.
+
+    InputStride - Supplies the number of elements between rows of the input
+        matrix.
+
+    OutputStride - Supplies the number of elements between rows of the output
+        matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t n = N;
+
+    //
+    // Transpose elements from the input matrix to the output matrix 2 columns
+    // at a time.
+    //
+
+    while (n >= 2) {
+
+        const uint64_t* s = Input;
+        uint64_t* d = Output;
+        size_t m = M;
+
+#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON64_INTRINSICS)
+
+        while (m >= 2) {
+
+            MlasTranspose2x2Block(s, InputStride, d, OutputStride);
+
+            s += InputStride * 2;
+            d += 2;
+            m -= 2;
+        }
+
+#endif
+
+        while (m > 0) {
+
+            d[0] = s[0];
+            d[OutputStride] = s[1];
+
+            s += InputStride;
+            d += 1;
+            m -= 1;
+        }
+
+        Input += 2;
+        Output += OutputStride * 2;
+        n -= 2;
+    }
+
+    //
+    // Transpose elements from the input matrix to the output matrix for the
+    // remaining column.
+    //
+
+    if (n > 0) {
+
+        const uint64_t* s = Input;
+        uint64_t* d = Output;
+        size_t m = M;
+
+        while (m >= 4) {
+
+            MlasTranspose4xNVector(s, InputStride, d, 1);
+
+            s += InputStride * 4;
+            d += 4;
+            m -= 4;
+        }
+
+        while (m > 0) {
+
+            d[0] = s[0];
+
+            s += InputStride;
+            d += 1;
+            m -= 1;
+        }
+    }
+}
@@ -0,0 +1,314 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_fusion.h"
+
+#include <algorithm>
+#include <map>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+struct FusibleOp {
+  std::string_view op_type;
+  std::vector<ONNX_NAMESPACE::OperatorSetVersion> versions;
+  size_t num_inputs;
+};
+
+// Keep in sync with the ops supported by the FusedElementwise kernel in contrib_ops/cpu/fused_elementwise.cc.
+const FusibleOp kFusibleOps[] = {
+    {"Add", {7, 13, 14}, 2},
+    {"Sub", {7, 13, 14}, 2},
+    {"Mul", {7, 13, 14}, 2},
+    {"Div", {7, 13, 14}, 2},
+    {"Pow", {7, 12, 13, 15}, 2},
+    {"Abs", {6, 13}, 1},
+    {"Ceil", {6, 13}, 1},
+    {"Erf", {9, 13}, 1},
+    {"Exp", {6, 13}, 1},
+    {"Floor", {6, 13}, 1},
+    {"LeakyRelu", {6, 16}, 1},
+    {"Log", {6, 13}, 1},
+    {"Neg", {6, 13}, 1},
+    {"Reciprocal", {6, 13}, 1},
+    {"Relu", {6, 13, 14}, 1},
+    {"Sigmoid", {6, 13}, 1},
+    {"Sqrt", {6, 13}, 1},
+    {"Tanh", {6, 13}, 1},
+};
+
+bool IsFloatTensor(const NodeArg* arg) {
+  if (arg == nullptr || !arg->Exists()) {
+    return false;
+  }
+  const TypeProto* type = arg->TypeAsProto();
+  return type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+// Returns true if both shapes are known to be the same. Dimensions are the same if they have the same value or
+// the same symbolic name.
+bool IsSameShape(const TensorShapeProto& shape, const TensorShapeProto& other_shape) {
+  if (shape.dim_size() != other_shape.dim_size()) {
+    return false;
+  }
+  for (int i = 0; i < shape.dim_size(); ++i) {
+    const auto& dim = shape.dim(i);
+    const auto& other_dim = other_shape.dim(i);
+    if (utils::HasDimValue(dim)) {
+      if (!utils::HasDimValue(other_dim) || dim.dim_value() != other_dim.dim_value()) {
+        return false;
+      }
+    } else if (utils::HasDimParam(dim)) {
+      if (!utils::HasDimParam(other_dim) || dim.dim_param() != other_dim.dim_param()) {
+        return false;
+      }
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the output shape of a node that can be fused, or nullptr.
+const TensorShapeProto* GetFusibleNodeShape(const Node& node, const InlinedHashSet<std::string_view>& providers) {
+  if (!graph_utils::IsSupportedProvider(node, providers) || node.OutputDefs().size() != 1) {
+    return nullptr;
+  }
+
+  const auto* op = std::find_if(std::begin(kFusibleOps), std::end(kFusibleOps),
+                                [&node](const FusibleOp& op) { return op.op_type == node.OpType(); });
+  if (op == std::end(kFusibleOps) ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(node, op->op_type, op->versions) ||
+      node.InputDefs().size() != op->num_inputs) {
+    return nullptr;
+  }
+
+  for (const NodeArg* input : node.InputDefs()) {
+    if (!IsFloatTensor(input)) {
+      return nullptr;
+    }
+  }
+  const NodeArg* output = node.OutputDefs()[0];
+  if (!IsFloatTensor(output) || output->Shape() == nullptr) {
+    return nullptr;
+  }
+
+  // Every dimension must be comparable with the shapes of the other nodes of a subgraph.
+  const TensorShapeProto* shape = output->Shape();
+  return IsSameShape(*shape, *shape) ? shape : nullptr;
+}
+
+// A set of connected fusible nodes with the same output shape. Like the partitions of the Triton fusion, it tracks
+// the values computed outside of it from its outputs, so that a node is only added if that does not create a
+// dependency between two of its nodes through a node outside of it.
+struct ElementwisePartition {
+  InlinedVector<Node*> nodes;
+  InlinedHashSet<const NodeArg*> outputs;
+  InlinedHashSet<const NodeArg*> dependencies;
+  const TensorShapeProto* shape = nullptr;
+  size_t output_ref_count = 0;
+
+  void MergeFrom(const ElementwisePartition& other) {
+    nodes.insert(nodes.end(), other.nodes.begin(), other.nodes.end());
+    outputs.insert(other.outputs.begin(), other.outputs.end());
+    dependencies.insert(other.dependencies.begin(), other.dependencies.end());
+    output_ref_count += other.output_ref_count;
+  }
+};
+
+void FusePartition(Graph& graph, const ElementwisePartition& partition) {
+  InlinedHashSet<const Node*> partition_nodes;
+  for (const Node* node : partition.nodes) {
+    partition_nodes.insert(node);
+  }
+
+  // Values 0 to N - 1 are the inputs of the fused node and value N + i is the result of the i-th op.
+  InlinedVector<NodeArg*> inputs;
+  InlinedHashMap<const NodeArg*, int64_t> input_values;
+  for (const Node* node : partition.nodes) {
+    for (NodeArg* input : node->MutableInputDefs()) {
+      if (partition.outputs.count(input) == 0 && input_values.count(input) == 0) {
+        input_values.emplace(input, static_cast<int64_t>(inputs.size()));
+        inputs.push_back(input);
+      }
+    }
+  }
+
+  const auto num_inputs = static_cast<int64_t>(inputs.size());
+  InlinedHashMap<const NodeArg*, int64_t> result_values;
+  std::vector<std::string> ops;
+  std::vector<int64_t> operands;
+  std::vector<float> alphas;
+  InlinedVector<NodeArg*> outputs;
+  std::vector<int64_t> output_values;
+  for (Node* node : partition.nodes) {
+    const auto& input_defs = node->InputDefs();
+    for (size_t i = 0; i < 2; ++i) {
+      if (i < input_defs.size()) {
+        auto result = result_values.find(input_defs[i]);
+        operands.push_back(result != result_values.end() ? result->second : input_values.at(input_defs[i]));
+      } else {
+        operands.push_back(-1);
+      }
+    }
+    float alpha = 0.0f;
+    if (node->OpType() == "LeakyRelu") {
+      const AttributeProto* alpha_attr = graph_utils::GetNodeAttribute(*node, "alpha");
+      alpha = alpha_attr != nullptr ? alpha_attr->f() : 0.01f;
+    }
+    ops.push_back(node->OpType());
+    alphas.push_back(alpha);
+
+    NodeArg* output = node->MutableOutputDefs()[0];
+    const int64_t value = num_inputs + static_cast<int64_t>(result_values.size());
+    result_values.emplace(output, value);
+
+    // The result is an output of the fused node if it is a graph output or used by a node outside of the partition.
+    bool is_output = graph.IsOutput(output);
+    for (auto it = node->OutputNodesBegin(), end = node->OutputNodesEnd(); !is_output && it != end; ++it) {
+      is_output = partition_nodes.count(&*it) == 0;
+    }
+    if (is_output) {
+      outputs.push_back(output);
+      output_values.push_back(value);
+    }
+  }
+
+  Node& fused_node = graph.AddNode(graph.GenerateNodeName("FusedElementwise"), "FusedElementwise",
+                                   "Fused elementwise subgraph", inputs, outputs, nullptr, kMSDomain);
+  fused_node.AddAttribute("ops", ops);
+  fused_node.AddAttribute("operands", operands);
+  fused_node.AddAttribute("alphas", alphas);
+  fused_node.AddAttribute("output_values", output_values);
+  fused_node.SetExecutionProviderType(partition.nodes[0]->GetExecutionProviderType());
+
+  // The edges of the fused node are created when the graph is resolved.
+  for (Node* node : partition.nodes) {
+    graph_utils::RemoveNodeOutputEdges(graph, *node);
+    graph.RemoveNode(node->Index());
+  }
+}
+
+}  // namespace
+
+Status ElementwiseFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                    const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  size_t next_partition_id = 0;
+  std::map<size_t, ElementwisePartition> partitions;
+  InlinedVector<ElementwisePartition> partitions_to_fuse;
+  InlinedHashMap<const NodeArg*, size_t> active_outputs;
+
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (p_node == nullptr) continue;
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    const TensorShapeProto* shape = GetFusibleNodeShape(node, GetCompatibleExecutionProviders());
+
+    InlinedVector<size_t> partitions_to_merge;
+    for (auto& [id, partition] : partitions) {
+      bool uses_output = false;
+      bool uses_dependency = false;
+      for (const NodeArg* input : node.InputDefs()) {
+        if (partition.outputs.count(input) != 0) {
+          --partition.output_ref_count;
+          uses_output = true;
+        }
+        if (partition.dependencies.count(input) != 0) {
+          uses_dependency = true;
+        }
+      }
+      for (const NodeArg* input : node.ImplicitInputDefs()) {
+        if (partition.outputs.count(input) != 0) {
+          --partition.output_ref_count;
+          uses_output = true;
+          uses_dependency = true;
+        }
+        if (partition.dependencies.count(input) != 0) {
+          uses_dependency = true;
+        }
+      }
+
+      if (shape != nullptr && uses_output && !uses_dependency && IsSameShape(*shape, *partition.shape)) {
+        partitions_to_merge.push_back(id);
+      } else if (uses_output || uses_dependency) {
+        for (const NodeArg* output : node.OutputDefs()) {
+          partition.dependencies.insert(output);
+        }
+      }
+    }
+
+    if (!partitions_to_merge.empty()) {
+      ElementwisePartition& partition = partitions.at(partitions_to_merge[0]);
+      for (size_t i = 1; i < partitions_to_merge.size(); ++i) {
+        partition.MergeFrom(partitions.at(partitions_to_merge[i]));
+        partitions.erase(partitions_to_merge[i]);
+      }
+      partition.nodes.push_back(&node);
+      partition.outputs.insert(node.OutputDefs()[0]);
+      partition.output_ref_count += node.GetOutputEdgesCount();
+    } else if (shape != nullptr) {
+      ElementwisePartition partition;
+      partition.nodes.push_back(&node);
+      partition.outputs.insert(node.OutputDefs()[0]);
+      partition.shape = shape;
+      partition.output_ref_count = node.GetOutputEdgesCount();
+      partitions.emplace(next_partition_id++, std::move(partition));
+    }
+
+    // A partition is complete once all the consumers of its outputs have been visited.
+    for (auto it = partitions.begin(); it != partitions.end();) {
+      if (it->second.output_ref_count == 0) {
+        if (it->second.nodes.size() > 1) {
+          partitions_to_fuse.push_back(std::move(it->second));
+        }
+        it = partitions.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    // Values that have no more consumers to visit can no longer create a dependency.
+    auto release_input = [&](const NodeArg* input) {
+      auto active_output = active_outputs.find(input);
+      if (active_output != active_outputs.end() && --active_output->second == 0) {
+        active_outputs.erase(active_output);
+        for (auto& [id, partition] : partitions) {
+          partition.dependencies.erase(input);
+        }
+      }
+    };
+    for (const NodeArg* input : node.InputDefs()) {
+      release_input(input);
+    }
+    for (const NodeArg* input : node.ImplicitInputDefs()) {
+      release_input(input);
+    }
+
+    for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+      ++active_outputs[node.OutputDefs()[it->GetSrcArgIndex()]];
+    }
+  }
+
+  for (const auto& partition : partitions_to_fuse) {
+    FusePartition(graph, partition);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,245 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/gather_block_quantization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+#include "core/common/narrow.h"
+#include "core/framework/int4.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/providers/common.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+// The largest block size used to quantize a row. Shorter rows use a single block.
+constexpr int64_t kMaxBlockSize = 128;
+// The smallest block size supported by GatherBlockQuantized.
+constexpr int64_t kMinBlockSize = 16;
+
+struct QuantizedTable {
+  NodeArg* data;
+  NodeArg* scales;
+  NodeArg* zero_points;
+  int64_t rank;
+  int64_t block_size;
+};
+
+int64_t GetBlockSize(int64_t row_size) {
+  int64_t block_size = kMaxBlockSize;
+  while (block_size > kMinBlockSize && block_size / 2 >= row_size) {
+    block_size /= 2;
+  }
+  return block_size;
+}
+
+// Quantizes each block of a row of the table to unsigned integers with a scale and zero point. Returns the root
+// mean square of the quantization error relative to the root mean square of the values.
+double QuantizeRows(gsl::span<const float> values, int64_t row_size, int64_t block_size, int64_t bits,
+                    std::vector<uint8_t>& quantized, std::vector<float>& scales, std::vector<uint8_t>& zero_points) {
+  const float qmax = static_cast<float>((1 << bits) - 1);
+  const size_t num_rows = values.size() / narrow<size_t>(row_size);
+  const size_t blocks_per_row = narrow<size_t>((row_size + block_size - 1) / block_size);
+
+  quantized.resize(values.size());
+  scales.resize(num_rows * blocks_per_row);
+  zero_points.resize(num_rows * blocks_per_row);
+
+  double sum_squared_error = 0.0;
+  double sum_squared_value = 0.0;
+  size_t scale_idx = 0;
+  for (size_t row_start = 0; row_start < values.size(); row_start += narrow<size_t>(row_size)) {
+    const size_t row_end = row_start + narrow<size_t>(row_size);
+    for (size_t block_start = row_start; block_start < row_end; ++scale_idx) {
+      const size_t block_end = std::min(block_start + narrow<size_t>(block_size), row_end);
+
+      // The range includes 0 so that the zero point can be represented.
+      float min_val = 0.0f;
+      float max_val = 0.0f;
+      for (size_t i = block_start; i < block_end; ++i) {
+        min_val = std::min(min_val, values[i]);
+        max_val = std::max(max_val, values[i]);
+      }
+
+      float scale = (max_val - min_val) / qmax;
+      if (scale == 0.0f) {
+        scale = 1.0f;
+      }
+      const float zero_point = std::clamp(std::round(-min_val / scale), 0.0f, qmax);
+      scales[scale_idx] = scale;
+      zero_points[scale_idx] = static_cast<uint8_t>(zero_point);
+
+      for (size_t i = block_start; i < block_end; ++i) {
+        const float q = std::clamp(std::round(values[i] / scale) + zero_point, 0.0f, qmax);
+        quantized[i] = static_cast<uint8_t>(q);
+        const double error = static_cast<double>(values[i]) - static_cast<double>((q - zero_point) * scale);
+        sum_squared_error += error * error;
+        sum_squared_value += static_cast<double>(values[i]) * values[i];
+      }
+      block_start = block_end;
+    }
+  }
+
+  if (sum_squared_value == 0.0) {
+    return 0.0;
+  }
+  return std::sqrt(sum_squared_error / sum_squared_value);
+}
+
+NodeArg& AddQuantizedInitializer(Graph& graph, const std::string& name, const std::vector<uint8_t>& values,
+                                 gsl::span<const int64_t> dims, int64_t bits) {
+  TensorProto tensor_proto;
+  tensor_proto.set_name(graph.GenerateNodeArgName(name));
+  if (bits == 4) {
+    std::vector<UInt4x2> packed(UInt4x2::CalcNumInt4Pairs(values.size()));
+    UInt4x2::Pack(packed, values);
+    tensor_proto.set_data_type(TensorProto_DataType_UINT4);
+    utils::SetRawDataInTensorProto(tensor_proto, packed.data(), packed.size() * sizeof(UInt4x2));
+  } else {
+    tensor_proto.set_data_type(TensorProto_DataType_UINT8);
+    utils::SetRawDataInTensorProto(tensor_proto, values.data(), values.size() * sizeof(uint8_t));
+  }
+  for (int64_t dim : dims) {
+    tensor_proto.add_dims(dim);
+  }
+  return graph_utils::AddInitializer(graph, tensor_proto);
+}
+
+int64_t GetGatherAxis(const Node& node, int64_t rank) {
+  const AttributeProto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+  return axis_attr != nullptr ? HandleNegativeAxis(axis_attr->i(), rank) : 0;
+}
+
+// Returns the table read by the Gather node if it may be quantized, or nullptr.
+const TensorProto* GetQuantizableTable(const Graph& graph, const NodeArg& data_arg, int64_t min_elements) {
+  const TensorProto* tensor_proto = graph_utils::GetConstantInitializer(graph, data_arg.Name(), false);
+  if (tensor_proto == nullptr || tensor_proto->data_type() != TensorProto_DataType_FLOAT ||
+      tensor_proto->dims_size() < 2 || graph.IsOutput(&data_arg)) {
+    return nullptr;
+  }
+
+  int64_t num_elements = 1;
+  for (int64_t dim : tensor_proto->dims()) {
+    num_elements *= dim;
+  }
+  const int64_t rank = tensor_proto->dims_size();
+  if (num_elements < min_elements || tensor_proto->dims(narrow<int>(rank - 1)) == 0) {
+    return nullptr;
+  }
+
+  // The float table is only released if all of its consumers are replaced. A Gather along the innermost axis would
+  // dequantize each gathered element on its own, so it is not replaced.
+  for (const Node* consumer : graph.GetConsumerNodes(data_arg.Name())) {
+    if (consumer == nullptr || consumer->OpType() != "Gather" || consumer->InputDefs()[0] != &data_arg ||
+        GetGatherAxis(*consumer, rank) == rank - 1) {
+      return nullptr;
+    }
+  }
+
+  return tensor_proto;
+}
+
+std::optional<QuantizedTable> QuantizeTable(Graph& graph, const NodeArg& data_arg, const TensorProto& tensor_proto,
+                                            int64_t bits, float max_error, const logging::Logger& logger) {
+  Initializer values{tensor_proto, graph.ModelPath()};
+  const int64_t row_size = tensor_proto.dims(tensor_proto.dims_size() - 1);
+  const int64_t block_size = GetBlockSize(row_size);
+
+  std::vector<uint8_t> quantized;
+  std::vector<float> scales;
+  std::vector<uint8_t> zero_points;
+  const double error = QuantizeRows(values.DataAsSpan<float>(), row_size, block_size, bits,
+                                    quantized, scales, zero_points);
+  if (error > max_error) {
+    LOGS(logger, VERBOSE) << "Not quantizing " << data_arg.Name() << " as the relative error " << error
+                          << " exceeds the budget " << max_error;
+    return std::nullopt;
+  }
+
+  InlinedVector<int64_t> dims(tensor_proto.dims().begin(), tensor_proto.dims().end());
+  InlinedVector<int64_t> scale_dims(dims);
+  scale_dims.back() = (row_size + block_size - 1) / block_size;
+
+  TensorProto scales_proto;
+  scales_proto.set_name(graph.GenerateNodeArgName(data_arg.Name() + "_scales"));
+  scales_proto.set_data_type(TensorProto_DataType_FLOAT);
+  utils::SetRawDataInTensorProto(scales_proto, scales.data(), scales.size() * sizeof(float));
+  for (int64_t dim : scale_dims) {
+    scales_proto.add_dims(dim);
+  }
+
+  return QuantizedTable{&AddQuantizedInitializer(graph, data_arg.Name() + "_quantized", quantized, dims, bits),
+                        &graph_utils::AddInitializer(graph, scales_proto),
+                        &AddQuantizedInitializer(graph, data_arg.Name() + "_zero_points", zero_points, scale_dims,
+                                                 bits),
+                        static_cast<int64_t>(dims.size()),
+                        block_size};
+}
+
+}  // namespace
+
+Status GatherBlockQuantization::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                          const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  // The quantized tables, or nullopt if a table may not be quantized.
+  InlinedHashMap<const NodeArg*, std::optional<QuantizedTable>> tables;
+
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (p_node == nullptr) continue;
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gather", {1, 11, 13}) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    const NodeArg* data_arg = node.InputDefs()[0];
+    auto table = tables.find(data_arg);
+    if (table == tables.end()) {
+      std::optional<QuantizedTable> quantized_table;
+      if (const TensorProto* tensor_proto = GetQuantizableTable(graph, *data_arg, min_elements_)) {
+        quantized_table = QuantizeTable(graph, *data_arg, *tensor_proto, bits_, max_error_, logger);
+      }
+      table = tables.emplace(data_arg, std::move(quantized_table)).first;
+    }
+
+    if (!table->second.has_value()) {
+      continue;
+    }
+
+    const QuantizedTable& quantized_table = *table->second;
+    Node& quantized_node = graph.AddNode(graph.GenerateNodeName(node.Name() + "_quantized"), "GatherBlockQuantized",
+                                         "Gather with block quantized data",
+                                         {quantized_table.data, node.MutableInputDefs()[1], quantized_table.scales,
+                                          quantized_table.zero_points},
+                                         node.MutableOutputDefs(), nullptr, kMSDomain);
+    quantized_node.AddAttribute("gather_axis", GetGatherAxis(node, quantized_table.rank));
+    quantized_node.AddAttribute("quantize_axis", quantized_table.rank - 1);
+    quantized_node.AddAttribute("block_size", quantized_table.block_size);
+    quantized_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    // The edges of the new node are created when the graph is resolved. The float table is removed then too if
+    // it is no longer used.
+    graph_utils::RemoveNodeOutputEdges(graph, node);
+    graph.RemoveNode(node.Index());
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
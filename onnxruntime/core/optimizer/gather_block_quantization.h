@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class GatherBlockQuantization
+
+Quantize the data of Gather nodes that read from large constant float tables, e.g. embedding tables, and replace
+the nodes with GatherBlockQuantized nodes.
+
+The table is quantized block-wise along its innermost axis to unsigned 4 or 8 bit integers, with a scale and zero
+point per block. Only the gathered rows are dequantized, so the float table does not need to be kept in memory.
+A table is left as is if the quantization error exceeds the accuracy budget, or if it is used by other nodes.
+*/
+class GatherBlockQuantization : public GraphTransformer {
+ public:
+  GatherBlockQuantization(int64_t bits, int64_t min_elements, float max_error,
+                          const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("GatherBlockQuantization", compatible_execution_providers),
+        bits_(bits),
+        min_elements_(min_elements),
+        max_error_(max_error) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+ private:
+  int64_t bits_;
+  int64_t min_elements_;
+  float max_error_;
+};
+
+}  // namespace onnxruntime
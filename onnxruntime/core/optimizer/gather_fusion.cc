@@ -3,9 +3,11 @@
 
 #include "core/optimizer/gather_fusion.h"
 
+#include "core/common/narrow.h"
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/utils.h"
+#include "core/providers/common.h"
 
 namespace onnxruntime {
 
@@ -52,6 +54,18 @@ static bool GetAxis(const Graph& graph, const Node& node, int64_t rank, int64_t&
   return false;
 }
 
+static bool GetReduceAxes(const Graph& graph, const Node& node, InlinedVector<int64_t>& axes) {
+  const auto& attrs = node.GetAttributes();
+  if (auto axes_attr = attrs.find("axes"); axes_attr != attrs.end()) {
+    for (int64_t axis : axes_attr->second.ints()) {
+      axes.push_back(axis);
+    }
+    return true;
+  }
+  return node.InputDefs().size() >= 2 && node.InputDefs()[1]->Exists() &&
+         optimizer_utils::AppendTensorFromInitializer(graph, *node.InputDefs()[1], axes);
+}
+
 }  // namespace
 
 bool GatherSliceToSplitFusion::IsSupportedGather(const Graph& graph, const Node& node, int64_t rank,
@@ -403,4 +417,73 @@ Status GatherToSliceFusion::ApplyImpl(Graph& graph, bool& modified, int graph_le
   return Status::OK();
 }
 
+Status GatherReduceToEmbeddingBagFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                                   const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (p_node == nullptr) continue;  // we removed the node as part of an earlier fusion
+    Node& node = *p_node;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gather", {1, 11, 13}) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        !optimizer_utils::CheckOutputEdges(graph, node, 1)) {
+      continue;
+    }
+
+    const NodeArg* data_arg = node.InputDefs()[0];
+    const auto* data_shape = data_arg->Shape();
+    const auto* indices_shape = node.InputDefs()[1]->Shape();
+    const auto* data_type = data_arg->TypeAsProto();
+    if (data_shape == nullptr || indices_shape == nullptr || data_type == nullptr ||
+        data_type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+      continue;
+    }
+
+    // The bags are along the last axis of the indices, which must not be empty as the mean of an empty bag is NaN.
+    const int64_t data_rank = data_shape->dim_size();
+    const int64_t indices_rank = indices_shape->dim_size();
+    if (data_rank < 1 || indices_rank < 1 || GetGatherAxis(node, data_rank) != 0 ||
+        !utils::HasDimValue(indices_shape->dim(narrow<int>(indices_rank - 1))) ||
+        indices_shape->dim(narrow<int>(indices_rank - 1)).dim_value() == 0) {
+      continue;
+    }
+
+    Node& reduce_node = *graph.GetNode(node.OutputNodesBegin()->Index());
+    const bool is_sum = graph_utils::IsSupportedOptypeVersionAndDomain(reduce_node, "ReduceSum", {1, 11, 13});
+    if ((!is_sum && !graph_utils::IsSupportedOptypeVersionAndDomain(reduce_node, "ReduceMean", {1, 11, 13, 18})) ||
+        !graph_utils::IsSupportedProvider(reduce_node, GetCompatibleExecutionProviders()) ||
+        reduce_node.InputDefs()[0] != node.OutputDefs()[0]) {
+      continue;
+    }
+
+    const ONNX_NAMESPACE::AttributeProto* keepdims_attr = graph_utils::GetNodeAttribute(reduce_node, "keepdims");
+    InlinedVector<int64_t> axes;
+    if (keepdims_attr == nullptr || keepdims_attr->i() != 0 || !GetReduceAxes(graph, reduce_node, axes) ||
+        axes.size() != 1) {
+      continue;
+    }
+    const int64_t output_rank = indices_rank + data_rank - 1;
+    if (HandleNegativeAxis(axes[0], output_rank) != indices_rank - 1) {
+      continue;
+    }
+
+    Node& embedding_bag_node = graph.AddNode(graph.GenerateNodeName("EmbeddingBag"), "EmbeddingBag",
+                                             "Fused Gather and " + reduce_node.OpType(),
+                                             {node.MutableInputDefs()[0], node.MutableInputDefs()[1]},
+                                             {reduce_node.MutableOutputDefs()[0]}, nullptr, kMSDomain);
+    embedding_bag_node.AddAttribute("mode", std::string(is_sum ? "sum" : "mean"));
+    embedding_bag_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, {node, reduce_node}, embedding_bag_node);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
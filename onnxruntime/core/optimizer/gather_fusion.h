@@ -40,4 +40,18 @@ class GatherToSliceFusion : public GraphTransformer {
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
+/**
+@Class GatherReduceToEmbeddingBagFusion
+
+Fuse Gather->ReduceSum or Gather->ReduceMean over the last axis of the indices to an EmbeddingBag node, which
+accumulates the gathered rows directly into the output instead of materializing them.
+*/
+class GatherReduceToEmbeddingBagFusion : public GraphTransformer {
+ public:
+  GatherReduceToEmbeddingBagFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("GatherReduceToEmbeddingBagFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
 }  // namespace onnxruntime
@@ -35,10 +35,12 @@
 #include "core/optimizer/double_qdq_pairs_remover.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
 #include "core/optimizer/free_dim_override_transformer.h"
+#include "core/optimizer/gather_block_quantization.h"
 #include "core/optimizer/gather_fusion.h"
 #include "core/optimizer/gelu_approximation.h"
 #include "core/optimizer/gelu_fusion.h"
@@ -347,6 +349,7 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<EmbedLayerNormFusion>(cpu_acl_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<GatherSliceToSplitFusion>(cpu_cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<GatherToSliceFusion>(cpu_cuda_rocm_eps));
+      transformers.emplace_back(std::make_unique<GatherReduceToEmbeddingBagFusion>(cpu_ep));
 
       transformers.emplace_back(std::make_unique<MatmulTransposeFusion>(cpu_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<BiasGeluFusion>(cpu_acl_cuda_dml_rocm_eps));
@@ -390,6 +393,23 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 
       transformers.emplace_back(std::make_unique<MatMulNBitsFusion>(cpu_ep));
 
+      // GatherBlockQuantization changes the results, so it needs to be enabled with the accuracy budget of the model.
+      const int64_t gather_block_quantize_bits = ParseStringWithClassicLocale<int64_t>(
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsGatherBlockQuantizeBits, "0"));
+      if (gather_block_quantize_bits != 0) {
+        ORT_ENFORCE(gather_block_quantize_bits == 4 || gather_block_quantize_bits == 8,
+                    "Invalid value for ", kOrtSessionOptionsGatherBlockQuantizeBits, ": ", gather_block_quantize_bits,
+                    ". It must be 0, 4 or 8.");
+        const int64_t gather_block_quantize_min_elements = ParseStringWithClassicLocale<int64_t>(
+            session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsGatherBlockQuantizeMinElements,
+                                                              "1048576"));
+        const float gather_block_quantize_max_error = ParseStringWithClassicLocale<float>(
+            session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsGatherBlockQuantizeMaxError, "0.01"));
+        transformers.emplace_back(std::make_unique<GatherBlockQuantization>(gather_block_quantize_bits,
+                                                                            gather_block_quantize_min_elements,
+                                                                            gather_block_quantize_max_error, cpu_ep));
+      }
+
 #endif  // !defined(DISABLE_CONTRIB_OPS)
       // The QDQFinalCleanupTransformer must run AFTER other transformers that fuse Q/DQ nodes. Otherwise, their
       // fusions might be prevented if this one removes a Q/DQ node too early.
@@ -417,6 +437,14 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       // PR #6351 implemented similar fusion-pattern for CUDA only, and can only fuse conv-add-relu,
       // while we can fuse more activation.
       transformers.emplace_back(std::make_unique<ConvAddActivationFusion>(cpu_ep));
+
+      // ElementwiseFusion runs last so that the pattern based fusions above and in level 2 get the first pick of
+      // the elementwise operators. It is opt-in as the fused kernel may change the results slightly.
+      const bool enable_elementwise_fusion =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableElementwiseFusion, "0") == "1";
+      if (enable_elementwise_fusion) {
+        transformers.emplace_back(std::make_unique<ElementwiseFusion>(cpu_ep));
+      }
 #endif
 
     } break;
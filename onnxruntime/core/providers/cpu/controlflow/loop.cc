@@ -12,6 +12,7 @@
 #include "core/providers/cpu/controlflow/loop.h"
 #include "core/providers/cpu/controlflow/utils.h"
 
+#include "core/common/safeint.h"
 #include "core/framework/allocator.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/op_kernel_context_internal.h"
@@ -195,6 +196,104 @@ Loop::Info::Info(const onnxruntime::Node& node, const GraphViewer& subgraph_in)
   }
 }
 
+namespace {
+
+// Accumulates the per-iteration values of a Loop scan output that is on CPU in one buffer.
+// The subgraph writes each iteration directly into the next slot of the buffer, which is provided as a pre-allocated
+// fetch, so the per-iteration values don't need to be kept until the end of the loop and concatenated.
+// The capacity of the buffer grows geometrically as the number of iterations is not known up front.
+class ScanOutputBuffer {
+ public:
+  // Initialize from the value produced by the first iteration. The buffer is not used if the value isn't a CPU tensor
+  // with a fixed size element type.
+  void Initialize(const OrtValue& first_output, AllocatorPtr allocator, int64_t max_trip_count) {
+    const auto& tensor = first_output.Get<Tensor>();
+    if (tensor.Location().device.Type() != OrtDevice::CPU || tensor.IsDataTypeString() || tensor.SizeInBytes() == 0) {
+      return;
+    }
+
+    element_type_ = tensor.DataType();
+    per_iteration_shape_ = tensor.Shape();
+    bytes_per_iteration_ = tensor.SizeInBytes();
+    allocator_ = std::move(allocator);
+    max_trip_count_ = max_trip_count;
+  }
+
+  bool IsInitialized() const { return allocator_ != nullptr; }
+
+  // Get the pre-allocated fetch for the next iteration.
+  OrtValue NextSlot() {
+    if (num_iterations_ == capacity_) {
+      Grow();
+    }
+
+    auto p_tensor = std::make_unique<Tensor>(element_type_, per_iteration_shape_, SlotData(num_iterations_),
+                                             allocator_->Info());
+    OrtValue slot;
+    // the slot keeps the buffer alive in case the subgraph also returns it as a loop carried variable.
+    slot.Init(p_tensor.release(), DataTypeImpl::GetType<Tensor>(),
+              [buffer = buffer_](void* p) { delete static_cast<Tensor*>(p); });
+    return slot;
+  }
+
+  // Save the value produced by the current iteration. This is a no-op if the subgraph wrote into the slot.
+  Status Save(const OrtValue& output) {
+    if (num_iterations_ == capacity_) {
+      Grow();
+    }
+
+    const auto& tensor = output.Get<Tensor>();
+    void* slot_data = SlotData(num_iterations_);
+    if (tensor.DataRaw() != slot_data) {
+      if (tensor.Shape() != per_iteration_shape_) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Inconsistent shape in loop output for output. ",
+                               " Expected:", per_iteration_shape_, " Got:", tensor.Shape());
+      }
+      memcpy(slot_data, tensor.DataRaw(), bytes_per_iteration_);
+    }
+
+    ++num_iterations_;
+    return Status::OK();
+  }
+
+  const TensorShape& PerIterationShape() const { return per_iteration_shape_; }
+  int64_t NumIterations() const { return num_iterations_; }
+  size_t SizeInBytes() const { return static_cast<size_t>(num_iterations_) * bytes_per_iteration_; }
+  const void* Data() const { return buffer_.get(); }
+
+ private:
+  void* SlotData(int64_t iteration) const {
+    return static_cast<uint8_t*>(buffer_.get()) + static_cast<size_t>(iteration) * bytes_per_iteration_;
+  }
+
+  void Grow() {
+    constexpr int64_t kInitialCapacity = 16;
+    int64_t capacity = capacity_ == 0 ? kInitialCapacity : capacity_ * 2;
+    capacity = std::max<int64_t>(std::min(capacity, max_trip_count_), capacity_ + 1);
+
+    std::shared_ptr<void> buffer = IAllocator::MakeUniquePtr<void>(
+        allocator_, SafeInt<size_t>(capacity) * bytes_per_iteration_);
+    if (num_iterations_ != 0) {
+      memcpy(buffer.get(), buffer_.get(), SizeInBytes());
+    }
+
+    buffer_ = std::move(buffer);
+    capacity_ = capacity;
+  }
+
+  MLDataType element_type_{nullptr};
+  TensorShape per_iteration_shape_;
+  size_t bytes_per_iteration_{0};
+  AllocatorPtr allocator_;
+  int64_t max_trip_count_{0};
+
+  std::shared_ptr<void> buffer_;
+  int64_t capacity_{0};
+  int64_t num_iterations_{0};
+};
+
+}  // namespace
+
 class LoopImpl {
  public:
   LoopImpl(OpKernelContextInternal& context,
@@ -211,10 +310,15 @@ class LoopImpl {
 
  private:
   void CreateInitialFeeds(std::vector<OrtValue>& feeds);
-  void SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs);
+  void UpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs);
+
+  // provide the next buffer slot as the fetch for the scan outputs that are buffered
+  void SetupScanOutputFetches(std::vector<OrtValue>& fetches);
+  Status SaveScanOutputs(const std::vector<OrtValue>& last_outputs);
 
   // create the single Loop output from a collection of per-iteration outputs
   Status ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index);
+  Status CopyBufferedLoopOutput(const ScanOutputBuffer& buffer, int output_index);
 
   OpKernelContextInternal& context_;
   const SessionState& session_state_;
@@ -228,10 +332,15 @@ class LoopImpl {
   OrtValue iter_num_mlvalue_;
   OrtValue condition_mlvalue_;
 
+  AllocatorPtr cpu_allocator_;
+
   // collection of OrtValue outputs from each loop iteration for the loop outputs.
   // the order from the subgraph matches the order from the loop output
   std::vector<std::vector<OrtValue>> loop_output_tensors_;
 
+  // the loop outputs that are on CPU are accumulated in a buffer instead
+  std::vector<ScanOutputBuffer> loop_output_buffers_;
+
   const Loop::ConcatOutput& concat_output_func_;
 };
 
@@ -428,11 +537,12 @@ Status LoopImpl::Initialize() {
   auto condition_rank = subgraph_inputs[1]->Shape()->dim_size();
 
   // these need to be on CPU
-  auto cpu_allocator = session_state_.GetAllocator(session_state_.GetExecutionProviders().Get(onnxruntime::kCpuExecutionProvider)->GetOrtDeviceByMemType(OrtMemTypeDefault));
-  iter_num_mlvalue_ = MakeScalarMLValue<int64_t>(cpu_allocator, 0, iter_num_rank != 0);
-  condition_mlvalue_ = MakeScalarMLValue<bool>(cpu_allocator, condition_, condition_rank != 0);
+  cpu_allocator_ = session_state_.GetAllocator(session_state_.GetExecutionProviders().Get(onnxruntime::kCpuExecutionProvider)->GetOrtDeviceByMemType(OrtMemTypeDefault));
+  iter_num_mlvalue_ = MakeScalarMLValue<int64_t>(cpu_allocator_, 0, iter_num_rank != 0);
+  condition_mlvalue_ = MakeScalarMLValue<bool>(cpu_allocator_, condition_, condition_rank != 0);
 
   loop_output_tensors_.resize(static_cast<size_t>(info_.num_outputs) - info_.num_loop_carried_vars);
+  loop_output_buffers_.resize(static_cast<size_t>(info_.num_outputs) - info_.num_loop_carried_vars);
 
   return status;
 }
@@ -455,8 +565,7 @@ void LoopImpl::CreateInitialFeeds(std::vector<OrtValue>& feeds) {
   }
 }
 
-void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs,
-                                         std::vector<OrtValue>& next_inputs) {
+void LoopImpl::UpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs) {
   // last_output: cond, loop vars..., loop output...
   // next_input: iter_num, cond, loop_vars. iter_num is re-used
 
@@ -464,12 +573,42 @@ void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outpu
   for (ptrdiff_t i = 1; i < info_.num_subgraph_inputs; ++i) {
     next_inputs[i] = last_outputs[i - 1];
   }
+}
+
+void LoopImpl::SetupScanOutputFetches(std::vector<OrtValue>& fetches) {
+  // the fetches for cond and loop carried vars are allocated by the subgraph execution
+  fetches.assign(static_cast<size_t>(info_.num_subgraph_outputs), OrtValue());
+
+  for (ptrdiff_t j = info_.num_loop_carried_vars; j < info_.num_outputs; ++j) {
+    auto& buffer = loop_output_buffers_[j - info_.num_loop_carried_vars];
+    if (buffer.IsInitialized()) {
+      fetches[j + 1] = buffer.NextSlot();  // skip 'cond' in output
+    }
+  }
+}
 
-  // save loop outputs as we have to concatenate at the end
+Status LoopImpl::SaveScanOutputs(const std::vector<OrtValue>& last_outputs) {
   for (ptrdiff_t j = info_.num_loop_carried_vars; j < info_.num_outputs; ++j) {
-    ORT_ENFORCE(last_outputs[j + 1].IsTensor(), "All scan outputs MUST be tensors");
-    loop_output_tensors_[j - info_.num_loop_carried_vars].push_back(last_outputs[j + 1]);  // skip 'cond' in output
+    const auto& output = last_outputs[j + 1];  // skip 'cond' in output
+    ORT_RETURN_IF_NOT(output.IsTensor(), "All scan outputs MUST be tensors");
+
+    auto& per_iteration_outputs = loop_output_tensors_[j - info_.num_loop_carried_vars];
+    auto& buffer = loop_output_buffers_[j - info_.num_loop_carried_vars];
+
+    // the buffer is set up from the first iteration. if it can't be used the values are saved to concatenate
+    // at the end.
+    if (!buffer.IsInitialized() && per_iteration_outputs.empty()) {
+      buffer.Initialize(output, cpu_allocator_, max_trip_count_);
+    }
+
+    if (buffer.IsInitialized()) {
+      ORT_RETURN_IF_ERROR(buffer.Save(output));
+    } else {
+      per_iteration_outputs.push_back(output);
+    }
   }
+
+  return Status::OK();
 }
 
 Status LoopImpl::ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index) {
@@ -492,6 +631,39 @@ Status LoopImpl::ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_outp
   return Status::OK();
 }
 
+Status LoopImpl::CopyBufferedLoopOutput(const ScanOutputBuffer& buffer, int output_index) {
+  const auto& per_iteration_dims = buffer.PerIterationShape().GetDims();
+
+  TensorShapeVector dims;
+  dims.reserve(1 + per_iteration_dims.size());
+
+  // first dimension is number of iterations
+  dims.push_back(buffer.NumIterations());
+  std::copy(per_iteration_dims.begin(), per_iteration_dims.end(), std::back_inserter(dims));
+
+  Tensor* output = context_.Output(output_index, TensorShape(dims));
+
+  if (output->Location().device.Type() == OrtDevice::CPU) {
+    memcpy(output->MutableDataRaw(), buffer.Data(), buffer.SizeInBytes());
+  } else {
+    // a derived Loop kernel may have the Loop output on another device
+    Tensor buffered_output(output->DataType(), output->Shape(), const_cast<void*>(buffer.Data()),
+                           cpu_allocator_->Info());
+    const auto* data_transfer = session_state_.GetDataTransferMgr().GetDataTransfer(
+        buffered_output.Location().device, output->Location().device);
+    ORT_RETURN_IF(data_transfer == nullptr, "No data transfer registered to copy Loop output ", output_index);
+
+    Stream* ort_stream = context_.GetComputeStream();
+    if (ort_stream) {
+      ORT_RETURN_IF_ERROR(data_transfer->CopyTensorAsync(buffered_output, *output, *ort_stream));
+    } else {
+      ORT_RETURN_IF_ERROR(data_transfer->CopyTensor(buffered_output, *output));
+    }
+  }
+
+  return Status::OK();
+}
+
 Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
   auto status = Status::OK();
 
@@ -504,8 +676,8 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
 
   while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
     if (iter_num_value != 0) {
-      SaveOutputsAndUpdateFeeds(fetches, feeds);
-      fetches.clear();
+      UpdateFeeds(fetches, feeds);
+      SetupScanOutputFetches(fetches);
     }
 
     status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, {},
@@ -515,6 +687,7 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
                                     // have to perofrm a stream sync to make sure the data arrived.
                                     true);
     ORT_RETURN_IF_ERROR(status);
+    ORT_RETURN_IF_ERROR(SaveScanOutputs(fetches));
 
     condition_mlvalue_ = fetches[0];
 
@@ -594,11 +767,13 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
     }
 
     for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
-      // add last output
-      auto& per_iteration_outputs = loop_output_tensors_[static_cast<ptrdiff_t>(i) - info_.num_loop_carried_vars];
-      per_iteration_outputs.push_back(fetches[static_cast<ptrdiff_t>(i) + 1]);  // skip cond
-
-      ORT_RETURN_IF_ERROR(ConcatenateLoopOutput(per_iteration_outputs, i));
+      const auto& buffer = loop_output_buffers_[static_cast<ptrdiff_t>(i) - info_.num_loop_carried_vars];
+      if (buffer.IsInitialized()) {
+        ORT_RETURN_IF_ERROR(CopyBufferedLoopOutput(buffer, i));
+      } else {
+        auto& per_iteration_outputs = loop_output_tensors_[static_cast<ptrdiff_t>(i) - info_.num_loop_carried_vars];
+        ORT_RETURN_IF_ERROR(ConcatenateLoopOutput(per_iteration_outputs, i));
+      }
     }
   } else {
     // no iterations.
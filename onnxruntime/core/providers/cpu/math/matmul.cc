@@ -4,6 +4,7 @@
 #include "core/providers/cpu/math/matmul.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/providers/cpu/math/matmul_helper.h"
+#include "core/providers/cpu/tunable/math/gemm.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
@@ -133,7 +134,7 @@ Status MatMul<T>::Compute(OpKernelContext* ctx) const {
 
   return Status::OK();
 }
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
 bool GemmPackBBfloat16(AllocatorPtr& alloc,
                        const Tensor& tensor_b,
                        bool trans_b,
@@ -172,6 +173,33 @@ bool GemmPackBBfloat16(AllocatorPtr& alloc,
 }
 #endif
 
+// Packs the non-zero blocks of a 2D weight matrix if enough of them are zero for the block sparse kernel to be
+// faster than the dense one.
+static bool GemmPackBSparseFp32(AllocatorPtr& alloc,
+                                const Tensor& tensor_b,
+                                bool trans_b,
+                                IAllocatorUniquePtr<void>& packed_b,
+                                size_t& packed_b_size,
+                                TensorShape& b_shape) {
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+
+  const size_t K = trans_b ? static_cast<size_t>(tensor_b.Shape()[1]) : static_cast<size_t>(tensor_b.Shape()[0]);
+  const size_t N = trans_b ? static_cast<size_t>(tensor_b.Shape()[0]) : static_cast<size_t>(tensor_b.Shape()[1]);
+  const CBLAS_TRANSPOSE trans = trans_b ? CblasTrans : CblasNoTrans;
+
+  packed_b_size = MlasSparseGemmPackBSize(trans, N, K, tensor_b.Data<float>(), trans_b ? K : N);
+  if (packed_b_size == 0) {
+    return false;
+  }
+
+  b_shape = tensor_b.Shape();
+  packed_b = IAllocator::MakeUniquePtr<void>(alloc, packed_b_size, true);
+  MlasSparseGemmPackB(trans, N, K, tensor_b.Data<float>(), trans_b ? K : N, packed_b.get());
+  return true;
+}
+
 Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ AllocatorPtr alloc,
                               /*out*/ bool& is_packed,
                               /*out*/ PrePackedWeights* prepacked_weights) {
@@ -180,7 +208,7 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ Alloc
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
     size_t dim1 = 0;
     size_t dim2 = 0;
     TensorShape b_shape = tensor.Shape();
@@ -195,7 +223,11 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ Alloc
     } else
 #endif
     {
-      is_packed = GemmPackBFp32(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
+      // the block sparse kernel doesn't support a transposed A
+      use_sparse_b_ = trans_a_attr_ == 0 && !trans_batch_a_ && !trans_batch_b_ &&
+                      GemmPackBSparseFp32(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
+      is_packed = use_sparse_b_ ||
+                  GemmPackBFp32(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
     }
 
     bool share_prepacked_weights = (prepacked_weights != nullptr);
@@ -227,12 +259,21 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const Tensor* b = packed_b_ ? nullptr : ctx->Input<Tensor>(1);
   const auto& b_shape = b ? b->Shape() : b_shape_;
 
-  // match CUDA kernel implementation, ignore transpose for vectors
-  const bool trans_a = trans_a_attr_ && a->Shape().NumDimensions() != 1;
-  const bool trans_b = trans_b_attr_ && b_shape.NumDimensions() != 1;
-
-  MatMulComputeHelper helper;
-  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape, trans_a, trans_b, trans_batch_a_, trans_batch_b_));
+  std::shared_ptr<const Plan> plan;
+  ORT_RETURN_IF_ERROR(plan_cache_.GetOrCreate(
+      {&a->Shape(), &b_shape},
+      [&](Plan& new_plan) {
+        // match CUDA kernel implementation, ignore transpose for vectors
+        new_plan.trans_a = trans_a_attr_ && a->Shape().NumDimensions() != 1;
+        new_plan.trans_b = trans_b_attr_ && b_shape.NumDimensions() != 1;
+        return new_plan.helper.Compute(a->Shape(), b_shape, new_plan.trans_a, new_plan.trans_b,
+                                       trans_batch_a_, trans_batch_b_);
+      },
+      plan));
+
+  const MatMulComputeHelper& helper = plan->helper;
+  const bool trans_a = plan->trans_a;
+  const bool trans_b = plan->trans_b;
   Tensor* y = ctx->Output(0, helper.OutputShape());
 
   // Bail out early if the output is going to be empty
@@ -258,7 +299,14 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const size_t K = static_cast<size_t>(helper.K());
   const size_t lda = helper.Lda(trans_a);
   const size_t ldb = helper.Ldb(trans_b);
-#if defined(__aarch64__) && defined(__linux__)
+  if (use_sparse_b_) {
+    for (size_t i = 0; i < max_len; i++) {
+      MlasSparseGemm(M, N, K, alpha_attr_, a_data + helper.LeftOffsets()[i], lda, packed_b_.get(),
+                     y_data + helper.OutputOffsets()[i], N, thread_pool);
+    }
+    return Status::OK();
+  }
+#if defined(MLAS_SBGEMM_SUPPORTED)
   if (use_fastmath_mode_ && !trans_b && ((N * K) >= kFastMathModeKernelsizeThreshold)) {
     std::vector<MLAS_SBGEMM_DATA_PARAMS> data(max_len);
     for (size_t i = 0; i < max_len; i++) {
@@ -289,8 +337,9 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
       data[i].alpha = alpha_attr_;
       data[i].beta = 0.0f;
     }
-    MlasGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
-                  M, N, K, data.data(), max_len, thread_pool);
+    ORT_RETURN_IF_ERROR(cpu::tunable::TunableSgemmBatch(tuning_ctx_, trans_a ? CblasTrans : CblasNoTrans,
+                                                        trans_b ? CblasTrans : CblasNoTrans,
+                                                        M, N, K, data.data(), max_len, thread_pool));
   }
   return Status::OK();
 }
@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include "core/framework/kernel_plan_cache.h"
 #include "core/framework/op_kernel.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/math/matmul_helper.h"
+#include "core/providers/cpu/tunable/cpu_tunable.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
@@ -29,10 +32,14 @@ class MatMul<float> final : public OpKernel {
     info.GetAttrOrDefault<int64_t>("transBatchB", &trans_batch_b_attr, 0);
     trans_batch_a_ = trans_batch_a_attr != 0;
     trans_batch_b_ = trans_batch_b_attr != 0;
+    tuning_ctx_ = cpu::tunable::GetCpuTuningContext(info);
 
-#if defined(__aarch64__) && defined(__linux__)
-    auto config_ops = info.GetConfigOptions().GetConfigEntry(kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16);
-    use_fastmath_mode_ = (config_ops == "1") && MlasBf16AccelerationSupported();
+#if defined(MLAS_SBGEMM_SUPPORTED)
+    const auto& config_options = info.GetConfigOptions();
+    const bool fastmath_requested =
+        config_options.GetConfigOrDefault(kOrtSessionOptionsMlasGemmFastMathBfloat16, "0") == "1" ||
+        config_options.GetConfigOrDefault(kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16, "0") == "1";
+    use_fastmath_mode_ = fastmath_requested && MlasBf16AccelerationSupported();
 #endif
   }
 
@@ -46,8 +53,19 @@ class MatMul<float> final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
+  // The shape dependent state of Compute, which is cached per input shape signature.
+  struct Plan {
+    MatMulComputeHelper helper;
+    bool trans_a;
+    bool trans_b;
+  };
+
   TensorShape b_shape_;
   IAllocatorUniquePtr<void> packed_b_;
+  // packed_b_ holds the non-zero blocks of a block sparse B for MlasSparseGemm
+  bool use_sparse_b_ = false;
+  KernelPlanCache<Plan> plan_cache_;
+  cpu::tunable::CpuTuningContext* tuning_ctx_;
 
   // For FusedMatMul contrib ops
   float alpha_attr_;
@@ -56,10 +74,10 @@ class MatMul<float> final : public OpKernel {
   bool trans_batch_a_;
   bool trans_batch_b_;
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
   // fastmath mode state
   bool use_fastmath_mode_;
-  // sbgemm kernel is implemented as 8x8 blocks with weights pre-packed to 4 blocks of 4x2
+  // sbgemm kernels process blocks of at least 32 elements of the pre-packed weights
   // so a minimum of 32 elements is defined to outweigh the additional prepacking overhead
   const size_t kFastMathModeKernelsizeThreshold = 32;
 #endif
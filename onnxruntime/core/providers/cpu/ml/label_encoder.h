@@ -4,6 +4,7 @@
 #pragma once
 #include <filesystem>
 #include "core/common/common.h"
+#include "core/common/flat_string_map.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/ml/ml_common.h"
 #include "core/framework/tensorprotoutils.h"
@@ -24,13 +25,13 @@ class LabelEncoder final : public OpKernel {
 
     auto num_entries = string_classes.size();
 
-    string_to_int_map_.reserve(num_entries);
+    string_to_int_map_.Reserve(num_entries);
     int_to_string_map_.reserve(num_entries);
 
     for (size_t i = 0; i < num_entries; ++i) {
       const std::string& str = string_classes[i];
 
-      string_to_int_map_[str] = i;
+      string_to_int_map_.InsertOrAssign(str, i);
       int_to_string_map_[i] = str;
     }
   }
@@ -38,13 +39,54 @@ class LabelEncoder final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  std::unordered_map<std::string, int64_t> string_to_int_map_;
+  FlatStringMap<int64_t> string_to_int_map_;
   std::unordered_map<int64_t, std::string> int_to_string_map_;
 
   std::string default_string_;
   int64_t default_int_;
 };
 
+// String keyed encoders use a FlatStringMap, whose keys live in one contiguous pool and which maps
+// the input in prefetched batches. Other key types keep the given hash map. Both keep the first value
+// of a duplicated key.
+template <typename TKey, typename TValue, typename TMap>
+using LabelEncoderMap = std::conditional_t<std::is_same_v<TKey, std::string>, FlatStringMap<TValue>, TMap>;
+
+template <typename TMap, typename TKey>
+void LabelEncoderMapReserve(TMap& map, const std::vector<TKey>& keys) {
+  if constexpr (std::is_same_v<TKey, std::string>) {
+    size_t total_key_size = 0;
+    for (const auto& key : keys) {
+      total_key_size += key.size();
+    }
+    map.Reserve(keys.size(), total_key_size);
+  } else {
+    map.reserve(keys.size());
+  }
+}
+
+template <typename TMap, typename TKey, typename TValue>
+void LabelEncoderMapEmplace(TMap& map, const TKey& key, const TValue& value) {
+  if constexpr (std::is_same_v<TKey, std::string>) {
+    map.TryEmplace(key, value);
+  } else {
+    map.emplace(key, value);
+  }
+}
+
+template <typename TMap, typename TKey, typename TValue>
+void LabelEncoderMapLookup(const TMap& map, gsl::span<const TKey> input, gsl::span<TValue> output,
+                           const TValue& default_value, concurrency::ThreadPool* threadpool) {
+  if constexpr (std::is_same_v<TKey, std::string>) {
+    ParallelLookup(input, output, threadpool, map, default_value);
+  } else {
+    ParallelLookup(input, output, threadpool, [&map, &default_value](const TKey& key) -> const TValue& {
+      const auto found = map.find(key);
+      return found == map.end() ? default_value : found->second;
+    });
+  }
+}
+
 template <typename TKey, typename TValue>
 class LabelEncoder_2 final : public OpKernel {
  public:
@@ -63,8 +105,8 @@ class LabelEncoder_2 final : public OpKernel {
     ORT_ENFORCE(num_keys == num_values, "The ", key_field_name_, " and ", value_field_name_,
                 " attributes in LabelEncoder ", "(name: ", info.node().Name(), ") must have the same length. ",
                 "However, the number of key is ", num_keys, " and the number of ", "values is ", num_values, ".");
-    map_.reserve(num_keys);
-    for (size_t i = 0; i < num_keys; ++i) map_.emplace(keys[i], values[i]);
+    LabelEncoderMapReserve(map_, keys);
+    for (size_t i = 0; i < num_keys; ++i) LabelEncoderMapEmplace(map_, keys[i], values[i]);
   }
 
   Status Compute(OpKernelContext* context) const override {
@@ -74,14 +116,7 @@ class LabelEncoder_2 final : public OpKernel {
 
     auto input = X->template DataAsSpan<TKey>();
     auto output = Y->template MutableDataAsSpan<TValue>();
-    auto input_iter = input.begin();
-    auto output_iter = output.begin();
-    while (input_iter != input.end()) {
-      const auto found = map_.find(*input_iter);
-      *output_iter = found == map_.end() ? default_value_ : found->second;
-      ++output_iter;
-      ++input_iter;
-    }
+    LabelEncoderMapLookup(map_, input, output, default_value_, context->GetOperatorThreadPool());
     return Status::OK();
   }
 
@@ -94,7 +129,7 @@ class LabelEncoder_2 final : public OpKernel {
   // A collection of key-value pairs. Each (a_key, a_value) pair
   // means that the "a_key" in the input would be mapped to "a_value".
   // If map_ doesn't contain "a_key", we use default_value_ as its output.
-  InlinedHashMap<TKey, TValue> map_;
+  LabelEncoderMap<TKey, TValue, InlinedHashMap<TKey, TValue>> map_;
   TValue default_value_;
   // ONNX attribute name to load keys.
   std::string key_field_name_;
@@ -202,8 +237,9 @@ class LabelEncoder_4 final : public OpKernel {
     auto keys = GetAttribute<TKey>(kernel_info, key_field_name_, "keys_tensor");
     auto values = GetAttribute<TValue>(kernel_info, value_field_name_, "values_tensor");
     ORT_ENFORCE(keys.size() == values.size(), "Keys and values must have the same length.");
+    LabelEncoderMapReserve(map_, keys);
     for (size_t i = 0; i < keys.size(); ++i) {
-      map_.emplace(keys[i], values[i]);
+      LabelEncoderMapEmplace(map_, keys[i], values[i]);
     }
   }
   Status Compute(OpKernelContext* context) const override {
@@ -213,20 +249,13 @@ class LabelEncoder_4 final : public OpKernel {
 
     auto input = X->template DataAsSpan<TKey>();
     auto output = Y->template MutableDataAsSpan<TValue>();
-    auto input_iter = input.begin();
-    auto output_iter = output.begin();
-    while (input_iter != input.end()) {
-      const auto found = map_.find(*input_iter);
-      *output_iter = found == map_.end() ? default_value_ : found->second;
-      ++output_iter;
-      ++input_iter;
-    }
+    LabelEncoderMapLookup(map_, input, output, default_value_, context->GetOperatorThreadPool());
     return Status::OK();
   }
 
  private:
   void InitializeAttrFields(const OpKernelInfo& kernel_info);
-  HashMap<TKey, TValue, NaNHash<TKey>, NaNEqual<TKey>> map_;
+  LabelEncoderMap<TKey, TValue, HashMap<TKey, TValue, NaNHash<TKey>, NaNEqual<TKey>>> map_;
   TValue default_value_;
   std::string key_field_name_;
   std::string value_field_name_;
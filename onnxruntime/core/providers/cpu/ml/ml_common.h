@@ -3,6 +3,7 @@
 
 #pragma once
 #include "core/common/common.h"
+#include "core/common/flat_string_map.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
 #include "core/util/math.h"
@@ -528,5 +529,35 @@ void batched_update_scores_inplace(gsl::span<T> scores, int64_t num_batches_in,
     }
   }
 }
+
+// Writes lookup(input[i]) to output[i] for every element, splitting the input across the thread pool.
+// Used by the encoder and mapper kernels, whose lookups are independent and read only shared tables.
+template <typename TInput, typename TOutput, typename LookupFn>
+void ParallelLookup(gsl::span<const TInput> input, gsl::span<TOutput> output, concurrency::ThreadPool* threadpool,
+                    LookupFn lookup) {
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, static_cast<std::ptrdiff_t>(input.size()), 16.0,
+      [&input, &output, &lookup](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          output[i] = lookup(input[i]);
+        }
+      });
+}
+
+// String keyed variant: each thread maps its part of the input with FlatStringMap::FindEach.
+template <typename TValue, typename TOutput>
+void ParallelLookup(gsl::span<const std::string> input, gsl::span<TOutput> output, concurrency::ThreadPool* threadpool,
+                    const FlatStringMap<TValue>& map, const TOutput& default_value) {
+  // A string key costs a hash over its bytes plus a probe.
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, static_cast<std::ptrdiff_t>(input.size()), 64.0,
+      [&input, &output, &map, &default_value](std::ptrdiff_t first, std::ptrdiff_t last) {
+        auto out = output.subspan(first, last - first);
+        map.FindEach(input.subspan(first, last - first), [&out, &default_value](size_t i, const TValue* found) {
+          out[i] = found == nullptr ? default_value : *found;
+        });
+      });
+}
+
 }  // namespace ml
 }  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/svmclassifier.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 // TODO: fix the warnings
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -74,6 +75,10 @@ SVMClassifier::SVMClassifier(const OpKernelInfo& info)
   ORT_ENFORCE(coefficients_.size() > 0);
   weights_are_all_positive_ = std::all_of(coefficients_.cbegin(), coefficients_.cend(),
                                           [](float value) { return value >= 0.f; });
+
+  if (mode_ == SVM_TYPE::SVM_SVC) {
+    PackSupportVectors(info, support_vectors_, vector_count_, feature_count_);
+  }
 }
 
 template <typename LabelType>
@@ -245,66 +250,82 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
     // combine the input data with the support vectors and apply the kernel type
     // output is {num_batches, vector_count_}
     batched_kernel_dot<float>(x_data, support_vectors_, num_batches, vector_count_, feature_count_, 0.f, kernels_span,
-                              threadpool);
-
-    for (int64_t n = 0; n < num_batches; n++) {
-      // reduce scores from kernels using coefficients, taking into account the varying number of support vectors
-      // per class.
-      // coefficients: [num_classes - 1, vector_count_]
-      //
-      // e.g. say you have 3 classes, with 3 x 3 coefficients
-      //
-      // AA AB AC
-      // BA BB BC
-      // CA CB CC
-      //
-      // you can remove the diagonal line of items comparing a class with itself leaving one less row.
-      //
-      // BA AB AC
-      // CA CB BC
-      //
-      // for each class there is a coefficient per support vector, and a class has one or more support vectors.
-      //
-      // Combine the scores for the two combinations for two classes with their coefficient.
-      // e.g. AB combines with BA.
-      // If A has 3 support vectors and B has 2, there's a 3x2 block for AB and a 2x3 block for BA to combine
-
-      auto cur_kernels = kernels_span.subspan(n * SafeInt<size_t>(vector_count_), onnxruntime::narrow<size_t>(vector_count_));
-      auto cur_scores = classifier_scores.subspan(n * SafeInt<size_t>(num_slots_per_iteration), onnxruntime::narrow<size_t>(num_classifiers));
-      auto cur_votes = votes_span.subspan(n * SafeInt<size_t>(class_count_), onnxruntime::narrow<size_t>(class_count_));
-      auto scores_iter = cur_scores.begin();
-
-      size_t classifier_idx = 0;
-      for (int64_t i = 0; i < class_count_ - 1; i++) {
-        int64_t start_index_i = starting_vector_[onnxruntime::narrow<size_t>(i)];  // start of support vectors for class i
-        int64_t class_i_support_count = vectors_per_class_[onnxruntime::narrow<size_t>(i)];
-        int64_t i_coeff_row_offset = vector_count_ * i;
-
-        for (int64_t j = i + 1; j < class_count_; j++) {
-          int64_t start_index_j = starting_vector_[onnxruntime::narrow<size_t>(j)];  // start of support vectors for class j
-          int64_t class_j_support_count = vectors_per_class_[onnxruntime::narrow<size_t>(j)];
-          int64_t j_coeff_row_offset = vector_count_ * (j - 1);
-
-          double sum = 0;
-
-          const float* val1 = &(coefficients_[j_coeff_row_offset + SafeInt<size_t>(start_index_i)]);
-          const float* val2 = &(cur_kernels[onnxruntime::narrow<size_t>(start_index_i)]);
-          for (int64_t m = 0; m < class_i_support_count; ++m, ++val1, ++val2)
-            sum += *val1 * *val2;
-
-          val1 = &(coefficients_[i_coeff_row_offset + SafeInt<size_t>(start_index_j)]);
-          val2 = &(cur_kernels[onnxruntime::narrow<size_t>(start_index_j)]);
-
-          for (int64_t m = 0; m < class_j_support_count; ++m, ++val1, ++val2)
-            sum += *val1 * *val2;
-
-          sum += rho_[classifier_idx++];
-
-          *scores_iter++ = static_cast<float>(sum);
-          ++(cur_votes[onnxruntime::narrow<size_t>(sum > 0 ? i : j)]);
+                              threadpool, true);
+
+    // reduce scores from kernels using coefficients, taking into account the varying number of support vectors
+    // per class.
+    // coefficients: [num_classes - 1, vector_count_]
+    //
+    // e.g. say you have 3 classes, with 3 x 3 coefficients
+    //
+    // AA AB AC
+    // BA BB BC
+    // CA CB CC
+    //
+    // you can remove the diagonal line of items comparing a class with itself leaving one less row.
+    //
+    // BA AB AC
+    // CA CB BC
+    //
+    // for each class there is a coefficient per support vector, and a class has one or more support vectors.
+    //
+    // Combine the scores for the two combinations for two classes with their coefficient.
+    // e.g. AB combines with BA.
+    // If A has 3 support vectors and B has 2, there's a 3x2 block for AB and a 2x3 block for BA to combine
+    //
+    // The support vectors of class c meet every coefficient row, so one GEMM per class computes
+    //   partials[n, c, r] = sum over the support vectors v of class c of kernels[n, v] * coefficients[r, v]
+    // and the classifier for classes i < j is partials[n, i, j - 1] + partials[n, j, i] + rho.
+    const int64_t partials_per_class = class_count_ - 1;
+    const int64_t partials_per_batch = class_count_ * partials_per_class;
+    std::vector<float> partials_data(SafeInt<size_t>(partials_per_batch) * static_cast<size_t>(num_batches), 0.f);
+
+    if (partials_per_class > 0) {
+      for (int64_t c = 0; c < class_count_; c++) {
+        const int64_t start_index = starting_vector_[onnxruntime::narrow<size_t>(c)];
+        const int64_t class_support_count = vectors_per_class_[onnxruntime::narrow<size_t>(c)];
+        if (class_support_count == 0) {
+          continue;
         }
+
+        MlasGemm(CblasNoTrans, CblasTrans,
+                 onnxruntime::narrow<size_t>(num_batches),
+                 onnxruntime::narrow<size_t>(partials_per_class),
+                 onnxruntime::narrow<size_t>(class_support_count),
+                 1.f,
+                 kernels_data.data() + start_index, onnxruntime::narrow<size_t>(vector_count_),
+                 coefficients_.data() + start_index, onnxruntime::narrow<size_t>(vector_count_),
+                 0.f,
+                 partials_data.data() + c * partials_per_class, onnxruntime::narrow<size_t>(partials_per_batch),
+                 threadpool);
       }
     }
+
+    // score and vote for every class pair, with the batch rows processed in parallel
+    auto score_batches = [this, &partials_data, partials_per_batch, partials_per_class, &classifier_scores,
+                          num_slots_per_iteration, num_classifiers, &votes_span](ptrdiff_t first, ptrdiff_t last) {
+      for (ptrdiff_t n = first; n < last; n++) {
+        const float* partials = partials_data.data() + n * partials_per_batch;
+        auto cur_scores = classifier_scores.subspan(n * SafeInt<size_t>(num_slots_per_iteration), onnxruntime::narrow<size_t>(num_classifiers));
+        auto cur_votes = votes_span.subspan(n * SafeInt<size_t>(class_count_), onnxruntime::narrow<size_t>(class_count_));
+        auto scores_iter = cur_scores.begin();
+
+        size_t classifier_idx = 0;
+        for (int64_t i = 0; i < class_count_ - 1; i++) {
+          for (int64_t j = i + 1; j < class_count_; j++) {
+            double sum = static_cast<double>(partials[i * partials_per_class + j - 1]) +
+                         static_cast<double>(partials[j * partials_per_class + i]) +
+                         rho_[classifier_idx++];
+
+            *scores_iter++ = static_cast<float>(sum);
+            ++(cur_votes[onnxruntime::narrow<size_t>(sum > 0 ? i : j)]);
+          }
+        }
+      }
+    };
+
+    concurrency::ThreadPool::TryParallelFor(threadpool, num_batches, static_cast<double>(num_classifiers * 4),
+                                            score_batches);
   }
 
   auto finalize_batch = [this, &final_scores, final_scores_per_batch,
@@ -3,8 +3,12 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "core/common/common.h"
+#include "core/common/narrow.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math_cpuonly.h"
 #include "ml_common.h"
 #include "core/providers/cpu/math/gemm.h"
@@ -30,41 +34,126 @@ class SVMCommon {
   void set_kernel_type(KERNEL new_kernel_type) { kernel_type_ = new_kernel_type; }
   KERNEL get_kernel_type() const { return kernel_type_; }
 
+  // Packs the support vectors, [vector_count, feature_count], once as the B matrix of the kernel GEMM and
+  // caches their squared norms for the RBF kernel. Both are used by batched_kernel_dot when b is the
+  // support vectors. For the RBF kernel the support vectors are centered on their mean first, which leaves
+  // ||x - s||^2 unchanged but keeps the norms of its expansion small for features with a large offset.
+  void PackSupportVectors(const OpKernelInfo& info, gsl::span<const float> support_vectors,
+                          ptrdiff_t vector_count, ptrdiff_t feature_count) {
+    if (vector_count <= 0 || feature_count <= 0) {
+      return;
+    }
+
+    const size_t n = narrow<size_t>(vector_count);
+    const size_t k = narrow<size_t>(feature_count);
+    if (support_vectors.size() != n * k) {
+      return;
+    }
+
+    const float* b = support_vectors.data();
+    if (kernel_type_ == KERNEL::RBF) {
+      Eigen::ArrayXd mean = Eigen::ArrayXd::Zero(narrow<Eigen::Index>(k));
+      for (size_t i = 0; i < n; ++i) {
+        mean += ConstEigenVectorArrayMap<float>(b + i * k, k).cast<double>();
+      }
+      support_vector_mean_.resize(k);
+      EigenVectorArrayMap<float>(support_vector_mean_.data(), k) = (mean / static_cast<double>(n)).cast<float>();
+
+      centered_support_vectors_.resize(n * k);
+      support_vector_norms_.resize(n);
+      for (size_t i = 0; i < n; ++i) {
+        auto centered = EigenVectorArrayMap<float>(centered_support_vectors_.data() + i * k, k);
+        centered = ConstEigenVectorArrayMap<float>(b + i * k, k) -
+                   ConstEigenVectorArrayMap<float>(support_vector_mean_.data(), k);
+        support_vector_norms_[i] = centered.square().sum();
+      }
+      b = centered_support_vectors_.data();
+    }
+
+    const size_t packed_size = MlasGemmPackBSize(n, k);
+    if (packed_size != 0) {
+      AllocatorPtr alloc = info.GetAllocator(OrtMemType::OrtMemTypeDefault);
+      packed_support_vectors_ = IAllocator::MakeUniquePtr<void>(alloc, packed_size, true);
+      memset(packed_support_vectors_.get(), 0, packed_size);
+      MlasGemmPackB(CblasTrans, n, k, b, k, packed_support_vectors_.get());
+      // The packed copy replaces the centered one
+      centered_support_vectors_ = std::vector<float>();
+    }
+  }
+
+  // out[m, n] = kernel(a[m, k], b[n, k]). b_is_support_vectors selects the data cached by PackSupportVectors.
   template <typename T>
   void batched_kernel_dot(const gsl::span<const T> a, const gsl::span<const T> b,
                           ptrdiff_t m, ptrdiff_t n, ptrdiff_t k,
                           float scalar_C,
                           const gsl::span<T> out,
-                          concurrency::ThreadPool* threadpool) const {
+                          concurrency::ThreadPool* threadpool,
+                          bool b_is_support_vectors = false) const {
     assert(a.size() == size_t(m * k) && b.size() == size_t(k * n) && out.size() == size_t(m * n));
 
-    if (kernel_type_ == KERNEL::RBF) {
-      T* cur_out = out.data();
-      const T* cur_batch = a.data();
+    const bool packed_b = b_is_support_vectors && packed_support_vectors_ != nullptr;
 
-      // each batch has 'k' features
-      for (int64_t batch = 0; batch < m; ++batch) {
-        const T* cur_support_vector = b.data();
+    if (kernel_type_ == KERNEL::RBF) {
+      // exp(-gamma * ||x - s||^2) with ||x - s||^2 = ||x||^2 + ||s||^2 - 2 x.s, so the cross terms are a
+      // single GEMM followed by a vectorized exp pass. Both sides are centered on the support vector mean
+      // when b is the support vectors.
+      const float* a_data = a.data();
+      const float* b_data = b.data();
+      std::vector<float> centered_a;
+      const bool centered = b_is_support_vectors && !support_vector_mean_.empty();
+      if (centered) {
+        centered_a.resize(a.size());
+        const auto mean = ConstEigenVectorArrayMap<float>(support_vector_mean_.data(), k);
+        for (ptrdiff_t i = 0; i < m; ++i) {
+          EigenVectorArrayMap<float>(centered_a.data() + i * k, k) =
+              ConstEigenVectorArrayMap<float>(a.data() + i * k, k) - mean;
+        }
+        a_data = centered_a.data();
+        if (!packed_b) {
+          b_data = centered_support_vectors_.data();
+        }
+      }
+      KernelGemm(a_data, b_data, packed_b, m, n, k, -2.f, 0.f, out.data(), threadpool);
 
-        // broadcast the support vectors against the k features in each batch. output is one value per support vector
-        for (int64_t support_vector = 0; support_vector < n; ++support_vector) {
-          T sum = 0.f;
-          const T* cur_input = cur_batch;
+      const float* b_norms = centered ? support_vector_norms_.data() : nullptr;
+      std::vector<float> computed_norms;
+      if (b_norms == nullptr) {
+        computed_norms.resize(narrow<size_t>(n));
+        for (size_t j = 0; j < computed_norms.size(); ++j) {
+          computed_norms[j] = ConstEigenVectorArrayMap<float>(b.data() + j * k, k).square().sum();
+        }
+        b_norms = computed_norms.data();
+      }
 
-          for (int64_t feature = 0; feature < k; ++feature) {
-            T val = *cur_input++ - *cur_support_vector++;
-            sum += val * val;
-          }
+      const float gamma = gamma_;
+      concurrency::ThreadPool::TryParallelFor(
+          threadpool, m, static_cast<double>(n) * 16,
+          [&a, &b, &out, a_data, b_norms, gamma, n, k](ptrdiff_t first, ptrdiff_t last) {
+            for (ptrdiff_t i = first; i < last; ++i) {
+              const float* x = a.data() + i * k;
+              float* row = out.data() + i * n;
+              const float x_norm = ConstEigenVectorArrayMap<float>(a_data + i * k, k).square().sum();
 
-          *cur_out++ = std::exp(-gamma_ * sum);
-        }
+              for (ptrdiff_t j = 0; j < n; ++j) {
+                // The expansion loses about FLT_EPSILON * (||x||^2 + ||s||^2) of absolute precision, the direct
+                // formula about FLT_EPSILON * ||x - s||^2. Pairs where the cancellation is severe are recomputed
+                // directly, unless the error is negligible for the kernel value anyway.
+                const float norms = x_norm + b_norms[j];
+                float distance = std::max(row[j] + norms, 0.f);
+                if (gamma * norms > kRbfExpansionLimit && distance < norms * kRbfCancellationRatio) {
+                  distance = (ConstEigenVectorArrayMap<float>(x, k) -
+                              ConstEigenVectorArrayMap<float>(b.data() + j * k, k))
+                                 .square()
+                                 .sum();
+                }
+                row[j] = -gamma * distance;
+              }
 
-        cur_batch += k;  // move to start of next batch
-      }
+              MlasComputeExp(row, row, narrow<size_t>(n));
+            }
+          });
     } else {
       float alpha = 1.f;
-      float beta = 1.f;
-      static const TensorShape shape_C({1});
       float c = scalar_C;  // scalar_C is used for LINEAR in the GEMM
 
       if (kernel_type_ != KERNEL::LINEAR) {
@@ -73,12 +162,20 @@ class SVMCommon {
         c = coef0_;
       }
 
-      onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
-                                        m, n, k,
-                                        alpha, a.data(), b.data(), beta,
-                                        c != 0.f ? &c : nullptr, &shape_C,
-                                        out.data(),
-                                        threadpool);
+      if (packed_b) {
+        if (c != 0.f) {
+          std::fill(out.begin(), out.end(), c);
+        }
+        KernelGemm(a.data(), b.data(), packed_b, m, n, k, alpha, c != 0.f ? 1.f : 0.f, out.data(), threadpool);
+      } else {
+        static const TensorShape shape_C({1});
+        onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                          m, n, k,
+                                          alpha, a.data(), b.data(), 1.f,
+                                          c != 0.f ? &c : nullptr, &shape_C,
+                                          out.data(),
+                                          threadpool);
+      }
 
       if (kernel_type_ == KERNEL::POLY) {
         auto map_out = EigenVectorArrayMap<T>(out.data(), out.size());
@@ -96,15 +193,38 @@ class SVMCommon {
   }
 
  private:
+  // Below this value of gamma * (||x||^2 + ||s||^2) the rounding error of the RBF expansion is negligible.
+  static constexpr float kRbfExpansionLimit = 8.f;
+  // Pairs with ||x - s||^2 below this fraction of ||x||^2 + ||s||^2 lose more than 4 bits to the RBF expansion.
+  static constexpr float kRbfCancellationRatio = 1.f / 16;
+
+  // out[m, n] = alpha * a[m, k] * b[n, k]^T + beta * out
+  void KernelGemm(const float* a, const float* b, bool packed_b, ptrdiff_t m, ptrdiff_t n, ptrdiff_t k,
+                   float alpha, float beta, float* out, concurrency::ThreadPool* threadpool) const {
+    if (packed_b) {
+      MlasGemm(CblasNoTrans, narrow<size_t>(m), narrow<size_t>(n), narrow<size_t>(k), alpha, a, narrow<size_t>(k),
+               packed_support_vectors_.get(), beta, out, narrow<size_t>(n), threadpool);
+    } else {
+      MlasGemm(CblasNoTrans, CblasTrans, narrow<size_t>(m), narrow<size_t>(n), narrow<size_t>(k), alpha, a,
+               narrow<size_t>(k), b, narrow<size_t>(k), beta, out, narrow<size_t>(n), threadpool);
+    }
+  }
+
   KERNEL kernel_type_;
   float gamma_{0.f};
   float coef0_{0.f};
   float degree_{0.f};
+  IAllocatorUniquePtr<void> packed_support_vectors_;
+  std::vector<float> support_vector_norms_;
+  std::vector<float> support_vector_mean_;
+  // Only kept when the support vectors could not be packed.
+  std::vector<float> centered_support_vectors_;
 };
 
 class SVMClassifier final : public OpKernel, private SVMCommon {
   using SVMCommon::batched_kernel_dot;
   using SVMCommon::get_kernel_type;
+  using SVMCommon::PackSupportVectors;
   using SVMCommon::set_kernel_type;
 
  public:
@@ -36,6 +36,10 @@ SVMRegressor<T>::SVMRegressor(const OpKernelInfo& info)
     mode_ = SVM_TYPE::SVM_LINEAR;
     set_kernel_type(KERNEL::LINEAR);
   }
+
+  if (mode_ == SVM_TYPE::SVM_SVC) {
+    PackSupportVectors(info, support_vectors_, vector_count_, feature_count_);
+  }
 }
 
 template <typename T>
@@ -68,7 +72,7 @@ Status SVMRegressor<T>::Compute(OpKernelContext* ctx) const {
     // combine the input data with the support vectors and apply the kernel type
     // output is {num_batches, vector_count_}
     batched_kernel_dot<float>(x_data, support_vectors_, num_batches, vector_count_, feature_count_, 0.f, tmp_data_span,
-                              threadpool);
+                              threadpool, true);
 
     static const TensorShape rho_shape({1});
 
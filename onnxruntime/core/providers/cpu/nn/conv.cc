@@ -17,8 +17,12 @@
 
 #include "core/providers/cpu/nn/conv.h"
 
+#include <algorithm>
+#include <sstream>
+
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
+#include "core/providers/cpu/tunable/cpu_tunable.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -153,6 +157,169 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+namespace {
+
+struct ConvParams : cpu::tunable::OpParams {
+  ConvParams(cpu::tunable::CpuTuningContext* tuning_ctx) : OpParams(tuning_ctx, nullptr) {}
+
+  std::string Signature() const override {
+    std::ostringstream oss;
+    const auto append = [&oss](const char* name, const int64_t* values, size_t count) {
+      oss << name;
+      for (size_t i = 0; i < count; ++i) {
+        oss << (i == 0 ? "" : "x") << values[i];
+      }
+    };
+    oss << "N" << parameters->BatchCount << "_G" << parameters->GroupCount << "_C" << parameters->InputChannels << "_M"
+        << parameters->FilterCount;
+    append("_X", input_shape, kernel_rank);
+    append("_K", kernel_shape, kernel_rank);
+    append("_S", strides, kernel_rank);
+    append("_D", dilations, kernel_rank);
+    append("_P", pads, 2 * kernel_rank);
+    oss << "_A" << static_cast<int>(parameters->Activation->ActivationKind) << "_B" << parameters->Beta
+        << "_T" << concurrency::ThreadPool::DegreeOfParallelism(thread_pool);
+    return oss.str();
+  }
+
+  const MLAS_CONV_PARAMETERS* parameters;
+  size_t working_buffer_size;
+  size_t kernel_rank;
+  const int64_t* input_shape;
+  const int64_t* output_shape;
+  const int64_t* kernel_shape;
+  const int64_t* strides;
+  const int64_t* dilations;
+  const int64_t* pads;
+  const float* X;
+  const float* W;
+  const float* B;
+  float* Y;
+  AllocatorPtr alloc;
+  concurrency::ThreadPool* thread_pool;
+};
+
+// MLAS picks the algorithm, e.g. a direct GEMM for pointwise convolutions, a depthwise kernel, or an expansion of the
+// input into segments that are multiplied on separate threads.
+Status MlasConvOp(const ConvParams* params) {
+  const size_t working_buffer_size = params->working_buffer_size;
+  auto* working_data = working_buffer_size > 0
+                           ? params->alloc->Alloc(sizeof(float) * SafeInt<size_t>(working_buffer_size))
+                           : nullptr;
+  BufferUniquePtr working_buffer(working_data, BufferDeleter(params->alloc));
+
+  MlasConv(params->parameters,
+           params->X,
+           params->W,
+           params->B,
+           static_cast<float*>(working_buffer.get()),
+           params->Y,
+           params->thread_pool);
+  return Status::OK();
+}
+
+// Expands the whole image of each group with Im2col and multiplies it with the filters in one threaded GEMM.
+Status Im2colConvOp(const ConvParams* params) {
+  const MLAS_CONV_PARAMETERS& parameters = *params->parameters;
+  const size_t group_count = parameters.GroupCount;
+  const size_t kernel_dim = parameters.K;
+  const size_t X_offset = parameters.InputChannels * parameters.InputSize;
+  const size_t Y_offset = parameters.FilterCount * parameters.OutputSize;
+  const size_t W_offset = parameters.FilterCount * kernel_dim;
+
+  auto col_data = IAllocator::MakeUniquePtr<float>(params->alloc, SafeInt<size_t>(kernel_dim) * parameters.OutputSize);
+  const float* Xdata = params->X;
+  float* Ydata = params->Y;
+  for (size_t image_id = 0; image_id < parameters.BatchCount; ++image_id) {
+    for (size_t group_id = 0; group_id < group_count; ++group_id) {
+      math::Im2col<float, StorageOrder::NCHW>()(
+          Xdata + group_id * X_offset,
+          params->input_shape,
+          params->output_shape,
+          narrow<int64_t>(kernel_dim),
+          params->kernel_shape,
+          params->strides,
+          params->dilations,
+          params->pads,
+          narrow<ptrdiff_t>(params->kernel_rank),
+          col_data.get());
+
+      math::Gemm<float>(
+          CblasNoTrans,
+          CblasNoTrans,
+          narrow<ptrdiff_t>(parameters.FilterCount),
+          narrow<ptrdiff_t>(parameters.OutputSize),
+          narrow<ptrdiff_t>(kernel_dim),
+          1,
+          params->W + group_id * W_offset,
+          col_data.get(),
+          parameters.Beta,
+          Ydata + group_id * Y_offset,
+          params->thread_pool);
+    }
+
+    MlasActivation(parameters.Activation, Ydata, params->B, group_count * parameters.FilterCount,
+                   parameters.OutputSize, parameters.OutputSize);
+
+    Xdata += X_offset * group_count;
+    Ydata += Y_offset * group_count;
+  }
+  return Status::OK();
+}
+
+class ConvTunableOp : public cpu::tunable::TunableOp<ConvParams> {
+ public:
+  ConvTunableOp() {
+    this->RegisterOp(MlasConvOp);
+    this->RegisterOp(Im2colConvOp);
+  }
+
+  // The candidates accumulate into the output if there is a Sum input, so they are tuned on a copy of it.
+  const ConvParams* PreTuning(const ConvParams* params) override {
+    if (params->parameters->Beta == 0.0f) {
+      return params;
+    }
+    const size_t output_size = params->parameters->BatchCount * params->parameters->GroupCount *
+                               params->parameters->FilterCount * params->parameters->OutputSize;
+    auto* proxy_params = new ConvParams(*params);
+    proxy_params->Y = static_cast<float*>(params->alloc->Alloc(SafeInt<size_t>(sizeof(float)) * output_size));
+    std::copy_n(params->Y, output_size, proxy_params->Y);
+    return proxy_params;
+  }
+
+  void PostTuning(const ConvParams* params) override {
+    if (params->parameters->Beta != 0.0f) {
+      params->alloc->Free(params->Y);
+      delete params;
+    }
+  }
+};
+
+}  // namespace
+
+Status Conv<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* /*prepacked_weights*/) {
+  is_packed = false;
+
+  // Remember a constant 3x3 filter that MLAS may use with the Winograd algorithm. The original filter is still used
+  // by the other algorithms, so the filter is not reported as packed and the transformed filter is not shared.
+  const auto& shape = tensor.Shape();
+  if (input_idx != 1 || shape.NumDimensions() != 4 || shape[2] != 3 || shape[3] != 3 || conv_attrs_.group <= 0 ||
+      shape[0] % conv_attrs_.group != 0) {
+    return Status::OK();
+  }
+  const auto is_one = [](int64_t value) { return value == 1; };
+  if (!std::all_of(conv_attrs_.strides.begin(), conv_attrs_.strides.end(), is_one) ||
+      !std::all_of(conv_attrs_.dilations.begin(), conv_attrs_.dilations.end(), is_one) ||
+      !MlasConvWinogradSupportsChannels(narrow<size_t>(shape[0] / conv_attrs_.group), narrow<size_t>(shape[1]))) {
+    return Status::OK();
+  }
+
+  packed_w_alloc_ = std::move(alloc);
+  return Status::OK();
+}
+
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* X = context->Input<Tensor>(0);
@@ -162,29 +329,85 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   const int64_t N = X->Shape()[0];
   const int64_t C = X->Shape()[1];
   const int64_t M = W->Shape()[0];
-  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
+  // Whether there is a Sum input only depends on the node, so it is the same for all the cached plans.
+  const float Beta = Sum != nullptr ? 1.0f : 0.0f;
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
 
-  // kernel_shape is an optional attribute and has to be inferred from W if not provided
-  TensorShapeVector kernel_shape;
-  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W->Shape(), kernel_shape));
+  std::shared_ptr<const Plan> plan;
+  ORT_RETURN_IF_ERROR(plan_cache_.GetOrCreate(
+      {&X->Shape(), &W->Shape()},
+      [&](Plan& new_plan) -> Status {
+        ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
 
-  ConvPadVector pads(conv_attrs_.pads);
-  if (pads.empty()) {
-    pads.resize(kernel_shape.size() * 2, 0);
-  }
-  TensorShapeVector dilations(conv_attrs_.dilations);
-  if (dilations.empty()) {
-    dilations.resize(kernel_shape.size(), 1);
-  }
-  TensorShapeVector strides(conv_attrs_.strides);
-  if (strides.empty()) {
-    strides.resize(kernel_shape.size(), 1);
-  }
+        // kernel_shape is an optional attribute and has to be inferred from W if not provided
+        TensorShapeVector& kernel_shape = new_plan.kernel_shape;
+        ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W->Shape(), kernel_shape));
 
-  TensorShapeVector Y_dims({N, M});
+        ConvPadVector& pads = new_plan.pads;
+        pads = conv_attrs_.pads;
+        if (pads.empty()) {
+          pads.resize(kernel_shape.size() * 2, 0);
+        }
+        TensorShapeVector& dilations = new_plan.dilations;
+        dilations = conv_attrs_.dilations;
+        if (dilations.empty()) {
+          dilations.resize(kernel_shape.size(), 1);
+        }
+        TensorShapeVector& strides = new_plan.strides;
+        strides = conv_attrs_.strides;
+        if (strides.empty()) {
+          strides.resize(kernel_shape.size(), 1);
+        }
+
+        new_plan.Y_dims = {N, M};
+        TensorShape input_shape = X->Shape().Slice(2);
+        ORT_RETURN_IF_ERROR(conv_attrs_.InferPadsAndOutputShape(input_shape, kernel_shape, strides, dilations, pads,
+                                                                new_plan.Y_dims));
+
+        new_plan.working_buffer_size = 0;
+        const size_t kernel_rank = kernel_shape.size();
+        if (kernel_rank >= 1 && kernel_rank <= 3 && TensorShape(new_plan.Y_dims).Size() != 0) {
+          TensorShape output_shape = TensorShape(new_plan.Y_dims).Slice(2);
+          MlasConvPrepare(&new_plan.parameters,
+                          kernel_rank,
+                          narrow<size_t>(N),
+                          narrow<size_t>(conv_attrs_.group),
+                          narrow<size_t>(C / conv_attrs_.group),
+                          input_shape.GetDims().data(),
+                          kernel_shape.data(),
+                          dilations.data(),
+                          pads.data(),
+                          strides.data(),
+                          output_shape.GetDims().data(),
+                          narrow<size_t>(M / conv_attrs_.group),
+                          &activation_,
+                          &new_plan.working_buffer_size,
+                          Beta,
+                          thread_pool);
+          if (packed_w_alloc_ != nullptr && new_plan.parameters.Algorithm == MlasConvAlgorithmWinograd) {
+            const MLAS_CONV_PARAMETERS& parameters = new_plan.parameters;
+            std::call_once(packed_w_once_, [&]() {
+              packed_w_ = IAllocator::MakeUniquePtr<float>(
+                  packed_w_alloc_,
+                  MlasConvWinogradPackFilterSize(parameters.GroupCount, parameters.FilterCount,
+                                                 parameters.InputChannels),
+                  true);
+              MlasConvWinogradPackFilter(parameters.GroupCount, parameters.FilterCount, parameters.InputChannels,
+                                         W->Data<float>(), packed_w_.get());
+            });
+            MlasConvSetWinogradPackedFilter(&new_plan.parameters, packed_w_.get(), &new_plan.working_buffer_size);
+          }
+        }
+        return Status::OK();
+      },
+      plan));
+
+  const TensorShapeVector& kernel_shape = plan->kernel_shape;
+  const ConvPadVector& pads = plan->pads;
+  const TensorShapeVector& dilations = plan->dilations;
+  const TensorShapeVector& strides = plan->strides;
   TensorShape input_shape = X->Shape().Slice(2);
-  ORT_RETURN_IF_ERROR(conv_attrs_.InferPadsAndOutputShape(input_shape, kernel_shape, strides, dilations, pads, Y_dims));
-  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+  Tensor* Y = context->Output(0, TensorShape(plan->Y_dims));
   TensorShape output_shape = Y->Shape().Slice(2);
 
   // Bail out early if one of the dimensions is zero.
@@ -199,7 +422,6 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   const auto* Bdata = B != nullptr ? B->Data<float>() : nullptr;
   auto Ydata = Y->MutableDataAsSpan<float>();
   // Check for the optional Conv/Sum fusion.
-  float Beta = 0.0f;
   if (Sum != nullptr) {
     const auto& sum_shape = Sum->Shape();
     ORT_RETURN_IF_NOT(Y->Shape() == sum_shape, "output and sum shape must match");
@@ -208,42 +430,32 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
     if (Ydata.data() != sum_data.data()) {
       gsl::copy(sum_data, Ydata);
     }
-    Beta = 1.0f;
   }
   const size_t kernel_rank = kernel_shape.size();
-  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
 
   if (kernel_rank >= 1 && kernel_rank <= 3) {
-    MLAS_CONV_PARAMETERS Parameters;
-    size_t WorkingBufferSize;
-    MlasConvPrepare(&Parameters,
-                    kernel_rank,
-                    narrow<size_t>(N),
-                    narrow<size_t>(conv_attrs_.group),
-                    narrow<size_t>(C / conv_attrs_.group),
-                    input_shape.GetDims().data(),
-                    kernel_shape.data(),
-                    dilations.data(),
-                    pads.data(),
-                    strides.data(),
-                    output_shape.GetDims().data(),
-                    narrow<size_t>(M / conv_attrs_.group),
-                    &activation_,
-                    &WorkingBufferSize,
-                    Beta,
-                    thread_pool);
-
-    auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * SafeInt<size_t>(WorkingBufferSize))
-                                               : nullptr;
-    BufferUniquePtr working_buffer(working_data, BufferDeleter(std::move(alloc)));
-
-    MlasConv(&Parameters,
-             Xdata.data(),
-             W->Data<float>(),
-             Bdata,
-             static_cast<float*>(working_buffer.get()),
-             Ydata.data(),
-             thread_pool);
+    ConvParams params(tuning_ctx_);
+    params.parameters = &plan->parameters;
+    params.working_buffer_size = plan->working_buffer_size;
+    params.kernel_rank = kernel_rank;
+    params.input_shape = input_shape.GetDims().data();
+    params.output_shape = output_shape.GetDims().data();
+    params.kernel_shape = kernel_shape.data();
+    params.strides = strides.data();
+    params.dilations = dilations.data();
+    params.pads = pads.data();
+    params.X = Xdata.data();
+    params.W = W->Data<float>();
+    params.B = Bdata;
+    params.Y = Ydata.data();
+    params.alloc = std::move(alloc);
+    params.thread_pool = thread_pool;
+
+    if (tuning_ctx_ != nullptr && tuning_ctx_->IsTunableOpEnabled()) {
+      static ConvTunableOp conv{};
+      return conv(&params);
+    }
+    return MlasConvOp(&params);
   } else {
     const int64_t input_image_size = input_shape.Size();
     const int64_t output_image_size = output_shape.Size();
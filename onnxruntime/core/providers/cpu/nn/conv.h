@@ -3,8 +3,12 @@
 
 #pragma once
 
+#include <mutex>
+
+#include "core/framework/kernel_plan_cache.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/nn/conv_attributes.h"
+#include "core/providers/cpu/tunable/cpu_tunable.h"
 #include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
@@ -24,16 +28,44 @@ class Conv : public OpKernel {
 template <>
 class Conv<float> : public OpKernel {
  public:
-  Conv(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
+  Conv(const OpKernelInfo& info)
+      : OpKernel(info), conv_attrs_(info), tuning_ctx_(cpu::tunable::GetCpuTuningContext(info)) {
     activation_.ActivationKind = MlasIdentityActivation;
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
   Status Compute(OpKernelContext* context) const override;
 
  protected:
   MLAS_ACTIVATION activation_;
 
   ConvAttributes conv_attrs_;
+
+ private:
+  // The shape dependent state of Compute, which is cached per input shape signature.
+  struct Plan {
+    TensorShapeVector kernel_shape;
+    ConvAttributes::ConvPadVector pads;
+    TensorShapeVector dilations;
+    TensorShapeVector strides;
+    TensorShapeVector Y_dims;
+    MLAS_CONV_PARAMETERS parameters;
+    size_t working_buffer_size;
+  };
+
+  KernelPlanCache<Plan> plan_cache_;
+  cpu::tunable::CpuTuningContext* tuning_ctx_;
+
+  // The allocator for the filter transformed for the MLAS Winograd algorithm, set if the filter is a constant 3x3
+  // filter with enough channels for the algorithm.
+  AllocatorPtr packed_w_alloc_;
+  // The filter is only transformed once a plan selects the Winograd algorithm, as the transformed filter is four
+  // times the size of the filter, which is still used by the other algorithms.
+  mutable std::once_flag packed_w_once_;
+  mutable IAllocatorUniquePtr<float> packed_w_;
 };
 
 }  // namespace onnxruntime
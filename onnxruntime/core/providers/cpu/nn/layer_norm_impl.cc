@@ -39,6 +39,22 @@ void ComputeJob(
   const T* p_input = X_data + task_idx * norm_size;
   T* p_output = Y_data + task_idx * norm_size;
 
+  if constexpr (std::is_same_v<T, float>) {
+    float mean = 0.0f;
+    float inv_std_dev = 0.0f;
+    MlasLayerNormalization<float>(p_input, nullptr, nullptr, scale_data, bias_data, p_output, nullptr,
+                                  static_cast<size_t>(norm_size), epsilon, simplified, &mean, &inv_std_dev);
+
+    if (mean_data != nullptr) {
+      mean_data[task_idx] = static_cast<U>(mean);
+    }
+
+    if (inv_std_dev_data != nullptr) {
+      inv_std_dev_data[task_idx] = static_cast<U>(inv_std_dev);
+    }
+    return;
+  }
+
   T mean(0.0f);
   T mean_square(0.0f);
 
@@ -92,53 +108,22 @@ void ComputeJob(
     AllocatorPtr alloc) {
   ORT_UNUSED_PARAMETER(scale_data);  // only used in float/double overload
   ORT_UNUSED_PARAMETER(bias_data);   // only used in float/double overload
+  ORT_UNUSED_PARAMETER(alloc);
 
   const MLFloat16* p_input = X_data + task_idx * norm_size;
   MLFloat16* p_output = Y_data + task_idx * norm_size;
 
-  float mean(0.0f);
-  float mean_square(0.0f);
-
-  const size_t num_elems = static_cast<size_t>(norm_size);
-  IAllocatorUniquePtr<float> input_float_uptr = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
-  MlasConvertHalfToFloatBuffer(p_input, input_float_uptr.get(), num_elems);
-
-  IAllocatorUniquePtr<float> output_float_uptr = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
-  float* output_float_ptr = output_float_uptr.get();
-
-  const float* input_float_ptr = input_float_uptr.get();
-  for (size_t h = 0; h < num_elems; h++) {
-    output_float_ptr[h] = input_float_ptr[h];
-    mean += input_float_ptr[h];
-    mean_square += input_float_ptr[h] * input_float_ptr[h];
-  }
-
-  mean = mean / norm_size;
-  if (simplified) {
-    mean_square = sqrt(mean_square / norm_size + epsilon);
-  } else {
-    mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon);
-  }
-
-  for (size_t h = 0; h < num_elems; h++) {
-    if (simplified) {
-      output_float_ptr[h] = output_float_ptr[h] / mean_square * scale_float_ptr[h];
-    } else if (nullptr == bias_float_ptr) {
-      output_float_ptr[h] = (output_float_ptr[h] - mean) / mean_square * scale_float_ptr[h];
-    } else {
-      output_float_ptr[h] = (output_float_ptr[h] - mean) / mean_square * scale_float_ptr[h] + bias_float_ptr[h];
-    }
-  }
-
-  MlasConvertFloatToHalfBuffer(output_float_ptr, p_output, num_elems);
+  float mean = 0.0f;
+  float inv_std_dev = 0.0f;
+  MlasLayerNormalization<MLFloat16>(p_input, nullptr, nullptr, scale_float_ptr, bias_float_ptr, p_output, nullptr,
+                                    static_cast<size_t>(norm_size), epsilon, simplified, &mean, &inv_std_dev);
 
   if (mean_data != nullptr) {
-    // ONNX spec doesn't support 'double' for 'U' so when 'T' == double, 'U' == float and we need to narrow
-    mean_data[task_idx] = MLFloat16(mean);
+    mean_data[task_idx] = static_cast<U>(mean);
   }
 
   if (inv_std_dev_data != nullptr) {
-    inv_std_dev_data[task_idx] = MLFloat16(1 / mean_square);
+    inv_std_dev_data[task_idx] = static_cast<U>(inv_std_dev);
   }
 }
 
@@ -3,6 +3,7 @@
 
 #include "tfidfvectorizer.h"
 #include "core/common/common.h"
+#include "core/common/flat_string_map.h"
 #include "core/common/inlined_containers.h"
 #include <core/common/safeint.h>
 #include "core/framework/tensor.h"
@@ -29,52 +30,27 @@ namespace ngram_details {
 // for a unigram (1) it would insert into a root map with a valid id.
 // for (1,2,3) node 2 would be a child of 1 but have id == 0
 // because (1,2) does not exists. Node 3 would have a valid id.
-template <class T>
+// String pools are interned into token ids first, so the trie is always keyed by integers.
 struct NgramPart;
 
-template <>
-struct NgramPart<int64_t>;
-
-template <>
-struct NgramPart<std::string>;
-
-using NgramPartInt = NgramPart<int64_t>;
-using NgramPartString = NgramPart<std::string>;
-
 // Avoid recursive class definitions using unique_ptr + forward declaration
-using IntMap = InlinedHashMap<int64_t, std::unique_ptr<NgramPartInt>>;
-
-#ifndef DISABLE_ABSEIL
-using StrMap = absl::flat_hash_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                   std::hash<std::string>, std::equal_to<std::string>>;
-#else
-using StrMap = std::unordered_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                  std::hash<std::string>, std::equal_to<std::string>>;
-#endif
-
-template <>
-struct NgramPart<int64_t> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  IntMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
-};
+using IntMap = InlinedHashMap<int64_t, std::unique_ptr<NgramPart>>;
 
-template <>
-struct NgramPart<std::string> {
+struct NgramPart {
   size_t id_;  // 0 - means no entry, search for a bigger N
-  StrMap leafs_;
+  IntMap leafs_;
   explicit NgramPart(size_t id) : id_(id) {}
 };
 
 // Returns next ngram_id
-template <class K, class ForwardIter, class Map>
+template <class ForwardIter>
 inline size_t PopulateGrams(ForwardIter first, size_t ngrams, size_t ngram_size, size_t ngram_id,
-                            Map& c) {
+                            IntMap& c) {
   for (; ngrams > 0; --ngrams) {
     size_t n = 1;
-    Map* m = &c;
+    IntMap* m = &c;
     while (true) {
-      auto p = m->emplace(*first, std::make_unique<NgramPart<K>>(0));
+      auto p = m->emplace(*first, std::make_unique<NgramPart>(0));
       ++first;
       if (n == ngram_size) {
         ORT_ENFORCE(p.first->second->id_ == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
@@ -134,10 +110,10 @@ struct TfIdfVectorizer::Impl {
   gsl::span<const int64_t> ngram_indexes_;
   gsl::span<const float> weights_;
 
-  // This map contains references to pool_string_ entries
-  // of pool_strings attribute
-  StrMap str_map_;
-  // This map contains pool_int64s entries
+  // Maps each distinct entry of the pool_strings attribute to a token id
+  // which is used in place of the string in int64_map_
+  FlatStringMap<int64_t> token_ids_;
+  // This map contains pool_int64s entries or the token ids of pool_strings entries
   IntMap int64_map_;
 
   size_t output_size_ = 0;
@@ -221,6 +197,17 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
     ORT_ENFORCE(status.IsOK() && !pool_int64s.empty(), "non-empty pool_int64s is required if pool_strings not provided");
   }
 
+  // Intern the strings so that the input is hashed once per element rather than once per n-gram probe.
+  InlinedVector<int64_t> pool_tokens;
+  if (!pool_strings.empty()) {
+    pool_tokens.reserve(pool_strings.size());
+    impl_->token_ids_.Reserve(pool_strings.size());
+    for (const std::string& str : pool_strings) {
+      const auto next_token = static_cast<int64_t>(impl_->token_ids_.Size());
+      pool_tokens.push_back(*impl_->token_ids_.TryEmplace(str, next_token).first);
+    }
+  }
+
   // Iterator via the pool. Insert 1 item for 1-grams, 2 items for 2-grams, etc.
   const auto total_items = (pool_strings.empty()) ? pool_int64s.size() : pool_strings.size();
   size_t ngram_id = 1;  // start with 1, 0 - means no n-gram
@@ -241,9 +228,9 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
       // Skip loading into hash_set ngrams that are not in the range of [min_gram_length-max_gram_length]
       if (ngram_size >= min_gram_length && ngram_size <= max_gram_length) {
         if (pool_strings.empty()) {
-          ngram_id = PopulateGrams<int64_t>(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_map_);
+          ngram_id = PopulateGrams(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_map_);
         } else {
-          ngram_id = PopulateGrams<std::string>(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_map_);
+          ngram_id = PopulateGrams(pool_tokens.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_map_);
         }
       } else {
         ngram_id += ngrams;
@@ -256,7 +243,7 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
 TfIdfVectorizer::~TfIdfVectorizer() = default;
 
 void TfIdfVectorizer::ComputeImpl(const void* x_data_raw, size_t elem_size, ptrdiff_t row_num, size_t row_size,
-                                  bool is_input_string, gsl::span<float> output_data,
+                                  gsl::span<float> output_data,
                                   std::function<void(size_t, gsl::span<float>&)>& fn_weight) const {
   const void* const row_begin = AdvanceElementPtr(x_data_raw, row_num * row_size, elem_size);
   const void* const row_end = AdvanceElementPtr(row_begin, row_size, elem_size);
@@ -279,42 +266,22 @@ void TfIdfVectorizer::ComputeImpl(const void* x_data_raw, size_t elem_size, ptrd
       }
 
       auto ngram_item = ngram_start;
-      if (is_input_string) {
-        const std::string* str_item = reinterpret_cast<const std::string*>(ngram_item);
-        const StrMap* str_map = &impl.str_map_;
-        for (auto ngram_size = 1;
-             !str_map->empty() &&
-             ngram_size <= max_gram_length &&
-             str_item < ngram_row_end;
-             ++ngram_size, str_item += skip_distance) {
-          auto hit = str_map->find(*str_item);
-          if (hit == str_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            output_idx = impl.OutputIdToIncrement(hit->second->id_);
-            fn_weight(output_idx, output_data);
-          }
-          str_map = &hit->second->leafs_;
+      const IntMap* int_map = &impl.int64_map_;
+      for (auto ngram_size = 1;
+           !int_map->empty() &&
+           ngram_size <= max_gram_length &&
+           ngram_item < ngram_row_end;
+           ++ngram_size, ngram_item = AdvanceElementPtr(ngram_item, skip_distance, elem_size)) {
+        int64_t val = (elem_size == 4) ? int64_t{*reinterpret_cast<const int32_t*>(ngram_item)} : *reinterpret_cast<const int64_t*>(ngram_item);
+        auto hit = int_map->find(val);
+        if (hit == int_map->end()) {
+          break;
         }
-      } else {
-        const IntMap* int_map = &impl.int64_map_;
-        for (auto ngram_size = 1;
-             !int_map->empty() &&
-             ngram_size <= max_gram_length &&
-             ngram_item < ngram_row_end;
-             ++ngram_size, ngram_item = AdvanceElementPtr(ngram_item, skip_distance, elem_size)) {
-          int64_t val = (elem_size == 4) ? int64_t{*reinterpret_cast<const int32_t*>(ngram_item)} : *reinterpret_cast<const int64_t*>(ngram_item);
-          auto hit = int_map->find(val);
-          if (hit == int_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            output_idx = impl.OutputIdToIncrement(hit->second->id_);
-            fn_weight(output_idx, output_data);
-          }
-          int_map = &hit->second->leafs_;
+        if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
+          output_idx = impl.OutputIdToIncrement(hit->second->id_);
+          fn_weight(output_idx, output_data);
         }
+        int_map = &hit->second->leafs_;
       }
       // Sliding window shift
       ngram_start = AdvanceElementPtr(ngram_start, 1, elem_size);
@@ -371,10 +338,11 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
   auto Y = ctx->Output(0, output_shape);
   auto output_data = Y->MutableData<float>();
   const bool is_input_string = X->IsDataTypeString();
+  const bool is_pool_string = !impl_->token_ids_.Empty();
 
   if (total_items == 0 ||
-      (is_input_string && impl_->str_map_.empty()) ||
-      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_map_.empty())) {
+      is_input_string != is_pool_string ||
+      impl_->int64_map_.empty()) {
     // TfidfVectorizer may receive an empty input when it follows a Tokenizer
     // (for example for a string containing only stopwords).
     // TfidfVectorizer returns a zero tensor of shape
@@ -416,12 +384,25 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
 
   std::function<void(ptrdiff_t)> fn = [this, C, output_data, x_data_raw, elem_size,
                                        is_input_string, num_batches, num_rows, &fn_weight](ptrdiff_t batch_num) {
+    // Strings are replaced by their token ids, -1 for strings outside of the pool, one row at a time.
+    InlinedVector<int64_t> row_tokens;
+    if (is_input_string) {
+      row_tokens.resize(C);
+    }
     // Frequency holder allocate [B..output_size_] and init all to zero.
     auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_batches, static_cast<size_t>(num_rows));
     for (auto row_num = work.start; row_num < work.end; ++row_num) {
       auto out = gsl::span<float>(output_data + row_num * this->impl_->output_size_, this->impl_->output_size_);
       std::fill(out.begin(), out.end(), 0.0f);
-      ComputeImpl(x_data_raw, elem_size, row_num, C, is_input_string, out, fn_weight);
+      if (is_input_string) {
+        const std::string* row = reinterpret_cast<const std::string*>(x_data_raw) + row_num * C;
+        this->impl_->token_ids_.FindEach(gsl::make_span(row, C), [&row_tokens](size_t i, const int64_t* token) {
+          row_tokens[i] = token == nullptr ? -1 : *token;
+        });
+        ComputeImpl(row_tokens.data(), sizeof(int64_t), 0, C, out, fn_weight);
+      } else {
+        ComputeImpl(x_data_raw, elem_size, row_num, C, out, fn_weight);
+      }
     }
   };
 
@@ -803,6 +803,15 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
       fast_shape, output_shape, fast_axes, keepdims_ != 0, noop_with_empty_axes);
 
   if (which_fast_reduce != FastReduceKind::kNone) {
+    if (fast_kind == FastReduceKind::kR && IsFastReduceKindAvailable(FastReduceKind::kKR, which_fast_reduce)) {
+      // Reducing every axis is a KR reduction of a single row,
+      // which the KR implementation splits across the thread pool.
+      Tensor* output = ctx->Output(0, output_shape);
+      TensorShapeVector kr_shape{1, fast_shape[0]};
+      ValidateFastReduceKR(kr_shape, *output);
+      case_kr(*input, kr_shape, *output, ctx->GetOperatorThreadPool());
+      return true;
+    }
     if (IsFastReduceKindAvailable(fast_kind, which_fast_reduce)) {
       Tensor* output = ctx->Output(0, output_shape);
       switch (fast_kind) {
@@ -1076,6 +1085,13 @@ std::unique_ptr<Tensor> ReduceSum<T>::Impl(const Tensor& input, gsl::span<const
     return output;
   }
 
+  if (fast_kind == FastReduceKind::kR) {
+    TensorShapeVector kr_shape{1, fast_shape[0]};
+    ValidateFastReduceKR(kr_shape, *output);
+    ReduceAggregatorSum<T>::FastReduceKR(input, kr_shape, *output, tp);
+    return output;
+  }
+
   if (IsFastReduceKindAvailable(fast_kind, ReduceAggregatorSum<T>::WhichFastReduce())) {
     switch (fast_kind) {
       case FastReduceKind::kKR: {
@@ -17,6 +17,9 @@
 #include "core/providers/cpu/reduction/reduction_kernel_base.h"
 #include "core/common/safeint.h"
 #include <cmath>
+#include <functional>
+#include <memory>
+#include <utility>
 
 namespace onnxruntime {
 
@@ -47,6 +50,10 @@ constexpr TensorOpCost ParallelReduceFastCost(int64_t n_row, int64_t n_col, int6
                       static_cast<double>(n_row * n_col * element_size * n_ops)};
 }
 
+/* Number of elements of a row reduced by one task when the rows of a KR reduction
+   are split into partial reductions, see ReduceAggregator::CommonFastReduceKRSplit. */
+constexpr int64_t kFastReduceSplitBlockSize = 16384;
+
 /**
   This only improves reduce function when reduced axes are contiguous:
   if len(shape) == 4, any single axis is ok, axes=(0, 1) or (1, 2) or (2, 3) is ok,
@@ -183,6 +190,101 @@ class ReduceAggregator : public ReduceAggregatorBase {
   static void fill_for_empty_set(Tensor&) { ORT_NOT_IMPLEMENTED(); }
 
  protected:
+  // A KR reduction with fewer rows than threads (a single row when every axis is reduced)
+  // leaves most of the thread pool idle. Every row is then split into blocks of
+  // kFastReduceSplitBlockSize elements reduced in parallel by f_block, and the partial
+  // results of a row are merged pairwise by f_combine so that the rounding error of a sum
+  // grows with the logarithm of the number of blocks. Returns false if the rows are not split.
+  template <typename TPARTIAL>
+  static bool CommonFastReduceKRSplit(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                      Tensor& output, concurrency::ThreadPool* tp,
+                                      std::function<TPARTIAL(const T*, int64_t)> f_block,
+                                      std::function<TPARTIAL(const TPARTIAL&, const TPARTIAL&)> f_combine,
+                                      std::function<TVAL(const TPARTIAL&)> f_final) {
+    int64_t n_rows = fast_shape[0];
+    int64_t n_cols = fast_shape[1];
+    if (n_rows >= concurrency::ThreadPool::DegreeOfParallelism(tp) || n_cols < 2 * kFastReduceSplitBlockSize) {
+      return false;
+    }
+
+    const T* data = input.Data<T>();
+    TVAL* out = output.MutableData<TVAL>();
+    int64_t n_blocks = (n_cols + kFastReduceSplitBlockSize - 1) / kFastReduceSplitBlockSize;
+    auto partials = std::make_unique<TPARTIAL[]>(SafeInt<size_t>(n_rows) * n_blocks);
+    TPARTIAL* partial_data = partials.get();
+
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<ptrdiff_t>(n_rows * n_blocks),
+        ParallelReduceFastCost(1, kFastReduceSplitBlockSize, sizeof(T), 6),
+        [data, partial_data, n_cols, n_blocks, f_block](ptrdiff_t first, ptrdiff_t last) {
+          for (ptrdiff_t i = first; i < last; ++i) {
+            int64_t row = i / n_blocks;
+            int64_t begin = (i % n_blocks) * kFastReduceSplitBlockSize;
+            partial_data[i] = f_block(data + row * n_cols + begin,
+                                      std::min(kFastReduceSplitBlockSize, n_cols - begin));
+          }
+        });
+
+    for (int64_t row = 0; row < n_rows; ++row) {
+      TPARTIAL* p = partial_data + row * n_blocks;
+      for (int64_t stride = 1; stride < n_blocks; stride *= 2) {
+        for (int64_t i = 0; i + stride < n_blocks; i += 2 * stride) {
+          p[i] = f_combine(p[i], p[i + stride]);
+        }
+      }
+      out[row] = f_final(p[0]);
+    }
+    return true;
+  }
+
+  // KR reduction where f_block reduces a contiguous range into a partial result and
+  // f_final turns it into the output value. f_combine merges two partial results and
+  // may be empty if they cannot be merged exactly, which disables the row split.
+  template <typename TPARTIAL>
+  static void CommonFastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                 Tensor& output, concurrency::ThreadPool* tp,
+                                 std::function<TPARTIAL(const T*, int64_t)> f_block,
+                                 std::function<TPARTIAL(const TPARTIAL&, const TPARTIAL&)> f_combine,
+                                 std::function<TVAL(const TPARTIAL&)> f_final) {
+    if (f_combine && CommonFastReduceKRSplit<TPARTIAL>(input, fast_shape, output, tp, f_block, f_combine, f_final)) {
+      return;
+    }
+
+    const T* data = input.Data<T>();
+    TVAL* out = output.MutableData<TVAL>();
+    int64_t stridei = fast_shape[1];
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(1, stridei, sizeof(T), 6),
+        [data, stridei, out, f_block, f_final](ptrdiff_t first, ptrdiff_t last) {
+          for (ptrdiff_t d = first; d < last; ++d) {
+            out[d] = f_final(f_block(data + d * stridei, stridei));
+          }
+        });
+  }
+
+  // RK reduction processed by ranges of columns: f_init writes the contribution of the first
+  // row into the output, f_update accumulates every other row and f_final finishes the range.
+  static void CommonFastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                 Tensor& output, concurrency::ThreadPool* tp,
+                                 std::function<void(TVAL*, const T*, int64_t)> f_init,
+                                 std::function<void(TVAL*, const T*, int64_t)> f_update,
+                                 std::function<void(TVAL*, int64_t)> f_final) {
+    const T* data = input.Data<T>();
+    TVAL* out = output.MutableData<TVAL>();
+    int64_t n_rows = fast_shape[0];
+    int64_t N = fast_shape[1];
+
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(N), ParallelReduceFastCost(1, n_rows, sizeof(T), 6),
+        [data, out, N, n_rows, f_init, f_update, f_final](ptrdiff_t begin, ptrdiff_t end) {
+          f_init(out + begin, data + begin, end - begin);
+          for (int64_t row = 1; row < n_rows; ++row) {
+            f_update(out + begin, data + row * N + begin, end - begin);
+          }
+          f_final(out + begin, end - begin);
+        });
+  }
+
   static void CommonFastReduceRKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                                   Tensor& output, concurrency::ThreadPool* tp,
                                   std::function<TVAL(const T*)> f_init,
@@ -231,16 +333,11 @@ class ReduceAggregatorSum : public ReduceAggregator<T, T> {
 
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
-    const T* data = input.Data<T>();
-    T* out = output.MutableData<T>();
-    int64_t stridei = fast_shape[1];
-    concurrency::ThreadPool::TryParallelFor(
-        tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(1, stridei, sizeof(T), 6),
-        [data, stridei, out](ptrdiff_t first, ptrdiff_t last) {
-          for (ptrdiff_t d = first; d < last; ++d) {
-            out[d] = aggall(data + d * stridei, stridei);
-          }
-        });
+    ReduceAggregator<T, T>::template CommonFastReduceKR<T>(
+        input, fast_shape, output, tp,
+        [](const T* p, int64_t size) -> T { return aggall(p, size); },
+        [](const T& a, const T& b) -> T { return a + b; },
+        [](const T& v) -> T { return v; });
   }
 
   static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -293,13 +390,43 @@ template <typename T, typename TVAL = T>
 class ReduceAggregatorSumSquare : public ReduceAggregator<T, TVAL> {
  public:
   inline ReduceAggregatorSumSquare(int64_t N, const T&) : ReduceAggregator<T, TVAL>(N, 0) {}
+  static TVAL aggall(const T* from_data, int64_t size) {
+    return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(from_data, onnxruntime::narrow<size_t>(size)).squaredNorm();
+  }
   inline TVAL aggall(const T* from_data) {
-    return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(from_data, onnxruntime::narrow<size_t>(this->N_)).squaredNorm();
+    return aggall(from_data, this->N_);
   }
   inline void update(const T& v) { this->accumulator_ += v * v; }
   static void fill_for_empty_set(Tensor& output) {
     EigenMap<T>(output).array() = static_cast<T>(0);
   }
+
+  // Fast reduction
+  static inline FastReduceKind WhichFastReduce() {
+    return FastReduceKind::kKR | FastReduceKind::kRK;
+  }
+
+  static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregator<T, TVAL>::template CommonFastReduceKR<TVAL>(
+        input, fast_shape, output, tp,
+        [](const T* p, int64_t size) -> TVAL { return aggall(p, size); },
+        [](const TVAL& a, const TVAL& b) -> TVAL { return a + b; },
+        [](const TVAL& v) -> TVAL { return v; });
+  }
+
+  static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregator<T, TVAL>::CommonFastReduceRK(
+        input, fast_shape, output, tp,
+        [](TVAL* out, const T* p, int64_t size) {
+          EigenVectorArrayMap<TVAL>(out, size) = ConstEigenVectorArrayMap<T>(p, size).square();
+        },
+        [](TVAL* out, const T* p, int64_t size) {
+          EigenVectorArrayMap<TVAL>(out, size) += ConstEigenVectorArrayMap<T>(p, size).square();
+        },
+        [](TVAL*, int64_t) {});
+  }
 };
 
 template <typename T>
@@ -399,6 +526,20 @@ class ReduceAggregatorMax : public ReduceAggregator<T> {
 
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
+    if (ReduceAggregator<T, T>::template CommonFastReduceKRSplit<T>(
+            input, fast_shape, output, tp,
+            [](const T* p, int64_t size) -> T { return aggall(p, size); },
+            [](const T& a, const T& b) -> T {
+              if constexpr (std::is_same_v<bool, T>) { /* bool specific impl */
+                return a || b;
+              } else {
+                return b > a ? b : a;
+              }
+            },
+            [](const T& v) -> T { return v; })) {
+      return;
+    }
+
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
     int64_t stridei = fast_shape[1];
@@ -609,6 +750,20 @@ class ReduceAggregatorMin : public ReduceAggregator<T, T> {
 
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
+    if (ReduceAggregator<T, T>::template CommonFastReduceKRSplit<T>(
+            input, fast_shape, output, tp,
+            [](const T* p, int64_t size) -> T { return aggall(p, size); },
+            [](const T& a, const T& b) -> T {
+              if constexpr (std::is_same_v<bool, T>) { /* bool specific impl */
+                return a && b;
+              } else {
+                return b < a ? b : a;
+              }
+            },
+            [](const T& v) -> T { return v; })) {
+      return;
+    }
+
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
     int64_t stridei = fast_shape[1];
@@ -720,14 +875,44 @@ template <typename T>
 class ReduceAggregatorL1 : public ReduceAggregator<T, T> {
  public:
   inline ReduceAggregatorL1(int64_t N, const T&) : ReduceAggregator<T, T>(N, 0) {}
+  static T aggall(const T* from_data, int64_t size) {
+    return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(from_data, onnxruntime::narrow<size_t>(size)).cwiseAbs().sum();
+  }
   inline T aggall(const T* from_data) {
-    return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(from_data, onnxruntime::narrow<size_t>(this->N_)).cwiseAbs().sum();
+    return aggall(from_data, this->N_);
   }
   inline void update(const T& v) { this->accumulator_ += v > 0 ? v : -v; }
 
   static void fill_for_empty_set(Tensor& output) {
     EigenMap<T>(output).array() = static_cast<T>(0);
   }
+
+  // Fast reduction
+  static inline FastReduceKind WhichFastReduce() {
+    return FastReduceKind::kKR | FastReduceKind::kRK;
+  }
+
+  static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregator<T, T>::template CommonFastReduceKR<T>(
+        input, fast_shape, output, tp,
+        [](const T* p, int64_t size) -> T { return aggall(p, size); },
+        [](const T& a, const T& b) -> T { return a + b; },
+        [](const T& v) -> T { return v; });
+  }
+
+  static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregator<T, T>::CommonFastReduceRK(
+        input, fast_shape, output, tp,
+        [](T* out, const T* p, int64_t size) {
+          EigenVectorArrayMap<T>(out, size) = ConstEigenVectorArrayMap<T>(p, size).abs();
+        },
+        [](T* out, const T* p, int64_t size) {
+          EigenVectorArrayMap<T>(out, size) += ConstEigenVectorArrayMap<T>(p, size).abs();
+        },
+        [](T*, int64_t) {});
+  }
 };
 
 template <typename T>
@@ -742,6 +927,39 @@ class ReduceAggregatorL2 : public ReduceAggregator<T, T> {
   static void fill_for_empty_set(Tensor& output) {
     EigenMap<T>(output).array() = static_cast<T>(0);
   }
+
+  // Fast reduction
+  static inline FastReduceKind WhichFastReduce() {
+    return FastReduceKind::kKR | FastReduceKind::kRK;
+  }
+
+  static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregator<T, T>::template CommonFastReduceKR<T>(
+        input, fast_shape, output, tp,
+        [](const T* p, int64_t size) -> T {
+          return ReduceAggregatorSumSquare<T, T>::aggall(p, size);
+        },
+        [](const T& a, const T& b) -> T { return a + b; },
+        [](const T& v) -> T { return reduce_sqrt<T>(v); });
+  }
+
+  static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregator<T, T>::CommonFastReduceRK(
+        input, fast_shape, output, tp,
+        [](T* out, const T* p, int64_t size) {
+          EigenVectorArrayMap<T>(out, size) = ConstEigenVectorArrayMap<T>(p, size).square();
+        },
+        [](T* out, const T* p, int64_t size) {
+          EigenVectorArrayMap<T>(out, size) += ConstEigenVectorArrayMap<T>(p, size).square();
+        },
+        [](T* out, int64_t size) {
+          for (int64_t i = 0; i < size; ++i) {
+            out[i] = reduce_sqrt<T>(out[i]);
+          }
+        });
+  }
 };
 
 template <typename T>
@@ -756,6 +974,37 @@ class ReduceAggregatorLogSum : public ReduceAggregator<T, T> {
   static void fill_for_empty_set(Tensor& output) {
     EigenMap<T>(output).array() = -std::numeric_limits<T>::infinity();
   }
+
+  // Fast reduction
+  static inline FastReduceKind WhichFastReduce() {
+    return FastReduceKind::kKR | FastReduceKind::kRK;
+  }
+
+  static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregator<T, T>::template CommonFastReduceKR<T>(
+        input, fast_shape, output, tp,
+        [](const T* p, int64_t size) -> T { return ReduceAggregatorSum<T>::aggall(p, size); },
+        [](const T& a, const T& b) -> T { return a + b; },
+        [](const T& v) -> T { return reduce_log<T>(v); });
+  }
+
+  static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregator<T, T>::CommonFastReduceRK(
+        input, fast_shape, output, tp,
+        [](T* out, const T* p, int64_t size) {
+          EigenVectorArrayMap<T>(out, size) = ConstEigenVectorArrayMap<T>(p, size);
+        },
+        [](T* out, const T* p, int64_t size) {
+          EigenVectorArrayMap<T>(out, size) += ConstEigenVectorArrayMap<T>(p, size);
+        },
+        [](T* out, int64_t size) {
+          for (int64_t i = 0; i < size; ++i) {
+            out[i] = reduce_log<T>(out[i]);
+          }
+        });
+  }
 };
 
 template <typename T>
@@ -767,12 +1016,24 @@ class ReduceAggregatorLogSumExp : public ReduceAggregator<T, T> {
   inline ReduceAggregatorLogSumExp(int64_t N, const T& init) : ReduceAggregator<T, T>(N, 0) {
     max_ = reduce_isinf(init) ? this->accumulator_ : init;
   }
-  inline T aggall(const T* from_data) {
-    max_ = Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(from_data, onnxruntime::narrow<size_t>(this->N_)).maxCoeff();
-    for (int64_t i = 0; i < this->N_; ++i) {
-      update(from_data[i]);
+  // Returns the shift (the largest finite value) and the sum of exp(v - shift) over a range,
+  // the same two loops NoTransposeReduce2Loops runs with update0 and update.
+  static std::pair<T, T> aggpartial(const T* from_data, int64_t size) {
+    ReduceAggregatorLogSumExp<T> agg(size, from_data[0]);
+    for (int64_t i = 0; i < size; ++i) {
+      agg.update0(from_data[i]);
+    }
+    for (int64_t i = 0; i < size; ++i) {
+      agg.update(from_data[i]);
     }
-    return get_value();
+    return std::make_pair(agg.max_, agg.accumulator_);
+  }
+  static T aggall(const T* from_data, int64_t size) {
+    std::pair<T, T> partial = aggpartial(from_data, size);
+    return reduce_log<T>(partial.second) + partial.first;
+  }
+  inline T aggall(const T* from_data) {
+    return aggall(from_data, this->N_);
   }
   inline void update0(const T& v) {
     max_ = (reduce_isinf(v) || reduce_isnan(v) || v < max_) ? max_ : v;
@@ -782,6 +1043,64 @@ class ReduceAggregatorLogSumExp : public ReduceAggregator<T, T> {
   static void fill_for_empty_set(Tensor& output) {
     EigenMap<T>(output).array() = -std::numeric_limits<T>::infinity();
   }
+
+  // Fast reduction
+  static inline FastReduceKind WhichFastReduce() {
+    return FastReduceKind::kKR | FastReduceKind::kRK;
+  }
+
+  static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    std::function<std::pair<T, T>(const std::pair<T, T>&, const std::pair<T, T>&)> combine;
+    if constexpr (std::is_floating_point_v<T>) {
+      // Partial sums are rescaled to the larger shift before they are added. Integer
+      // exponentials are truncated, so integer rows are not split.
+      combine = [](const std::pair<T, T>& a, const std::pair<T, T>& b) -> std::pair<T, T> {
+        T shift = a.first > b.first ? a.first : b.first;
+        return std::make_pair(shift, a.second * reduce_exp(a.first - shift) + b.second * reduce_exp(b.first - shift));
+      };
+    }
+    ReduceAggregator<T, T>::template CommonFastReduceKR<std::pair<T, T>>(
+        input, fast_shape, output, tp,
+        [](const T* p, int64_t size) -> std::pair<T, T> { return aggpartial(p, size); },
+        combine,
+        [](const std::pair<T, T>& v) -> T { return reduce_log<T>(v.second) + v.first; });
+  }
+
+  static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    const T* data = input.Data<T>();
+    T* out = output.MutableData<T>();
+    int64_t n_rows = fast_shape[0];
+    int64_t N = fast_shape[1];
+
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(N), ParallelReduceFastCost(1, n_rows, sizeof(T), 8),
+        [data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
+          // The output holds the shift of every column while the sums are accumulated.
+          std::vector<T> sums(onnxruntime::narrow<size_t>(end - begin), 0);
+          const T* p;
+          for (int64_t j = begin; j < end; ++j) {
+            out[j] = reduce_isinf(data[j]) ? static_cast<T>(0) : data[j];
+          }
+          for (int64_t row = 0; row < n_rows; ++row) {
+            p = data + row * N;
+            for (int64_t j = begin; j < end; ++j) {
+              if (!reduce_isinf(p[j]) && !reduce_isnan(p[j]) && !(p[j] < out[j]))
+                out[j] = p[j];
+            }
+          }
+          for (int64_t row = 0; row < n_rows; ++row) {
+            p = data + row * N;
+            for (int64_t j = begin; j < end; ++j) {
+              sums[j - begin] += reduce_exp(p[j] - out[j]);
+            }
+          }
+          for (int64_t j = begin; j < end; ++j) {
+            out[j] = reduce_log<T>(sums[j - begin]) + out[j];
+          }
+        });
+  }
 };
 
 void NoTransposePrepareForReduce(const TensorShape& new_input_shape,
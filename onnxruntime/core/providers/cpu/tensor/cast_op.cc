@@ -15,6 +15,7 @@
 #include "core/framework/data_types.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/util/math_cpuonly.h"
@@ -177,19 +178,48 @@ template <>
 struct EigenCastType<BFloat16> {
   using type = Eigen::bfloat16;
 };
+// Estimated cost of casting one element, in the units of TensorOpCost::compute_cycles. Float 8 conversions are done
+// one element at a time with bit manipulations.
+template <typename SrcType, typename DstType>
+constexpr double CastCostPerElement() {
+#if !defined(DISABLE_FLOAT8_TYPES)
+  return IsOrtFloat8Type<SrcType>::value || IsOrtFloat8Type<DstType>::value ? 16.0 : 1.0;
+#else
+  return 1.0;
+#endif
+}
+
+// Casts the elements of a tensor in blocks, which are distributed over the thread pool if the tensor is large.
+// `cast_block` is called with the input, output and number of elements of a block.
+template <typename SrcType, typename DstType, typename CastBlock>
+void ParallelCast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out,
+                  CastBlock&& cast_block) {
+  const std::ptrdiff_t shape_size = narrow<std::ptrdiff_t>(shape.Size());
+  const auto* in_data = in.Data<SrcType>();
+  auto* out_data = out.MutableData<DstType>();
+  concurrency::ThreadPool::TryParallelFor(
+      context.GetOperatorThreadPool(), shape_size,
+      TensorOpCost{static_cast<double>(sizeof(SrcType)), static_cast<double>(sizeof(DstType)),
+                   CastCostPerElement<SrcType, DstType>()},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        cast_block(in_data + first, out_data + first, last - first);
+      });
+}
+
 // generic tensor X -> Y
 template <typename SrcType, typename DstType, typename Enable = void>
 struct TensorCaster {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
     using SrcEigenCastType = typename EigenCastType<SrcType>::type;
     using DstEigenCastType = typename EigenCastType<DstType>::type;
 
-    const std::ptrdiff_t shape_size = narrow<std::ptrdiff_t>(shape.Size());
-    const auto in_vector =
-        ConstEigenVectorMap<SrcEigenCastType>(reinterpret_cast<const SrcEigenCastType*>(in.Data<SrcType>()), shape_size);
-    auto out_vector =
-        EigenVectorMap<DstEigenCastType>(reinterpret_cast<DstEigenCastType*>(out.MutableData<DstType>()), shape_size);
-    out_vector = in_vector.template cast<DstEigenCastType>();
+    ParallelCast<SrcType, DstType>(
+        context, shape, in, out, [](const SrcType* in_data, DstType* out_data, std::ptrdiff_t count) {
+          const auto in_vector =
+              ConstEigenVectorMap<SrcEigenCastType>(reinterpret_cast<const SrcEigenCastType*>(in_data), count);
+          auto out_vector = EigenVectorMap<DstEigenCastType>(reinterpret_cast<DstEigenCastType*>(out_data), count);
+          out_vector = in_vector.template cast<DstEigenCastType>();
+        });
   }
 };
 
@@ -224,13 +254,13 @@ struct TensorCaster<std::string, DstType> {
 // tensor X -> float 8
 template <typename SrcType, typename DstType, typename Enable = void>
 struct TensorCasterNoSat {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
-    const std::ptrdiff_t shape_size = narrow<std::ptrdiff_t>(shape.Size());
-    const auto* in_data = in.Data<SrcType>();
-    auto* out_data = out.MutableData<DstType>();
-    for (std::ptrdiff_t i = 0; i < shape_size; ++i) {
-      out_data[i] = DstType(static_cast<float>(in_data[i]), false);
-    }
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    ParallelCast<SrcType, DstType>(
+        context, shape, in, out, [](const SrcType* in_data, DstType* out_data, std::ptrdiff_t count) {
+          for (std::ptrdiff_t i = 0; i < count; ++i) {
+            out_data[i] = DstType(static_cast<float>(in_data[i]), false);
+          }
+        });
   }
 };
 
@@ -254,11 +284,45 @@ struct TensorCasterNoSat<std::string, DstType> {
 // tensor MLFloat16 -> float
 template <>
 struct TensorCaster<MLFloat16, float> {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
-    auto out_data = out.MutableData<float>();
-    auto in_data = in.Data<MLFloat16>();
-    const size_t shape_size = narrow<size_t>(shape.Size());
-    MlasConvertHalfToFloatBuffer(in_data, out_data, shape_size);
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    ParallelCast<MLFloat16, float>(
+        context, shape, in, out, [](const MLFloat16* in_data, float* out_data, std::ptrdiff_t count) {
+          MlasConvertHalfToFloatBuffer(in_data, out_data, narrow<size_t>(count));
+        });
+  }
+};
+
+// tensor float -> MLFloat16
+template <>
+struct TensorCaster<float, MLFloat16> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    ParallelCast<float, MLFloat16>(
+        context, shape, in, out, [](const float* in_data, MLFloat16* out_data, std::ptrdiff_t count) {
+          MlasConvertFloatToHalfBuffer(in_data, out_data, narrow<size_t>(count));
+        });
+  }
+};
+
+// tensor BFloat16 -> float
+template <>
+struct TensorCaster<BFloat16, float> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    ParallelCast<BFloat16, float>(
+        context, shape, in, out, [](const BFloat16* in_data, float* out_data, std::ptrdiff_t count) {
+          MlasConvertBFloat16ToFloatBuffer(reinterpret_cast<const uint16_t*>(in_data), out_data,
+                                           narrow<size_t>(count));
+        });
+  }
+};
+
+// tensor float -> BFloat16
+template <>
+struct TensorCaster<float, BFloat16> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    ParallelCast<float, BFloat16>(
+        context, shape, in, out, [](const float* in_data, BFloat16* out_data, std::ptrdiff_t count) {
+          MlasConvertFloatToBFloat16Buffer(in_data, reinterpret_cast<uint16_t*>(out_data), narrow<size_t>(count));
+        });
   }
 };
 
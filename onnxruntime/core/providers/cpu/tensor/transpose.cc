@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/tensor/transpose.h"
 
+#include <algorithm>
 #include <memory>
 #include "core/framework/element_type_lists.h"
 #include "core/framework/utils.h"
@@ -348,6 +349,166 @@ bool IsTransposeReshape(const gsl::span<const size_t>& perm, gsl::span<const int
   return true;
 }
 
+// Removes the axes of size 1 and merges the input axes that stay adjacent and in order in the output, e.g.
+// shape {2, 3, 4, 5} with perm {0, 2, 3, 1} becomes shape {2, 3, 20} with perm {0, 2, 1}.
+static void MergeTransposeAxes(gsl::span<const size_t> permutations, gsl::span<const int64_t> input_dims,
+                               InlinedVector<size_t>& merged_dims, InlinedVector<size_t>& merged_perm) {
+  // The input axes of size > 1 in output order, renumbered so that they are consecutive.
+  InlinedVector<size_t> input_axis_index(input_dims.size());
+  size_t num_axes = 0;
+  for (size_t i = 0; i < input_dims.size(); ++i) {
+    input_axis_index[i] = num_axes;
+    if (input_dims[i] != 1) ++num_axes;
+  }
+
+  // Groups of merged axes in output order, as their first input axis and their size.
+  InlinedVector<size_t> group_first_axis;
+  InlinedVector<size_t> group_dims;
+  size_t previous_axis = 0;
+  for (size_t axis : permutations) {
+    if (input_dims[axis] == 1) continue;
+    const size_t index = input_axis_index[axis];
+    const size_t dim = narrow<size_t>(input_dims[axis]);
+    if (!group_first_axis.empty() && index == previous_axis + 1) {
+      group_dims.back() *= dim;
+    } else {
+      group_first_axis.push_back(index);
+      group_dims.push_back(dim);
+    }
+    previous_axis = index;
+  }
+
+  // The merged input axes are the groups ordered by their first input axis.
+  const size_t num_groups = group_first_axis.size();
+  merged_dims.assign(num_groups, 0);
+  merged_perm.assign(num_groups, 0);
+  for (size_t i = 0; i < num_groups; ++i) {
+    size_t merged_axis = 0;
+    for (size_t j = 0; j < num_groups; ++j) {
+      if (group_first_axis[j] < group_first_axis[i]) ++merged_axis;
+    }
+    merged_perm[i] = merged_axis;
+    merged_dims[merged_axis] = group_dims[i];
+  }
+}
+
+template <typename T>
+static void TransposeTile(const uint8_t* input, uint8_t* output, size_t m, size_t n, size_t input_stride,
+                          size_t output_stride) {
+  MlasTranspose(reinterpret_cast<const T*>(input), reinterpret_cast<T*>(output), m, n, input_stride, output_stride);
+}
+
+// Transposes the input as a batch of 2D transposes of its innermost axis with the input axis that becomes the
+// innermost axis of the output. The 2D transposes are split into tiles that fit in the L1 cache, which are
+// transposed with the SIMD kernels of MLAS, and the tiles are distributed over the thread pool.
+// Returns false if the elements, or the blocks of elements that are not moved, are not 1, 2, 4 or 8 bytes.
+static bool TryTileTranspose(const gsl::span<const size_t>& permutations, const Tensor& input, Tensor& output,
+                             const TensorShape& input_shape, concurrency::ThreadPool* tp) {
+  if (input.IsDataTypeString()) {
+    return false;
+  }
+
+  InlinedVector<size_t> dims;
+  InlinedVector<size_t> perm;
+  MergeTransposeAxes(permutations, input_shape.GetDims(), dims, perm);
+  if (perm.size() < 2) {
+    return false;
+  }
+
+  // If the innermost axis is not moved, it is copied as a single element.
+  size_t element_size = input.DataType()->Size();
+  if (perm.back() == perm.size() - 1) {
+    element_size *= dims.back();
+    dims.pop_back();
+    perm.pop_back();
+  }
+  if (element_size != 1 && element_size != 2 && element_size != 4 && element_size != 8) {
+    return false;
+  }
+
+  const size_t rank = perm.size();
+  InlinedVector<size_t> input_strides(rank);
+  InlinedVector<size_t> output_strides(rank);  // the output strides of the input axes
+  size_t input_stride = 1;
+  size_t output_stride = 1;
+  for (size_t i = rank; i-- > 0;) {
+    input_strides[i] = input_stride;
+    input_stride *= dims[i];
+    output_strides[perm[i]] = output_stride;
+    output_stride *= dims[perm[i]];
+  }
+
+  // The tile is M rows of the input axis that becomes the innermost output axis by N columns of the innermost input
+  // axis. The other axes are looped over.
+  const size_t row_axis = perm.back();
+  const size_t M = dims[row_axis];
+  const size_t N = dims[rank - 1];
+  InlinedVector<size_t> outer_dims;
+  InlinedVector<size_t> outer_input_strides;
+  InlinedVector<size_t> outer_output_strides;
+  size_t num_outer = 1;
+  for (size_t i = 0; i + 1 < rank; ++i) {
+    if (i != row_axis) {
+      outer_dims.push_back(dims[i]);
+      outer_input_strides.push_back(input_strides[i]);
+      outer_output_strides.push_back(output_strides[i]);
+      num_outer *= dims[i];
+    }
+  }
+
+  const size_t tile_size = element_size == 1 ? 128 : (element_size == 8 ? 32 : 64);
+  const size_t num_m_tiles = (M + tile_size - 1) / tile_size;
+  const size_t num_n_tiles = (N + tile_size - 1) / tile_size;
+  const size_t num_tiles = num_outer * num_m_tiles * num_n_tiles;
+
+  void (*transpose_tile)(const uint8_t*, uint8_t*, size_t, size_t, size_t, size_t);
+  switch (element_size) {
+    case sizeof(uint8_t):
+      transpose_tile = TransposeTile<uint8_t>;
+      break;
+    case sizeof(uint16_t):
+      transpose_tile = TransposeTile<uint16_t>;
+      break;
+    case sizeof(uint32_t):
+      transpose_tile = TransposeTile<uint32_t>;
+      break;
+    default:
+      transpose_tile = TransposeTile<uint64_t>;
+      break;
+  }
+
+  const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
+  auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
+  const double tile_bytes = static_cast<double>(std::min(M, tile_size) * std::min(N, tile_size) * element_size);
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, narrow<std::ptrdiff_t>(num_tiles), TensorOpCost{tile_bytes, tile_bytes, tile_bytes / element_size},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (auto tile = narrow<size_t>(first); tile < narrow<size_t>(last); ++tile) {
+          const size_t n_tile = tile % num_n_tiles;
+          const size_t m_tile = tile / num_n_tiles % num_m_tiles;
+          size_t outer = tile / num_n_tiles / num_m_tiles;
+
+          const size_t m_start = m_tile * tile_size;
+          const size_t n_start = n_tile * tile_size;
+          size_t input_offset = m_start * input_strides[row_axis] + n_start;
+          size_t output_offset = n_start * output_strides[rank - 1] + m_start;
+          for (size_t i = outer_dims.size(); i-- > 0;) {
+            const size_t index = outer % outer_dims[i];
+            outer /= outer_dims[i];
+            input_offset += index * outer_input_strides[i];
+            output_offset += index * outer_output_strides[i];
+          }
+
+          transpose_tile(input_data + input_offset * element_size, output_data + output_offset * element_size,
+                         std::min(tile_size, M - m_start), std::min(tile_size, N - n_start),
+                         input_strides[row_axis], output_strides[rank - 1]);
+        }
+      });
+
+  return true;
+}
+
 static Status TransposeImpl(const gsl::span<const size_t>& permutations, const Tensor& input, Tensor& output,
                             const TensorShape* input_shape_override, concurrency::ThreadPool* tp) {
   TensorShape shape = input_shape_override ? *input_shape_override : input.Shape();
@@ -359,6 +520,10 @@ static Status TransposeImpl(const gsl::span<const size_t>& permutations, const T
     return Status::OK();
   }
 
+  if (TryTileTranspose(permutations, input, output, shape, tp)) {
+    return Status::OK();
+  }
+
   size_t from = 0, to = 0;
   bool moving_single_axis = IsTransposeMovingSingleAxis(permutations, from, to);
 
@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/tunable/cpu_tuning_context.h"
+
+#include <limits>
+#include <sstream>
+
+#include "core/common/cpuid_info.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/tuning_context.h"
+#define TUNING_CONTEXT_IMPL
+#include "core/framework/tuning_context_impl.h"
+#undef TUNING_CONTEXT_IMPL
+
+namespace onnxruntime {
+namespace cpu {
+namespace tunable {
+
+std::string CpuTuningResultsValidator::GetCpuModel() const {
+  const auto& cpuid_info = CPUIDInfo::GetCPUIDInfo();
+  std::ostringstream oss;
+  oss << (cpuid_info.GetModelName().empty() ? "unknown" : cpuid_info.GetModelName());
+#if defined(CPUIDINFO_ARCH_X86)
+  oss << "|AVX=" << cpuid_info.HasAVX() << "|AVX2=" << cpuid_info.HasAVX2()
+      << "|AVX512F=" << cpuid_info.HasAVX512f() << "|AVX512_BF16=" << cpuid_info.HasAVX512_BF16()
+      << "|AMX_BF16=" << cpuid_info.HasAMX_BF16();
+#elif defined(CPUIDINFO_ARCH_ARM)
+  oss << "|NEON_DOT=" << cpuid_info.HasArmNeonDot()
+      << "|NEON_I8MM=" << cpuid_info.HasArmNeon_I8MM() << "|NEON_BF16=" << cpuid_info.HasArmNeon_BF16();
+#endif
+  return oss.str();
+}
+
+Status CpuTuningResultsValidator::ValidateCpuModel(const std::string& value) const {
+  auto current = GetCpuModel();
+  ORT_RETURN_IF(current != value, "CPU model mismatch: tuning results produced with CPU ", value,
+                ", onnxruntime currently run with CPU ", current);
+  return Status::OK();
+}
+
+CpuTuningResultsValidator::CpuTuningResultsValidator() {
+  RegisterValidator(
+      "CPU_MODEL",
+      [this]() { return GetCpuModel(); },
+      [this](const std::string& value) { return ValidateCpuModel(value); });
+}
+
+CpuTuningContext::CpuTuningContext(IExecutionProvider* ep) : ITuningContext(ep) {}
+
+void CpuTuningContext::EnableTunableOp() {
+  LOGS_DEFAULT(INFO) << "Enable TunableOp for CPU Execution Provider";
+  enable_ = true;
+}
+
+void CpuTuningContext::DisableTunableOp() {
+  LOGS_DEFAULT(INFO) << "Disable TunableOp for CPU Execution Provider";
+  enable_ = false;
+}
+
+bool CpuTuningContext::IsTunableOpEnabled() const {
+  return enable_;
+}
+
+void CpuTuningContext::EnableTuning() {
+  LOGS_DEFAULT(INFO) << "Enable TunableOp tuning for CPU Execution Provider";
+  tuning_enable_ = true;
+}
+
+void CpuTuningContext::DisableTuning() {
+  LOGS_DEFAULT(INFO) << "Disable TunableOp tuning for CPU Execution Provider";
+  tuning_enable_ = false;
+}
+
+bool CpuTuningContext::IsTuningEnabled() const {
+  return tuning_enable_;
+}
+
+void CpuTuningContext::SetMaxTuningDurationMs(int max_duration_ms) {
+  max_tuning_duration_ms_ = max_duration_ms;
+}
+
+int CpuTuningContext::GetMaxTuningDurationMs() const {
+  const int max_duration_ms = max_tuning_duration_ms_;
+  return max_duration_ms > 0 ? max_duration_ms : std::numeric_limits<int>::max();
+}
+
+TuningResultsManager& CpuTuningContext::GetTuningResultsManager() {
+  return manager_;
+}
+
+const TuningResultsManager& CpuTuningContext::GetTuningResultsManager() const {
+  return manager_;
+}
+
+const TuningResultsValidator& CpuTuningContext::GetTuningResultsValidator() const {
+  return validator_;
+}
+
+}  // namespace tunable
+}  // namespace cpu
+}  // namespace onnxruntime
@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/tunable/math/gemm.h"
+
+#include <algorithm>
+
+namespace onnxruntime {
+namespace cpu {
+namespace tunable {
+
+SgemmBatchParams::SgemmBatchParams(CpuTuningContext* tuning_ctx, CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+                                   size_t m, size_t n, size_t k, const MLAS_SGEMM_DATA_PARAMS* data,
+                                   size_t batch_size, concurrency::ThreadPool* thread_pool)
+    : OpParams(tuning_ctx, nullptr),
+      trans_a(trans_a),
+      trans_b(trans_b),
+      m(m),
+      n(n),
+      k(k),
+      data(data),
+      batch_size(batch_size),
+      thread_pool(thread_pool) {}
+
+std::string SgemmBatchParams::Signature() const {
+  const bool b_is_packed = batch_size > 0 && data[0].BIsPacked;
+  return MakeString((trans_a == CblasTrans ? "T" : "N"), (trans_b == CblasTrans ? "T" : "N"), (b_is_packed ? "P" : ""),
+                    "_", m, "_", n, "_", k, "_", batch_size,
+                    "_", concurrency::ThreadPool::DegreeOfParallelism(thread_pool));
+}
+
+namespace {
+
+// MLAS splits each SGEMM along M or N based on its own estimate of the work per thread.
+Status MlasSgemmBatchOp(const SgemmBatchParams* params) {
+  MlasGemmBatch(params->trans_a, params->trans_b, params->m, params->n, params->k, params->data, params->batch_size,
+                params->thread_pool);
+  return Status::OK();
+}
+
+// Runs on the calling thread only, which avoids the cost of waking up the thread pool for small problems.
+Status SingleThreadedSgemmBatchOp(const SgemmBatchParams* params) {
+  TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(concurrency::ThreadPool::DegreeOfParallelism(params->thread_pool) <= 1,
+                                            "the thread pool has a single thread");
+  MlasGemmBatch(params->trans_a, params->trans_b, params->m, params->n, params->k, params->data, params->batch_size,
+                nullptr);
+  return Status::OK();
+}
+
+// Splits the rows of each SGEMM into one band per thread, so that each thread reads all of B but only its own part
+// of A and C. This suits tall and skinny problems for which MLAS would rather split along N.
+Status RowPartitionedSgemmBatchOp(const SgemmBatchParams* params) {
+  // A band should have enough rows to fill the register tiles of the SGEMM kernels.
+  constexpr size_t kMinRowsPerBand = 16;
+
+  const auto num_threads = static_cast<size_t>(concurrency::ThreadPool::DegreeOfParallelism(params->thread_pool));
+  TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(num_threads <= 1, "the thread pool has a single thread");
+  TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(params->m < 2 * kMinRowsPerBand, "too few rows to split, m=", params->m);
+
+  const size_t max_bands = params->m / kMinRowsPerBand;
+  const size_t bands = std::min(max_bands, (num_threads + params->batch_size - 1) / params->batch_size);
+  TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(bands <= 1, "each SGEMM of the batch already has a thread");
+  const size_t rows_per_band = (params->m + bands - 1) / bands;
+  const size_t num_bands = (params->m + rows_per_band - 1) / rows_per_band;
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      params->thread_pool, static_cast<std::ptrdiff_t>(params->batch_size * num_bands),
+      [params, rows_per_band, num_bands](std::ptrdiff_t task) {
+        const size_t batch = static_cast<size_t>(task) / num_bands;
+        const size_t row = static_cast<size_t>(task) % num_bands * rows_per_band;
+
+        MLAS_SGEMM_DATA_PARAMS data = params->data[batch];
+        data.A += params->trans_a == CblasTrans ? row : row * data.lda;
+        data.C += row * data.ldc;
+        MlasGemm(params->trans_a, params->trans_b, std::min(rows_per_band, params->m - row), params->n, params->k,
+                 data, nullptr);
+      });
+  return Status::OK();
+}
+
+class SgemmBatchTunableOp : public TunableOp<SgemmBatchParams> {
+ public:
+  SgemmBatchTunableOp() {
+    this->RegisterOp(MlasSgemmBatchOp);
+    this->RegisterOp(SingleThreadedSgemmBatchOp);
+    this->RegisterOp(RowPartitionedSgemmBatchOp);
+  }
+};
+
+}  // namespace
+
+Status TunableSgemmBatch(CpuTuningContext* tuning_ctx, CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+                         size_t m, size_t n, size_t k, const MLAS_SGEMM_DATA_PARAMS* data, size_t batch_size,
+                         concurrency::ThreadPool* thread_pool) {
+  SgemmBatchParams params(tuning_ctx, trans_a, trans_b, m, n, k, data, batch_size, thread_pool);
+  // Tuning runs the candidates repeatedly on the same output, so it is only done if they overwrite it.
+  const bool overwrites_c = std::all_of(data, data + batch_size,
+                                        [](const MLAS_SGEMM_DATA_PARAMS& gemm) { return gemm.beta == 0.0f; });
+  if (tuning_ctx != nullptr && tuning_ctx->IsTunableOpEnabled() && overwrites_c) {
+    static SgemmBatchTunableOp sgemm_batch{};
+    return sgemm_batch(&params);
+  }
+
+  return MlasSgemmBatchOp(&params);
+}
+
+}  // namespace tunable
+}  // namespace cpu
+}  // namespace onnxruntime
@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/common/status.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tunable/cpu_tunable.h"
+
+namespace onnxruntime {
+namespace cpu {
+namespace tunable {
+
+struct SgemmBatchParams : OpParams {
+  SgemmBatchParams(CpuTuningContext* tuning_ctx, CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+                   size_t m, size_t n, size_t k, const MLAS_SGEMM_DATA_PARAMS* data, size_t batch_size,
+                   concurrency::ThreadPool* thread_pool);
+
+  std::string Signature() const override;
+
+  CBLAS_TRANSPOSE trans_a;
+  CBLAS_TRANSPOSE trans_b;
+  size_t m;
+  size_t n;
+  size_t k;
+  const MLAS_SGEMM_DATA_PARAMS* data;
+  size_t batch_size;
+  concurrency::ThreadPool* thread_pool;
+};
+
+// Computes the batch of SGEMMs with MlasGemmBatch. If TunableOp is enabled for the tuning context, the fastest of
+// several ways of splitting the work across the threads of the thread pool is used instead, which is found for each
+// problem size on its first use. SGEMMs that accumulate into C (beta != 0) are not tuned.
+Status TunableSgemmBatch(CpuTuningContext* tuning_ctx, CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+                         size_t m, size_t n, size_t k, const MLAS_SGEMM_DATA_PARAMS* data, size_t batch_size,
+                         concurrency::ThreadPool* thread_pool);
+
+}  // namespace tunable
+}  // namespace cpu
+}  // namespace onnxruntime
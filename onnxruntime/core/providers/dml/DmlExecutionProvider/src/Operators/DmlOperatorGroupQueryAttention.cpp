@@ -314,5 +314,50 @@ public:
     }
 };
 
+void CALLBACK QueryGroupQueryAttention(IMLOperatorSupportQueryContextPrivate* context, /*out*/ bool* isSupported)
+{
+    *isSupported = false;
+
+    MLOperatorEdgeDescription queryEdgeDescription = {};
+    if (FAILED(context->GetInputEdgeDescription(0, &queryEdgeDescription))
+    ||  queryEdgeDescription.edgeType != MLOperatorEdgeType::Tensor)
+    {
+        return;
+    }
+
+    // DML computes the KV cache in the type of the query, so fall back if T_CACHE differs from T.
+    for (uint32_t inputIndex : {3u, 4u}) // past_key, past_value
+    {
+        if (!context->IsInputValid(inputIndex))
+        {
+            continue;
+        }
+
+        MLOperatorEdgeDescription edgeDescription = {};
+        if (FAILED(context->GetInputEdgeDescription(inputIndex, &edgeDescription))
+        ||  edgeDescription.tensorDataType != queryEdgeDescription.tensorDataType)
+        {
+            return;
+        }
+    }
+
+    for (uint32_t outputIndex : {1u, 2u}) // present_key, present_value
+    {
+        if (!context->IsOutputValid(outputIndex))
+        {
+            continue;
+        }
+
+        MLOperatorEdgeDescription edgeDescription = {};
+        if (FAILED(context->GetOutputEdgeDescription(outputIndex, &edgeDescription))
+        ||  edgeDescription.tensorDataType != queryEdgeDescription.tensorDataType)
+        {
+            return;
+        }
+    }
+
+    *isSupported = true;
+}
+
 DML_OP_DEFINE_CREATION_FUNCTION(GroupQueryAttention, DmlOperatorGroupQueryAttention);
 } // namespace Dml
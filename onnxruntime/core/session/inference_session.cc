@@ -928,10 +928,16 @@ common::Status InferenceSession::SaveToOrtFormat(const std::filesystem::path& fi
   ORT_RETURN_IF_ERROR(
       kernel_type_str_resolver.SaveToOrtFormat(builder, fbs_kernel_type_str_resolver));
 
+  flatbuffers::Offset<fbs::ExecutionPlan> fbs_execution_plan;
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsSaveExecutionPlanInOrtFormat, "0") == "1") {
+    ORT_RETURN_IF_ERROR(session_state_->SaveExecutionPlanToOrtFormat(builder, fbs_execution_plan));
+  }
+
   fbs::InferenceSessionBuilder sb(builder);
   sb.add_ort_version(ort_model_version);
   sb.add_model(fbs_model);
   sb.add_kernel_type_str_resolver(fbs_kernel_type_str_resolver);
+  sb.add_execution_plan(fbs_execution_plan);
   auto session = sb.Finish();
   builder.Finish(session, fbs::InferenceSessionIdentifier());
 
@@ -1795,6 +1801,25 @@ common::Status InferenceSession::Initialize() {
       }
     }
 
+    // The CPU EP has no provider options, so its TunableOp settings are given as session config entries.
+    if (auto* cpu_ep = execution_providers_.Get(kCpuExecutionProvider); cpu_ep != nullptr) {
+      auto tuning_ctx = cpu_ep->GetTuningContext();
+      if (nullptr != tuning_ctx) {
+        const auto& config_options = session_options_.config_options;
+        if (config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTunableOpEnable, "0") == "1") {
+          tuning_ctx->EnableTunableOp();
+        }
+        if (config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTunableOpTuningEnable, "0") == "1") {
+          tuning_ctx->EnableTuning();
+        }
+        if (const auto max_tuning_duration_ms =
+                config_options.GetConfigEntry(kOrtSessionOptionsCpuTunableOpMaxTuningDurationMs);
+            max_tuning_duration_ms.has_value()) {
+          tuning_ctx->SetMaxTuningDurationMs(ParseStringWithClassicLocale<int>(*max_tuning_duration_ms));
+        }
+      }
+    }
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
     // Don't want to pollute SessionState constructor since memory profile is enabled optionally.
     session_state_->SetMemoryProfiler(&memory_profiler_);
@@ -2062,6 +2087,11 @@ common::Status InferenceSession::Initialize() {
                                                   cpu_ep, GetIntraOpThreadPoolToUse(),
                                                   session_state_->GetMutableBufferedTensors()));
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+
+      if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsUseSavedExecutionPlan, "1") == "1") {
+        session_state_->SetOrtFormatExecutionPlan(
+            fbs::GetInferenceSession(ort_format_model_bytes_.data())->execution_plan());
+      }
     }
 
     ORT_RETURN_IF_ERROR_SESSIONID_(
@@ -4,8 +4,10 @@
 #include "core/session/lora_adapters.h"
 #include "lora/adapter_format_utils.h"
 
+#include <algorithm>
 #include <unordered_map>
 
+#include "core/common/narrow.h"
 #include "core/framework/data_transfer.h"
 #include "core/framework/error_code_helper.h"
 #include "core/session/onnxruntime_c_api.h"
@@ -82,18 +84,65 @@ static Status CreateOrtValueOnDevice(const OrtValue& ort_value_mapped,
   return Status::OK();
 }
 
-void LoraAdapter::InitializeParamsValues() {
-  if (adapter_ == nullptr) {
-    ORT_THROW("Adapter is not loaded yet.");
-  }
-
+static std::unique_ptr<IDataTransfer> GetDeviceDataTransfer(const AllocatorPtr& device_allocator) {
   std::unique_ptr<IDataTransfer> data_transfer;
-  if (device_allocator_) {
-    data_transfer = GetDataTransfer(device_allocator_->Info());
+  if (device_allocator) {
+    data_transfer = GetDataTransfer(device_allocator->Info());
     if (data_transfer == nullptr) {
       ORT_THROW("Data transfer is not available for the specified device allocator, it also must not be a CPU allocator");
     }
   }
+  return data_transfer;
+}
+
+// Copies src into the zero initialized dst that has padded_dims, which are at least
+// as large as the dimensions of src.
+static void CopyToPaddedBuffer(const Tensor& src, gsl::span<const int64_t> padded_dims, uint8_t* dst) {
+  const auto dims = src.Shape().GetDims();
+  const size_t element_size = src.DataType()->Size();
+  const auto* src_bytes = static_cast<const uint8_t*>(src.DataRaw());
+
+  if (src.Shape().Size() == 0) {
+    return;
+  }
+
+  if (dims.empty()) {
+    memcpy(dst, src_bytes, element_size);
+    return;
+  }
+
+  const size_t rank = dims.size();
+  const size_t row_bytes = narrow<size_t>(dims[rank - 1]) * element_size;
+  const size_t num_rows = narrow<size_t>(src.Shape().SizeToDimension(rank - 1));
+
+  InlinedVector<size_t> padded_strides(rank, 1);
+  for (size_t d = rank - 1; d > 0; --d) {
+    padded_strides[d - 1] = padded_strides[d] * narrow<size_t>(padded_dims[d]);
+  }
+
+  InlinedVector<int64_t> index(rank, 0);
+  for (size_t row = 0; row < num_rows; ++row) {
+    size_t offset = 0;
+    for (size_t d = 0; d + 1 < rank; ++d) {
+      offset += narrow<size_t>(index[d]) * padded_strides[d];
+    }
+    memcpy(dst + offset * element_size, src_bytes + row * row_bytes, row_bytes);
+
+    for (size_t d = rank - 1; d-- > 0;) {
+      if (++index[d] < dims[d]) {
+        break;
+      }
+      index[d] = 0;
+    }
+  }
+}
+
+void LoraAdapter::InitializeParamsValues() {
+  if (adapter_ == nullptr) {
+    ORT_THROW("Adapter is not loaded yet.");
+  }
+
+  std::unique_ptr<IDataTransfer> data_transfer = GetDeviceDataTransfer(device_allocator_);
 
   const auto* params = adapter_->parameters();
   ORT_ENFORCE(params != nullptr, "Params absent");
@@ -120,6 +169,89 @@ void LoraAdapter::InitializeParamsValues() {
   params_values_.swap(params_values);
 }
 
+void LoraAdapter::Stack(gsl::span<const LoraAdapter* const> adapters) {
+  ORT_ENFORCE(!adapters.empty(), "At least one adapter is required to create a stacked adapter.");
+  const LoraAdapter& first = *adapters[0];
+  for (const auto* adapter : adapters) {
+    ORT_ENFORCE(adapter != nullptr, "Stacked adapters must not be null.");
+    ORT_ENFORCE(adapter->GetParamNum() == first.GetParamNum(),
+                "All stacked adapters must have the same parameters.");
+    ORT_ENFORCE(adapter->ModelVersion() == first.ModelVersion(),
+                "All stacked adapters must be created for the same model version.");
+    // The tensors are created over the raw data of the adapter, make sure every copy below stays within it.
+    if (adapter->adapter_ != nullptr && adapter->adapter_->parameters() != nullptr) {
+      for (const auto* param : *adapter->adapter_->parameters()) {
+        std::string name;
+        adapters::utils::LoadStringFromLoraFormat(name, param->name());
+        auto hit = adapter->params_values_.find(name);
+        ORT_ENFORCE(hit != adapter->params_values_.end(), "Parameter: ", name, " is not loaded.");
+        const size_t raw_size = param->raw_data() != nullptr ? param->raw_data()->size() : 0;
+        const size_t expected_size = hit->second.GetMapped().Get<Tensor>().SizeInBytes();
+        ORT_ENFORCE(raw_size == expected_size, "Parameter: ", name, " has ", raw_size,
+                    " bytes of data, but its shape and element type require ", expected_size, " bytes.");
+      }
+    }
+  }
+
+  std::unique_ptr<IDataTransfer> data_transfer = GetDeviceDataTransfer(device_allocator_);
+  AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
+  const size_t num_adapters = adapters.size();
+
+  std::unordered_map<std::string, Param> params_values;
+  params_values.reserve(first.params_values_.size());
+  for (const auto& [name, first_param] : first.params_values_) {
+    const auto& first_tensor = first_param.GetMapped().Get<Tensor>();
+    ORT_ENFORCE(!first_tensor.IsDataTypeString(), "Parameter: ", name, " string parameters can not be stacked.");
+
+    InlinedVector<const Tensor*> tensors;
+    tensors.reserve(num_adapters);
+    TensorShapeVector padded_dims = first_tensor.Shape().AsShapeVector();
+    for (const auto* adapter : adapters) {
+      auto hit = adapter->params_values_.find(name);
+      ORT_ENFORCE(hit != adapter->params_values_.end(), "Parameter: ", name, " is missing from a stacked adapter.");
+      const auto& tensor = hit->second.GetMapped().Get<Tensor>();
+      ORT_ENFORCE(tensor.DataType() == first_tensor.DataType(), "Parameter: ", name,
+                  " has different element types in the stacked adapters.");
+      ORT_ENFORCE(tensor.Shape().NumDimensions() == padded_dims.size(), "Parameter: ", name,
+                  " has different ranks in the stacked adapters.");
+      const auto dims = tensor.Shape().GetDims();
+      for (size_t d = 0; d < padded_dims.size(); ++d) {
+        padded_dims[d] = std::max(padded_dims[d], dims[d]);
+      }
+      tensors.push_back(&tensor);
+    }
+
+    TensorShapeVector stacked_dims;
+    stacked_dims.reserve(padded_dims.size() + 1);
+    stacked_dims.push_back(narrow<int64_t>(num_adapters));
+    stacked_dims.insert(stacked_dims.end(), padded_dims.begin(), padded_dims.end());
+
+    Tensor stacked(first_tensor.DataType(), TensorShape(stacked_dims), cpu_allocator);
+    auto* stacked_bytes = static_cast<uint8_t*>(stacked.MutableDataRaw());
+    memset(stacked_bytes, 0, stacked.SizeInBytes());
+    const size_t slot_bytes = stacked.SizeInBytes() / num_adapters;
+    for (size_t i = 0; i < num_adapters; ++i) {
+      CopyToPaddedBuffer(*tensors[i], padded_dims, stacked_bytes + i * slot_bytes);
+    }
+
+    OrtValue ort_value;
+    Tensor::InitOrtValue(std::move(stacked), ort_value);
+    if (data_transfer) {
+      OrtValue ort_value_ondevice;
+      ORT_THROW_IF_ERROR(CreateOrtValueOnDevice(ort_value, device_allocator_,
+                                                *data_transfer, ort_value_ondevice));
+      params_values.emplace(name, Param(std::move(ort_value), std::move(ort_value_ondevice)));
+    } else {
+      params_values.emplace(name, Param(std::move(ort_value)));
+    }
+  }
+
+  model_version_ = first.ModelVersion();
+  adapter_ = nullptr;
+  buffer_.emplace<std::monostate>();
+  params_values_.swap(params_values);
+}
+
 }  // namespace lora
 }  // namespace onnxruntime
 
@@ -161,6 +293,29 @@ ORT_API_STATUS_IMPL(OrtApis::CreateLoraAdapterFromArray, _In_ const void* bytes,
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateLoraAdapterStack, _In_reads_(num_adapters) const OrtLoraAdapter* const* adapters,
+                    size_t num_adapters, _In_ OrtAllocator* allocator, _Outptr_ OrtLoraAdapter** adapter) {
+  API_IMPL_BEGIN
+
+  if (adapters == nullptr || num_adapters == 0) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "At least one adapter is required");
+  }
+
+  std::unique_ptr<onnxruntime::lora::LoraAdapter> lora_adapter;
+  if (allocator != nullptr) {
+    auto alloc_ptr = std::make_shared<onnxruntime::IAllocatorImplWrappingOrtAllocator>(allocator);
+    lora_adapter = std::make_unique<onnxruntime::lora::LoraAdapter>(std::move(alloc_ptr));
+  } else {
+    lora_adapter = std::make_unique<onnxruntime::lora::LoraAdapter>();
+  }
+
+  auto* const* stacked = reinterpret_cast<const onnxruntime::lora::LoraAdapter* const*>(adapters);
+  lora_adapter->Stack(gsl::make_span(stacked, num_adapters));
+  *adapter = reinterpret_cast<OrtLoraAdapter*>(lora_adapter.release());
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API(void, OrtApis::ReleaseLoraAdapter, _Frees_ptr_opt_ OrtLoraAdapter* adapter) {
   delete reinterpret_cast<onnxruntime::lora::LoraAdapter*>(adapter);
 }
@@ -98,6 +98,18 @@ class LoraAdapter {
   /// <param name="file_name"></param>
   void MemoryMap(const std::filesystem::path& file_path);
 
+  /// <summary>
+  /// Stacks the parameters of the given adapters along a new leading dimension so that
+  /// a single Run can select a different adapter for every batch row (see com.microsoft.LoRAMatMul).
+  /// All adapters must have the same parameter names, element types, ranks and model version, and the
+  /// data of every parameter must match its shape and element type.
+  /// Parameters with smaller dimensions (e.g. a lower LoRA rank) are zero padded, which leaves
+  /// the low-rank product unchanged. The stacked parameters are copied to the device if
+  /// this adapter was created with a device allocator.
+  /// </summary>
+  /// <param name="adapters">adapters to stack, in the order of their adapter index</param>
+  void Stack(gsl::span<const LoraAdapter* const> adapters);
+
   /// <summary>
   /// Returns number of parameters in the adapter.
   /// The number is expected to be even as lora params come in pairs.
@@ -108,19 +120,19 @@ class LoraAdapter {
   }
 
   /// <summary>
-  /// Gets lora format version
+  /// Gets lora format version, 0 for stacked adapters
   /// </summary>
   /// <returns></returns>
   int FormatVersion() const noexcept {
-    return adapter_->format_version();
+    return adapter_ != nullptr ? adapter_->format_version() : 0;
   }
 
   /// <summary>
-  /// Gets adapter version
+  /// Gets adapter version, 0 for stacked adapters
   /// </summary>
   /// <returns></returns>
   int AdapterVersion() const noexcept {
-    return adapter_->adapter_version();
+    return adapter_ != nullptr ? adapter_->adapter_version() : 0;
   }
 
   /// <summary>
@@ -128,7 +140,7 @@ class LoraAdapter {
   /// </summary>
   /// <returns></returns>
   int ModelVersion() const noexcept {
-    return adapter_->model_version();
+    return adapter_ != nullptr ? adapter_->model_version() : model_version_;
   }
 
   /// <summary>
@@ -169,6 +181,8 @@ class LoraAdapter {
 
   AllocatorPtr device_allocator_;
   const adapters::Adapter* adapter_{nullptr};
+  // Model version of the stacked adapters, adapter_ is not set for those.
+  int model_version_{0};
   std::unordered_map<std::string, Param> params_values_;
 };
 
@@ -276,6 +276,39 @@ class Session:
                 return self._sess.run(output_names, input_feed, run_options)
             raise
 
+    def run_with_output_buffers(self, output_names, input_feed, output_buffers, run_options=None):
+        """
+        Compute the predictions into numpy arrays allocated by the caller.
+
+        :param output_names: name of the outputs
+        :param input_feed: dictionary ``{ input_name: input_value }``
+        :param output_buffers: list with a numpy array or None for every output name. The arrays must be
+            writeable and C-contiguous, and have the type and shape of the output. The output is written
+            directly into the array. ORT allocates the outputs for which None is given.
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+        :return: list of results, the given array for every output with a buffer, otherwise as in
+            :meth:`Session.run`.
+
+        ::
+
+            y = np.empty((1, 1000), dtype=np.float32)
+            sess.run_with_output_buffers([output_name], {input_name: x}, [y])
+        """
+        self._validate_input(list(input_feed.keys()))
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+        try:
+            return self._sess.run_with_output_buffers(output_names, input_feed, output_buffers, run_options)
+        except C.EPFail as err:
+            if self._enable_fallback:
+                print(f"EP Error: {err!s} using {self._providers}")
+                print(f"Falling back to {self._fallback_providers} and retrying.")
+                self.set_providers(self._fallback_providers)
+                # Fallback only once.
+                self.disable_fallback()
+                return self._sess.run_with_output_buffers(output_names, input_feed, output_buffers, run_options)
+            raise
+
     def run_async(self, output_names, input_feed, callback, user_data, run_options=None):
         """
         Compute the predictions asynchronously in a separate cxx thread from ort intra-op threadpool.
@@ -306,6 +339,30 @@ class Session:
             output_names = [output.name for output in self._outputs_meta]
         return self._sess.run_async(output_names, input_feed, callback, user_data, run_options)
 
+    def run_batch(self, output_names, input_names, batch_feeds, run_options=None):
+        """
+        Compute the predictions of a batch of independent requests.
+
+        The GIL is released once for the whole batch, and the requests run concurrently
+        on the ort intra-op threadpool when it has at least two threads.
+
+        :param output_names: name of the outputs
+        :param input_names: name of the inputs, shared by all requests
+        :param batch_feeds: list of requests, every request is a sequence with a value
+            for each of ``input_names``
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+        :return: list with the list of results of every request, every result is either
+            a numpy array, a sparse tensor, a list or a dictionary.
+
+        ::
+
+            results = sess.run_batch([output_name], [input_name], [(x0,), (x1,), (x2,)])
+        """
+        self._validate_input(list(input_names))
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+        return self._sess.run_batch(output_names, input_names, batch_feeds, run_options)
+
     def run_with_ort_values(self, output_names, input_dict_ort_values, run_options=None):
         """
         Compute the predictions.
@@ -1023,5 +1023,32 @@ void CreateGenericMLValue(const onnxruntime::InputDefList* input_def_list, const
   }
 }
 
+void CreateOutputMLValueOverNumpyArray(const AllocatorPtr& alloc, const std::string& name_output,
+                                       const py::object& value, OrtValue* p_mlvalue) {
+  if (!PyObjectCheck_NumpyArray(value.ptr())) {
+    throw std::runtime_error("The output buffer for '" + name_output + "' must be a numpy array");
+  }
+
+  PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(value.ptr());
+  const int npy_type = PyArray_TYPE(arr);
+  if (!IsNumericNumpyType(npy_type)) {
+    throw std::runtime_error("The output buffer for '" + name_output + "' must be a numeric numpy array");
+  }
+
+  // The output is written in place, so unlike an input the array can't be made contiguous by a copy.
+  if (!PyArray_ISCARRAY(arr)) {
+    throw std::runtime_error("The output buffer for '" + name_output +
+                             "' must be a writeable, aligned and C-contiguous numpy array");
+  }
+
+  auto p_tensor = std::make_unique<Tensor>(NumpyTypeToOnnxRuntimeTensorType(npy_type), GetArrayShape(arr),
+                                           PyArray_DATA(arr), alloc->Info());
+
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  p_mlvalue->Init(p_tensor.release(),
+                  ml_tensor,
+                  ml_tensor->GetDeleteFunc());
+}
+
 }  // namespace python
 }  // namespace onnxruntime
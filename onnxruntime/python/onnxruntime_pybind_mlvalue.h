@@ -123,6 +123,12 @@ void CreateGenericMLValue(const onnxruntime::InputDefList* input_def_list, const
                           const std::string& name_input, const pybind11::object& value, OrtValue* p_mlvalue,
                           bool accept_only_numpy_array = false, bool use_numpy_data_memory = true, MemCpyFunc mem_cpy_to_device = CpuToCpuMemCpy);
 
+// Creates a CPU OrtValue over the memory of a numpy array so that a model output can be written directly into it.
+// The array must be a writeable, aligned and C-contiguous numeric array. The numpy object owns the memory
+// and needs to be alive until the corresponding OrtValue is in scope.
+void CreateOutputMLValueOverNumpyArray(const AllocatorPtr& alloc, const std::string& name_output,
+                                       const pybind11::object& value, OrtValue* p_mlvalue);
+
 pybind11::object GetPyObjFromTensor(const OrtValue& rtensor,
                                     const DataTransferManager* data_transfer_manager = nullptr,
                                     const std::unordered_map<OrtDevice::DeviceType, MemCpyFunc>* mem_cpy_to_host_functions = nullptr);
@@ -61,6 +61,8 @@ const OrtDevice::DeviceType OrtDevice::GPU;
 
 #include <iterator>
 #include <algorithm>
+#include <condition_variable>
+#include <mutex>
 
 namespace onnxruntime {
 namespace python {
@@ -166,6 +168,54 @@ void AsyncCallback(void* user_data, OrtValue** outputs, size_t num_outputs, OrtS
   }
 }
 
+struct BatchRun;
+
+// A request of run_batch(). The fetches are allocated by Run() and released during destruction.
+struct BatchRequest {
+  std::vector<OrtValue> feeds;
+  std::vector<const OrtValue*> feeds_raw;
+  std::vector<OrtValue*> fetches_raw;
+  std::string error;
+  BatchRun* batch_run = nullptr;
+
+  ~BatchRequest() {
+    std::for_each(fetches_raw.begin(), fetches_raw.end(), [](const OrtValue* fetch) {
+      if (fetch) {
+        std::unique_ptr<const OrtValue> fetch_recycler(fetch);
+      }
+    });
+  }
+};
+
+// Tracks the requests of run_batch() that are running on the intra op thread pool.
+struct BatchRun {
+  std::mutex mutex;
+  std::condition_variable completed;
+  size_t num_pending = 0;
+
+  void OnRequestCompleted() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (--num_pending == 0) {
+      completed.notify_all();
+    }
+  }
+
+  void WaitForRequests() {
+    std::unique_lock<std::mutex> lock(mutex);
+    completed.wait(lock, [this]() { return num_pending == 0; });
+  }
+};
+
+// Called from the intra op thread pool without the GIL. No python objects are touched.
+void BatchRequestCallback(void* user_data, OrtValue** /*outputs*/, size_t /*num_outputs*/, OrtStatusPtr ort_status) {
+  auto* request = reinterpret_cast<BatchRequest*>(user_data);
+  Ort::Status status(ort_status);
+  if (!status.IsOK()) {
+    request->error = status.GetErrorMessage();
+  }
+  request->batch_run->OnRequestCompleted();
+}
+
 void AppendLoraParametersAsInputs(const RunOptions& run_options,
                                   size_t total_entries,
                                   NameMLValMap& feeds) {
@@ -402,6 +452,52 @@ py::object AddTensorAsPyObj(const OrtValue& val, const DataTransferManager* data
   return GetPyObjFromTensor(val, data_transfer_manager, mem_cpy_to_host_functions);
 }
 
+// Creates the feeds for Run() from python objects. Numpy arrays are used without a copy if they are contiguous.
+static NameMLValMap CreateFeedsFromPyObjects(PyInferenceSession* sess,
+                                             const std::map<std::string, const py::object>& pyfeeds,
+                                             const RunOptions* run_options) {
+  NameMLValMap feeds;
+  if (run_options != nullptr && !run_options->active_adapters.empty()) {
+    AppendLoraParametersAsInputs(*run_options, pyfeeds.size(), feeds);
+  } else {
+    feeds.reserve(pyfeeds.size());
+  }
+
+  for (const auto& feed : pyfeeds) {
+    // No need to process 'None's sent in by the user
+    // to feed Optional inputs in the graph.
+    // We just won't include anything in the feed and ORT
+    // will handle such implicit 'None's internally.
+    if (!feed.second.is(py::none())) {
+      OrtValue ml_value;
+      auto px = sess->GetSessionHandle()->GetModelInputs();
+      if (!px.first.IsOK() || !px.second) {
+        throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+      }
+      CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
+      ThrowIfPyErrOccured();
+      feeds.insert(std::make_pair(feed.first, std::move(ml_value)));
+    }
+  }
+
+  return feeds;
+}
+
+static py::object FetchAsPyObj(size_t pos, const OrtValue& fet) {
+  if (fet.IsAllocated()) {
+    if (fet.IsTensor()) {
+      return AddTensorAsPyObj(fet, nullptr, nullptr);
+    } else if (fet.IsSparseTensor()) {
+      return GetPyObjectFromSparseTensor(pos, fet, nullptr);
+    } else {
+      return AddNonTensorAsPyObj(fet, nullptr, nullptr);
+    }
+  }
+
+  // Send back None because the corresponding OrtValue was empty
+  return py::none();
+}
+
 static std::unique_ptr<onnxruntime::IExecutionProvider> LoadExecutionProvider(
     const std::string& ep_shared_lib_path,
     const ProviderOptions& provider_options = {},
@@ -2043,33 +2139,55 @@ including arg name, arg type (contains both type and shape).)pbdoc")
            [](PyInferenceSession* sess, const std::vector<std::string>& output_names,
               const std::map<std::string, const py::object>& pyfeeds, RunOptions* run_options = nullptr)
                -> py::list {
-             NameMLValMap feeds;
-             if (run_options != nullptr && !run_options->active_adapters.empty()) {
-               AppendLoraParametersAsInputs(*run_options, pyfeeds.size(), feeds);
-             } else {
-               feeds.reserve(pyfeeds.size());
+             NameMLValMap feeds = CreateFeedsFromPyObjects(sess, pyfeeds, run_options);
+
+             std::vector<OrtValue> fetches;
+             fetches.reserve(output_names.size());
+             common::Status status;
+
+             {
+               // release GIL to allow multiple python threads to invoke Run() in parallel.
+               py::gil_scoped_release release;
+               if (run_options != nullptr) {
+                 OrtPybindThrowIfError(sess->GetSessionHandle()->Run(*run_options, feeds, output_names, &fetches));
+               } else {
+                 OrtPybindThrowIfError(sess->GetSessionHandle()->Run(feeds, output_names, &fetches));
+               }
              }
 
-             for (const auto& feed : pyfeeds) {
-               // No need to process 'None's sent in by the user
-               // to feed Optional inputs in the graph.
-               // We just won't include anything in the feed and ORT
-               // will handle such implicit 'None's internally.
-               if (!feed.second.is(py::none())) {
-                 OrtValue ml_value;
-                 auto px = sess->GetSessionHandle()->GetModelInputs();
-                 if (!px.first.IsOK() || !px.second) {
-                   throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
-                 }
-                 CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
-                 ThrowIfPyErrOccured();
-                 feeds.insert(std::make_pair(feed.first, std::move(ml_value)));
+             py::list result;
+             for (size_t pos = 0; pos < fetches.size(); ++pos) {
+               result.append(FetchAsPyObj(pos, fetches[pos]));
+             }
+             return result;
+           })
+      /// This method runs the model with numpy arrays provided by the caller for some or all of the outputs.
+      /// The outputs are written directly into the memory of these arrays, which are returned in place of new
+      /// arrays. An entry of output_buffers may be None to let ORT allocate that output.
+      .def("run_with_output_buffers",
+           [](PyInferenceSession* sess, const std::vector<std::string>& output_names,
+              const std::map<std::string, const py::object>& pyfeeds, const py::list& output_buffers,
+              RunOptions* run_options = nullptr) -> py::list {
+             if (output_buffers.size() != output_names.size()) {
+               throw std::runtime_error("The number of output buffers must match the number of output names");
+             }
+
+             NameMLValMap feeds = CreateFeedsFromPyObjects(sess, pyfeeds, run_options);
+
+             std::vector<OrtValue> fetches(output_names.size());
+             for (size_t i = 0; i < output_names.size(); ++i) {
+               if (!output_buffers[i].is_none()) {
+                 CreateOutputMLValueOverNumpyArray(GetAllocator(), output_names[i], output_buffers[i], &fetches[i]);
                }
              }
 
-             std::vector<OrtValue> fetches;
-             fetches.reserve(output_names.size());
-             common::Status status;
+             // the data pointers are kept to check that the outputs were written in place
+             std::vector<const void*> buffer_data(fetches.size(), nullptr);
+             for (size_t i = 0; i < fetches.size(); ++i) {
+               if (fetches[i].IsAllocated()) {
+                 buffer_data[i] = fetches[i].Get<Tensor>().DataRaw();
+               }
+             }
 
              {
                // release GIL to allow multiple python threads to invoke Run() in parallel.
@@ -2082,20 +2200,120 @@ including arg name, arg type (contains both type and shape).)pbdoc")
              }
 
              py::list result;
-             size_t pos = 0;
-             for (const auto& fet : fetches) {
-               if (fet.IsAllocated()) {
-                 if (fet.IsTensor()) {
-                   result.append(AddTensorAsPyObj(fet, nullptr, nullptr));
-                 } else if (fet.IsSparseTensor()) {
-                   result.append(GetPyObjectFromSparseTensor(pos, fet, nullptr));
-                 } else {
-                   result.append(AddNonTensorAsPyObj(fet, nullptr, nullptr));
+             for (size_t pos = 0; pos < fetches.size(); ++pos) {
+               if (buffer_data[pos] == nullptr) {
+                 result.append(FetchAsPyObj(pos, fetches[pos]));
+                 continue;
+               }
+
+               // An output that is also a model input is returned as the input value instead of being written into
+               // the buffer, so it is copied.
+               const Tensor& tensor = fetches[pos].Get<Tensor>();
+               if (tensor.DataRaw() != buffer_data[pos]) {
+                 py::array buffer = py::reinterpret_borrow<py::array>(output_buffers[pos]);
+                 if (tensor.Location().device.Type() != OrtDevice::CPU ||
+                     tensor.DataType() != NumpyTypeToOnnxRuntimeTensorType(GetNumpyArrayType(buffer)) ||
+                     tensor.Shape() != GetShape(buffer)) {
+                   throw std::runtime_error("The output buffer for '" + output_names[pos] +
+                                            "' doesn't match the type and shape of the output");
                  }
-               } else {  // Send back None because the corresponding OrtValue was empty
-                 result.append(py::none());
+                 CpuToCpuMemCpy(buffer.mutable_data(), tensor.DataRaw(), tensor.SizeInBytes());
+               }
+               result.append(output_buffers[pos]);
+             }
+             return result;
+           })
+      /// This method runs a batch of independent requests with the GIL released for the whole batch.
+      /// The input and output names are given once for all requests, and every entry of batch_feeds is a sequence
+      /// with a value for each input name. The requests run concurrently on the intra op thread pool through
+      /// RunAsync(), or one after the other if the pool has less than two threads.
+      /// A list of outputs is returned for every request.
+      .def("run_batch",
+           [](PyInferenceSession* sess, const std::vector<std::string>& output_names,
+              const std::vector<std::string>& input_names, const py::list& batch_feeds,
+              RunOptions* run_options = nullptr) -> py::list {
+             if (run_options != nullptr && !run_options->active_adapters.empty()) {
+               LOGS(*sess->GetSessionHandle()->GetLogger(), WARNING)
+                   << "run_batch has active adapters specified, but won't have an effect";
+             }
+
+             auto px = sess->GetSessionHandle()->GetModelInputs();
+             if (!px.first.IsOK() || !px.second) {
+               throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+             }
+
+             std::vector<const char*> feed_names_raw;
+             feed_names_raw.reserve(input_names.size());
+             for (const auto& name : input_names) {
+               feed_names_raw.push_back(name.c_str());
+             }
+
+             std::vector<const char*> fetch_names_raw;
+             fetch_names_raw.reserve(output_names.size());
+             for (const auto& name : output_names) {
+               fetch_names_raw.push_back(name.c_str());
+             }
+
+             // create all the feeds while holding the GIL
+             BatchRun batch_run;
+             std::vector<BatchRequest> requests(batch_feeds.size());
+             for (size_t i = 0; i < requests.size(); ++i) {
+               auto feed_values = py::reinterpret_borrow<py::sequence>(batch_feeds[i]);
+               if (feed_values.size() != input_names.size()) {
+                 throw std::runtime_error("Request " + std::to_string(i) + " of the batch has " +
+                                          std::to_string(feed_values.size()) + " inputs but " +
+                                          std::to_string(input_names.size()) + " input names were given");
+               }
+
+               auto& request = requests[i];
+               request.feeds.resize(input_names.size());
+               request.feeds_raw.reserve(input_names.size());
+               for (size_t j = 0; j < input_names.size(); ++j) {
+                 CreateGenericMLValue(px.second, GetAllocator(), input_names[j], feed_values[j], &request.feeds[j]);
+                 ThrowIfPyErrOccured();
+                 request.feeds_raw.push_back(&request.feeds[j]);
+               }
+               request.fetches_raw.resize(output_names.size(), nullptr);
+               request.batch_run = &batch_run;
+             }
+
+             {
+               // release GIL for the whole batch to allow other python threads to run
+               py::gil_scoped_release release;
+               auto* session = sess->GetSessionHandle();
+               RunOptions default_run_options;
+               const RunOptions& options = run_options != nullptr ? *run_options : default_run_options;
+
+               batch_run.num_pending = requests.size();
+               for (auto& request : requests) {
+                 auto status = session->RunAsync(&options, feed_names_raw, request.feeds_raw, fetch_names_raw,
+                                                 request.fetches_raw, BatchRequestCallback, &request);
+                 if (!status.IsOK()) {
+                   // RunAsync() needs an intra op thread pool with at least two threads
+                   status = session->Run(options, feed_names_raw, request.feeds_raw, fetch_names_raw,
+                                         request.fetches_raw);
+                   if (!status.IsOK()) {
+                     request.error = status.ErrorMessage();
+                   }
+                   batch_run.OnRequestCompleted();
+                 }
+               }
+
+               batch_run.WaitForRequests();
+             }
+
+             py::list result;
+             for (size_t i = 0; i < requests.size(); ++i) {
+               const auto& request = requests[i];
+               if (!request.error.empty()) {
+                 throw std::runtime_error("Request " + std::to_string(i) + " of the batch failed: " + request.error);
+               }
+
+               py::list outputs;
+               for (size_t pos = 0; pos < request.fetches_raw.size(); ++pos) {
+                 outputs.append(FetchAsPyObj(pos, *request.fetches_raw[pos]));
                }
-               ++pos;
+               result.append(std::move(outputs));
              }
              return result;
            })
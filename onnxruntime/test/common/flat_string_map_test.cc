@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/flat_string_map.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(FlatStringMapTest, FindAndDuplicates) {
+  FlatStringMap<int> map;
+  EXPECT_TRUE(map.Empty());
+  EXPECT_EQ(map.Find("a"), nullptr);
+
+  EXPECT_TRUE(map.TryEmplace("a", 1).second);
+  EXPECT_TRUE(map.TryEmplace("", 2).second);
+  EXPECT_TRUE(map.TryEmplace("prefix_0", 3).second);
+  EXPECT_TRUE(map.TryEmplace("prefix_01", 4).second);
+  EXPECT_TRUE(map.TryEmplace(std::string("a\0", 2), 5).second);
+
+  // TryEmplace keeps the first value of a key, InsertOrAssign the last.
+  auto [value, inserted] = map.TryEmplace("a", 6);
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(*value, 1);
+  EXPECT_EQ(*map.InsertOrAssign("prefix_0", 7), 7);
+
+  ASSERT_EQ(map.Size(), 5u);
+  EXPECT_EQ(*map.Find("a"), 1);
+  EXPECT_EQ(*map.Find(""), 2);
+  EXPECT_EQ(*map.Find("prefix_0"), 7);
+  EXPECT_EQ(*map.Find("prefix_01"), 4);
+  EXPECT_EQ(*map.Find(std::string("a\0", 2)), 5);
+  EXPECT_EQ(map.Find("prefix_1"), nullptr);
+  EXPECT_EQ(map.Find("prefix_02"), nullptr);
+  EXPECT_EQ(map.Find("b"), nullptr);
+
+  // Keys longer than the size field of a slot.
+  const std::string long_key(70000, 'k');
+  EXPECT_TRUE(map.TryEmplace(long_key, 8).second);
+  EXPECT_EQ(*map.Find(long_key), 8);
+  EXPECT_EQ(map.Find(long_key + "k"), nullptr);
+  EXPECT_EQ(map.Find(long_key.substr(1)), nullptr);
+}
+
+TEST(FlatStringMapTest, LargeVocabulary) {
+  constexpr int kCount = 100000;
+  FlatStringMap<int> map;
+  std::unordered_map<std::string, int> reference;
+  for (int i = 0; i < kCount; ++i) {
+    // Keys of varying length sharing long common prefixes.
+    std::string key = std::string(static_cast<size_t>(i % 23), 'x') + std::to_string(i * 7919 % kCount);
+    map.TryEmplace(key, i);
+    reference.emplace(key, i);
+  }
+
+  ASSERT_EQ(map.Size(), reference.size());
+  std::vector<std::string> queries;
+  for (const auto& [key, value] : reference) {
+    const int* found = map.Find(key);
+    ASSERT_NE(found, nullptr) << key;
+    EXPECT_EQ(*found, value) << key;
+    EXPECT_EQ(map.Find(key + "y"), nullptr) << key;
+    queries.push_back(key);
+    queries.push_back(key + "y");
+  }
+
+  // The table is large enough for FindEach to take the prefetching path.
+  size_t hits = 0;
+  map.FindEach(gsl::span<const std::string>(queries), [&](size_t i, const int* found) {
+    const auto expected = reference.find(queries[i]);
+    if (expected == reference.end()) {
+      EXPECT_EQ(found, nullptr) << queries[i];
+    } else {
+      ASSERT_NE(found, nullptr) << queries[i];
+      EXPECT_EQ(*found, expected->second) << queries[i];
+      ++hits;
+    }
+  });
+  EXPECT_EQ(hits, reference.size());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
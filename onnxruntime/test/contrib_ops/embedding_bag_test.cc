@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// A 5 x 3 table where row r is {r, 10 * r, 100 * r}.
+std::vector<float> TableData() {
+  std::vector<float> data;
+  for (int r = 0; r < 5; ++r) {
+    data.push_back(static_cast<float>(r));
+    data.push_back(static_cast<float>(10 * r));
+    data.push_back(static_cast<float>(100 * r));
+  }
+  return data;
+}
+
+}  // namespace
+
+TEST(EmbeddingBagTest, Sum) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddInput<float>("data", {5, 3}, TableData());
+  test.AddInput<int64_t>("indices", {2, 3}, {0, 1, 2, 4, 4, 3});
+  test.AddOutput<float>("output", {2, 3}, {3.f, 30.f, 300.f, 11.f, 110.f, 1100.f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, Mean) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddInput<float>("data", {5, 3}, TableData());
+  test.AddInput<int64_t>("indices", {2, 3}, {0, 1, 2, 4, 4, 4});
+  test.AddOutput<float>("output", {2, 3}, {1.f, 10.f, 100.f, 4.f, 40.f, 400.f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, BatchedIndicesAndNegativeIndices) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddInput<float>("data", {5, 3}, TableData());
+  test.AddInput<int32_t>("indices", {2, 2, 2}, {0, -1, 1, 2, -2, -2, 3, 0});
+  test.AddOutput<float>("output", {2, 2, 3},
+                        {4.f, 40.f, 400.f, 3.f, 30.f, 300.f, 6.f, 60.f, 600.f, 3.f, 30.f, 300.f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, Offsets) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddInput<float>("data", {5, 3}, TableData());
+  test.AddInput<int64_t>("indices", {5}, {1, 3, 2, 4, 0});
+  // The second bag is empty.
+  test.AddInput<int64_t>("offsets", {4}, {0, 2, 2, 3});
+  test.AddOutput<float>("output", {4, 3},
+                        {2.f, 20.f, 200.f, 0.f, 0.f, 0.f, 2.f, 20.f, 200.f, 2.f, 20.f, 200.f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, InvalidIndices) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddInput<float>("data", {5, 3}, TableData());
+  test.AddInput<int64_t>("indices", {1, 2}, {0, 5});
+  test.AddOutput<float>("output", {1, 3}, {0.f, 0.f, 0.f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds");
+}
+
+TEST(EmbeddingBagTest, InvalidOffsets) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddInput<float>("data", {5, 3}, TableData());
+  test.AddInput<int64_t>("indices", {3}, {0, 1, 2});
+  test.AddInput<int64_t>("offsets", {2}, {2, 1});
+  test.AddOutput<float>("output", {2, 3}, std::vector<float>(6));
+  test.Run(OpTester::ExpectResult::kExpectFailure, "offsets must be non-decreasing");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include <random>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+std::vector<float> RandomValues(size_t count, std::default_random_engine& generator) {
+  std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+  std::vector<float> values(count);
+  for (auto& value : values) {
+    value = distribution(generator);
+  }
+  return values;
+}
+
+int64_t Size(const std::vector<int64_t>& dims) {
+  int64_t size = 1;
+  for (const int64_t dim : dims) {
+    size *= dim;
+  }
+  return size;
+}
+
+// Returns the element of an input of shape `dims` that is broadcast to element `index` of `output_dims`.
+float Broadcast(const std::vector<float>& values, const std::vector<int64_t>& dims,
+                const std::vector<int64_t>& output_dims, int64_t index) {
+  int64_t offset = 0;
+  int64_t stride = 1;
+  for (size_t i = 0; i < dims.size(); i++) {
+    const size_t d = output_dims.size() - 1 - i;
+    const int64_t dim = dims[dims.size() - 1 - i];
+    const int64_t position = index % output_dims[d];
+    index /= output_dims[d];
+    if (dim != 1) {
+      offset += position * stride;
+    }
+    stride *= dim;
+  }
+  return values[static_cast<size_t>(offset)];
+}
+
+// y0 = silu((x + bias) * scale), y1 = LeakyRelu(y0 - z)
+void RunSiluSubgraphTest(const std::vector<int64_t>& x_dims, const std::vector<int64_t>& bias_dims,
+                         const std::vector<int64_t>& z_dims) {
+  std::default_random_engine generator(static_cast<unsigned>(Size(x_dims)));
+  const auto x = RandomValues(static_cast<size_t>(Size(x_dims)), generator);
+  const auto bias = RandomValues(static_cast<size_t>(Size(bias_dims)), generator);
+  const auto z = RandomValues(static_cast<size_t>(Size(z_dims)), generator);
+  const float scale = 1.5f;
+  const float alpha = 0.1f;
+
+  const int64_t size = Size(x_dims);
+  std::vector<float> y0(static_cast<size_t>(size));
+  std::vector<float> y1(static_cast<size_t>(size));
+  for (int64_t i = 0; i < size; i++) {
+    const double v = (double(x[i]) + Broadcast(bias, bias_dims, x_dims, i)) * scale;
+    const double silu = v / (1.0 + std::exp(-v));
+    const double d = silu - Broadcast(z, z_dims, x_dims, i);
+    y0[i] = static_cast<float>(silu);
+    y1[i] = static_cast<float>(d >= 0.0 ? d : alpha * d);
+  }
+
+  // values: 0 x, 1 bias, 2 scale, 3 z, 4 x + bias, 5 * scale, 6 sigmoid, 7 silu, 8 - z, 9 LeakyRelu
+  OpTester test("FusedElementwise", 1, kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Add", "Mul", "Sigmoid", "Mul", "Sub", "LeakyRelu"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, 4, 2, 5, -1, 5, 6, 7, 3, 8, -1});
+  test.AddAttribute("alphas", std::vector<float>{0.0f, 0.0f, 0.0f, 0.0f, 0.0f, alpha});
+  test.AddAttribute("output_values", std::vector<int64_t>{7, 9});
+  test.AddInput<float>("x", x_dims, x);
+  test.AddInput<float>("bias", bias_dims, bias);
+  test.AddInput<float>("scale", {}, {scale});
+  test.AddInput<float>("z", z_dims, z);
+  test.AddOutput<float>("y0", x_dims, y0);
+  test.AddOutput<float>("y1", x_dims, y1);
+  test.SetOutputAbsErr("y0", 1e-5f);
+  test.SetOutputAbsErr("y1", 1e-5f);
+  test.Run();
+}
+
+}  // namespace
+
+TEST(FusedElementwiseTest, RepeatedBias) {
+  RunSiluSubgraphTest({2, 3, 16}, {16}, {2, 3, 16});
+  RunSiluSubgraphTest({4, 1000, 7}, {1000, 7}, {4, 1000, 7});
+}
+
+TEST(FusedElementwiseTest, Broadcast) {
+  RunSiluSubgraphTest({2, 3, 16}, {3, 1}, {2, 1, 16});
+  RunSiluSubgraphTest({3, 700, 9}, {1, 9}, {3, 1, 9});
+  RunSiluSubgraphTest({5, 33}, {5, 1}, {1});
+}
+
+TEST(FusedElementwiseTest, UnaryChain) {
+  // y = Sqrt(Abs(Neg(x))) + Reciprocal(Exp(x)), where x is used by two ops
+  const std::vector<float> x{-4.0f, -1.0f, 0.0f, 0.25f, 1.0f, 9.0f};
+  std::vector<float> y;
+  for (const float value : x) {
+    y.push_back(std::sqrt(std::abs(-value)) + 1.0f / std::exp(value));
+  }
+
+  OpTester test("FusedElementwise", 1, kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Neg", "Abs", "Sqrt", "Exp", "Reciprocal", "Add"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, -1, 1, -1, 2, -1, 0, -1, 4, -1, 3, 5});
+  test.AddAttribute("output_values", std::vector<int64_t>{6});
+  test.AddInput<float>("x", {2, 3}, x);
+  test.AddOutput<float>("y", {2, 3}, y);
+  test.SetOutputAbsErr("y", 1e-5f);
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
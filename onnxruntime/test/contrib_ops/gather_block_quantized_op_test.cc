@@ -122,8 +122,6 @@ void Test_Fail_WithZeroPoints(int64_t gather_axis,
 }
 
 TEST(GatherBlockQuantizedOpTest, UnsupportedTypes) {
-  Test_Fail_WithZeroPoints<int8_t, float, int32_t>(0, 2, 16);
-  Test_Fail_WithZeroPoints<uint8_t, float, int32_t>(0, 2, 16);
   Test_Fail_WithZeroPoints<int16_t, float, int32_t>(0, 2, 16);
   Test_Fail_WithZeroPoints<uint16_t, float, int32_t>(0, 2, 16);
   Test_Fail_WithZeroPoints<int32_t, float, int32_t>(0, 2, 16);
@@ -287,6 +285,8 @@ TEST(GatherBlockQuantizedOpTest, GatherAxis0WithZeroPoints) {
   Test_GatherAxis0_WithZeroPoints<Int4x2, float, int64_t>();
   Test_GatherAxis0_WithZeroPoints<UInt4x2, MLFloat16, int64_t>();
   Test_GatherAxis0_WithZeroPoints<Int4x2, MLFloat16, int64_t>();
+  Test_GatherAxis0_WithZeroPoints<int8_t, float, int32_t>();
+  Test_GatherAxis0_WithZeroPoints<int8_t, MLFloat16, int64_t>();
 }
 
 template <typename T1, typename T2, typename Tind>
@@ -340,6 +340,8 @@ TEST(GatherBlockQuantizedOpTest, GatherAxis0NoZeroPoints) {
   Test_GatherAxis0_NoZeroPoints<Int4x2, MLFloat16, int32_t>();
   Test_GatherAxis0_NoZeroPoints<Int4x2, float, int64_t>();
   Test_GatherAxis0_NoZeroPoints<Int4x2, MLFloat16, int64_t>();
+  Test_GatherAxis0_NoZeroPoints<int8_t, float, int32_t>();
+  Test_GatherAxis0_NoZeroPoints<int8_t, float, int64_t>();
 }
 
 template <typename T1, typename T2, typename Tind>
@@ -401,6 +403,8 @@ TEST(GatherBlockQuantizedOpTest, GatherAxis1) {
   Test_GatherAxis1_WithZeroPoints<Int4x2, float, int64_t>();
   Test_GatherAxis1_WithZeroPoints<UInt4x2, MLFloat16, int64_t>();
   Test_GatherAxis1_WithZeroPoints<Int4x2, MLFloat16, int64_t>();
+  Test_GatherAxis1_WithZeroPoints<int8_t, float, int32_t>();
+  Test_GatherAxis1_WithZeroPoints<int8_t, MLFloat16, int64_t>();
 }
 
 template <typename T1, typename T2, typename Tind>
@@ -462,6 +466,8 @@ TEST(GatherBlockQuantizedOpTest, GatherAxis2) {
   Test_GatherAxis2_WithZeroPoints<Int4x2, float, int64_t>();
   Test_GatherAxis2_WithZeroPoints<UInt4x2, MLFloat16, int64_t>();
   Test_GatherAxis2_WithZeroPoints<Int4x2, MLFloat16, int64_t>();
+  Test_GatherAxis2_WithZeroPoints<int8_t, float, int32_t>();
+  Test_GatherAxis2_WithZeroPoints<int8_t, MLFloat16, int64_t>();
 }
 
 }  // namespace test
@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <random>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+std::vector<float> RandomValues(size_t count, std::default_random_engine& generator) {
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  std::vector<float> values(count);
+  for (auto& value : values) {
+    value = distribution(generator);
+  }
+  return values;
+}
+
+void RunLoRAMatMulTest(const std::vector<int64_t>& a_dims, int64_t N, int64_t num_adapters, int64_t rank,
+                       const std::vector<int32_t>& adapter_indices, float scale) {
+  std::default_random_engine generator(static_cast<unsigned>(N * 31 + rank));
+
+  const int64_t batch_size = a_dims.front();
+  const int64_t K = a_dims.back();
+  int64_t M = 1;
+  for (size_t i = 1; i + 1 < a_dims.size(); i++) {
+    M *= a_dims[i];
+  }
+
+  const auto a = RandomValues(static_cast<size_t>(batch_size * M * K), generator);
+  const auto b = RandomValues(static_cast<size_t>(K * N), generator);
+  const auto lora_a = RandomValues(static_cast<size_t>(num_adapters * K * rank), generator);
+  const auto lora_b = RandomValues(static_cast<size_t>(num_adapters * rank * N), generator);
+
+  std::vector<float> y(static_cast<size_t>(batch_size * M * N));
+  for (int64_t batch = 0; batch < batch_size; batch++) {
+    const int32_t index = adapter_indices[static_cast<size_t>(batch)];
+    for (int64_t m = 0; m < M; m++) {
+      const float* a_row = a.data() + (batch * M + m) * K;
+      std::vector<double> down(static_cast<size_t>(rank), 0.0);
+      if (index >= 0) {
+        for (int64_t r = 0; r < rank; r++) {
+          for (int64_t k = 0; k < K; k++) {
+            down[r] += double(a_row[k]) * lora_a[(index * K + k) * rank + r];
+          }
+        }
+      }
+      for (int64_t n = 0; n < N; n++) {
+        double sum = 0.0;
+        for (int64_t k = 0; k < K; k++) {
+          sum += double(a_row[k]) * b[k * N + n];
+        }
+        if (index >= 0) {
+          double update = 0.0;
+          for (int64_t r = 0; r < rank; r++) {
+            update += down[r] * lora_b[(index * rank + r) * N + n];
+          }
+          sum += scale * update;
+        }
+        y[(batch * M + m) * N + n] = static_cast<float>(sum);
+      }
+    }
+  }
+
+  std::vector<int64_t> y_dims = a_dims;
+  y_dims.back() = N;
+
+  OpTester test("LoRAMatMul", 1, kMSDomain);
+  test.AddAttribute<float>("scale", scale);
+  test.AddInput<float>("A", a_dims, a);
+  test.AddInput<float>("B", {K, N}, b, true);
+  test.AddInput<float>("lora_A", {num_adapters, K, rank}, lora_a);
+  test.AddInput<float>("lora_B", {num_adapters, rank, N}, lora_b);
+  test.AddInput<int32_t>("adapter_indices", {batch_size}, adapter_indices);
+  test.AddOutput<float>("Y", y_dims, y);
+  test.SetOutputAbsErr("Y", 1e-4f);
+  test.Run();
+}
+
+}  // namespace
+
+TEST(LoRAMatMulTest, SingleAdapter) {
+  RunLoRAMatMulTest({2, 3, 16}, 8, 1, 4, {0, 0}, 1.0f);
+}
+
+TEST(LoRAMatMulTest, MixedAdapters) {
+  RunLoRAMatMulTest({5, 7, 32}, 24, 3, 8, {2, 0, -1, 1, 2}, 0.5f);
+  RunLoRAMatMulTest({4, 64}, 48, 4, 16, {3, 1, 0, 2}, 2.0f);
+  RunLoRAMatMulTest({3, 2, 2, 20}, 12, 2, 3, {1, -1, 0}, 1.0f);
+}
+
+TEST(LoRAMatMulTest, BaseOnly) {
+  RunLoRAMatMulTest({3, 4, 16}, 8, 2, 4, {-1, -1, -1}, 1.0f);
+}
+
+TEST(LoRAMatMulTest, InvalidAdapterIndex) {
+  OpTester test("LoRAMatMul", 1, kMSDomain);
+  test.AddInput<float>("A", {2, 1, 2}, {1.0f, 2.0f, 3.0f, 4.0f});
+  test.AddInput<float>("B", {2, 2}, {1.0f, 0.0f, 0.0f, 1.0f});
+  test.AddInput<float>("lora_A", {1, 2, 1}, {1.0f, 1.0f});
+  test.AddInput<float>("lora_B", {1, 1, 2}, {1.0f, 1.0f});
+  test.AddInput<int32_t>("adapter_indices", {2}, {0, 1});
+  test.AddOutput<float>("Y", {2, 1, 2}, {0.0f, 0.0f, 0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "is out of range");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
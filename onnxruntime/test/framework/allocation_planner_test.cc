@@ -359,6 +359,21 @@ class PlannerTest : public ::testing::Test {
     EXPECT_EQ(plan_->allocation_plan[id].alloc_kind, kind) << "Error in allocation kind for " << name;
   }
 
+  void CheckInplaceReuse(const std::string& name, const std::string& reused_name) {
+    int id;
+    index(name, id);
+    int reused_id;
+    index(reused_name, reused_id);
+    EXPECT_TRUE(plan_->allocation_plan[id].is_inplace_reuse) << name << " is not computed in-place";
+    EXPECT_EQ(plan_->allocation_plan[id].reused_buffer, reused_id) << "Error in reused buffer for " << name;
+  }
+
+  void CheckNotInplaceReuse(const std::string& name) {
+    int id;
+    index(name, id);
+    EXPECT_FALSE(plan_->allocation_plan[id].is_inplace_reuse) << name << " is reported as computed in-place";
+  }
+
   void CheckFreed(int step_number, std::initializer_list<std::string> freed_items) {
     // TODO: add the checker for new implementation of release plan
     //// create set and check equality
@@ -510,6 +525,7 @@ TEST_F(PlannerTest, InPlaceTest) {
   CheckAllocKind(X2, AllocKind::kAllocate);
   CheckAllocKind(X3, AllocKind::kReuse);
   CheckAllocKind(X4, AllocKind::kAllocateOutput);
+  CheckInplaceReuse(X3, X2);
 
   // check each ml-value is freed at appropriate step
   CheckFreed(0, {});
@@ -517,6 +533,64 @@ TEST_F(PlannerTest, InPlaceTest) {
   CheckFreed(2, {X2});
 }
 
+// BroadcastInPlaceTest: Check that a binary op that broadcasts one input reuses the input with the output's shape.
+TEST_F(PlannerTest, BroadcastInPlaceTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), B1("B1"), B2("B2"), X3("X3"), X4("X4"), node_name("add");
+
+  std::unique_ptr<::onnxruntime::KernelDef> add_kernel = KernelDefBuilder()
+                                                              .SetName("Add")
+                                                              .Provider(kCpuExecutionProvider)
+                                                              .SinceVersion(7, 12)
+                                                              .MayInplace(0, 0)
+                                                              .MayInplace(1, 0)
+                                                              .Build();
+
+  // graph structure:
+  AddNormalNode(X1, X2);  // X1: input; X2: temporary
+  AddNormalNode(B1, B2);  // B1: input; B2: temporary that is broadcast by the Add
+  std::vector<onnxruntime::NodeArg*> add_inputs{Arg(B2), Arg(X2)}, add_outputs{Arg(X3)};
+  AddNode(*add_kernel, node_name, add_inputs, add_outputs);  // may-in-place operator; X3: temporary
+  AddNormalNode(X3, X4);                                     // X4: output
+
+  // simulate shape-inference results:
+  Shape shape1{"M", "N"};
+  Shape shape2{"N"};
+  SetShape({{X1, &shape1.value}, {X2, &shape1.value}, {B1, &shape2.value}, {B2, &shape2.value},
+            {X3, &shape1.value}, {X4, &shape1.value}});
+
+  CreatePlan();
+
+  // B2 is the first input of the Add, but only X2 has the shape of the output.
+  CheckAllocKind(B2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kReuse);
+  CheckInplaceReuse(X3, X2);
+}
+
+// AliasIsNotInPlaceTest: Check that an output that must alias its input is not reported as computed in-place.
+TEST_F(PlannerTest, AliasIsNotInPlaceTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4");
+
+  std::unique_ptr<::onnxruntime::KernelDef> alias_kernel =
+      KernelDefBuilder().SetName("Relu").Provider(kCpuExecutionProvider).SinceVersion(1, 10).Alias(0, 0).Build();
+
+  // graph structure:
+  AddNormalNode(X1, X2);           // X1: input; X2: temporary
+  AddNode(*alias_kernel, X2, X3);  // aliasing operator; X3: temporary
+  AddNormalNode(X3, X4);           // X4: output
+
+  // simulate shape-inference results:
+  Shape shape1{"M", "N"};
+  auto shape = &shape1.value;
+  SetShape({{X1, shape}, {X2, shape}, {X3, shape}, {X4, shape}});
+
+  CreatePlan();
+
+  CheckAllocKind(X3, AllocKind::kReuse);
+  CheckNotInplaceReuse(X3);
+}
+
 TEST_F(PlannerTest, ExternalOutputsTest) {
   // tensor variables:
   std::string X1("X1"), X2("X2"), X3("X3"), X4("X4");
@@ -22,6 +22,7 @@
 #include "core/framework/kernel_registry.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
+#include "core/framework/shared_initializer_store.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/bfc_arena.h"
 #include "core/graph/graph_viewer.h"
@@ -2882,6 +2883,91 @@ TEST(InferenceSessionTests, InitializerSharing_EnsureSessionsUseUserAddedInitial
   }
 }
 
+TEST(InferenceSessionTests, InitializerSharing_EnsureSessionsShareInitializersByContent) {
+  const char* init_name = "W";
+
+  SessionOptions so_shared;
+  ASSERT_STATUS_OK(so_shared.config_options.AddConfigEntry(kOrtSessionOptionsShareInitializersByContent, "1"));
+
+  InferenceSessionTestSharingInitializer sess1(so_shared, GetEnvironment());
+  ASSERT_STATUS_OK(sess1.Load(MODEL_URI));
+  ASSERT_STATUS_OK(sess1.Initialize());
+
+  InferenceSessionTestSharingInitializer sess2(so_shared, GetEnvironment());
+  ASSERT_STATUS_OK(sess2.Load(MODEL_URI));
+  ASSERT_STATUS_OK(sess2.Initialize());
+
+  SessionOptions so_not_shared;
+  InferenceSessionTestSharingInitializer sess3(so_not_shared, GetEnvironment());
+  ASSERT_STATUS_OK(sess3.Load(MODEL_URI));
+  ASSERT_STATUS_OK(sess3.Initialize());
+
+  int so1_idx;
+  ASSERT_STATUS_OK(sess1.GetSessionState().GetOrtValueNameIdxMap().GetIdx(init_name, so1_idx));
+  const auto* so1_init_buffer = sess1.GetSessionState().GetInitializedTensors().at(so1_idx).Get<Tensor>().Data<float>();
+
+  int so2_idx;
+  ASSERT_STATUS_OK(sess2.GetSessionState().GetOrtValueNameIdxMap().GetIdx(init_name, so2_idx));
+  const auto* so2_init_buffer = sess2.GetSessionState().GetInitializedTensors().at(so2_idx).Get<Tensor>().Data<float>();
+
+  // Ensure both sessions that share initializers by content use the same data ptr
+  ASSERT_EQ(so1_init_buffer, so2_init_buffer);
+
+  int so3_idx;
+  ASSERT_STATUS_OK(sess3.GetSessionState().GetOrtValueNameIdxMap().GetIdx(init_name, so3_idx));
+  const auto* so3_init_buffer = sess3.GetSessionState().GetInitializedTensors().at(so3_idx).Get<Tensor>().Data<float>();
+
+  // Ensure a session that does not share initializers by content has its own copy
+  ASSERT_NE(so3_init_buffer, so1_init_buffer);
+
+  RunOptions run_options;
+  RunModel(sess1, run_options);
+  RunModel(sess2, run_options);
+  RunModel(sess3, run_options);
+}
+
+TEST(InferenceSessionTests, InitializerSharing_EnsureSessionsSharePrePackedWeightsByContent) {
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsShareInitializersByContent, "1"));
+
+  SharedInitializerStore& store = SharedInitializerStore::Instance();
+  const auto initial_stats = store.GetStats();
+
+  InferenceSessionWrapper sess1(so, GetEnvironment());
+  ASSERT_STATUS_OK(sess1.Load(ORT_TSTR("testdata/matmul_1.onnx")));
+  ASSERT_STATUS_OK(sess1.Initialize());
+  const auto sess1_stats = store.GetStats();
+
+  InferenceSessionWrapper sess2(so, GetEnvironment());
+  ASSERT_STATUS_OK(sess2.Load(ORT_TSTR("testdata/matmul_1.onnx")));
+  ASSERT_STATUS_OK(sess2.Initialize());
+  const auto sess2_stats = store.GetStats();
+
+  // The MatMul weight is only pre-packed if MLAS supports packing on this platform. If it is, the sessions release
+  // the weight after pre-packing it and share the pre-packed weight instead.
+  if (sess1_stats.num_prepacked_weights > initial_stats.num_prepacked_weights) {
+    EXPECT_EQ(sess2_stats.num_prepacked_weights, sess1_stats.num_prepacked_weights);
+    EXPECT_EQ(sess2_stats.prepacked_weights_bytes, sess1_stats.prepacked_weights_bytes);
+  }
+  EXPECT_EQ(sess2_stats.num_initializers, sess1_stats.num_initializers);
+  EXPECT_EQ(sess2_stats.num_shared_lookups, sess1_stats.num_shared_lookups + 1);
+
+  // Y = X * W with W = [1, 2]^T
+  std::vector<int64_t> dims_x = {3, 2};
+  std::vector<float> values_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  OrtValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims_x, values_x, &ml_value);
+  NameMLValMap feeds{{"X", ml_value}};
+  const std::vector<std::string> output_names{"Y"};
+  const std::vector<int64_t> expected_dims_y = {3, 1};
+  const std::vector<float> expected_values_y = {5.0f, 11.0f, 17.0f};
+  for (auto* session : {&sess1, &sess2}) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session->Run(feeds, output_names, &fetches));
+    VerifyOutputs(fetches, expected_dims_y, expected_values_y);
+  }
+}
+
 void RunModelWithDenormalAsZero(InferenceSession& session_object,
                                 const RunOptions& run_options,
                                 bool set_denormal_as_zero) {
@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/kernel_plan_cache.h"
+
+#include "gtest/gtest.h"
+
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+struct TestPlan {
+  int64_t size = 0;
+};
+
+Status GetPlan(const KernelPlanCache<TestPlan>& cache, const TensorShape& a, const TensorShape& b,
+               int& num_created, std::shared_ptr<const TestPlan>& plan) {
+  return cache.GetOrCreate(
+      {&a, &b},
+      [&](TestPlan& new_plan) {
+        ++num_created;
+        new_plan.size = a.Size() + b.Size();
+        return Status::OK();
+      },
+      plan);
+}
+
+}  // namespace
+
+TEST(KernelPlanCacheTest, ReusesPlanForSameShapes) {
+  KernelPlanCache<TestPlan> cache;
+  int num_created = 0;
+  std::shared_ptr<const TestPlan> plan;
+  std::shared_ptr<const TestPlan> other_plan;
+
+  ASSERT_STATUS_OK(GetPlan(cache, TensorShape({2, 3}), TensorShape({3}), num_created, plan));
+  ASSERT_STATUS_OK(GetPlan(cache, TensorShape({2, 3}), TensorShape({3}), num_created, other_plan));
+  EXPECT_EQ(num_created, 1);
+  EXPECT_EQ(plan, other_plan);
+  EXPECT_EQ(plan->size, 9);
+
+  // The shapes are distinguished by their ranks, not only by their concatenated dimensions.
+  ASSERT_STATUS_OK(GetPlan(cache, TensorShape({2}), TensorShape({3, 3}), num_created, other_plan));
+  EXPECT_EQ(num_created, 2);
+  EXPECT_NE(plan, other_plan);
+  EXPECT_EQ(other_plan->size, 11);
+  EXPECT_EQ(cache.Size(), 2u);
+}
+
+TEST(KernelPlanCacheTest, EvictsLeastRecentlyUsedPlan) {
+  KernelPlanCache<TestPlan> cache(2);
+  int num_created = 0;
+  std::shared_ptr<const TestPlan> plan;
+
+  ASSERT_STATUS_OK(GetPlan(cache, TensorShape({1}), TensorShape({1}), num_created, plan));
+  ASSERT_STATUS_OK(GetPlan(cache, TensorShape({2}), TensorShape({2}), num_created, plan));
+  ASSERT_STATUS_OK(GetPlan(cache, TensorShape({1}), TensorShape({1}), num_created, plan));
+  EXPECT_EQ(num_created, 2);
+
+  // {2}, {2} is the least recently used plan, so it is evicted.
+  ASSERT_STATUS_OK(GetPlan(cache, TensorShape({3}), TensorShape({3}), num_created, plan));
+  EXPECT_EQ(cache.Size(), 2u);
+  ASSERT_STATUS_OK(GetPlan(cache, TensorShape({1}), TensorShape({1}), num_created, plan));
+  EXPECT_EQ(num_created, 3);
+  ASSERT_STATUS_OK(GetPlan(cache, TensorShape({2}), TensorShape({2}), num_created, plan));
+  EXPECT_EQ(num_created, 4);
+}
+
+TEST(KernelPlanCacheTest, DoesNotCacheFailures) {
+  KernelPlanCache<TestPlan> cache;
+  int num_calls = 0;
+  std::shared_ptr<const TestPlan> plan;
+  const TensorShape shape({4});
+
+  auto create_fn = [&](TestPlan&) {
+    ++num_calls;
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid shape");
+  };
+  EXPECT_FALSE(cache.GetOrCreate({&shape}, create_fn, plan).IsOK());
+  EXPECT_FALSE(cache.GetOrCreate({&shape}, create_fn, plan).IsOK());
+  EXPECT_EQ(num_calls, 2);
+  EXPECT_EQ(cache.Size(), 0u);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -17,6 +17,7 @@ TEST(MemPatternPlannerTest, TraceAllocaitonTest) {
   auto pattern = planner.GenerateMemPattern();
 
   EXPECT_EQ(pattern.PeakSize(), 1024u + 256u + 512u + 1024u);
+  EXPECT_EQ(pattern.LowerBoundSize(), 1024u + 256u + 512u + 1024u);
   EXPECT_EQ(pattern.GetBlock(0)->offset_, 0u);
   EXPECT_EQ(pattern.GetBlock(1)->offset_, 1024u);
   EXPECT_EQ(pattern.GetBlock(2)->offset_, 1024 + 256u);
@@ -30,10 +31,42 @@ TEST(MemPatternPlannerTest, TraceAllocaitonTest) {
 
   pattern = planner.GenerateMemPattern();
 
-  EXPECT_EQ(pattern.PeakSize(), 1024u + 256u + 512u + 1024u + 512u);
-  EXPECT_EQ(pattern.GetBlock(4)->offset_, 1024u + 256u + 512u + 1024u);
-  EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024u + 256u + 512u);
-  EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024u);
+  // Placing the blocks as they are traced needs 1024 + 256 + 512 + 1024 + 512 bytes, as block 4 does not fit in the
+  // gap left by block 1. Knowing all the lifetimes, the blocks are packed into the lower bound of 0, 2, 3 and 4.
+  EXPECT_EQ(pattern.LowerBoundSize(), 1024u + 512u + 1024u + 512u);
+  EXPECT_EQ(pattern.PeakSize(), 1024u + 512u + 1024u + 512u);
+  EXPECT_EQ(pattern.GetBlock(0)->offset_, 0u);
+  EXPECT_EQ(pattern.GetBlock(3)->offset_, 1024u);
+  EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024u);
+  EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024u + 600u);
+  EXPECT_EQ(pattern.GetBlock(2)->offset_, 1024u + 1024u);
+  EXPECT_EQ(pattern.GetBlock(1)->offset_, 1024u + 1024u + 512u);
+  EXPECT_EQ(pattern.GetBlock(4)->offset_, 1024u + 1024u + 512u);
+}
+
+TEST(MemPatternPlannerTest, PackBlocksByLifetimeTest) {
+  constexpr bool using_counters = false;
+  MemPatternPlanner planner{using_counters};
+  // A small block that is freed late keeps the large block that is allocated after it from reusing the memory of
+  // the first block when the blocks are placed as they are traced.
+  planner.TraceAllocation(0, 512);
+  planner.TraceAllocation(1, 64);
+  planner.TraceFree(0);
+  planner.TraceAllocation(2, 1024);
+  planner.TraceFree(1);
+  planner.TraceAllocation(3, 512);
+  planner.TraceFree(2);
+  planner.TraceFree(3);
+
+  auto pattern = planner.GenerateMemPattern();
+
+  EXPECT_EQ(pattern.LowerBoundSize(), 1024u + 512u);
+  EXPECT_EQ(pattern.PeakSize(), 1024u + 512u);
+  for (int i = 0; i < 4; ++i) {
+    const auto* block = pattern.GetBlock(i);
+    ASSERT_NE(block, nullptr);
+    EXPECT_LE(block->offset_ + block->size_, pattern.PeakSize());
+  }
 }
 }  // namespace test
 }  // namespace onnxruntime
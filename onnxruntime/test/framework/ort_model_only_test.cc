@@ -350,6 +350,95 @@ TEST(OrtModelOnlyTests, MetadataSerialization) {
   SaveAndCompareModels(ORT_TSTR("testdata/model_with_metadata.onnx"), ort_file);
 }
 
+TEST(OrtModelOnlyTests, SerializeExecutionPlan) {
+  const auto ort_file = ORT_TSTR("testdata/mnist.onnx.execution_plan.test_output.ort");
+  {
+    SessionOptions so;
+    so.session_logid = "SerializeExecutionPlan";
+    so.optimized_model_filepath = ort_file;
+    // keep the Add and Relu nodes that compute their output in-place
+    so.graph_optimization_level = TransformerLevel::Default;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSaveModelFormat, "ORT"));
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsSaveExecutionPlanInOrtFormat, "1"));
+    InferenceSessionWrapper session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/mnist.onnx")));
+    ASSERT_STATUS_OK(session_object.Initialize());
+  }
+
+  // load the model once using the saved execution plan and once creating the plan
+  SessionOptions so_saved_plan;
+  so_saved_plan.session_logid = "LoadSavedExecutionPlan";
+  InferenceSessionWrapper session_saved_plan{so_saved_plan, GetEnvironment()};
+  ASSERT_STATUS_OK(session_saved_plan.Load(ort_file));
+  ASSERT_STATUS_OK(session_saved_plan.Initialize());
+  ASSERT_TRUE(session_saved_plan.GetSessionState().IsExecutionPlanFromOrtFormat());
+
+  SessionOptions so_created_plan;
+  so_created_plan.session_logid = "CreateExecutionPlan";
+  ASSERT_STATUS_OK(so_created_plan.config_options.AddConfigEntry(kOrtSessionOptionsUseSavedExecutionPlan, "0"));
+  InferenceSessionWrapper session_created_plan{so_created_plan, GetEnvironment()};
+  ASSERT_STATUS_OK(session_created_plan.Load(ort_file));
+  ASSERT_STATUS_OK(session_created_plan.Initialize());
+  ASSERT_FALSE(session_created_plan.GetSessionState().IsExecutionPlanFromOrtFormat());
+
+  const auto& saved_plan = *session_saved_plan.GetSessionState().GetExecutionPlan();
+  const auto& created_plan = *session_created_plan.GetSessionState().GetExecutionPlan();
+
+  ASSERT_EQ(saved_plan.allocation_plan.size(), created_plan.allocation_plan.size());
+  for (size_t i = 0; i < saved_plan.allocation_plan.size(); ++i) {
+    const auto& saved = saved_plan.allocation_plan[i];
+    const auto& created = created_plan.allocation_plan[i];
+    EXPECT_EQ(saved.alloc_kind, created.alloc_kind) << "OrtValue " << i;
+    EXPECT_EQ(saved.reused_buffer, created.reused_buffer) << "OrtValue " << i;
+    EXPECT_EQ(saved.is_inplace_reuse, created.is_inplace_reuse) << "OrtValue " << i;
+    EXPECT_EQ(saved.location, created.location) << "OrtValue " << i;
+    EXPECT_EQ(saved.value_type, created.value_type) << "OrtValue " << i;
+    EXPECT_EQ(saved.program_counter.Starts(), created.program_counter.Starts()) << "OrtValue " << i;
+    EXPECT_EQ(saved.program_counter.Ends(), created.program_counter.Ends()) << "OrtValue " << i;
+  }
+
+  ASSERT_EQ(saved_plan.execution_plan.size(), 1u);
+  ASSERT_EQ(created_plan.execution_plan.size(), 1u);
+  const auto& saved_steps = saved_plan.execution_plan[0]->steps_;
+  const auto& created_steps = created_plan.execution_plan[0]->steps_;
+  ASSERT_EQ(saved_steps.size(), created_steps.size());
+  for (size_t i = 0; i < saved_steps.size(); ++i) {
+    EXPECT_EQ(saved_steps[i]->GetNodeIndex(), created_steps[i]->GetNodeIndex());
+  }
+
+  ASSERT_EQ(saved_plan.release_actions.size(), created_plan.release_actions.size());
+  for (size_t i = 0; i < saved_plan.release_actions.size(); ++i) {
+    EXPECT_EQ(saved_plan.release_actions[i].value_index, created_plan.release_actions[i].value_index);
+    EXPECT_EQ(saved_plan.release_actions[i].ref_count, created_plan.release_actions[i].ref_count);
+  }
+  EXPECT_EQ(saved_plan.node_release_list, created_plan.node_release_list);
+  EXPECT_EQ(saved_plan.node_stream_map_, created_plan.node_stream_map_);
+  ASSERT_EQ(saved_plan.value_to_stream_map.size(), created_plan.value_to_stream_map.size());
+  for (const auto& [value_index, stream_index] : created_plan.value_to_stream_map) {
+    const auto it = saved_plan.value_to_stream_map.find(value_index);
+    ASSERT_NE(it, saved_plan.value_to_stream_map.end()) << "OrtValue " << value_index;
+    EXPECT_EQ(it->second, stream_index) << "OrtValue " << value_index;
+  }
+
+  const auto& saved_stats = session_saved_plan.GetSessionState().GetInplaceReuseStats();
+  const auto& created_stats = session_created_plan.GetSessionState().GetInplaceReuseStats();
+  EXPECT_GT(created_stats.num_values, 0u);
+  EXPECT_EQ(saved_stats.num_values, created_stats.num_values);
+  EXPECT_EQ(saved_stats.num_bytes, created_stats.num_bytes);
+
+  OrtValue ml_value;
+  std::vector<float> data(28 * 28, 1.0f);
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {1, 1, 28, 28}, data,
+                       &ml_value);
+  NameMLValMap feeds{{"Input3", ml_value}};
+  const std::vector<std::string> output_names{"Plus214_Output_0"};
+  std::vector<OrtValue> saved_plan_fetches;
+  std::vector<OrtValue> created_plan_fetches;
+  ASSERT_STATUS_OK(session_saved_plan.Run(feeds, output_names, &saved_plan_fetches));
+  ASSERT_STATUS_OK(session_created_plan.Run(feeds, output_names, &created_plan_fetches));
+  CheckOrtValuesAreEqual("Plus214_Output_0", created_plan_fetches[0], saved_plan_fetches[0]);
+}
+
 // test we can load an old ORT format model and run it in a full build.
 // we changed from using kernel hashes to kernel type constraints in v5, so an old model should be able to be loaded
 // in a full build if we add the kernel type constraints during loading. this also means we can save the updated
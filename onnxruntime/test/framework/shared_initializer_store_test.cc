@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_initializer_store.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+#include "test/framework/test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+OrtValue CreateInitializer(SharedInitializerStore& store, const std::vector<int64_t>& dims,
+                           const std::vector<float>& values) {
+  OrtValue value;
+  CreateMLValue<float>(store.GetAllocator(), dims, values, &value);
+  return value;
+}
+
+PrePackedWeights CreatePrePackedWeights(SharedInitializerStore& store, const std::vector<uint8_t>& bytes) {
+  PrePackedWeights weights;
+  auto buffer = IAllocator::MakeUniquePtr<void>(store.GetAllocator(), bytes.size(), true);
+  std::memcpy(buffer.get(), bytes.data(), bytes.size());
+  weights.buffers_.push_back(std::move(buffer));
+  weights.buffer_sizes_.push_back(bytes.size());
+  return weights;
+}
+
+}  // namespace
+
+TEST(SharedInitializerStoreTest, SharesIdenticalInitializers) {
+  SharedInitializerStore store;
+
+  OrtValue value = store.GetOrAddInitializer(CreateInitializer(store, {2, 2}, {1.f, 2.f, 3.f, 4.f}));
+  OrtValue same_value = store.GetOrAddInitializer(CreateInitializer(store, {2, 2}, {1.f, 2.f, 3.f, 4.f}));
+  EXPECT_EQ(value.Get<Tensor>().DataRaw(), same_value.Get<Tensor>().DataRaw());
+
+  // Initializers are only shared if their shape and bytes are the same.
+  OrtValue reshaped_value = store.GetOrAddInitializer(CreateInitializer(store, {4}, {1.f, 2.f, 3.f, 4.f}));
+  OrtValue other_value = store.GetOrAddInitializer(CreateInitializer(store, {2, 2}, {1.f, 2.f, 3.f, 5.f}));
+  EXPECT_NE(value.Get<Tensor>().DataRaw(), reshaped_value.Get<Tensor>().DataRaw());
+  EXPECT_NE(value.Get<Tensor>().DataRaw(), other_value.Get<Tensor>().DataRaw());
+
+  const auto stats = store.GetStats();
+  EXPECT_EQ(stats.num_initializers, 3u);
+  EXPECT_EQ(stats.initializer_bytes, 12 * sizeof(float));
+  EXPECT_EQ(stats.num_shared_lookups, 1u);
+  EXPECT_EQ(stats.shared_bytes, 4 * sizeof(float));
+}
+
+TEST(SharedInitializerStoreTest, ReleasesUnusedInitializers) {
+  SharedInitializerStore store;
+
+  OrtValue value = store.GetOrAddInitializer(CreateInitializer(store, {3}, {1.f, 2.f, 3.f}));
+  {
+    OrtValue same_value = store.GetOrAddInitializer(CreateInitializer(store, {3}, {1.f, 2.f, 3.f}));
+    EXPECT_EQ(store.GetStats().num_initializers, 1u);
+  }
+
+  // The initializer is kept while a value still uses it.
+  EXPECT_EQ(store.GetStats().num_initializers, 1u);
+  EXPECT_EQ(value.Get<Tensor>().Data<float>()[2], 3.f);
+
+  value = OrtValue();
+  EXPECT_EQ(store.GetStats().num_initializers, 0u);
+}
+
+TEST(SharedInitializerStoreTest, SharesIdenticalPrePackedWeights) {
+  SharedInitializerStore store;
+
+  auto weights = store.GetOrAddPrePackedWeights("MatMul+1", CreatePrePackedWeights(store, {1, 2, 3, 4}));
+  auto same_weights = store.GetOrAddPrePackedWeights("MatMul+1", CreatePrePackedWeights(store, {1, 2, 3, 4}));
+  EXPECT_EQ(weights, same_weights);
+
+  // Weights with the same key but different bytes are not shared.
+  auto other_weights = store.GetOrAddPrePackedWeights("MatMul+1", CreatePrePackedWeights(store, {1, 2, 3, 5}));
+  EXPECT_NE(weights, other_weights);
+
+  auto stats = store.GetStats();
+  EXPECT_EQ(stats.num_prepacked_weights, 1u);
+  EXPECT_EQ(stats.prepacked_weights_bytes, 4u);
+  EXPECT_EQ(stats.num_shared_lookups, 1u);
+
+  weights.reset();
+  same_weights.reset();
+  EXPECT_EQ(store.GetStats().num_prepacked_weights, 0u);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -199,6 +199,86 @@ TEST(LoraAdapterTest, Load) {
   }
 }
 
+TEST(LoraAdapterTest, Stack) {
+  // Two adapters of rank 2 and 3 for a 4 x 5 weight
+  constexpr std::array<int64_t, 2> ranks = {2, 3};
+  constexpr int64_t K = 4;
+  constexpr int64_t N = 5;
+
+  std::vector<lora::LoraAdapter> adapters(ranks.size());
+  for (size_t i = 0; i < ranks.size(); ++i) {
+    const int64_t rank = ranks[i];
+    InlinedVector<float> lora_a(static_cast<size_t>(K * rank));
+    InlinedVector<float> lora_b(static_cast<size_t>(rank * N));
+    std::iota(lora_a.begin(), lora_a.end(), 100.f * (i + 1));
+    std::iota(lora_b.begin(), lora_b.end(), -100.f * (i + 1));
+
+    adapters::utils::AdapterFormatBuilder adapter_builder;
+    adapter_builder.AddParameter("lora_A", adapters::TensorDataType::FLOAT, std::array<int64_t, 2>{K, rank},
+                                 ReinterpretAsSpan<const uint8_t>(gsl::make_span(lora_a)));
+    adapter_builder.AddParameter("lora_B", adapters::TensorDataType::FLOAT, std::array<int64_t, 2>{rank, N},
+                                 ReinterpretAsSpan<const uint8_t>(gsl::make_span(lora_b)));
+    adapters[i].Load(adapter_builder.Finish(kAdapterVersion, kModelVersion));
+  }
+
+  const std::array<const lora::LoraAdapter*, 2> to_stack = {&adapters[0], &adapters[1]};
+  lora::LoraAdapter stacked;
+  stacked.Stack(to_stack);
+
+  ASSERT_EQ(2U, stacked.GetParamNum());
+  ASSERT_EQ(kModelVersion, stacked.ModelVersion());
+
+  auto [begin, end] = stacked.GetParamIterators();
+  for (; begin != end; ++begin) {
+    const auto& [name, param] = *begin;
+    const auto& tensor = param.GetDeviceOrMapped().Get<Tensor>();
+    const bool is_down = name == "lora_A";
+    const int64_t rows = is_down ? K : 3;
+    const int64_t cols = is_down ? 3 : N;
+    ASSERT_EQ(tensor.Shape(), TensorShape({2, rows, cols}));
+
+    const auto data = tensor.DataAsSpan<float>();
+    for (size_t i = 0; i < ranks.size(); ++i) {
+      const int64_t src_rows = is_down ? K : ranks[i];
+      const int64_t src_cols = is_down ? ranks[i] : N;
+      const float start = (is_down ? 100.f : -100.f) * (i + 1);
+      for (int64_t r = 0; r < rows; ++r) {
+        for (int64_t c = 0; c < cols; ++c) {
+          const float expected = (r < src_rows && c < src_cols) ? start + static_cast<float>(r * src_cols + c) : 0.f;
+          ASSERT_EQ(expected, data[static_cast<size_t>((static_cast<int64_t>(i) * rows + r) * cols + c)]) << name << " adapter " << i << " @" << r << "," << c;
+        }
+      }
+    }
+  }
+
+  // Parameters must match across the stacked adapters
+  adapters::utils::AdapterFormatBuilder adapter_builder;
+  InlinedVector<float> other(static_cast<size_t>(K * 2));
+  adapter_builder.AddParameter("other", adapters::TensorDataType::FLOAT, std::array<int64_t, 2>{K, 2},
+                               ReinterpretAsSpan<const uint8_t>(gsl::make_span(other)));
+  InlinedVector<float> mismatched_b(static_cast<size_t>(2 * N));
+  adapter_builder.AddParameter("lora_B", adapters::TensorDataType::FLOAT, std::array<int64_t, 2>{2, N},
+                               ReinterpretAsSpan<const uint8_t>(gsl::make_span(mismatched_b)));
+  lora::LoraAdapter mismatched;
+  mismatched.Load(adapter_builder.Finish(kAdapterVersion, kModelVersion));
+  const std::array<const lora::LoraAdapter*, 2> invalid = {&adapters[0], &mismatched};
+  lora::LoraAdapter failed;
+  ASSERT_THROW(failed.Stack(invalid), OnnxRuntimeException);
+
+  // Parameter data must cover the declared shape
+  adapters::utils::AdapterFormatBuilder truncated_builder;
+  InlinedVector<float> truncated_a(static_cast<size_t>(K * 2));
+  InlinedVector<float> truncated_b(static_cast<size_t>(N));
+  truncated_builder.AddParameter("lora_A", adapters::TensorDataType::FLOAT, std::array<int64_t, 2>{K, 2},
+                                 ReinterpretAsSpan<const uint8_t>(gsl::make_span(truncated_a)));
+  truncated_builder.AddParameter("lora_B", adapters::TensorDataType::FLOAT, std::array<int64_t, 2>{2, N},
+                                 ReinterpretAsSpan<const uint8_t>(gsl::make_span(truncated_b)));
+  lora::LoraAdapter truncated;
+  truncated.Load(truncated_builder.Finish(kAdapterVersion, kModelVersion));
+  const std::array<const lora::LoraAdapter*, 2> short_data = {&adapters[0], &truncated};
+  ASSERT_THROW(failed.Stack(short_data), OnnxRuntimeException);
+}
+
 #ifdef USE_CUDA
 TEST(LoraAdapterTest, VerifyDeviceCopy) {
   auto cpu_ep = DefaultCpuExecutionProvider();
@@ -52,3 +52,65 @@ BENCHMARK(BM_ConvertF32ToF16)
     });
 
 #endif  // defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
+
+//
+// Buffer conversions through the platform dispatch of MLAS, for all targets.
+//
+
+static void ConvertBufferArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"count"});
+  b->Arg(1 << 12)->Arg(1 << 18)->Arg(1 << 22);
+}
+
+void BM_ConvertHalfToFloatBuffer(benchmark::State& state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+  auto values = RandomVectorUniform(count, -30000.0f, 30000.0f);
+  auto src = std::vector<MLAS_FP16>(count);
+  MlasConvertFloatToHalfBuffer(values.data(), src.data(), count);
+  auto dst = std::vector<float>(count);
+
+  for (auto _ : state) {
+    MlasConvertHalfToFloatBuffer(src.data(), dst.data(), count);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * count * (sizeof(uint16_t) + sizeof(float))));
+}
+
+void BM_ConvertFloatToHalfBuffer(benchmark::State& state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+  auto src = RandomVectorUniform(count, -30000.0f, 30000.0f);
+  auto dst = std::vector<MLAS_FP16>(count);
+
+  for (auto _ : state) {
+    MlasConvertFloatToHalfBuffer(src.data(), dst.data(), count);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * count * (sizeof(uint16_t) + sizeof(float))));
+}
+
+void BM_ConvertBFloat16ToFloatBuffer(benchmark::State& state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+  auto values = RandomVectorUniform(count, -30000.0f, 30000.0f);
+  auto src = std::vector<uint16_t>(count);
+  MlasConvertFloatToBFloat16Buffer(values.data(), src.data(), count);
+  auto dst = std::vector<float>(count);
+
+  for (auto _ : state) {
+    MlasConvertBFloat16ToFloatBuffer(src.data(), dst.data(), count);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * count * (sizeof(uint16_t) + sizeof(float))));
+}
+
+void BM_ConvertFloatToBFloat16Buffer(benchmark::State& state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+  auto src = RandomVectorUniform(count, -30000.0f, 30000.0f);
+  auto dst = std::vector<uint16_t>(count);
+
+  for (auto _ : state) {
+    MlasConvertFloatToBFloat16Buffer(src.data(), dst.data(), count);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * count * (sizeof(uint16_t) + sizeof(float))));
+}
+
+BENCHMARK(BM_ConvertHalfToFloatBuffer)->UseRealTime()->Apply(ConvertBufferArgs);
+BENCHMARK(BM_ConvertFloatToHalfBuffer)->UseRealTime()->Apply(ConvertBufferArgs);
+BENCHMARK(BM_ConvertBFloat16ToFloatBuffer)->UseRealTime()->Apply(ConvertBufferArgs);
+BENCHMARK(BM_ConvertFloatToBFloat16Buffer)->UseRealTime()->Apply(ConvertBufferArgs);
@@ -38,8 +38,7 @@ static const std::vector<std::string>& ArgNamesForConv(size_t rank) {
   return rank_to_args_name[rank];
 }
 
-// dummy for some strange build error when using Bench capture
-void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
+static void RunSconvNchw(benchmark::State& state, bool pack_winograd_filter) {
   const int64_t rank = state.range(0);                       // Rank
   const int64_t batch_size = state.range(1);                 // N
   const int64_t groups = state.range(2);                     // G
@@ -116,6 +115,20 @@ void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
   auto F = RandomVectorUniform(f_shape, -1.0, 1.0);
   int64_t y_size = std::accumulate(y_shape.begin(), y_shape.end(), 1LL, std::multiplies<int64_t>());
   std::vector<float> Y(static_cast<size_t>(y_size));
+
+  // The filter of a Winograd convolution can be transformed once ahead of time instead of by every MlasConv.
+  std::vector<float> packed_filter;
+  if (pack_winograd_filter && Parameters.Algorithm == MlasConvAlgorithmWinograd) {
+    packed_filter.resize(MlasConvWinogradPackFilterSize(static_cast<size_t>(groups),
+                                                        static_cast<size_t>(output_channels_per_group),
+                                                        static_cast<size_t>(input_channels_per_group)));
+    MlasConvWinogradPackFilter(static_cast<size_t>(groups),
+                               static_cast<size_t>(output_channels_per_group),
+                               static_cast<size_t>(input_channels_per_group),
+                               F.data(),
+                               packed_filter.data());
+    MlasConvSetWinogradPackedFilter(&Parameters, packed_filter.data(), &WorkingBufferSize);
+  }
   std::vector<float> working_buffer(WorkingBufferSize);
 
   // warm up first round.
@@ -138,6 +151,15 @@ void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
   }
 }
 
+// dummy for some strange build error when using Bench capture
+void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
+  RunSconvNchw(state, false);
+}
+
+void SCONV_NCHW_PACKED(benchmark::State& state, const char* /*dummy*/) {
+  RunSconvNchw(state, true);
+}
+
 static void ResNet50(benchmark::internal::Benchmark* b) {
   b->ArgNames(ArgNamesForConv(2));
 
@@ -245,3 +267,21 @@ static void General_Conv2d(benchmark::internal::Benchmark* b) {
 }
 
 BENCHMARK_CAPTURE(SCONV_NCHW, 2d, "")->Apply(General_Conv2d)->UseRealTime();
+
+static void Winograd(benchmark::internal::Benchmark* b) {
+  b->ArgNames(ArgNamesForConv(2));
+
+  // The 3x3 convolutions with unit strides of VGG and ResNet backbones at small batch sizes.
+  //    Rank, N, G, Cpg, Fpg,   I,    , K, , P, , , , S, , D, ,
+  b->Args({2, 1, 1, 64, 64, 224, 224, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 1, 1, 128, 128, 112, 112, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 1, 1, 64, 64, 56, 56, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 4, 1, 64, 64, 56, 56, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 1, 1, 128, 128, 28, 28, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 1, 1, 256, 256, 14, 14, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 1, 1, 512, 512, 7, 7, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 1, 1, 24, 24, 24, 40, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+}
+
+BENCHMARK_CAPTURE(SCONV_NCHW, Winograd, "")->Apply(Winograd)->UseRealTime();
+BENCHMARK_CAPTURE(SCONV_NCHW_PACKED, Winograd, "")->Apply(Winograd)->UseRealTime();
@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <cmath>
+#include <limits>
+
+class MlasBFloat16CastTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferFloat;
+  MatrixGuardBuffer<float> BufferFloatOutput;
+  MatrixGuardBuffer<uint16_t> BufferBFloat16;
+
+  static uint16_t ReferenceFloatToBFloat16(float Value) {
+    uint32_t Bits;
+    memcpy(&Bits, &Value, sizeof(Bits));
+    if (std::isnan(Value)) {
+      return static_cast<uint16_t>((Bits >> 16) | 0x0040);
+    }
+    // Round to nearest even.
+    const uint32_t Lower = Bits & 0xFFFF;
+    uint32_t Upper = Bits >> 16;
+    if (Lower > 0x8000 || (Lower == 0x8000 && (Upper & 1) != 0)) {
+      Upper++;
+    }
+    return static_cast<uint16_t>(Upper);
+  }
+
+  void Test(size_t Count) {
+    float* Input = BufferFloat.GetBuffer(Count);
+    float* Output = BufferFloatOutput.GetBuffer(Count);
+    uint16_t* BFloat16 = BufferBFloat16.GetBuffer(Count);
+
+    const float Specials[] = {0.0f, -0.0f, 1.0f, -2.5f, 1.00390625f, 1.01171875f, 1.005859375f,
+                              std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(),
+                              std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                              std::numeric_limits<float>::quiet_NaN(), -std::numeric_limits<float>::quiet_NaN(),
+                              std::numeric_limits<float>::denorm_min()};
+    for (size_t i = 0; i < Count; i++) {
+      Input[i] = (i % 3 == 0) ? Specials[(i / 3) % std::size(Specials)]
+                              : static_cast<float>(static_cast<int>(i * 7919) % 20011 - 10005) / 7.0f;
+    }
+
+    MlasConvertFloatToBFloat16Buffer(Input, BFloat16, Count);
+    for (size_t i = 0; i < Count; i++) {
+      ASSERT_EQ(BFloat16[i], ReferenceFloatToBFloat16(Input[i])) << " @" << i << " of " << Count;
+    }
+
+    MlasConvertBFloat16ToFloatBuffer(BFloat16, Output, Count);
+    for (size_t i = 0; i < Count; i++) {
+      uint32_t Bits;
+      memcpy(&Bits, &Output[i], sizeof(Bits));
+      ASSERT_EQ(Bits, static_cast<uint32_t>(BFloat16[i]) << 16) << " @" << i << " of " << Count;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("CastBFloat16");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t Count = 1; Count <= 64; Count++) {
+      Test(Count);
+    }
+    Test(1000);
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasBFloat16CastTest>::RegisterShortExecute();
+  }
+  return count;
+});
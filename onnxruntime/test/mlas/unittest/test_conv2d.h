@@ -60,6 +60,17 @@ class MlasConv2DTest : public MlasTestBase {
                     0.0f,
                     threadpool_);
 
+    // The Winograd algorithm rounds differently than the GEMM of the reference convolution.
+    UsesWinograd = (Parameters.Algorithm == MlasConvAlgorithmWinograd);
+
+    // The threaded tests also cover the filter that is transformed ahead of time.
+    if (UsesWinograd && Threaded) {
+      float* PackedFilter = BufferPackedFilter.GetBuffer(
+          MlasConvWinogradPackFilterSize(GroupCount, FilterCount, InputChannels));
+      MlasConvWinogradPackFilter(GroupCount, FilterCount, InputChannels, Filter, PackedFilter);
+      MlasConvSetWinogradPackedFilter(&Parameters, PackedFilter, &WorkingBufferSize);
+    }
+
     MlasConv(&Parameters,
              Input,
              Filter,
@@ -154,9 +165,12 @@ class MlasConv2DTest : public MlasTestBase {
   MatrixGuardBuffer<float> BufferOutputReference;
   MatrixGuardBuffer<float> BufferWorking;
   MatrixGuardBuffer<float> BufferIm2Col;
+  MatrixGuardBuffer<float> BufferPackedFilter;
 
   MLAS_THREADPOOL* threadpool_;
 
+  bool UsesWinograd = false;
+
  public:
   static const char* GetTestSuiteName() {
     static const std::string suite_name(Threaded ? "Conv2d_Threaded" : "Conv2d_SingleThread");
@@ -215,6 +229,8 @@ class MlasConv2DTest : public MlasTestBase {
     float* Output = BufferOutput.GetBuffer(OutputElements);
     float* OutputReference = BufferOutputReference.GetBuffer(OutputElements);
 
+    UsesWinograd = false;
+
     MlasConv2D(BatchCount,
                GroupCount,
                InputChannels,
@@ -246,6 +262,21 @@ class MlasConv2DTest : public MlasTestBase {
                     Bias,
                     OutputReference);
 
+    if (UsesWinograd) {
+      for (size_t i = 0; i < OutputElements; i++) {
+        ASSERT_TRUE(CloseEnough(Output[i], OutputReference[i]))
+            << "@" << i << " of " << OutputElements << ", got: " << Output[i] << ", expecting: " << OutputReference[i]
+            << " B" << BatchCount << "/"
+            << "G" << GroupCount << "/"
+            << "Cpg" << InputChannels << "/"
+            << "Fpg" << FilterCount << "/"
+            << "H" << InputHeight << "/"
+            << "W" << InputWidth << "/"
+            << "Pad" << PaddingLeftHeight << "," << PaddingLeftWidth << "," << PaddingRightHeight << "," << PaddingRightWidth;
+      }
+      return;
+    }
+
     ASSERT_EQ(memcmp(Output, OutputReference, OutputElements * sizeof(float)), 0)
         << "B" << BatchCount << "/"
         << "G" << GroupCount << "/"
@@ -143,6 +143,15 @@ class Conv2dShortExecuteTest : public MlasTestFixture<Conv2dTester> {
     return test_registered;
   }
 
+  // Winograd convolutions with partial tiles, asymmetric padding and more filters than a filter block. These are
+  // only registered for the MlasConv tester, which compares Winograd outputs with a tolerance.
+  static size_t RegisterWinogradShortExecuteTests() {
+    size_t test_registered = 0;
+    test_registered += RegisterSingleTest(2, 2, 16, 13, 17, 24, 3, 3, 1, 0, 2, 1, 1, 1, 1, 1);
+    test_registered += RegisterSingleTest(1, 1, 40, 9, 30, 80, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+    return test_registered;
+  }
+
  private:
   size_t BatchCount_;
   size_t GroupCount_;
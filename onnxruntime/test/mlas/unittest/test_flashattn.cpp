@@ -0,0 +1,286 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+#include "test_fp16.h"
+
+#include <vector>
+
+struct FlashAttentionTestParams {
+  size_t BatchSize;
+  size_t NumHeads;
+  size_t KvNumHeads;
+  size_t QSequenceLength;
+  size_t KvBufferSequenceLength;
+  size_t HeadSize;
+  size_t QBlockSize;
+  size_t KvBlockSize;
+  bool Causal;
+  int LocalWindowSize;
+  bool Sparse;
+  float Softcap;
+  bool SmoothSoftmax;
+};
+
+template <bool Threaded>
+class MlasFlashAttentionTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferQuery;
+  MatrixGuardBuffer<float> BufferKey;
+  MatrixGuardBuffer<float> BufferValue;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  // Block sparse layout where each block row keeps the diagonal block, the
+  // first block and every other block, similar to a strided/dilated pattern.
+  static void BuildSparseLayout(size_t BlockCount, std::vector<int32_t>& RowIndices, std::vector<int32_t>& ColIndices) {
+    RowIndices.assign(1, 0);
+    ColIndices.clear();
+    for (size_t r = 0; r < BlockCount; r++) {
+      for (size_t c = 0; c <= r; c++) {
+        if (c == 0 || c == r || (r - c) % 2 == 0) {
+          ColIndices.push_back(static_cast<int32_t>(c));
+        }
+      }
+      RowIndices.push_back(static_cast<int32_t>(ColIndices.size()));
+    }
+  }
+
+  static bool IsVisible(const FlashAttentionTestParams& Params, const std::vector<int32_t>& RowIndices,
+                        const std::vector<int32_t>& ColIndices, size_t QPosition, size_t KvPosition) {
+    if (Params.Causal) {
+      if (KvPosition > QPosition) {
+        return false;
+      }
+      if (Params.LocalWindowSize > 0 && KvPosition + Params.LocalWindowSize < QPosition) {
+        return false;
+      }
+    }
+    if (Params.Sparse) {
+      size_t BlockRow = QPosition / Params.KvBlockSize;
+      int32_t BlockCol = static_cast<int32_t>(KvPosition / Params.KvBlockSize);
+      bool Found = false;
+      for (int32_t j = RowIndices[BlockRow]; j < RowIndices[BlockRow + 1]; j++) {
+        Found = Found || ColIndices[j] == BlockCol;
+      }
+      return Found;
+    }
+    return true;
+  }
+
+  void ReferenceAttention(const FlashAttentionTestParams& Params, const std::vector<int32_t>& ValidLengths,
+                          const std::vector<int32_t>& RowIndices, const std::vector<int32_t>& ColIndices,
+                          const float* Query, const float* Key, const float* Value, float* Output, float Scale) {
+    const size_t H = Params.HeadSize;
+    const size_t S = Params.QSequenceLength;
+    const size_t L = Params.KvBufferSequenceLength;
+    std::vector<float> Scores(L);
+
+    for (size_t b = 0; b < Params.BatchSize; b++) {
+      const size_t ValidLength = static_cast<size_t>(ValidLengths[b]);
+      const size_t PastLength = ValidLength > S ? ValidLength - S : 0;
+      for (size_t n = 0; n < Params.NumHeads; n++) {
+        const size_t KvHead = n / (Params.NumHeads / Params.KvNumHeads);
+        const float* K = Key + (b * Params.KvNumHeads + KvHead) * L * H;
+        const float* V = Value + (b * Params.KvNumHeads + KvHead) * L * H;
+        for (size_t s = 0; s < S; s++) {
+          const float* Q = Query + ((b * Params.NumHeads + n) * S + s) * H;
+          float* O = Output + ((b * S + s) * Params.NumHeads + n) * H;
+
+          float Max = Params.SmoothSoftmax ? 0.0f : std::numeric_limits<float>::lowest();
+          for (size_t t = 0; t < ValidLength; t++) {
+            if (!IsVisible(Params, RowIndices, ColIndices, PastLength + s, t)) {
+              continue;
+            }
+            float Dot = 0.0f;
+            for (size_t h = 0; h < H; h++) {
+              Dot += Q[h] * K[t * H + h];
+            }
+            Dot *= Scale;
+            if (Params.Softcap > 0.0f) {
+              Dot = Params.Softcap * std::tanh(Dot / Params.Softcap);
+            }
+            Scores[t] = Dot;
+            Max = std::max(Max, Dot);
+          }
+
+          double Sum = Params.SmoothSoftmax ? std::exp(-double(Max)) : 0.0;
+          for (size_t t = 0; t < ValidLength; t++) {
+            if (IsVisible(Params, RowIndices, ColIndices, PastLength + s, t)) {
+              Scores[t] = float(std::exp(double(Scores[t]) - double(Max)));
+              Sum += Scores[t];
+            } else {
+              Scores[t] = 0.0f;
+            }
+          }
+
+          for (size_t h = 0; h < H; h++) {
+            double Acc = 0.0;
+            for (size_t t = 0; t < ValidLength; t++) {
+              Acc += double(Scores[t]) * V[t * H + h];
+            }
+            O[h] = Sum > 0.0 ? float(Acc / Sum) : 0.0f;
+          }
+        }
+      }
+    }
+  }
+
+  void Test(const FlashAttentionTestParams& Params, bool Fp16) {
+    const size_t H = Params.HeadSize;
+    const size_t QElements = Params.BatchSize * Params.NumHeads * Params.QSequenceLength * H;
+    const size_t KvElements = Params.BatchSize * Params.KvNumHeads * Params.KvBufferSequenceLength * H;
+
+    float* Query = BufferQuery.GetBuffer(QElements);
+    float* Key = BufferKey.GetBuffer(KvElements);
+    float* Value = BufferValue.GetBuffer(KvElements);
+    float* Output = BufferOutput.GetBuffer(QElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(QElements);
+
+    std::default_random_engine generator(static_cast<unsigned>(QElements + KvElements));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    for (size_t i = 0; i < QElements; i++) {
+      Query[i] = distribution(generator);
+    }
+    for (size_t i = 0; i < KvElements; i++) {
+      Key[i] = distribution(generator);
+      Value[i] = distribution(generator);
+    }
+
+    // Round inputs to fp16 so that both paths see the same values.
+    std::vector<MLFp16> QueryFp16, KeyFp16, ValueFp16, OutputFp16;
+    if (Fp16) {
+      QueryFp16.resize(QElements);
+      KeyFp16.resize(KvElements);
+      ValueFp16.resize(KvElements);
+      OutputFp16.resize(QElements);
+      for (size_t i = 0; i < QElements; i++) {
+        QueryFp16[i] = MLFp16(Query[i]);
+        Query[i] = QueryFp16[i].ToFloat();
+      }
+      for (size_t i = 0; i < KvElements; i++) {
+        KeyFp16[i] = MLFp16(Key[i]);
+        Key[i] = KeyFp16[i].ToFloat();
+        ValueFp16[i] = MLFp16(Value[i]);
+        Value[i] = ValueFp16[i].ToFloat();
+      }
+    }
+
+    // Shorter valid key lengths for all but the first batch.
+    std::vector<int32_t> ValidLengths(Params.BatchSize);
+    for (size_t b = 0; b < Params.BatchSize; b++) {
+      size_t Length = Params.KvBufferSequenceLength - b * 3;
+      ValidLengths[b] = static_cast<int32_t>(std::max(Length, Params.QSequenceLength));
+    }
+
+    std::vector<int32_t> RowIndices, ColIndices;
+    if (Params.Sparse) {
+      BuildSparseLayout((Params.KvBufferSequenceLength + Params.KvBlockSize - 1) / Params.KvBlockSize,
+                        RowIndices, ColIndices);
+    }
+
+    const float Scale = 1.0f / std::sqrt(static_cast<float>(H));
+
+    MlasFlashAttentionThreadedArgs args;
+    args.batch_size = static_cast<int>(Params.BatchSize);
+    args.num_heads = static_cast<int>(Params.NumHeads);
+    args.q_sequence_length = static_cast<int>(Params.QSequenceLength);
+    args.kv_sequence_length = static_cast<int>(Params.KvBufferSequenceLength);
+    args.qk_head_size = static_cast<int>(H);
+    args.v_head_size = static_cast<int>(H);
+    args.q_block_size = static_cast<int>(Params.QBlockSize);
+    args.kv_block_size = static_cast<int>(Params.KvBlockSize);
+    args.scale = Scale;
+    args.thread_count = Threaded ? 4 : 1;
+    args.kv_num_heads = static_cast<int>(Params.KvNumHeads);
+    args.kv_buffer_sequence_length = static_cast<int>(Params.KvBufferSequenceLength);
+    args.kv_valid_lengths = ValidLengths.data();
+    args.causal = Params.Causal;
+    args.local_window_size = Params.LocalWindowSize;
+    args.softcap = Params.Softcap;
+    args.smooth_softmax = Params.SmoothSoftmax;
+    if (Params.Sparse) {
+      args.sparse_block_size = static_cast<int>(Params.KvBlockSize);
+      args.num_sparse_layout = 1;
+      args.sparse_stride_row_indices = static_cast<int>(RowIndices.size());
+      args.sparse_stride_col_indices = static_cast<int>(ColIndices.size());
+      args.sparse_block_row_indices = RowIndices.data();
+      args.sparse_block_col_indices = ColIndices.data();
+    }
+    if (Fp16) {
+      args.query_fp16 = reinterpret_cast<const MLAS_FP16*>(QueryFp16.data());
+      args.key_fp16 = reinterpret_cast<const MLAS_FP16*>(KeyFp16.data());
+      args.value_fp16 = reinterpret_cast<const MLAS_FP16*>(ValueFp16.data());
+      args.output_fp16 = reinterpret_cast<MLAS_FP16*>(OutputFp16.data());
+    } else {
+      args.query = Query;
+      args.key = Key;
+      args.value = Value;
+      args.output = Output;
+    }
+
+    args.buffer_size_per_thread = MlasFlashAttentionGetBufferSizePerThread(&args);
+    std::vector<float> Buffer(args.buffer_size_per_thread * args.thread_count / sizeof(float));
+    args.buffer = Buffer.data();
+
+    MlasFlashAttention(&args, threadpool_);
+
+    if (Fp16) {
+      for (size_t i = 0; i < QElements; i++) {
+        Output[i] = OutputFp16[i].ToFloat();
+      }
+    }
+
+    ReferenceAttention(Params, ValidLengths, RowIndices, ColIndices, Query, Key, Value, OutputReference, Scale);
+
+    const float Tolerance = Fp16 ? 2e-3f : 1e-5f;
+    for (size_t i = 0; i < QElements; i++) {
+      float diff = std::fabs(Output[i] - OutputReference[i]);
+      ASSERT_TRUE(diff <= Tolerance || diff <= std::fabs(OutputReference[i]) * Tolerance)
+          << "B:" << Params.BatchSize << " N:" << Params.NumHeads << " Nkv:" << Params.KvNumHeads
+          << " S:" << Params.QSequenceLength << " L:" << Params.KvBufferSequenceLength
+          << " causal:" << Params.Causal << " window:" << Params.LocalWindowSize << " sparse:" << Params.Sparse
+          << " fp16:" << Fp16 << " index " << i << ", got: " << Output[i] << ", expecting: " << OutputReference[i];
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "FlashAttention_Threaded" : "FlashAttention_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasFlashAttentionTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    static const FlashAttentionTestParams TestParams[] = {
+        // B, N, Nkv, S, L, H, Br, Bc, causal, window, sparse, softcap, smooth
+        {2, 4, 4, 37, 37, 32, 8, 16, false, -1, false, 0.0f, false},
+        {2, 4, 4, 37, 37, 32, 8, 16, true, -1, false, 0.0f, false},
+        {2, 6, 2, 1, 70, 64, 1, 16, true, -1, false, 0.0f, false},
+        {1, 6, 3, 5, 70, 64, 4, 32, true, -1, false, 0.0f, false},
+        {2, 4, 2, 48, 48, 32, 16, 16, true, 20, false, 0.0f, false},
+        {2, 4, 2, 3, 65, 32, 2, 8, true, 9, false, 30.0f, true},
+        {2, 4, 1, 64, 64, 16, 16, 16, true, -1, true, 0.0f, false},
+        {1, 4, 2, 1, 77, 16, 1, 16, true, -1, true, 0.0f, false},
+        {1, 2, 2, 29, 29, 48, 7, 11, true, -1, false, 50.0f, true},
+    };
+
+    for (const auto& Params : TestParams) {
+      Test(Params, false);
+      Test(Params, true);
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasFlashAttentionTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasFlashAttentionTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
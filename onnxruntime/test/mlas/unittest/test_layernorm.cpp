@@ -0,0 +1,228 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+#include "test_fp16.h"
+
+class MlasLayerNormTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferSkip;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferScale;
+  MatrixGuardBuffer<float> BufferShift;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferSkipOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<float> BufferSkipOutputReference;
+
+  static void ReferenceLayerNorm(const float* Input, const float* Skip, const float* Bias, const float* Scale,
+                                 const float* Shift, float* Output, float* SkipOutput, size_t N, float Epsilon,
+                                 bool Simplified, float* Mean, float* InvStdDev) {
+    double Sum = 0.0;
+    for (size_t n = 0; n < N; n++) {
+      float Value = Input[n] + (Skip ? Skip[n] : 0.0f) + (Bias ? Bias[n] : 0.0f);
+      SkipOutput[n] = Value;
+      Sum += Value;
+    }
+
+    double RowMean = Simplified ? 0.0 : Sum / N;
+    double SumSquare = 0.0;
+    for (size_t n = 0; n < N; n++) {
+      double Delta = SkipOutput[n] - RowMean;
+      SumSquare += Delta * Delta;
+    }
+
+    double RowInvStdDev = 1.0 / std::sqrt(SumSquare / N + Epsilon);
+    for (size_t n = 0; n < N; n++) {
+      double Value = (SkipOutput[n] - RowMean) * RowInvStdDev * Scale[n];
+      if (Shift != nullptr && !Simplified) {
+        Value += Shift[n];
+      }
+      Output[n] = float(Value);
+    }
+
+    *Mean = float(RowMean);
+    *InvStdDev = float(RowInvStdDev);
+  }
+
+  void Test(size_t N, float Offset, bool HasSkip, bool HasBias, bool HasShift, bool HasSkipOutput, bool Simplified) {
+    float* Input = BufferInput.GetBuffer(N);
+    float* Skip = BufferSkip.GetBuffer(N);
+    float* Bias = BufferBias.GetBuffer(N);
+    float* Scale = BufferScale.GetBuffer(N);
+    float* Shift = BufferShift.GetBuffer(N);
+    float* Output = BufferOutput.GetBuffer(N);
+    float* SkipOutput = BufferSkipOutput.GetBuffer(N);
+    float* OutputReference = BufferOutputReference.GetBuffer(N);
+    float* SkipOutputReference = BufferSkipOutputReference.GetBuffer(N);
+
+    std::default_random_engine generator(static_cast<unsigned>(N));
+    std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+
+    // A large common offset makes E[x^2] - E[x]^2 lose most of its precision.
+    for (size_t n = 0; n < N; n++) {
+      Input[n] = Offset + distribution(generator);
+      Skip[n] = distribution(generator);
+      Bias[n] = distribution(generator) * 0.1f;
+      Scale[n] = distribution(generator);
+      Shift[n] = distribution(generator);
+    }
+
+    constexpr float Epsilon = 1e-5f;
+    float Mean = 0.0f;
+    float InvStdDev = 0.0f;
+    float MeanReference;
+    float InvStdDevReference;
+
+    ReferenceLayerNorm(Input, HasSkip ? Skip : nullptr, HasBias ? Bias : nullptr, Scale, HasShift ? Shift : nullptr,
+                       OutputReference, SkipOutputReference, N, Epsilon, Simplified, &MeanReference,
+                       &InvStdDevReference);
+    MlasLayerNormalization<float>(Input, HasSkip ? Skip : nullptr, HasBias ? Bias : nullptr, Scale,
+                                  HasShift ? Shift : nullptr, Output, HasSkipOutput ? SkipOutput : nullptr, N,
+                                  Epsilon, Simplified, &Mean, &InvStdDev);
+
+    // The row itself is only representable to a few ulps of the offset.
+    const float AbsoluteTolerance = 1e-4f + Offset * 1e-6f;
+    const float RelativeTolerance = 1e-4f + Offset * 1e-6f;
+
+    for (size_t n = 0; n < N; n++) {
+      float diff = std::fabs(Output[n] - OutputReference[n]);
+      ASSERT_TRUE(diff <= AbsoluteTolerance || diff <= std::fabs(OutputReference[n]) * RelativeTolerance)
+          << "N=" << N << " Offset=" << Offset << " Simplified=" << Simplified << " @" << n
+          << ", got: " << Output[n] << ", expecting: " << OutputReference[n];
+      if (HasSkipOutput) {
+        ASSERT_EQ(SkipOutput[n], SkipOutputReference[n]) << "N=" << N << " @" << n;
+      }
+    }
+
+    if (!Simplified) {
+      ASSERT_NEAR(Mean, MeanReference, std::fabs(MeanReference) * 1e-5f + 1e-5f) << "N=" << N;
+    }
+    ASSERT_NEAR(InvStdDev, InvStdDevReference, InvStdDevReference * 1e-3f) << "N=" << N;
+  }
+
+  void TestFp16(size_t N, bool Simplified) {
+    float* Input = BufferInput.GetBuffer(N);
+    float* Skip = BufferSkip.GetBuffer(N);
+    float* Bias = BufferBias.GetBuffer(N);
+    float* Scale = BufferScale.GetBuffer(N);
+    float* Shift = BufferShift.GetBuffer(N);
+    float* OutputReference = BufferOutputReference.GetBuffer(N);
+    float* SkipOutputReference = BufferSkipOutputReference.GetBuffer(N);
+
+    std::default_random_engine generator(static_cast<unsigned>(N));
+    std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+
+    std::vector<MLFp16> InputFp16(N);
+    std::vector<MLFp16> SkipFp16(N);
+    std::vector<MLFp16> OutputFp16(N);
+    std::vector<MLFp16> SkipOutputFp16(N);
+
+    for (size_t n = 0; n < N; n++) {
+      InputFp16[n] = MLFp16(distribution(generator));
+      SkipFp16[n] = MLFp16(distribution(generator));
+      Input[n] = InputFp16[n].ToFloat();
+      Skip[n] = SkipFp16[n].ToFloat();
+      Bias[n] = distribution(generator) * 0.1f;
+      Scale[n] = distribution(generator);
+      Shift[n] = distribution(generator);
+    }
+
+    constexpr float Epsilon = 1e-5f;
+    float MeanReference;
+    float InvStdDevReference;
+
+    ReferenceLayerNorm(Input, Skip, Bias, Scale, Shift, OutputReference, SkipOutputReference, N, Epsilon, Simplified,
+                       &MeanReference, &InvStdDevReference);
+    MlasLayerNormalization<MLAS_FP16>(reinterpret_cast<const MLAS_FP16*>(InputFp16.data()),
+                                      reinterpret_cast<const MLAS_FP16*>(SkipFp16.data()), Bias, Scale, Shift,
+                                      reinterpret_cast<MLAS_FP16*>(OutputFp16.data()),
+                                      reinterpret_cast<MLAS_FP16*>(SkipOutputFp16.data()), N, Epsilon, Simplified,
+                                      nullptr, nullptr);
+
+    for (size_t n = 0; n < N; n++) {
+      float Output = OutputFp16[n].ToFloat();
+      ASSERT_NEAR(Output, OutputReference[n], std::fabs(OutputReference[n]) * 2e-3f + 2e-3f)
+          << "N=" << N << " Simplified=" << Simplified << " @" << n;
+      float SkipOutput = SkipOutputFp16[n].ToFloat();
+      ASSERT_NEAR(SkipOutput, SkipOutputReference[n], std::fabs(SkipOutputReference[n]) * 1e-3f)
+          << "N=" << N << " @" << n;
+    }
+  }
+
+  template <typename OutputType>
+  void TestQuantizeLinear(size_t N, bool Simplified) {
+    float* Input = BufferInput.GetBuffer(N);
+    float* Skip = BufferSkip.GetBuffer(N);
+    float* Scale = BufferScale.GetBuffer(N);
+    float* Shift = BufferShift.GetBuffer(N);
+    float* OutputReference = BufferOutputReference.GetBuffer(N);
+    float* SkipOutputReference = BufferSkipOutputReference.GetBuffer(N);
+
+    std::default_random_engine generator(static_cast<unsigned>(N));
+    std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+
+    for (size_t n = 0; n < N; n++) {
+      Input[n] = distribution(generator);
+      Skip[n] = distribution(generator);
+      Scale[n] = distribution(generator);
+      Shift[n] = distribution(generator);
+    }
+
+    constexpr float Epsilon = 1e-5f;
+    constexpr float OutputScale = 0.05f;
+    const OutputType ZeroPoint = std::is_signed<OutputType>::value ? OutputType(-3) : OutputType(128);
+    float MeanReference;
+    float InvStdDevReference;
+
+    ReferenceLayerNorm(Input, Skip, nullptr, Scale, Shift, OutputReference, SkipOutputReference, N, Epsilon,
+                       Simplified, &MeanReference, &InvStdDevReference);
+
+    std::vector<OutputType> Output(N);
+    MlasLayerNormalizationQuantizeLinear<OutputType>(Input, Skip, nullptr, Scale, Shift, Output.data(), nullptr, N,
+                                                     Epsilon, Simplified, OutputScale, ZeroPoint);
+
+    for (size_t n = 0; n < N; n++) {
+      float Quantized = std::nearbyintf(OutputReference[n] / OutputScale) + float(ZeroPoint);
+      Quantized = std::min(std::max(Quantized, float(std::numeric_limits<OutputType>::min())),
+                           float(std::numeric_limits<OutputType>::max()));
+      ASSERT_LE(std::fabs(float(Output[n]) - Quantized), 1.0f)
+          << "N=" << N << " Simplified=" << Simplified << " @" << n;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("LayerNorm");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t n = 1; n < 80; n++) {
+      for (int flags = 0; flags < 16; flags++) {
+        Test(n, 0.0f, flags & 1, flags & 2, flags & 4, flags & 8, false);
+        Test(n, 0.0f, flags & 1, flags & 2, flags & 4, flags & 8, true);
+      }
+    }
+
+    for (size_t n : {255, 768, 1000, 4096}) {
+      Test(n, 0.0f, true, true, true, true, false);
+      Test(n, 100.0f, true, true, true, true, false);
+      Test(n, 1000.0f, false, false, true, false, false);
+      Test(n, 0.0f, true, false, false, true, true);
+      TestFp16(n, false);
+      TestFp16(n, true);
+      TestQuantizeLinear<int8_t>(n, false);
+      TestQuantizeLinear<uint8_t>(n, true);
+    }
+
+    for (size_t n = 1; n < 40; n++) {
+      TestFp16(n, false);
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasLayerNormTest>::RegisterShortExecute() : 0;
+});
@@ -15,12 +15,12 @@ Abstract:
 
 --*/
 
-#if defined(__aarch64__) && defined(__linux__)
-
 #pragma once
 
 #include "test_util.h"
 
+#if defined(MLAS_SBGEMM_SUPPORTED)
+
 template <typename T>
 void SmallFloatFill(T* start, size_t size) {
   constexpr float MinimumFillValue = -11.0f;
@@ -43,6 +43,22 @@ float cosine_similarity(const float* A, const float* B, size_t Vector_Length) {
   return dot / (sqrt(denom_a) * sqrt(denom_b));
 }
 
+/**
+ * @brief Scalar emulation of the fp32 to bf16 conversion done by the kernels,
+ *        using round-to-nearest-even.
+ */
+float RoundToBfloat16(float Value) {
+  uint32_t bits;
+  std::memcpy(&bits, &Value, sizeof(bits));
+  if ((bits & 0x7fffffff) > 0x7f800000) {
+    return Value;  // NaN
+  }
+  bits += 0x7fff + ((bits >> 16) & 1);
+  bits &= 0xffff0000;
+  std::memcpy(&Value, &bits, sizeof(bits));
+  return Value;
+}
+
 /**
  * @brief Test class for bf16 precision GEMM
  * @tparam AType  Data type of A matrix, need to be float
@@ -137,7 +153,7 @@ class MlasSBGemmTest : public MlasTestBase {
               sum = float(Bias[n]);
             }
             for (size_t kk = 0; kk < std::min(KStride, K - k); kk++) {
-              float down(float(*b) * float(*a) + sum);
+              float down(RoundToBfloat16(float(*b)) * RoundToBfloat16(float(*a)) + sum);
               sum = float(down);
               b += N;
               a += 1;
@@ -278,4 +294,4 @@ class MlasSBGemmTest : public MlasTestBase {
   }
 };
 
-#endif  // defined(__aarch64__) && defined(__linux__)
+#endif  // defined(MLAS_SBGEMM_SUPPORTED)
@@ -0,0 +1,101 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasSparseGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  // Zeroes the rows of each panel of 16 columns of B, except for one in KeepEvery rows.
+  void MakeBlockSparse(float* B, CBLAS_TRANSPOSE TransB, size_t N, size_t K, size_t KeepEvery) {
+    for (size_t n = 0; n < N; n += 16) {
+      for (size_t k = 0; k < K; k++) {
+        if ((k + n / 16) % KeepEvery == 0) {
+          continue;
+        }
+        for (size_t nn = n; nn < std::min(N, n + 16); nn++) {
+          (TransB == CblasNoTrans ? B[k * N + nn] : B[nn * K + k]) = 0.0f;
+        }
+      }
+    }
+  }
+
+  void Test(CBLAS_TRANSPOSE TransB, size_t M, size_t N, size_t K, size_t KeepEvery, float alpha) {
+    const float* A = BufferA.GetBuffer(M * K);
+    float* B = BufferB.GetBuffer(N * K);
+    float* C = BufferC.GetBuffer(M * N, true);
+    float* CReference = BufferCReference.GetBuffer(M * N, true);
+
+    MakeBlockSparse(B, TransB, N, K, KeepEvery);
+    const size_t ldb = (TransB == CblasNoTrans) ? N : K;
+
+    const size_t PackedBSize = MlasSparseGemmPackBSize(TransB, N, K, B, ldb);
+    if (KeepEvery < 4) {
+      // Half of the rows of the panels are non-zero, which isn't sparse enough.
+      ASSERT_EQ(PackedBSize, size_t(0));
+      return;
+    }
+    ASSERT_GT(PackedBSize, size_t(0));
+
+    void* PackedB = BufferPackedB.GetBuffer(PackedBSize, true);
+    MlasSparseGemmPackB(TransB, N, K, B, ldb, PackedB);
+    MlasSparseGemm(M, N, K, alpha, A, K, PackedB, C, N, threadpool_);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        float sum = 0.0f;
+        for (size_t k = 0; k < K; k++) {
+          sum += A[m * K + k] * (TransB == CblasNoTrans ? B[k * N + n] : B[n * K + k]);
+        }
+        CReference[m * N + n] = alpha * sum;
+      }
+    }
+
+    for (size_t i = 0; i < M * N; i++) {
+      ASSERT_TRUE(CloseEnough(C[i], CReference[i]))
+          << " Diff @[" << i / N << ", " << i % N << "] " << C[i] << "/" << CReference[i]
+          << " TransB=" << TransB << " M=" << M << " N=" << N << " K=" << K << " KeepEvery=" << KeepEvery;
+    }
+  }
+
+ public:
+  MlasSparseGemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "SparseGemm_Threaded" : "SparseGemm_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (auto TransB : {CblasNoTrans, CblasTrans}) {
+      for (size_t M : {1, 2, 7, 65}) {
+        for (size_t N : {1, 15, 16, 40}) {
+          for (size_t K : {8, 32, 72}) {
+            for (size_t KeepEvery : {2, 4, 8}) {
+              Test(TransB, M, N, K, KeepEvery, 1.0f);
+            }
+          }
+        }
+      }
+    }
+    Test(CblasNoTrans, 9, 33, 64, 4, 0.5f);
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSparseGemmTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSparseGemmTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -16,16 +16,37 @@ class MlasTransposeTest : public MlasTestBase {
     ElementType* Output = BufferOutput.GetBuffer(M * N);
     ElementType* OutputReference = BufferOutputReference.GetBuffer(M * N);
 
-    MlasTranspose(Input, Output, M, N);
-    ReferenceTranspose(Input, OutputReference, M, N);
+    if constexpr (!std::is_same_v<ElementType, uint64_t>) {
+      MlasTranspose(Input, Output, M, N);
+      ReferenceTranspose(Input, OutputReference, M, N, N, M);
 
-    ASSERT_EQ(memcmp(Output, OutputReference, M * N * sizeof(ElementType)), 0) << " [" << M << "," << N << "]";
+      ASSERT_EQ(memcmp(Output, OutputReference, M * N * sizeof(ElementType)), 0) << " [" << M << "," << N << "]";
+    }
+  }
+
+  void
+  TestStrided(size_t M, size_t N) {
+    // Transpose a tile of a larger matrix, leaving the elements outside of the tile unchanged.
+    const size_t InputStride = N + 3;
+    const size_t OutputStride = M + 5;
+    ElementType* Input = BufferInput.GetBuffer(M * InputStride);
+    ElementType* Output = BufferOutput.GetBuffer(N * OutputStride);
+    ElementType* OutputReference = BufferOutputReference.GetBuffer(N * OutputStride);
+    std::fill_n(Output, N * OutputStride, ElementType(0x5A));
+    std::fill_n(OutputReference, N * OutputStride, ElementType(0x5A));
+
+    MlasTranspose(Input, Output, M, N, InputStride, OutputStride);
+    ReferenceTranspose(Input, OutputReference, M, N, InputStride, OutputStride);
+
+    ASSERT_EQ(memcmp(Output, OutputReference, N * OutputStride * sizeof(ElementType)), 0)
+        << " [" << M << "," << N << "] strided";
   }
 
-  void ReferenceTranspose(const ElementType* Input, ElementType* Output, size_t M, size_t N) {
+  void ReferenceTranspose(const ElementType* Input, ElementType* Output, size_t M, size_t N, size_t InputStride,
+                          size_t OutputStride) {
     for (size_t m = 0; m < M; m++) {
       for (size_t n = 0; n < N; n++) {
-        Output[n * M + m] = Input[m * N + n];
+        Output[n * OutputStride + m] = Input[m * InputStride + n];
       }
     }
   }
@@ -40,6 +61,7 @@ class MlasTransposeTest : public MlasTestBase {
     for (size_t m = 1; m <= 32; m++) {
       for (size_t n = 1; n <= 32; n++) {
         Test(m, n);
+        TestStrided(m, n);
       }
     }
   }
@@ -48,6 +70,7 @@ class MlasTransposeTest : public MlasTestBase {
 static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
   size_t count = 0;
   if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasTransposeTest<uint64_t>>::RegisterShortExecute();
     count += MlasDirectShortExecuteTests<MlasTransposeTest<uint32_t>>::RegisterShortExecute();
     count += MlasDirectShortExecuteTests<MlasTransposeTest<uint16_t>>::RegisterShortExecute();
     count += MlasDirectShortExecuteTests<MlasTransposeTest<uint8_t>>::RegisterShortExecute();
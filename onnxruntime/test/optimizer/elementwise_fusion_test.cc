@@ -0,0 +1,128 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+namespace {
+
+void RunElementwiseFusionTest(const std::function<void(ModelTestBuilder& helper)>& build_test_case,
+                              const std::function<void(InferenceSessionWrapper& session)>& check_graph) {
+  auto add_session_options = [](SessionOptions& session_options) {
+    ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsEnableElementwiseFusion, "1"));
+  };
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level3, 13, 1e-5, 1e-5,
+                    nullptr, add_session_options);
+}
+
+}  // namespace
+
+TEST(ElementwiseFusionTests, FuseSubgraph) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x_arg = builder.MakeInput<float>({2, 4, 8}, -2.f, 2.f);
+    auto* y_arg = builder.MakeInput<float>({2, 1, 8}, -2.f, 2.f);
+    auto* bias_arg = builder.MakeInitializer<float>({8}, -1.f, 1.f);
+    auto* scale_arg = builder.MakeScalarInitializer<float>(0.5f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* tanh_out = builder.MakeIntermediate();
+    auto* sub_out = builder.MakeIntermediate();
+    auto* exp_out = builder.MakeIntermediate();
+    auto* relu_out = builder.MakeOutput();
+    auto* div_out = builder.MakeOutput();
+    auto* transpose_out = builder.MakeOutput();
+
+    builder.AddNode("Add", {x_arg, bias_arg}, {add_out});
+    builder.AddNode("Mul", {add_out, scale_arg}, {mul_out});
+    builder.AddNode("Tanh", {mul_out}, {tanh_out});
+    builder.AddNode("Sub", {tanh_out, y_arg}, {sub_out});
+    builder.AddNode("Relu", {sub_out}, {relu_out});
+    builder.AddNode("Exp", {x_arg}, {exp_out});
+    builder.AddNode("Div", {exp_out, add_out}, {div_out});
+    // An intermediate value that is also used outside of the subgraph.
+    builder.AddNode("Transpose", {mul_out}, {transpose_out}).AddAttribute("perm", std::vector<int64_t>{2, 0, 1});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Tanh"], 0);
+    EXPECT_EQ(op_to_count["Sub"], 0);
+    EXPECT_EQ(op_to_count["Relu"], 0);
+    EXPECT_EQ(op_to_count["Exp"], 0);
+    EXPECT_EQ(op_to_count["Div"], 0);
+    EXPECT_EQ(op_to_count["Transpose"], 1);
+
+    for (const auto& node : session.GetGraph().Nodes()) {
+      if (node.OpType() == "FusedElementwise") {
+        EXPECT_EQ(node.InputDefs().size(), 4u);
+        EXPECT_EQ(node.OutputDefs().size(), 3u);
+      }
+    }
+  };
+
+  RunElementwiseFusionTest(build_test_case, check_graph);
+}
+
+TEST(ElementwiseFusionTests, NoFusionThroughOtherNode) {
+  // Abs and Add cannot be fused as Add also depends on Abs through Softmax.
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x_arg = builder.MakeInput<float>({3, 16}, -2.f, 2.f);
+    auto* abs_out = builder.MakeIntermediate();
+    auto* softmax_out = builder.MakeIntermediate();
+    auto* output = builder.MakeOutput();
+
+    builder.AddNode("Abs", {x_arg}, {abs_out});
+    builder.AddNode("Softmax", {abs_out}, {softmax_out});
+    builder.AddNode("Add", {abs_out, softmax_out}, {output});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 0);
+    EXPECT_EQ(op_to_count["Abs"], 1);
+    EXPECT_EQ(op_to_count["Add"], 1);
+  };
+
+  RunElementwiseFusionTest(build_test_case, check_graph);
+}
+
+TEST(ElementwiseFusionTests, NoFusionOfDifferentShapes) {
+  // The Add output has a different shape than the Sigmoid output, so they are not fused.
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x_arg = builder.MakeInput<float>({4, 1}, -2.f, 2.f);
+    auto* y_arg = builder.MakeInput<float>({4, 8}, -2.f, 2.f);
+    auto* sigmoid_out = builder.MakeIntermediate();
+    auto* output = builder.MakeOutput();
+
+    builder.AddNode("Sigmoid", {x_arg}, {sigmoid_out});
+    builder.AddNode("Add", {sigmoid_out, y_arg}, {output});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 0);
+    EXPECT_EQ(op_to_count["Sigmoid"], 1);
+    EXPECT_EQ(op_to_count["Add"], 1);
+  };
+
+  RunElementwiseFusionTest(build_test_case, check_graph);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
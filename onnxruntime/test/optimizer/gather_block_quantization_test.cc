@@ -0,0 +1,118 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+namespace {
+
+void RunGatherBlockQuantizationTest(const std::function<void(ModelTestBuilder& helper)>& build_test_case,
+                                    const std::function<void(InferenceSessionWrapper& session)>& check_graph,
+                                    const std::string& bits, const std::string& max_error, double tolerance) {
+  auto add_session_options = [&](SessionOptions& session_options) {
+    ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsGatherBlockQuantizeBits,
+                                                                   bits.c_str()));
+    ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsGatherBlockQuantizeMinElements,
+                                                                   "256"));
+    ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsGatherBlockQuantizeMaxError,
+                                                                   max_error.c_str()));
+  };
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2, 13, tolerance,
+                    0.0, nullptr, add_session_options);
+}
+
+// Two Gathers read the rows of one table.
+void BuildEmbeddingTable(ModelTestBuilder& builder) {
+  auto* table_arg = builder.MakeInitializer<float>({40, 48}, -1.f, 1.f);
+  auto* indices_arg = builder.MakeInput<int64_t>({2, 3}, {0, 39, 7, 7, -1, 12});
+  auto* other_indices_arg = builder.MakeInput<int64_t>({4}, {3, 1, 4, 1});
+  auto* gather_out = builder.MakeOutput();
+  auto* other_gather_out = builder.MakeOutput();
+
+  builder.AddNode("Gather", {table_arg, indices_arg}, {gather_out});
+  builder.AddNode("Gather", {table_arg, other_indices_arg}, {other_gather_out});
+}
+
+int CountTableInitializers(const Graph& graph) {
+  int count = 0;
+  for (const auto& [name, tensor_proto] : graph.GetAllInitializedTensors()) {
+    if (tensor_proto->data_type() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT && tensor_proto->dims_size() == 2 &&
+        tensor_proto->dims(1) == 48) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(GatherBlockQuantizationTests, QuantizeTableToInt8) {
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Gather"], 0);
+    EXPECT_EQ(op_to_count["com.microsoft.GatherBlockQuantized"], 2);
+    // The float table is released.
+    EXPECT_EQ(CountTableInitializers(session.GetGraph()), 0);
+  };
+
+  RunGatherBlockQuantizationTest(BuildEmbeddingTable, check_graph, "8", "0.01", 0.01);
+}
+
+TEST(GatherBlockQuantizationTests, QuantizeTableToInt4) {
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Gather"], 0);
+    EXPECT_EQ(op_to_count["com.microsoft.GatherBlockQuantized"], 2);
+  };
+
+  RunGatherBlockQuantizationTest(BuildEmbeddingTable, check_graph, "4", "0.2", 0.1);
+}
+
+TEST(GatherBlockQuantizationTests, ErrorExceedsBudget) {
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Gather"], 2);
+    EXPECT_EQ(op_to_count["com.microsoft.GatherBlockQuantized"], 0);
+  };
+
+  // Uniformly distributed values have a relative error of about 0.07 with 4 bits.
+  RunGatherBlockQuantizationTest(BuildEmbeddingTable, check_graph, "4", "0.01", 0.0);
+}
+
+TEST(GatherBlockQuantizationTests, TableUsedByOtherNode) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* table_arg = builder.MakeInitializer<float>({40, 48}, -1.f, 1.f);
+    auto* indices_arg = builder.MakeInput<int64_t>({3}, {0, 39, 7});
+    auto* input_arg = builder.MakeInput<float>({2, 40}, -1.f, 1.f);
+    auto* gather_out = builder.MakeOutput();
+    auto* matmul_out = builder.MakeOutput();
+
+    builder.AddNode("Gather", {table_arg, indices_arg}, {gather_out});
+    builder.AddNode("MatMul", {input_arg, table_arg}, {matmul_out});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Gather"], 1);
+    EXPECT_EQ(op_to_count["com.microsoft.GatherBlockQuantized"], 0);
+  };
+
+  RunGatherBlockQuantizationTest(build_test_case, check_graph, "8", "0.01", 0.0);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
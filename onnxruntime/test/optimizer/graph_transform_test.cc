@@ -7786,6 +7786,105 @@ TEST_F(GraphTransformationTests, GatherToSliceFusion) {
 
 #if !defined(DISABLE_CONTRIB_OPS)
 
+TEST_F(GraphTransformationTests, GatherReduceToEmbeddingBagFusion) {
+  auto pre_graph_checker = [&](Graph& graph) {
+    auto op_count_map = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_count_map["Gather"] == 1);
+    return Status::OK();
+  };
+
+  // OpSet-12, ReduceSum with the axes attribute.
+  {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* data_arg = builder.MakeInitializer<float>({16, 8}, -1.f, 1.f);
+      auto* indices_arg = builder.MakeInput<int64_t>({4, 3}, 0, 15);
+      auto* gather_output = builder.MakeIntermediate();
+      auto* reduce_output = builder.MakeOutput();
+
+      builder.AddNode("Gather", {data_arg, indices_arg}, {gather_output});
+      Node& reduce_node = builder.AddNode("ReduceSum", {gather_output}, {reduce_output});
+      reduce_node.AddAttribute("axes", std::vector<int64_t>{1});
+      reduce_node.AddAttribute("keepdims", static_cast<int64_t>(0));
+    };
+
+    auto post_graph_checker = [&](Graph& graph) {
+      auto op_count_map = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_count_map["Gather"] == 0);
+      TEST_RETURN_IF_NOT(op_count_map["ReduceSum"] == 0);
+      TEST_RETURN_IF_NOT(op_count_map["com.microsoft.EmbeddingBag"] == 1);
+      for (auto& node : graph.Nodes()) {
+        if (node.OpType() == "EmbeddingBag") {
+          TEST_RETURN_IF_NOT(node.GetAttributes().at("mode").s() == "sum");
+        }
+      }
+      return Status::OK();
+    };
+
+    std::unique_ptr<GraphTransformer> transformer = std::make_unique<GatherReduceToEmbeddingBagFusion>();
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 12, *logger_, std::move(transformer),
+                                          TransformerLevel::Level2, 1, pre_graph_checker, post_graph_checker));
+  }
+
+  // OpSet-18, ReduceMean with the axes input over the last axis of 3-D indices.
+  {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* data_arg = builder.MakeInitializer<float>({16, 8}, -1.f, 1.f);
+      auto* indices_arg = builder.MakeInput<int64_t>({2, 4, 3}, 0, 15);
+      auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {static_cast<int64_t>(-2)});
+      auto* gather_output = builder.MakeIntermediate();
+      auto* reduce_output = builder.MakeOutput();
+
+      builder.AddNode("Gather", {data_arg, indices_arg}, {gather_output});
+      builder.AddNode("ReduceMean", {gather_output, axes_arg}, {reduce_output})
+          .AddAttribute("keepdims", static_cast<int64_t>(0));
+    };
+
+    auto post_graph_checker = [&](Graph& graph) {
+      auto op_count_map = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_count_map["Gather"] == 0);
+      TEST_RETURN_IF_NOT(op_count_map["ReduceMean"] == 0);
+      TEST_RETURN_IF_NOT(op_count_map["com.microsoft.EmbeddingBag"] == 1);
+      for (auto& node : graph.Nodes()) {
+        if (node.OpType() == "EmbeddingBag") {
+          TEST_RETURN_IF_NOT(node.GetAttributes().at("mode").s() == "mean");
+        }
+      }
+      return Status::OK();
+    };
+
+    std::unique_ptr<GraphTransformer> transformer = std::make_unique<GatherReduceToEmbeddingBagFusion>();
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 18, *logger_, std::move(transformer),
+                                          TransformerLevel::Level2, 1, pre_graph_checker, post_graph_checker));
+  }
+
+  // Invalid cases: keepdims is not 0, or the reduction is not over the bags.
+  for (const bool keep_dims : {true, false}) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* data_arg = builder.MakeInitializer<float>({16, 8}, -1.f, 1.f);
+      auto* indices_arg = builder.MakeInput<int64_t>({4, 3}, 0, 15);
+      auto* gather_output = builder.MakeIntermediate();
+      auto* reduce_output = builder.MakeOutput();
+
+      builder.AddNode("Gather", {data_arg, indices_arg}, {gather_output});
+      Node& reduce_node = builder.AddNode("ReduceSum", {gather_output}, {reduce_output});
+      reduce_node.AddAttribute("axes", std::vector<int64_t>{keep_dims ? 1 : 2});
+      reduce_node.AddAttribute("keepdims", static_cast<int64_t>(keep_dims ? 1 : 0));
+    };
+
+    auto post_graph_checker = [&](Graph& graph) {
+      auto op_count_map = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_count_map["Gather"] == 1);
+      TEST_RETURN_IF_NOT(op_count_map["ReduceSum"] == 1);
+      TEST_RETURN_IF_NOT(op_count_map["com.microsoft.EmbeddingBag"] == 0);
+      return Status::OK();
+    };
+
+    std::unique_ptr<GraphTransformer> transformer = std::make_unique<GatherReduceToEmbeddingBagFusion>();
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 12, *logger_, std::move(transformer),
+                                          TransformerLevel::Level2, 1, pre_graph_checker, post_graph_checker));
+  }
+}
+
 TEST_F(GraphTransformationTests, MatMulNBitsBiasFusion) {
   struct TestOptions {
     bool bias_is_first_add_input{false};
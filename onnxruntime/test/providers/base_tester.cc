@@ -744,6 +744,12 @@ void BaseTester::RunWithConfig(size_t* number_of_pre_packed_weights_counter,
           std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
           if (provider_type == onnxruntime::kRocmExecutionProvider) {
             execution_providers.emplace_back(DefaultRocmExecutionProvider(/*test_tunable_op=*/true));
+          } else if (provider_type == onnxruntime::kCpuExecutionProvider) {
+            auto cpu_ep = DefaultCpuExecutionProvider();
+            if (auto* tuning_ctx = cpu_ep->GetTuningContext(); tuning_ctx != nullptr) {
+              tuning_ctx->EnableTunableOpAndTuning();
+              execution_providers.emplace_back(std::move(cpu_ep));
+            }
           }
 
           if (!execution_providers.empty()) {
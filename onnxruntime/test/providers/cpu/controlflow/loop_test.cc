@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include <future>
+#include <numeric>
 #include <thread>
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -1042,6 +1043,76 @@ TEST(Loop, IterationCountAsOutput) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
 
+// test enough iterations for the buffer of the scan outputs to grow, with one scan output written by a node and one
+// that is a subgraph input so has to be copied
+TEST(Loop, ScanOutputsWithManyIterations) {
+  auto create_subgraph = []() {
+    Model model("Many iterations subgraph", false, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    /* Inputs: iter_num, cond_in, loop carried state variables.
+
+         iter_num_in    cond_in     loop_var_0_in
+             |             |             |
+         [Identity]   [Identity]         |
+           /     \         |             |
+    loop_var_0_out \    cond_out    loop_out_1
+               loop_out_0
+    */
+
+    TypeProto int64_scalar;
+    int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto bool_scalar;
+    bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+    bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    // graph inputs
+    auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+    auto& loop_var_0_in = graph.GetOrCreateNodeArg("loop_var_0_in", &int64_scalar);
+
+    // graph outputs
+    auto& cond_out = graph.GetOrCreateNodeArg("cond_out", &bool_scalar);
+    auto& loop_var_0_out = graph.GetOrCreateNodeArg("loop_var_0_out", &int64_scalar);
+    auto& loop_out_0 = graph.GetOrCreateNodeArg("loop_out_0", &int64_scalar);
+
+    graph.AddNode("loop_var_out", "Identity", "Forward iter_num_in to loop_var_0_out", {&iter_num_in},
+                  {&loop_var_0_out});
+    graph.AddNode("loop_out", "Identity", "Forward iter_num_in to loop_out_0", {&iter_num_in}, {&loop_out_0});
+    graph.AddNode("cond_in_identity", "Identity", "Forward cond_in to cond_out", {&cond_in}, {&cond_out});
+
+    graph.SetInputs({&iter_num_in, &cond_in, &loop_var_0_in});
+    graph.SetOutputs({&cond_out, &loop_var_0_out, &loop_out_0, &loop_var_0_in});
+
+    auto status = graph.Resolve();
+    EXPECT_EQ(status, Status::OK());
+
+    return graph.ToGraphProto();
+  };
+
+  constexpr int64_t num_iterations = 40;
+  std::vector<int64_t> iter_nums(num_iterations);
+  std::iota(iter_nums.begin(), iter_nums.end(), 0);
+  std::vector<int64_t> loop_var_values(num_iterations);
+  std::iota(loop_var_values.begin(), loop_var_values.end(), -1);
+
+  OpTester test("Loop", 11);
+  auto body = create_subgraph();
+  test.AddAttribute<GraphProto>("body", body);
+  test.AddInput<int64_t>("M", {1}, {num_iterations});
+  test.AddInput<bool>("cond", {1}, {true});
+  test.AddInput<int64_t>("loop_var_0_orig", {1}, {-1});
+
+  test.AddOutput<int64_t>("loop_var_0_final", {1}, {num_iterations - 1});
+  test.AddOutput<int64_t>("loop_out_0_final", {num_iterations, 1}, iter_nums);
+  test.AddOutput<int64_t>("loop_out_1_final", {num_iterations, 1}, loop_var_values);
+
+  // Disable TensorRT on unsupported data type BOOL
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM)
 // test that when part of the subgraph run on CUDA/ROCm it executes successfully
 TEST(Loop, MixedExecutionProviders) {
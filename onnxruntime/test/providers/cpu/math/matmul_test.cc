@@ -430,6 +430,43 @@ TEST(MathOpTest, MatMulSharedPrepackedWeights) {
   }
 }
 
+
+// A B initializer with most of its rows zeroed is packed for the block sparse MLAS kernel.
+TEST(MathOpTest, MatMulBlockSparseInitializer) {
+  constexpr int64_t M = 3;
+  constexpr int64_t K = 32;
+  constexpr int64_t N = 20;
+
+  std::vector<float> a_values(M * K);
+  for (int64_t i = 0; i < M * K; ++i) {
+    a_values[i] = static_cast<float>(i % 7) - 3.0f;
+  }
+  std::vector<float> b_values(K * N, 0.0f);
+  for (int64_t k = 0; k < K; k += 8) {
+    for (int64_t n = 0; n < N; ++n) {
+      b_values[k * N + n] = static_cast<float>((k + n) % 5) - 2.0f;
+    }
+  }
+
+  std::vector<float> y_values(M * N, 0.0f);
+  for (int64_t m = 0; m < M; ++m) {
+    for (int64_t n = 0; n < N; ++n) {
+      for (int64_t k = 0; k < K; ++k) {
+        y_values[m * N + n] += a_values[m * K + k] * b_values[k * N + n];
+      }
+    }
+  }
+
+  OpTester test("MatMul");
+  test.AddInput<float>("A", {M, K}, a_values);
+  test.AddInput<float>("B", {K, N}, b_values, true);
+  test.AddOutput<float>("Y", {M, N}, y_values);
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.ConfigEps(std::move(execution_providers))
+      .RunWithConfig();
+}
+
 #endif
 
 }  // namespace test
@@ -43,5 +43,36 @@ TEST(CategoryMapper, IntToString) {
 
   RunTest(dims, input, output);
 }
+
+TEST(CategoryMapper, LargeVocabularyWithDuplicates) {
+  constexpr int64_t kCategories = 5000;
+  std::vector<std::string> categories;
+  std::vector<int64_t> indexes;
+  for (int64_t i = 0; i < kCategories; ++i) {
+    categories.push_back("category_" + std::to_string(i));
+    indexes.push_back(i);
+  }
+  // The last duplicate of a string wins.
+  categories.push_back("category_7");
+  indexes.push_back(kCategories);
+
+  std::vector<std::string> input;
+  std::vector<int64_t> output;
+  for (int64_t i = 0; i < 3 * kCategories; i += 3) {
+    input.push_back("category_" + std::to_string(i));
+    output.push_back(i == 7 ? kCategories : (i < kCategories ? i : -1));
+  }
+  input.push_back("category_7");
+  output.push_back(kCategories);
+
+  OpTester test("CategoryMapper", 1, onnxruntime::kMLDomain);
+  test.AddAttribute("cats_strings", categories);
+  test.AddAttribute("cats_int64s", indexes);
+  test.AddAttribute("default_string", "default");
+  test.AddAttribute<int64_t>("default_int64", -1);
+  test.AddInput<std::string>("X", {static_cast<int64_t>(input.size())}, input);
+  test.AddOutput<int64_t>("Y", {static_cast<int64_t>(output.size())}, output);
+  test.Run();
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <numeric>
+#include <random>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -263,5 +266,93 @@ TEST(MLOpTest, SVMClassifierLinear) {
   test.Run();
 }
 
+// Compares the GEMM based kernel evaluation and voting against a direct evaluation, for features uniformly
+// distributed in [offset - 2, offset + 2].
+static void TestMulticlassRBFManySupportVectors(float offset, float gamma) {
+  constexpr int64_t num_batches = 64;
+  constexpr int64_t num_features = 8;
+  const std::vector<int64_t> classes = {10, 20, 30};
+  const std::vector<int64_t> vectors_per_class = {20, 15, 25};
+  const int64_t class_count = static_cast<int64_t>(classes.size());
+  const int64_t vector_count = std::accumulate(vectors_per_class.begin(), vectors_per_class.end(), int64_t{0});
+
+  std::default_random_engine generator(17);
+  std::uniform_real_distribution<float> distribution(-2.f, 2.f);
+  auto random_values = [&](size_t count, float value_offset) {
+    std::vector<float> values(count);
+    for (auto& value : values) {
+      value = value_offset + distribution(generator);
+    }
+    return values;
+  };
+
+  const auto support_vectors = random_values(static_cast<size_t>(vector_count * num_features), offset);
+  const auto coefficients = random_values(static_cast<size_t>((class_count - 1) * vector_count), 0.f);
+  const auto rho = random_values(static_cast<size_t>(class_count * (class_count - 1) / 2), 0.f);
+  const auto X = random_values(static_cast<size_t>(num_batches * num_features), offset);
+
+  std::vector<int64_t> starting_vector;
+  for (int64_t i = 0, start = 0; i < class_count; ++i) {
+    starting_vector.push_back(start);
+    start += vectors_per_class[i];
+  }
+
+  std::vector<int64_t> predictions;
+  std::vector<float> scores;
+  for (int64_t n = 0; n < num_batches; ++n) {
+    std::vector<double> kernels(static_cast<size_t>(vector_count));
+    for (int64_t v = 0; v < vector_count; ++v) {
+      double distance = 0;
+      for (int64_t f = 0; f < num_features; ++f) {
+        const double delta = double(X[n * num_features + f]) - support_vectors[v * num_features + f];
+        distance += delta * delta;
+      }
+      kernels[v] = std::exp(-gamma * distance);
+    }
+
+    std::vector<int64_t> votes(static_cast<size_t>(class_count), 0);
+    size_t classifier = 0;
+    for (int64_t i = 0; i < class_count - 1; ++i) {
+      for (int64_t j = i + 1; j < class_count; ++j) {
+        double sum = rho[classifier++];
+        for (int64_t v = 0; v < vectors_per_class[i]; ++v) {
+          sum += coefficients[(j - 1) * vector_count + starting_vector[i] + v] * kernels[starting_vector[i] + v];
+        }
+        for (int64_t v = 0; v < vectors_per_class[j]; ++v) {
+          sum += coefficients[i * vector_count + starting_vector[j] + v] * kernels[starting_vector[j] + v];
+        }
+        scores.push_back(static_cast<float>(sum));
+        ++votes[sum > 0 ? i : j];
+      }
+    }
+    predictions.push_back(classes[std::max_element(votes.begin(), votes.end()) - votes.begin()]);
+  }
+
+  OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("vectors_per_class", vectors_per_class);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", std::vector<float>{gamma, 0.f, 3.f});
+  test.AddAttribute("classlabels_ints", classes);
+
+  test.AddInput<float>("X", {num_batches, num_features}, X);
+  test.AddOutput<int64_t>("Y", {num_batches}, predictions);
+  test.AddOutput<float>("Z", {num_batches, class_count * (class_count - 1) / 2}, scores);
+  test.SetOutputAbsErr("Z", 1e-4f);
+
+  test.Run();
+}
+
+TEST(MLOpTest, SVMClassifierMulticlassRBFManySupportVectors) {
+  TestMulticlassRBFManySupportVectors(0.f, 0.1f);
+}
+
+TEST(MLOpTest, SVMClassifierMulticlassRBFLargeNorms) {
+  // ||x||^2 + ||s||^2 is about 1e9 while ||x - s||^2 is about 20, the expansion must not lose the difference.
+  TestMulticlassRBFManySupportVectors(10000.f, 0.5f);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -3,6 +3,7 @@
 #include "core/graph/constants.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/providers/run_options_config_keys.h"
 
 using namespace std;
 namespace onnxruntime {
@@ -10,6 +11,14 @@ namespace test {
 
 namespace {
 
+const onnxruntime::RunOptions run_options = []() {
+  onnxruntime::RunOptions options{};
+  ORT_THROW_IF_ERROR(options.config_options.AddConfigEntry(kOpTesterRunOptionsConfigTestTunableOp, "true"));
+  return options;
+}();
+
+const constexpr auto run_with_tunable_op = &run_options;
+
 struct ConvOpAndTestAttributes {
   string auto_pad;
   vector<int64_t> dilations;
@@ -76,7 +85,7 @@ void TestConvOp(const ConvOpAndTestAttributes& attributes,
   // QNN SDK 2.10.0 has a bug that breaks support for dynamic bias inputs.
   excluded_providers.insert(kQnnExecutionProvider);
 
-  test.Run(expect_result, err_str, excluded_providers);
+  test.Run(expect_result, err_str, excluded_providers, run_with_tunable_op);
 }
 
 }  // namespace
@@ -992,5 +1001,49 @@ TEST(ConvTest, Conv_AutoPad_with_non_default_strides) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape, true);
 }
 
+// A 3x3 convolution with enough channels for the MLAS Winograd algorithm. The constant filter is transformed once
+// when the algorithm is first selected.
+TEST(ConvTest, Conv2D_Winograd_ConstantFilter) {
+  constexpr int64_t C = 16, M = 24, H = 9, W_size = 10;
+  vector<float> X(C * H * W_size);
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = static_cast<float>(static_cast<int>(i * 7 % 13) - 6) / 8.f;
+  }
+  vector<float> W(M * C * 3 * 3);
+  for (size_t i = 0; i < W.size(); ++i) {
+    W[i] = static_cast<float>(static_cast<int>(i * 5 % 11) - 5) / 16.f;
+  }
+
+  // The output has the size of the input with a padding of 1.
+  vector<float> Y(M * H * W_size);
+  for (int64_t m = 0; m < M; ++m) {
+    for (int64_t y = 0; y < H; ++y) {
+      for (int64_t x = 0; x < W_size; ++x) {
+        double sum = 0.0;
+        for (int64_t c = 0; c < C; ++c) {
+          for (int64_t ky = 0; ky < 3; ++ky) {
+            for (int64_t kx = 0; kx < 3; ++kx) {
+              const int64_t iy = y + ky - 1, ix = x + kx - 1;
+              if (iy >= 0 && iy < H && ix >= 0 && ix < W_size) {
+                sum += static_cast<double>(X[(c * H + iy) * W_size + ix]) * W[((m * C + c) * 3 + ky) * 3 + kx];
+              }
+            }
+          }
+        }
+        Y[(m * H + y) * W_size + x] = static_cast<float>(sum);
+      }
+    }
+  }
+
+  OpTester test("Conv", 11);
+  test.AddAttribute("kernel_shape", vector<int64_t>{3, 3});
+  test.AddAttribute("pads", vector<int64_t>{1, 1, 1, 1});
+  test.AddInput<float>("X", {1, C, H, W_size}, X);
+  test.AddInput<float>("W", {M, C, 3, 3}, W, true);
+  test.AddOutput<float>("Y", {1, M, H, W_size}, Y);
+  test.SetOutputTolerance(1e-4f);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
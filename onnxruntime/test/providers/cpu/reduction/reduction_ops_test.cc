@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <random>
 #include <cmath>
 #include <limits>
@@ -6014,6 +6015,86 @@ TEST(ReductionOpTest, ReduceSum_RKRK_keepdims) {
   test.Run();
 }
 
+// Rows longer than 2 * kFastReduceSplitBlockSize with fewer rows than threads
+// are split into partial reductions merged pairwise.
+TEST(ReductionOpTest, ReduceSum_KR_split) {
+  const int64_t n_rows = 3;
+  const int64_t n_cols = 40000;
+  std::vector<float> in_data(n_rows * n_cols);
+  for (size_t i = 0; i < in_data.size(); ++i)
+    in_data[i] = static_cast<float>(i % 17);
+  std::vector<float> expected(n_rows, 0.f);
+  for (int64_t i = 0; i < n_rows; ++i) {
+    for (int64_t j = 0; j < n_cols; ++j) {
+      expected[i] += in_data[i * n_cols + j];
+    }
+  }
+
+  OpTester test("ReduceSum");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", {n_rows, n_cols}, in_data);
+  test.AddOutput<float>("reduced", {n_rows}, expected);
+  test.Run();
+
+  OpTester test_all("ReduceSum");
+  test_all.AddAttribute("keepdims", (int64_t)0);
+  test_all.AddInput<float>("data", {n_rows, n_cols}, in_data);
+  test_all.AddOutput<float>("reduced", {}, {expected[0] + expected[1] + expected[2]});
+  test_all.Run();
+}
+
+TEST(ReductionOpTest, ReduceKR_split) {
+  const int64_t n_rows = 2;
+  const int64_t n_cols = 50000;
+  std::vector<float> in_data(n_rows * n_cols);
+  for (size_t i = 0; i < in_data.size(); ++i)
+    in_data[i] = 0.25f + static_cast<float>(i % 23) / 8.f;
+
+  for (const char* op : {"ReduceMax", "ReduceMin", "ReduceMean", "ReduceL1", "ReduceL2",
+                         "ReduceSumSquare", "ReduceLogSum", "ReduceLogSumExp"}) {
+    const std::string op_name(op);
+    std::vector<float> expected(n_rows);
+    for (int64_t i = 0; i < n_rows; ++i) {
+      const float* row = in_data.data() + i * n_cols;
+      double max_value = *std::max_element(row, row + n_cols);
+      double acc = op_name == "ReduceMin" ? row[0] : 0.0;
+      for (int64_t j = 0; j < n_cols; ++j) {
+        double v = row[j];
+        if (op_name == "ReduceMax") {
+          acc = std::max(acc, v);
+        } else if (op_name == "ReduceMin") {
+          acc = std::min(acc, v);
+        } else if (op_name == "ReduceL2" || op_name == "ReduceSumSquare") {
+          acc += v * v;
+        } else if (op_name == "ReduceLogSumExp") {
+          acc += std::exp(v - max_value);
+        } else {
+          acc += v;
+        }
+      }
+      if (op_name == "ReduceMean") {
+        acc /= static_cast<double>(n_cols);
+      } else if (op_name == "ReduceL2") {
+        acc = std::sqrt(acc);
+      } else if (op_name == "ReduceLogSum") {
+        acc = std::log(acc);
+      } else if (op_name == "ReduceLogSumExp") {
+        acc = std::log(acc) + max_value;
+      }
+      expected[i] = static_cast<float>(acc);
+    }
+
+    OpTester test(op);
+    test.AddAttribute("axes", std::vector<int64_t>{1});
+    test.AddAttribute("keepdims", (int64_t)1);
+    test.AddInput<float>("data", {n_rows, n_cols}, in_data);
+    test.AddOutput<float>("reduced", {n_rows, 1}, expected);
+    test.SetOutputRelErr("reduced", 1e-5f);
+    test.Run();
+  }
+}
+
 void test_empty_set(const std::string& op, int opset, bool axes_as_input, float empty_value) {
   OpTester test(op, opset);
   std::vector<int64_t> input_shape = {2, 0, 4};
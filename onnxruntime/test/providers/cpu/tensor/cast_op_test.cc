@@ -153,6 +153,44 @@ TEST(CastOpTest, NonStringTypes) {
       CastNonStringTester{});
 }
 
+// Large enough to be cast in parallel blocks, with a remainder that is not a multiple of the SIMD width.
+TEST(CastOpTest, LargeTensors) {
+  const std::vector<int64_t> shape{3, 33337};
+  const size_t size = 3 * 33337;
+  std::vector<float> float_input(size);
+  for (size_t i = 0; i < size; ++i) {
+    float_input[i] = static_cast<float>(static_cast<int>(i * 7919 % 20011) - 10005) / 7.0f;
+  }
+  float_input[0] = NAN;
+  float_input[1] = std::numeric_limits<float>::infinity();
+  float_input[2] = -std::numeric_limits<float>::max();
+
+  const auto float16_output = CastedValues<float, MLFloat16>(gsl::make_span(float_input));
+  TestCastOp(gsl::make_span(float_input), gsl::make_span(float16_output), shape);
+  const auto float16_to_float = CastedValues<MLFloat16, float>(gsl::make_span(float16_output));
+  TestCastOp(gsl::make_span(float16_output), gsl::make_span(float16_to_float), shape);
+
+  const auto bfloat16_output = CastedValues<float, BFloat16>(gsl::make_span(float_input));
+  TestCastOp(gsl::make_span(float_input), gsl::make_span(bfloat16_output), shape);
+  const auto bfloat16_to_float = CastedValues<BFloat16, float>(gsl::make_span(bfloat16_output));
+  TestCastOp(gsl::make_span(bfloat16_output), gsl::make_span(bfloat16_to_float), shape);
+
+  std::vector<float> finite_input(float_input.begin() + 3, float_input.end());
+  const std::vector<int64_t> finite_shape{static_cast<int64_t>(finite_input.size())};
+  const auto int32_output = CastedValues<float, int32_t>(gsl::make_span(finite_input));
+  TestCastOp(gsl::make_span(finite_input), gsl::make_span(int32_output), finite_shape);
+
+#if !defined(DISABLE_FLOAT8_TYPES)
+  std::vector<Float8E4M3FN> float8_output;
+  float8_output.reserve(size);
+  for (float value : float_input) {
+    float8_output.emplace_back(value, false);
+  }
+  TestCastOp<float, Float8E4M3FN>(gsl::make_span(float_input), gsl::make_span(float8_output), shape,
+                                  OpTester::ExpectResult::kExpectSuccess, "", 19, Saturate::False);
+#endif
+}
+
 TEST(CastOpTest, FromString) {
   const std::vector<int64_t> shape{2, 2, 2};
   const std::vector<std::string> string_data = {"-inf", "+INF", "0.9767611", "0.28280696",
@@ -769,6 +769,50 @@ TEST(TransposeOpTest, DoTransposeEltWise) {
   }
 }
 
+template <typename T>
+static void TiledTransposeTest(const std::vector<int64_t>& input_shape, const std::vector<int64_t>& perm) {
+  const size_t rank = input_shape.size();
+  std::vector<int64_t> input_strides(rank, 1);
+  for (size_t i = rank - 1; i > 0; --i) {
+    input_strides[i - 1] = input_strides[i] * input_shape[i];
+  }
+  std::vector<int64_t> expected_shape(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    expected_shape[i] = input_shape[perm[i]];
+  }
+
+  const int64_t size = TensorShape(input_shape).Size();
+  std::vector<T> input_vals(size);
+  for (int64_t i = 0; i < size; ++i) {
+    input_vals[i] = static_cast<T>(i % 101);
+  }
+  std::vector<T> expected_vals(size);
+  for (int64_t i = 0; i < size; ++i) {
+    int64_t remainder = i;
+    int64_t input_offset = 0;
+    for (size_t axis = rank; axis-- > 0;) {
+      input_offset += remainder % expected_shape[axis] * input_strides[perm[axis]];
+      remainder /= expected_shape[axis];
+    }
+    expected_vals[i] = input_vals[input_offset];
+  }
+
+  TransposeTest(input_shape, input_vals, &perm, expected_shape, expected_vals);
+}
+
+TEST(TransposeOpTest, TiledTranspose) {
+  // Larger than one tile in both dimensions of the 2D transposes, with partial tiles.
+  TiledTransposeTest<float>({3, 70, 130}, {0, 2, 1});
+  TiledTransposeTest<float>({70, 5, 130}, {2, 1, 0});
+  TiledTransposeTest<uint8_t>({2, 150, 3, 140}, {3, 0, 2, 1});
+  TiledTransposeTest<int16_t>({4, 3, 5, 2, 7}, {4, 2, 0, 3, 1});
+  TiledTransposeTest<double>({40, 1, 33, 3}, {3, 1, 2, 0});
+  // The innermost axis is not moved, so pairs of floats are transposed as 8 byte elements.
+  TiledTransposeTest<float>({3, 35, 40, 2}, {0, 2, 1, 3});
+  // The innermost axis is not moved and too large to be transposed as a single element.
+  TiledTransposeTest<float>({3, 5, 4, 6}, {1, 0, 2, 3});
+}
+
 #if USE_CUDA
 constexpr const char* kGpuExecutionProvider = kCudaExecutionProvider;
 #elif USE_ROCM
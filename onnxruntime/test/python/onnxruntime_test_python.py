@@ -707,6 +707,25 @@ class TestInferenceSession(unittest.TestCase):
         output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
         np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
 
+    def test_run_model_with_output_buffers(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=available_providers)
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        y = np.zeros((3, 2), dtype=np.float32)
+        res = sess.run_with_output_buffers(["Y"], {"X": x}, [y])
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        # the output is written into the given array, which is returned
+        self.assertIs(res[0], y)
+        np.testing.assert_allclose(output_expected, y, rtol=1e-05, atol=1e-08)
+
+        # ORT allocates the outputs without a buffer
+        res = sess.run_with_output_buffers(["Y"], {"X": x}, [None])
+        np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+
+        with self.assertRaises(Exception):
+            sess.run_with_output_buffers(["Y"], {"X": x}, [np.zeros((2, 3), dtype=np.float32).T])
+        with self.assertRaises(Exception):
+            sess.run_with_output_buffers(["Y"], {"X": x}, [np.zeros((3, 3), dtype=np.float32)])
+
     def test_run_async(self):
         event = threading.Event()
         output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
@@ -738,6 +757,21 @@ class TestInferenceSession(unittest.TestCase):
         event.wait(10)  # timeout in 10 sec
         self.assertTrue(event.is_set())
 
+    def test_run_batch(self):
+        so = onnxrt.SessionOptions()
+        so.intra_op_num_threads = 2
+
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), so, providers=available_providers)
+        xs = [np.full((3, 2), i, dtype=np.float32) for i in range(8)]
+        res = sess.run_batch(["Y"], ["X"], [(x,) for x in xs])
+        self.assertEqual(len(res), len(xs))
+        for x, outputs in zip(xs, res):
+            self.assertEqual(len(outputs), 1)
+            np.testing.assert_allclose(x * x, outputs[0], rtol=1e-05, atol=1e-08)
+
+        with self.assertRaises(Exception):
+            sess.run_batch(["Y"], ["X"], [(xs[0], xs[1])])
+
     def test_run_model_from_bytes(self):
         with open(get_name("mul_1.onnx"), "rb") as f:
             content = f.read()
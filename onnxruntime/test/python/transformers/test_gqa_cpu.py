@@ -1896,6 +1896,161 @@ def parity_check_gqa_past_no_buff(
     return all_close
 
 
+def create_group_query_attention_graph_kv_cache_type(config, cache_type, share_buffer=True):
+    # Token generation graph whose past/present KV are stored in cache_type, which may differ from ORT_TYPE.
+    quantized = cache_type == TensorProto.INT8
+    present_kv_seqlen = (
+        config.kv_sequence_length if share_buffer else config.kv_sequence_length + config.sequence_length
+    )
+    nodes = [
+        helper.make_node(
+            "GroupQueryAttention",
+            [
+                "query",
+                "key",
+                "value",
+                "past_key",
+                "past_value",
+                "seqlens_k",
+                "total_sequence_length",
+                "",
+                "",
+                "k_scale" if quantized else "",
+                "v_scale" if quantized else "",
+            ],
+            ["output", "present_key", "present_value"],
+            "GroupQueryAttention_0",
+            num_heads=config.num_heads,
+            kv_num_heads=config.kv_num_heads,
+            domain="com.microsoft",
+        ),
+    ]
+
+    head_size = config.head_size
+    past_shape = [config.batch_size, config.kv_num_heads, config.kv_sequence_length, head_size]
+    present_shape = [config.batch_size, config.kv_num_heads, present_kv_seqlen, head_size]
+    graph_input = [
+        helper.make_tensor_value_info(
+            "query", ORT_TYPE, [config.batch_size, config.sequence_length, config.num_heads * head_size]
+        ),
+        helper.make_tensor_value_info(
+            "key", ORT_TYPE, [config.batch_size, config.sequence_length, config.kv_num_heads * head_size]
+        ),
+        helper.make_tensor_value_info(
+            "value", ORT_TYPE, [config.batch_size, config.sequence_length, config.kv_num_heads * head_size]
+        ),
+        helper.make_tensor_value_info("past_key", cache_type, past_shape),
+        helper.make_tensor_value_info("past_value", cache_type, past_shape),
+        helper.make_tensor_value_info("seqlens_k", TensorProto.INT32, [config.batch_size]),
+        helper.make_tensor_value_info("total_sequence_length", TensorProto.INT32, [1]),
+    ]
+    if quantized:
+        graph_input += [
+            helper.make_tensor_value_info("k_scale", TensorProto.FLOAT, [config.kv_num_heads]),
+            helper.make_tensor_value_info("v_scale", TensorProto.FLOAT, [config.kv_num_heads]),
+        ]
+
+    graph_output = [
+        helper.make_tensor_value_info(
+            "output", ORT_TYPE, [config.batch_size, config.sequence_length, config.num_heads * head_size]
+        ),
+        helper.make_tensor_value_info("present_key", cache_type, present_shape),
+        helper.make_tensor_value_info("present_value", cache_type, present_shape),
+    ]
+
+    graph = helper.make_graph(nodes, "GroupQueryAttention_Graph", graph_input, graph_output)
+    model = helper.make_model(graph)
+    return model.SerializeToString()
+
+
+def parity_check_gqa_kv_cache_type(config, cache_type, share_buffer=True, rtol=1e-2, atol=1e-2):
+    # Compare a GQA run with a narrow KV cache to the same run with a KV cache of the activation type.
+    numpy.random.seed(0)
+    head_size = config.head_size
+    past_seqlen = config.past_sequence_length
+    q = numpy.random.uniform(-1, 1, (config.batch_size, config.sequence_length, config.num_heads * head_size))
+    k = numpy.random.uniform(-1, 1, (config.batch_size, config.sequence_length, config.kv_num_heads * head_size))
+    v = numpy.random.uniform(-1, 1, (config.batch_size, config.sequence_length, config.kv_num_heads * head_size))
+    past_shape = (config.batch_size, config.kv_num_heads, config.kv_sequence_length, head_size)
+    past_k = numpy.zeros(past_shape)
+    past_v = numpy.zeros(past_shape)
+    past_k[:, :, :past_seqlen, :] = numpy.random.uniform(-1, 1, past_k[:, :, :past_seqlen, :].shape)
+    past_v[:, :, :past_seqlen, :] = numpy.random.uniform(-1, 1, past_v[:, :, :past_seqlen, :].shape)
+
+    # Per head symmetric scales for the int8 cache.
+    k_scale = numpy.full((config.kv_num_heads,), 1.0 / 127.0, dtype=numpy.float32)
+    v_scale = numpy.full((config.kv_num_heads,), 1.0 / 127.0, dtype=numpy.float32)
+    if cache_type == TensorProto.INT8:
+        past_k = numpy.clip(numpy.round(past_k / k_scale[None, :, None, None]), -127, 127)
+        past_v = numpy.clip(numpy.round(past_v / v_scale[None, :, None, None]), -127, 127)
+        past_k_ref = past_k * k_scale[None, :, None, None]
+        past_v_ref = past_v * v_scale[None, :, None, None]
+        cache_numpy_type = numpy.int8
+    else:
+        past_k_ref = past_k.astype(numpy.float16).astype(numpy.float32)
+        past_v_ref = past_v.astype(numpy.float16).astype(numpy.float32)
+        cache_numpy_type = numpy.float16
+
+    seqlens_k = numpy.full((config.batch_size,), past_seqlen + config.sequence_length - 1, dtype=numpy.int32)
+    total_seqlen = numpy.array([past_seqlen + config.sequence_length], dtype=numpy.int32)
+
+    def run(model, past_key, past_value, extra_inputs):
+        ort_inputs = {
+            "query": q.astype(NUMPY_TYPE),
+            "key": k.astype(NUMPY_TYPE),
+            "value": v.astype(NUMPY_TYPE),
+            "past_key": past_key,
+            "past_value": past_value,
+            "seqlens_k": seqlens_k,
+            "total_sequence_length": total_seqlen,
+        }
+        ort_inputs.update(extra_inputs)
+        sess = InferenceSession(model, SessionOptions(), providers=["CPUExecutionProvider"])
+        return sess.run(None, ort_inputs)
+
+    ref_model = create_group_query_attention_graph_kv_cache_type(config, ORT_TYPE, share_buffer)
+    out_ref, present_k_ref, _ = run(ref_model, past_k_ref.astype(NUMPY_TYPE), past_v_ref.astype(NUMPY_TYPE), {})
+
+    model = create_group_query_attention_graph_kv_cache_type(config, cache_type, share_buffer)
+    extra_inputs = {"k_scale": k_scale, "v_scale": v_scale} if cache_type == TensorProto.INT8 else {}
+    out, present_k, _ = run(model, past_k.astype(cache_numpy_type), past_v.astype(cache_numpy_type), extra_inputs)
+
+    if cache_type == TensorProto.INT8:
+        present_k = present_k.astype(numpy.float32) * k_scale[None, :, None, None]
+        cache_atol = k_scale.max()
+    else:
+        cache_atol = 1e-3
+
+    total = past_seqlen + config.sequence_length
+    cache_close = numpy.allclose(
+        present_k[:, :, :total, :].astype(numpy.float32),
+        present_k_ref[:, :, :total, :].astype(numpy.float32),
+        rtol=0,
+        atol=cache_atol,
+    )
+    out_close = numpy.allclose(out.astype(numpy.float32), out_ref.astype(numpy.float32), rtol=rtol, atol=atol)
+    print(
+        "KV cache type:",
+        cache_type,
+        " B:",
+        config.batch_size,
+        " S:",
+        config.sequence_length,
+        " Past:",
+        past_seqlen,
+        " N:",
+        config.num_heads,
+        " kvN:",
+        config.kv_num_heads,
+        " h:",
+        head_size,
+        " Share Buffer:",
+        share_buffer,
+        f" {GREEN}Passed{RESET}" if cache_close and out_close else f" {RED}Failed{RESET}",
+    )
+    return cache_close and out_close
+
+
 class TestGQA(unittest.TestCase):
     def test_gqa_no_past(self):
         torch.manual_seed(69)
@@ -2069,6 +2224,17 @@ class TestGQA(unittest.TestCase):
                                     )
                                     self.assertTrue(all_close)
 
+    def test_gqa_kv_cache_type(self):
+        print("-------- TEST GQA KV CACHE TYPE ---------")
+        cache_types = [TensorProto.INT8] if ORT_TYPE == TensorProto.FLOAT16 else [TensorProto.FLOAT16, TensorProto.INT8]
+        for cache_type in cache_types:
+            for b, s, s2, sp in [(1, 1, 128, 37), (2, 1, 64, 63), (1, 5, 64, 16)]:
+                for n, n2 in [(6, 6), (9, 3)]:
+                    for share_buffer in [True, False]:
+                        config = Config(b, s, s2, sp, n, n2, 64)
+                        all_close = parity_check_gqa_kv_cache_type(config, cache_type, share_buffer=share_buffer)
+                        self.assertTrue(all_close)
+
 
 if __name__ == "__main__":
     unittest.main()
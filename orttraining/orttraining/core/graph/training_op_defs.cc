@@ -1634,6 +1634,12 @@ void RegisterTrainingOpSchemas() {
           "    Computation is aligned with Huggingface AdamW.",
           AttributeProto::INT,
           static_cast<int64_t>(0))
+      .Attr(
+          "max_norm",
+          "If positive, the gradients are clipped by their global L2 norm to this value before the weights are "
+          "updated. The gradients themselves are not modified. 0 (the default) disables clipping.",
+          AttributeProto::FLOAT,
+          0.f)
       .TypeConstraint(
           "T1",
           {"tensor(float)"},
@@ -1652,8 +1658,8 @@ void RegisterTrainingOpSchemas() {
           "Constrain gradients' types.")
       .TypeConstraint(
           "S_MOMENT",
-          {"seq(tensor(float16))", "seq(tensor(float))", "seq(tensor(double))"},
-          "Constrain momentums' types.")
+          {"seq(tensor(float16))", "seq(tensor(float))", "seq(tensor(double))", "seq(tensor(bfloat16))"},
+          "Constrain momentums' types. bfloat16 momentums halve the memory of the optimizer state.")
       .TypeConstraint(
           "T_BOOL",
           {"tensor(bool)"},
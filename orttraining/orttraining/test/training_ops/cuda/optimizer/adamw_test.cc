@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 
 #include "gtest/gtest.h"
@@ -361,6 +363,148 @@ TEST(AdamWTest, HFAdamWMultipleWeightsStrictTest_Loop10Steps) {
   HFAdamWMultipleWeightsTestLoop10Steps(true);
 }
 
+// Computes the expected values of one step of torch AdamW (adam_mode 0) with the gradients scaled by
+// gradient_scale. The momentums are rounded with round_momentum after they are updated.
+template <typename RoundFn>
+void ReferenceTorchAdamWStep(float lr, int64_t step, float weight_decay, float gradient_scale,
+                             std::vector<float>& weight, const std::vector<float>& gradient,
+                             std::vector<float>& momentum_1, std::vector<float>& momentum_2, RoundFn round_momentum) {
+  const float alpha = 0.9f, beta = 0.999f, epsilon = 1e-8f;
+  const float alpha_correction = 1.f - static_cast<float>(std::pow(alpha, step));
+  const float beta_correction = 1.f - static_cast<float>(std::pow(beta, step));
+  for (size_t i = 0; i < weight.size(); ++i) {
+    const float g = gradient[i] * gradient_scale;
+    const float w = weight[i] - weight[i] * lr * weight_decay;
+    const float m1 = alpha * momentum_1[i] + (1.f - alpha) * g;
+    const float m2 = beta * momentum_2[i] + (1.f - beta) * g * g;
+    weight[i] = w - (lr * m1) / (alpha_correction * (std::sqrt(m2 / beta_correction) + epsilon));
+    momentum_1[i] = round_momentum(m1);
+    momentum_2[i] = round_momentum(m2);
+  }
+}
+
+std::vector<float> MakeValues(size_t size, float scale, float offset) {
+  std::vector<float> values(size);
+  for (size_t i = 0; i < size; ++i) {
+    values[i] = offset + scale * static_cast<float>(static_cast<int>(i * 37 % 101) - 50) / 50.f;
+  }
+  return values;
+}
+
+TEST(AdamWTest, FusedClipGradNorm_CPU) {
+  const float lr = 1e-3f, weight_decay = 1e-2f, max_norm = 1.f;
+  const int64_t step = 3;
+  // The second tensor spans several chunks of the multi-tensor update.
+  const std::vector<VectorInt64> shapes{{2, 3}, {130, 300}};
+
+  OpTester test("AdamWOptimizer", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("weight_decay", weight_decay);
+  test.AddAttribute("max_norm", max_norm);
+
+  SeqTensors<float> weights, gradients, momentums_1, momentums_2;
+  SeqTensors<float> updated_weights, updated_momentums_1, updated_momentums_2;
+  std::vector<std::vector<float>> gradient_values;
+  double sum_of_squares = 0.0;
+  for (size_t t = 0; t < shapes.size(); ++t) {
+    const size_t size = static_cast<size_t>(TensorShape(shapes[t]).Size());
+    gradient_values.push_back(MakeValues(size, 0.5f, 0.1f * t));
+    for (float g : gradient_values.back()) {
+      sum_of_squares += static_cast<double>(g) * g;
+    }
+  }
+  const float gradient_scale =
+      std::min(max_norm / (static_cast<float>(std::sqrt(sum_of_squares)) + 0.000001f), 1.f);
+  ASSERT_LT(gradient_scale, 1.f);
+
+  for (size_t t = 0; t < shapes.size(); ++t) {
+    const size_t size = gradient_values[t].size();
+    std::vector<float> weight = MakeValues(size, 1.f, 0.f);
+    std::vector<float> momentum_1 = MakeValues(size, 0.01f, 0.f);
+    std::vector<float> momentum_2 = MakeValues(size, 0.001f, 0.002f);
+    weights.AddTensor(shapes[t], weight);
+    gradients.AddTensor(shapes[t], gradient_values[t]);
+    momentums_1.AddTensor(shapes[t], momentum_1);
+    momentums_2.AddTensor(shapes[t], momentum_2);
+
+    ReferenceTorchAdamWStep(lr, step, weight_decay, gradient_scale, weight, gradient_values[t], momentum_1,
+                            momentum_2, [](float value) { return value; });
+    updated_weights.AddTensor(shapes[t], weight);
+    updated_momentums_1.AddTensor(shapes[t], momentum_1);
+    updated_momentums_2.AddTensor(shapes[t], momentum_2);
+  }
+
+  test.AddInput<float>("lr", {}, {lr});
+  test.AddInput<int64_t>("step", {}, {step});
+  test.AddSeqInput("weights", weights);
+  test.AddSeqInput("gradients", gradients);
+  test.AddSeqInput("momentums_1", momentums_1);
+  test.AddSeqInput("momentums_2", momentums_2);
+  test.AddOutput<bool>("updated_flag", {}, {1});
+  test.AddSeqOutput("updated_weights", updated_weights, 1e-4f, 1e-6f);
+  test.AddSeqOutput("updated_momentums_1", updated_momentums_1, 1e-4f, 1e-7f);
+  test.AddSeqOutput("updated_momentums_2", updated_momentums_2, 1e-4f, 1e-9f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.emplace_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(AdamWTest, BFloat16Momentums_CPU) {
+  const float lr = 1e-3f, weight_decay = 1e-2f;
+  const int64_t step = 5;
+  const std::vector<VectorInt64> shapes{{7}, {201, 100}};
+
+  OpTester test("AdamWOptimizer", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("weight_decay", weight_decay);
+
+  const auto to_bfloat16 = [](const std::vector<float>& values) {
+    std::vector<BFloat16> result;
+    result.reserve(values.size());
+    for (float value : values) {
+      result.push_back(BFloat16(value));
+    }
+    return result;
+  };
+  const auto round_to_bfloat16 = [](float value) { return BFloat16(value).ToFloat(); };
+
+  SeqTensors<float> weights, gradients, updated_weights;
+  SeqTensors<BFloat16> momentums_1, momentums_2, updated_momentums_1, updated_momentums_2;
+  for (size_t t = 0; t < shapes.size(); ++t) {
+    const size_t size = static_cast<size_t>(TensorShape(shapes[t]).Size());
+    std::vector<float> weight = MakeValues(size, 1.f, 0.f);
+    std::vector<float> gradient = MakeValues(size, 0.1f, 0.01f);
+    std::vector<float> momentum_1 = MakeValues(size, 0.01f, 0.f);
+    std::vector<float> momentum_2 = MakeValues(size, 0.001f, 0.002f);
+    std::transform(momentum_1.begin(), momentum_1.end(), momentum_1.begin(), round_to_bfloat16);
+    std::transform(momentum_2.begin(), momentum_2.end(), momentum_2.begin(), round_to_bfloat16);
+    weights.AddTensor(shapes[t], weight);
+    gradients.AddTensor(shapes[t], gradient);
+    momentums_1.AddTensor(shapes[t], to_bfloat16(momentum_1));
+    momentums_2.AddTensor(shapes[t], to_bfloat16(momentum_2));
+
+    ReferenceTorchAdamWStep(lr, step, weight_decay, 1.f, weight, gradient, momentum_1, momentum_2,
+                            round_to_bfloat16);
+    updated_weights.AddTensor(shapes[t], weight);
+    updated_momentums_1.AddTensor(shapes[t], to_bfloat16(momentum_1));
+    updated_momentums_2.AddTensor(shapes[t], to_bfloat16(momentum_2));
+  }
+
+  test.AddInput<float>("lr", {}, {lr});
+  test.AddInput<int64_t>("step", {}, {step});
+  test.AddSeqInput("weights", weights);
+  test.AddSeqInput("gradients", gradients);
+  test.AddSeqInput("momentums_1", momentums_1);
+  test.AddSeqInput("momentums_2", momentums_2);
+  test.AddOutput<bool>("updated_flag", {}, {1});
+  test.AddSeqOutput("updated_weights", updated_weights, 1e-4f, 1e-6f);
+  test.AddSeqOutput("updated_momentums_1", updated_momentums_1);
+  test.AddSeqOutput("updated_momentums_2", updated_momentums_2);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.emplace_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 }  // namespace
 
 }  // namespace optimizer
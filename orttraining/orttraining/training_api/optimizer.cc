@@ -58,6 +58,28 @@ Status GraphInputsAreExpected(gsl::span<const std::string> actual_graph_inputs,
   return Status::OK();
 }
 
+// Returns the element type of the tensors in a sequence input of the optimizer graph, or nullptr if it is not known.
+// For example, the momentums may be stored in bfloat16 instead of the element type of the parameters.
+MLDataType GetSequenceInputElementType(const InferenceSession& session, const std::string& input_name) {
+  const auto [status, input_defs] = session.GetModelInputs();
+  if (!status.IsOK() || input_defs == nullptr) {
+    return nullptr;
+  }
+  for (const NodeArg* input_def : *input_defs) {
+    if (input_def->Name() != input_name) {
+      continue;
+    }
+    const ONNX_NAMESPACE::TypeProto* type = input_def->TypeAsProto();
+    if (type == nullptr || !type->has_sequence_type() || !type->sequence_type().elem_type().has_tensor_type() ||
+        !type->sequence_type().elem_type().tensor_type().has_elem_type()) {
+      return nullptr;
+    }
+    return DataTypeImpl::TensorTypeFromONNXEnum(type->sequence_type().elem_type().tensor_type().elem_type())
+        ->GetElementType();
+  }
+  return nullptr;
+}
+
 }  // namespace
 
 std::unique_ptr<OptimizerAlgorithmBase> OptimizerAlorithmFactory::CreateInstance(
@@ -102,15 +124,27 @@ Status Optimizer::GenerateMomentumNamedStates(OptimizerCheckpointState& optimize
 
   auto& param_named_optimizer_states = optimizer_state_->param_named_optimizer_states;
   auto& optim_sess_state = optim_sess_->GetSessionState();
+
+  // The momentums are created with the element type of the optimizer graph inputs, so that a graph with bfloat16
+  // momentums halves the memory of the optimizer state.
+  const auto& momentum_keys = optimizer_algo_ptr_->momentum_keys;
+  InlinedVector<MLDataType> momentum_element_types;
+  for (size_t m_index = 0; m_index < momentum_keys.size(); ++m_index) {
+    momentum_element_types.push_back(
+        GetSequenceInputElementType(*optim_sess_, optimizer_algo_ptr_->optimizer_states_inputs[m_index]));
+  }
+
   for (auto& pair : state_->module_checkpoint_state.named_parameters) {
     if (pair.second->RequiresGrad()) {
       param_named_optimizer_states.insert({pair.first, ParameterOptimizerState()});
       ParameterOptimizerState& cur_param_optimizer_states = param_named_optimizer_states[pair.first];
-      for (auto& state_name : optimizer_algo_ptr_->momentum_keys) {
+      for (size_t m_index = 0; m_index < momentum_keys.size(); ++m_index) {
         OrtValue param_state;
-        ORT_ENFORCE(utils::CreateZeroValuedOrtValueLike(optim_sess_state, pair.second->Data(), param_state).IsOK(),
+        ORT_ENFORCE(utils::CreateZeroValuedOrtValueLike(optim_sess_state, pair.second->Data(), param_state,
+                                                        momentum_element_types[m_index])
+                        .IsOK(),
                     "Error generating moment state for ", pair.first);
-        cur_param_optimizer_states.insert({state_name, std::move(param_state)});
+        cur_param_optimizer_states.insert({momentum_keys[m_index], std::move(param_state)});
       }
     }
   }
@@ -58,8 +58,10 @@ bool GetParamNameFromSuffix(const std::string& name, const std::string& suffix,
 // returns True if suffix is present in name else False
 bool GetParamNameFromGradient(const std::string& grad_name, std::string& param_name);
 
-// Allocate OrtValue like the input ortvalue on the same device
-Status CreateZeroValuedOrtValueLike(const SessionState& sess_state, const OrtValue& input_val, OrtValue& output_val);
+// Allocate OrtValue like the input ortvalue on the same device. If element_type is given, it is used instead of the
+// element type of the input.
+Status CreateZeroValuedOrtValueLike(const SessionState& sess_state, const OrtValue& input_val, OrtValue& output_val,
+                                    MLDataType element_type = nullptr);
 
 // Create OrtValue from a single value of type T
 template <typename T>
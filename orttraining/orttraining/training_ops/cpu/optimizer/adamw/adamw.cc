@@ -1,10 +1,14 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
+
 #include "orttraining/training_ops/cpu/optimizer/adamw/adamw.h"
 #include "orttraining/training_ops/cpu/optimizer/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/TensorSeq.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
@@ -31,6 +35,8 @@ Status AdamWOptimizerBase::PrepareForCompute(OpKernelContext* ctx, AdamWOptimize
   ORT_RETURN_IF_NOT(prepare.num_of_weights == num_of_gradients, "Number of weights and gradients mismatch.");
   ORT_RETURN_IF_NOT(num_of_gradients == num_of_momentums_1, "Number of gradients and momentums_1 mismatch.");
   ORT_RETURN_IF_NOT(num_of_momentums_1 == num_of_momentums_2, "Number of momentums_1 and momentums_2 mismatch.");
+  ORT_RETURN_IF_NOT(prepare.momentums_1->DataType() == prepare.momentums_2->DataType(),
+                    "Element types of momentums_1 and momentums_2 mismatch.");
 
   prepare.grouped_tensor_sizes.resize(prepare.num_of_weights);
   prepare.grouped_tensor_pointers.resize(prepare.num_of_weights);
@@ -60,8 +66,8 @@ Status AdamWOptimizerBase::PrepareForCompute(OpKernelContext* ctx, AdamWOptimize
           prepare.grouped_tensor_pointers[i] = {
               const_cast<float*>(weight_tensor.Data<float>()),
               const_cast<float*>(gradient_tensor.Data<float>()),
-              const_cast<float*>(momentum_1_tensor.Data<float>()),
-              const_cast<float*>(momentum_2_tensor.Data<float>())};
+              const_cast<void*>(momentum_1_tensor.DataRaw()),
+              const_cast<void*>(momentum_2_tensor.DataRaw())};
         }
       });
 
@@ -73,6 +79,126 @@ Status AdamWOptimizerBase::PrepareForCompute(OpKernelContext* ctx, AdamWOptimize
   return Status::OK();
 }
 
+namespace {
+
+// The number of elements of a tensor that are updated by one task. The tensors are split into chunks so that all of
+// them are updated in a single parallel sweep, however their sizes are distributed.
+constexpr size_t kChunkSize = 16 * 1024;
+
+// The number of bfloat16 momentums that are converted to float on the stack at a time.
+constexpr size_t kBFloat16BlockSize = 256;
+
+// Matches the epsilon used by InplaceClipGradNorm.
+constexpr float kClipNormEpsilon = 0.000001f;
+
+struct Chunk {
+  size_t tensor_index;
+  size_t offset;
+  size_t size;
+};
+
+InlinedVector<Chunk> SplitIntoChunks(gsl::span<const int> tensor_sizes) {
+  InlinedVector<Chunk> chunks;
+  for (size_t i = 0; i < tensor_sizes.size(); ++i) {
+    const auto tensor_size = static_cast<size_t>(tensor_sizes[i]);
+    for (size_t offset = 0; offset < tensor_size; offset += kChunkSize) {
+      chunks.push_back({i, offset, std::min(kChunkSize, tensor_size - offset)});
+    }
+  }
+  return chunks;
+}
+
+// Returns the L2 norm of all gradients. The sum of squares of every chunk is stored and the sums are added in order,
+// so that the norm does not depend on the number of threads.
+float GetGradientNorm(concurrency::ThreadPool* tp, gsl::span<const Chunk> chunks,
+                      const std::vector<std::vector<void*>>& tensor_pointers) {
+  std::vector<double> sums(chunks.size());
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(chunks.size()),
+      TensorOpCost{static_cast<double>(kChunkSize * sizeof(float)), 0.0, static_cast<double>(kChunkSize * 2)},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t c = begin; c != end; ++c) {
+          const Chunk& chunk = chunks[c];
+          const float* gradient = static_cast<const float*>(tensor_pointers[chunk.tensor_index][1]) + chunk.offset;
+          double sum = 0.0;
+          for (size_t i = 0; i < chunk.size; ++i) {
+            sum += static_cast<double>(gradient[i]) * gradient[i];
+          }
+          sums[c] = sum;
+        }
+      });
+
+  double total = 0.0;
+  for (double sum : sums) {
+    total += sum;
+  }
+  return static_cast<float>(std::sqrt(total));
+}
+
+struct AdamWParameters {
+  int64_t adam_mode;
+  float alpha;
+  float beta;
+  float epsilon;
+  float weight_decay;
+  float lr;
+  float alpha_correction;
+  float beta_correction;
+  float lr_corrected;
+  // The scale applied to the gradients to clip their norm.
+  float gradient_scale;
+};
+
+// Updates the momentums and the weights, reading and writing each element once.
+void AdamWUpdateElements(const AdamWParameters& params, float* weight, const float* gradient, float* momentum_1,
+                         float* momentum_2, size_t count) {
+  const float alpha = params.alpha;
+  const float beta = params.beta;
+  if (params.adam_mode == 0) {
+    for (size_t i = 0; i < count; ++i) {
+      const float g = gradient[i] * params.gradient_scale;
+      float w = weight[i];
+      w = w - w * params.lr * params.weight_decay;
+      const float m1 = alpha * momentum_1[i] + (1.f - alpha) * g;
+      const float m2 = beta * momentum_2[i] + (1.f - beta) * g * g;
+      const float denom = std::sqrt(m2 / params.beta_correction) + params.epsilon;
+      weight[i] = w - (params.lr * m1) / (params.alpha_correction * denom);
+      momentum_1[i] = m1;
+      momentum_2[i] = m2;
+    }
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      const float g = gradient[i] * params.gradient_scale;
+      const float m1 = alpha * momentum_1[i] + (1.f - alpha) * g;
+      const float m2 = beta * momentum_2[i] + (1.f - beta) * g * g;
+      const float denom = std::sqrt(m2) + params.epsilon;
+      float w = weight[i] - params.lr_corrected * m1 / denom;
+      weight[i] = w - params.lr * params.weight_decay * w;
+      momentum_1[i] = m1;
+      momentum_2[i] = m2;
+    }
+  }
+}
+
+// The momentums are stored in bfloat16 to halve the memory of the optimizer state, and are updated in float.
+void AdamWUpdateElements(const AdamWParameters& params, float* weight, const float* gradient, BFloat16* momentum_1,
+                         BFloat16* momentum_2, size_t count) {
+  float m1[kBFloat16BlockSize];
+  float m2[kBFloat16BlockSize];
+  for (size_t offset = 0; offset < count; offset += kBFloat16BlockSize) {
+    const size_t block_size = std::min(kBFloat16BlockSize, count - offset);
+    auto* momentum_1_bits = reinterpret_cast<uint16_t*>(momentum_1 + offset);
+    auto* momentum_2_bits = reinterpret_cast<uint16_t*>(momentum_2 + offset);
+    MlasConvertBFloat16ToFloatBuffer(momentum_1_bits, m1, block_size);
+    MlasConvertBFloat16ToFloatBuffer(momentum_2_bits, m2, block_size);
+    AdamWUpdateElements(params, weight + offset, gradient + offset, m1, m2, block_size);
+    MlasConvertFloatToBFloat16Buffer(m1, momentum_1_bits, block_size);
+    MlasConvertFloatToBFloat16Buffer(m2, momentum_2_bits, block_size);
+  }
+}
+
+}  // namespace
+
 ONNX_OPERATOR_KERNEL_EX(
     AdamWOptimizer,
     kMSDomain,
@@ -90,46 +216,34 @@ ONNX_OPERATOR_KERNEL_EX(
     AdamWOptimizer<float>);
 
 template <typename T>
-Status AdamWOptimizer<T>::AdamWComputeMode0(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2,
-                                            float lr, float alpha_correction, float beta_correction) const {
-  // Perform weight decay.
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) - (MakeEigenArrayMap<T>(weight) * lr * weight_decay_);
-
-  // Compute exponentially-averaged historical gradient.
-  MakeEigenArrayMap<T>(momentums_1) = alpha_ * MakeEigenArrayMap<T>(momentums_1) +
-                                      (1.f - alpha_) * MakeEigenArrayMap<T>(gradient);
-
-  // Compute exponentially-averaged historical squared gradient.
-  MakeEigenArrayMap<T>(momentums_2) = beta_ * MakeEigenArrayMap<T>(momentums_2) +
-                                      (1.f - beta_) * MakeEigenArrayMap<T>(gradient) * MakeEigenArrayMap<T>(gradient);
-
-  // Compute the new weight.
-  auto denom = (MakeEigenArrayMap<T>(momentums_2) / beta_correction).sqrt() + epsilon_;
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) -
-                                 (lr * MakeEigenArrayMap<T>(momentums_1)) / (alpha_correction * denom);
-
-  return Status::OK();
-}
-
-template <typename T>
-Status AdamWOptimizer<T>::AdamWComputeMode1(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2,
-                                            float lr, float lr_corrected) const {
-  // Compute exponentially-averaged historical gradient.
-  MakeEigenArrayMap<T>(momentums_1) = alpha_ * MakeEigenArrayMap<T>(momentums_1) +
-                                      (1.f - alpha_) * MakeEigenArrayMap<T>(gradient);
-
-  // Compute exponentially-averaged historical squared gradient.
-  MakeEigenArrayMap<T>(momentums_2) = beta_ * MakeEigenArrayMap<T>(momentums_2) +
-                                      (1.f - beta_) * MakeEigenArrayMap<T>(gradient) * MakeEigenArrayMap<T>(gradient);
-
-  auto denom = MakeEigenArrayMap<T>(momentums_2).sqrt() + epsilon_;
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) -
-                                 (lr_corrected * MakeEigenArrayMap<T>(momentums_1) / denom);
-
-  // Perform weight decay.
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) - (lr * weight_decay_ * MakeEigenArrayMap<T>(weight));
+template <typename TMomentum>
+void AdamWOptimizer<T>::AdamWUpdate(const AdamWOptimizerBase::Prepare& p, concurrency::ThreadPool* tp, float lr,
+                                    float alpha_correction, float beta_correction, float lr_corrected) const {
+  const InlinedVector<Chunk> chunks = SplitIntoChunks(p.grouped_tensor_sizes);
+
+  AdamWParameters params{adam_mode_, alpha_, beta_, epsilon_, weight_decay_, lr, alpha_correction, beta_correction,
+                         lr_corrected, 1.f};
+  if (max_norm_ > 0.f) {
+    // The gradients are scaled while the weights are updated, instead of being clipped in place beforehand.
+    const float total_norm = GetGradientNorm(tp, chunks, p.grouped_tensor_pointers);
+    params.gradient_scale = std::min(max_norm_ / (total_norm + kClipNormEpsilon), 1.f);
+  }
 
-  return Status::OK();
+  const double chunk_size = static_cast<double>(kChunkSize);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(chunks.size()),
+      TensorOpCost{(2 * sizeof(float) + 2 * sizeof(TMomentum)) * chunk_size,
+                   (sizeof(float) + 2 * sizeof(TMomentum)) * chunk_size, 16.0 * chunk_size},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t c = begin; c != end; ++c) {
+          const Chunk& chunk = chunks[c];
+          const std::vector<void*>& pointers = p.grouped_tensor_pointers[chunk.tensor_index];
+          AdamWUpdateElements(params, static_cast<float*>(pointers[0]) + chunk.offset,
+                              static_cast<const float*>(pointers[1]) + chunk.offset,
+                              static_cast<TMomentum*>(pointers[2]) + chunk.offset,
+                              static_cast<TMomentum*>(pointers[3]) + chunk.offset, chunk.size);
+        }
+      });
 }
 
 template <typename T>
@@ -165,21 +279,15 @@ Status AdamWOptimizer<T>::Compute(OpKernelContext* ctx) const {
     //         bias correction is applied on learning rate, then use lr_corrected for subsequent computations.
     //         weight decay is applied after weight is updated.
 
-    for (size_t weight_index = 0; weight_index < p.num_of_weights; ++weight_index) {
-      Tensor& weight = const_cast<Tensor&>(p.weights->Get(weight_index));
-      Tensor& gradient = const_cast<Tensor&>(p.gradients->Get(weight_index));
-      Tensor& momentums_1 = const_cast<Tensor&>(p.momentums_1->Get(weight_index));
-      Tensor& momentums_2 = const_cast<Tensor&>(p.momentums_2->Get(weight_index));
-
-      if (adam_mode_ == 0) {
-        ORT_RETURN_IF_ERROR(
-            AdamWComputeMode0(weight, gradient, momentums_1, momentums_2, lr, alpha_correction, beta_correction));
-      } else if (adam_mode_ == 1) {
-        ORT_RETURN_IF_ERROR(
-            AdamWComputeMode1(weight, gradient, momentums_1, momentums_2, lr, lr_corrected));
-      } else {
-        ORT_THROW("Unsupported Adamw optimizer mode.");
-      }
+    // All parameters are updated in one parallel sweep over chunks of the tensors, and each element of the weights,
+    // gradients and momentums is read and written once.
+    const MLDataType momentum_type = p.momentums_1->DataType();
+    if (momentum_type == DataTypeImpl::GetType<BFloat16>()) {
+      AdamWUpdate<BFloat16>(p, ctx->GetOperatorThreadPool(), lr, alpha_correction, beta_correction, lr_corrected);
+    } else if (momentum_type == DataTypeImpl::GetType<float>()) {
+      AdamWUpdate<float>(p, ctx->GetOperatorThreadPool(), lr, alpha_correction, beta_correction, lr_corrected);
+    } else {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported element type of momentums.");
     }
 
     *updated_flag_ptr = true;
@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "orttraining/training_ops/cpu/optimizer/adamw/adamwbase.h"
 
@@ -21,11 +22,9 @@ class AdamWOptimizer final : public OpKernel, public AdamWOptimizerBase {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  Status AdamWComputeMode0(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2, float lr,
-                           float alpha_correction,
-                           float beta_correction) const;
-  Status AdamWComputeMode1(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2, float lr,
-                           float lr_corrected) const;
+  template <typename TMomentum>
+  void AdamWUpdate(const AdamWOptimizerBase::Prepare& p, concurrency::ThreadPool* tp, float lr,
+                   float alpha_correction, float beta_correction, float lr_corrected) const;
 };
 
 }  // namespace contrib
@@ -40,9 +40,11 @@ class AdamWOptimizerBase {
     info.GetAttrOrDefault("weight_decay", &weight_decay_, 0.f);
     info.GetAttrOrDefault("adam_mode", &adam_mode_, static_cast<int64_t>(0));
     info.GetAttrOrDefault("correct_bias", &correct_bias_, static_cast<int64_t>(1));
+    info.GetAttrOrDefault("max_norm", &max_norm_, 0.f);
 
     ORT_ENFORCE(adam_mode_ == 0 || adam_mode_ == 1, "The value of adam_mode is invalid.");
     ORT_ENFORCE(correct_bias_ == 0 || correct_bias_ == 1, "The value of correct_bias is invalid.");
+    ORT_ENFORCE(max_norm_ >= 0.f, "The value of max_norm must be non-negative.");
 
     // To have torch adamw equivalence, correct_bias must be 1 for adam_mode=0.
     ORT_ENFORCE(adam_mode_ != 0 || correct_bias_ == 1, "The correct_bias should be 1 for adam_mode = 0.");
@@ -58,6 +60,8 @@ class AdamWOptimizerBase {
   float weight_decay_;
   int64_t adam_mode_{0};
   int64_t correct_bias_{0};
+  // The global norm the gradients are clipped to before the update, or 0 if they are not clipped.
+  float max_norm_{0.f};
 };
 
 }  // namespace contrib
@@ -14,6 +14,7 @@ namespace cuda {
 class AdamWOptimizer final : public CudaKernel, public contrib::AdamWOptimizerBase {
  public:
   AdamWOptimizer(const OpKernelInfo& info) : CudaKernel(info), contrib::AdamWOptimizerBase(info) {
+    ORT_ENFORCE(max_norm_ == 0.f, "max_norm is not supported by the CUDA AdamWOptimizer, use InplaceClipGradNorm.");
   }
 
   Status ComputeInternal(OpKernelContext* context) const override;